@@ -0,0 +1,650 @@
+// AoC 2024 - driver program for all days
+// ======================================
+
+// date:  2025-01-16
+// by:    Joseph21 (Joseph21-6147)
+
+// All dayNN.aoc24.cpp files compiled with AOC24_DRIVER defined, linked together with this file and the
+// libs, give one program that can run any selection of days in one process. For instance:
+//
+//     g++ -std=c++17 -O2 -DAOC24_DRIVER -o aoc24 aoc24_driver.cpp day*.aoc24.cpp <libs>.cpp
+//
+// Use --help to get the command line options. The flcBenchmark options (--warmup, --repeat, --profile,
+// --counters, --memory, --cache, --artifacts, --threads, --trace, --json, --csv, --compare, --threshold) apply to every day that is run.
+//
+// With --scaling <f1,f2,...> the selected days are not run on their puzzle input, but on generated inputs
+// (see flcInputGen) of each of the given scales, and the timings of each part are fitted to find how
+// they grow with the input size (see flcScaling). For instance:
+//
+//     aoc24 --day 9,20 --scaling 1,2,4,8,16 --repeat 3
+//
+// "--scaling default" takes the scales of SCALING_DEFAULT_SCALES (0.25 up to 16).
+//
+// With --verify <n> the days that registered more than one engine for a part (see aoc24_registry.h) run
+// all those engines on the puzzle input and on n generated inputs, and the answers and artifacts of each
+// engine are checked against those of the reference engine. The generated inputs get seed --seed, --seed
+// + 1, ... and take their scales in turn from --scaling (default 0.1, 0.5, 1, 2).
+//
+// With --engine <name> a normal run uses engine <name> for the parts that registered one by that name,
+// and the day's own solution for the other parts. E.g. --engine streamed parses and solves the record
+// oriented days in one pass (see flcPipeline.h). When all parts that run use an engine that reads the
+// input itself, the input data preparation is skipped, so the parsed input is never held in memory.
+//
+// With --concurrent, part 1 and part 2 of the days that declared independent parts (see aoc24_registry.h)
+// run at the same time on two threads, after parsing has produced the input snapshot. Each part is timed
+// by its own flcBenchmark object (and so its own flcTimer), and the wall time of the two together is
+// reported as well. With --jobs <n> up to n days run at the same time. The output of each day is
+// collected and printed in the order of the days, so only the suite total shows the gain. The allocation
+// and hardware counters are shared by the whole process, so --memory and --counters are refused together
+// with --concurrent or --jobs.
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "flcBenchmark.h"
+#include "aoc24_registry.h"
+#include "flcInputCache.h"
+#include "flcInputGen.h"
+#include "flcScaling.h"
+
+// ==========   COMMAND LINE
+
+typedef struct sDriverOptionsStruct {
+    std::vector<std::string> vDays;        // selected days - empty means all days
+    int nPhase = AOC24_PUZZLE;             // EXAMPLE, TEST or PUZZLE
+    bool bPart1 = true, bPart2 = true;     // parsing is always done
+    std::string sInputFile;                // if not empty, overrides the default input file
+    std::vector<double> vScales;           // if not empty, run the scaling analysis on these scales
+    unsigned long long nSeed = 2024;       // seed of the generated inputs for --scaling and --verify
+    int nVerify = -1;                      // if >= 0, verify the engines on this nr of generated inputs
+    bool bConcurrent = false;              // run the parts of a day at the same time, where possible
+    int nJobs = 1;                         // nr of days that run at the same time
+    bool bMemory = false, bCounters = false;    // handled by flcBenchmark, only checked here
+    std::string sEngine;                   // if not empty, the engine to run for the parts that have one by this name
+    bool bList = false;
+    bool bHelp = false;
+} DriverOptionsType;
+
+void PrintUsage( const char *sProgName ) {
+    std::cout << "usage: " << sProgName << " [options]" << std::endl;
+    std::cout << "    --day <d>         day to run, e.g. 7, 07 or day07 - repeat or separate by commas for more days (default: all)" << std::endl;
+    std::cout << "    --phase <p>       example, test or puzzle (default: puzzle)" << std::endl;
+    std::cout << "    --part <p>        parse, 1, 2 or all (default: all) - the parts always include parsing" << std::endl;
+    std::cout << "    --input <file>    input file to use instead of the default one (only with a single day)" << std::endl;
+    std::cout << "    --list            list the registered days and exit" << std::endl;
+    std::cout << "    --scaling <f,..>  run on generated inputs of these scales and fit the time to the input size" << std::endl;
+    std::cout << "                      (\"default\" for the scales 0.25, 0.5, 1, 2, 4, 8 and 16)" << std::endl;
+    std::cout << "    --seed <n>        seed of the generated inputs for --scaling and --verify (default: 2024)" << std::endl;
+    std::cout << "    --verify <n>      check the engines of a part against its reference, on the puzzle input and n generated inputs" << std::endl;
+    std::cout << "    --concurrent      run part 1 and part 2 at the same time (days with independent parts only)" << std::endl;
+    std::cout << "    --jobs <n>        nr of days to run at the same time (default: 1)" << std::endl;
+    std::cout << "    --engine <name>   run this engine for the parts that have one by that name, e.g. streamed" << std::endl;
+    std::cout << "    --warmup <n>      nr of untimed runs per phase (default: 0)" << std::endl;
+    std::cout << "    --repeat <n>      nr of timed runs per phase (default: 1)" << std::endl;
+    std::cout << "    --profile         print the flcProfiler section report at the end" << std::endl;
+    std::cout << "    --counters        add hardware performance counters to the profiler report" << std::endl;
+    std::cout << "    --memory          report heap allocations and peak memory per phase" << std::endl;
+    std::cout << "    --cache           reuse the parsed input data of an earlier run (days 01, 13, 14, 23)" << std::endl;
+    std::cout << "    --artifacts <dir> keep the artifacts that can be persisted (like the race track of day 20) in this directory, for later runs" << std::endl;
+    std::cout << "    --threads <n>     nr of threads for the parallel loops (default: hardware concurrency)" << std::endl;
+    std::cout << "    --trace <level>   trace log level: off, panic, error, trace, debug or verbose (default: verbose)" << std::endl;
+    std::cout << "    --json <file>     write the results per phase as JSON" << std::endl;
+    std::cout << "    --csv <file>      write the results per phase as CSV" << std::endl;
+    std::cout << "    --compare <file>  compare the results against a baseline written with --json or --csv" << std::endl;
+    std::cout << "    --threshold <p>   percentage a median time may grow before it's flagged (default: 10)" << std::endl;
+    std::cout << std::endl;
+}
+
+// "7", "07" and "day07" all result in "day07" - returns empty string if sArg is not a valid day
+std::string NormalizeDay( const std::string &sArg ) {
+    std::string sNr = (sArg.compare( 0, 3, "day" ) == 0) ? sArg.substr( 3 ) : sArg;
+    if (sNr.empty() || sNr.length() > 2 || sNr.find_first_not_of( "0123456789" ) != std::string::npos) {
+        return "";
+    }
+    int nDay = atoi( sNr.c_str());
+    if (nDay < 1 || nDay > 25) {
+        return "";
+    }
+    return std::string( "day" ) + (nDay < 10 ? "0" : "") + std::to_string( nDay );
+}
+
+// returns false if there's an error on the command line
+bool ParseOptions( int argc, char *argv[], DriverOptionsType &options ) {
+    bool bResult = true;
+    auto is_arg = [&]( int i, const char *sLong, const char *sShort ) {
+        return strcmp( argv[i], sLong ) == 0 || (sShort != nullptr && strcmp( argv[i], sShort ) == 0);
+    };
+    for (int i = 1; i < argc && bResult; i++) {
+        bool bNeedsValue = is_arg( i, "--day"   , "-d" ) || is_arg( i, "--phase" , nullptr ) ||
+                           is_arg( i, "--part"  , nullptr ) || is_arg( i, "--input" , "-i" ) ||
+                           is_arg( i, "--warmup", "-w" ) || is_arg( i, "--repeat", "-r" ) ||
+                           is_arg( i, "--json"  , nullptr ) || is_arg( i, "--csv"    , nullptr ) ||
+                           is_arg( i, "--compare", nullptr ) || is_arg( i, "--threshold", nullptr ) ||
+                           is_arg( i, "--threads", "-t" ) || is_arg( i, "--trace", nullptr ) ||
+                           is_arg( i, "--scaling", nullptr ) || is_arg( i, "--seed", nullptr ) ||
+                           is_arg( i, "--verify", nullptr ) || is_arg( i, "--jobs", "-j" ) ||
+                           is_arg( i, "--artifacts", nullptr ) || is_arg( i, "--engine", "-e" );
+        if (bNeedsValue && i + 1 >= argc) {
+            std::cout << "ERROR: ParseOptions() --> missing value for argument: " << argv[i] << std::endl;
+            bResult = false;
+        } else if (is_arg( i, "--day", "-d" )) {
+            std::string sList = argv[++i];
+            size_t nStart = 0;
+            while (nStart <= sList.length() && bResult) {
+                size_t nEnd = sList.find( ',', nStart );
+                if (nEnd == std::string::npos) nEnd = sList.length();
+                std::string sToken = sList.substr( nStart, nEnd - nStart );
+                if (sToken == "all") {
+                    options.vDays.clear();
+                } else {
+                    std::string sDay = NormalizeDay( sToken );
+                    if (sDay.empty()) {
+                        std::cout << "ERROR: ParseOptions() --> invalid day: " << sToken << std::endl;
+                        bResult = false;
+                    } else {
+                        options.vDays.push_back( sDay );
+                    }
+                }
+                nStart = nEnd + 1;
+            }
+        } else if (is_arg( i, "--phase", nullptr )) {
+            std::string sPhase = argv[++i];
+            if      (sPhase == "example") options.nPhase = AOC24_EXAMPLE;
+            else if (sPhase == "test"   ) options.nPhase = AOC24_TEST;
+            else if (sPhase == "puzzle" ) options.nPhase = AOC24_PUZZLE;
+            else {
+                std::cout << "ERROR: ParseOptions() --> invalid phase: " << sPhase << std::endl;
+                bResult = false;
+            }
+        } else if (is_arg( i, "--part", nullptr )) {
+            std::string sPart = argv[++i];
+            if      (sPart == "parse") { options.bPart1 = false; options.bPart2 = false; }
+            else if (sPart == "1"    ) { options.bPart1 = true ; options.bPart2 = false; }
+            else if (sPart == "2"    ) { options.bPart1 = false; options.bPart2 = true ; }
+            else if (sPart == "all"  ) { options.bPart1 = true ; options.bPart2 = true ; }
+            else {
+                std::cout << "ERROR: ParseOptions() --> invalid part: " << sPart << std::endl;
+                bResult = false;
+            }
+        } else if (is_arg( i, "--input", "-i" )) {
+            options.sInputFile = argv[++i];
+        } else if (is_arg( i, "--scaling", nullptr )) {
+            std::string sList = argv[++i];
+            size_t nStart = 0;
+            if (sList == "default") {
+                options.vScales = SCALING_DEFAULT_SCALES;
+                nStart = std::string::npos;
+            }
+            while (nStart <= sList.length() && bResult) {
+                size_t nEnd = sList.find( ',', nStart );
+                if (nEnd == std::string::npos) nEnd = sList.length();
+                double dScale = atof( sList.substr( nStart, nEnd - nStart ).c_str());
+                if (dScale <= 0.0) {
+                    std::cout << "ERROR: ParseOptions() --> invalid scale: " << sList.substr( nStart, nEnd - nStart ) << std::endl;
+                    bResult = false;
+                } else {
+                    options.vScales.push_back( dScale );
+                }
+                nStart = nEnd + 1;
+            }
+        } else if (is_arg( i, "--seed", nullptr )) {
+            options.nSeed = strtoull( argv[++i], nullptr, 10 );
+        } else if (is_arg( i, "--verify", nullptr )) {
+            options.nVerify = atoi( argv[++i] );
+            if (options.nVerify < 0) {
+                std::cout << "ERROR: ParseOptions() --> invalid nr of inputs to verify: " << argv[i] << std::endl;
+                bResult = false;
+            }
+        } else if (is_arg( i, "--jobs", "-j" )) {
+            options.nJobs = atoi( argv[++i] );
+            if (options.nJobs < 1) {
+                std::cout << "ERROR: ParseOptions() --> invalid nr of jobs: " << argv[i] << std::endl;
+                bResult = false;
+            }
+        } else if (is_arg( i, "--engine", "-e" )) {
+            options.sEngine = argv[++i];
+        } else if (is_arg( i, "--concurrent", nullptr )) {
+            options.bConcurrent = true;
+        } else if (is_arg( i, "--list", "-l" )) {
+            options.bList = true;
+        } else if (is_arg( i, "--help", "-h" )) {
+            options.bHelp = true;
+        } else if (is_arg( i, "--memory", "-m" )) {
+            options.bMemory = true;
+        } else if (is_arg( i, "--counters", "-c" )) {
+            options.bCounters = true;
+        } else if (bNeedsValue) {
+            i += 1;    // the other options with a value are handled by flcBenchmark, skip the value
+        } else if (!(is_arg( i, "--profile", "-p" ) || is_arg( i, "--cache", nullptr ))) {
+            std::cout << "ERROR: ParseOptions() --> unknown argument: " << argv[i] << std::endl;
+            bResult = false;
+        }
+    }
+    // the allocation and hardware counters are process wide, so they can't be split over parts or days
+    // that run at the same time
+    if (bResult && (options.bConcurrent || options.nJobs > 1) && (options.bMemory || options.bCounters)) {
+        std::cout << "ERROR: ParseOptions() --> --memory and --counters can't be combined with --concurrent or --jobs" << std::endl;
+        bResult = false;
+    }
+    return bResult;
+}
+
+// ==========   RUNNING DAYS
+
+std::string Phase2string( int nPhase ) {
+    switch (nPhase) {
+        case AOC24_EXAMPLE: return "EXAMPLE";
+        case AOC24_TEST   : return "TEST"   ;
+        case AOC24_PUZZLE : return "PUZZLE" ;
+    }
+    return "unknown";
+}
+
+// how a part is solved: by the day's own SolvePart1() / SolvePart2(), or by the engine selected with --engine
+typedef struct sPartSolverStruct {
+    std::string                  sPhaseName;    // e.g. "solving puzzle part 1" or "solving puzzle part 1 (streamed)"
+    std::function<std::string()> fnSolve;
+    bool                         bOwnInput = false;
+} PartSolverType;
+
+PartSolverType GetPartSolver( DayEntryType &day, DriverOptionsType &options, int nPart ) {
+    PartSolverType solver;
+    solver.sPhaseName = "solving puzzle part " + std::to_string( nPart );
+    solver.fnSolve    = (nPart == 1) ? day.fnPart1 : day.fnPart2;
+    EngineEntryType *pEngine = options.sEngine.empty() ? nullptr : aoc24Registry::Instance().FindEngine( day.sDay, nPart, options.sEngine );
+    if (pEngine != nullptr) {
+        solver.sPhaseName += " (" + pEngine->sEngine + ")";
+        solver.fnSolve     = pEngine->fnSolve;
+        solver.bOwnInput   = pEngine->bOwnInput;
+    }
+    return solver;
+}
+
+// runs part 1 and part 2 of the day at the same time: part 2 on a thread of its own, part 1 on the
+// calling thread. Each part has its own benchmark object, their results are added to bench afterwards
+void RunPartsConcurrently( DayEntryType &day, DriverOptionsType &options, PartSolverType &solver1, PartSolverType &solver2, flcBenchmark &bench, std::ostream &os ) {
+    flcBenchmark bench1( bench.GetWarmup(), bench.GetRepeat());
+    flcBenchmark bench2( bench.GetWarmup(), bench.GetRepeat());
+    bench1.SetContext( day.sDay, Phase2string( options.nPhase ));
+    bench2.SetContext( day.sDay, Phase2string( options.nPhase ));
+
+    std::string sAnswer1, sAnswer2;
+    flcTimer wallTimer;
+    std::thread part2Thread( [&]() { bench2.RunPhase( solver2.sPhaseName, [&]() { sAnswer2 = solver2.fnSolve(); } ); } );
+    bench1.RunPhase( solver1.sPhaseName, [&]() { sAnswer1 = solver1.fnSolve(); } );
+    part2Thread.join();
+    double dWallTime = wallTimer.TimeDuration();
+
+    bench.AddPhase( bench1.GetPhase( 0 ));
+    bench.SetAnswerString( sAnswer1 );
+    os << std::endl << "Answer to part 1: " << sAnswer1 << std::endl << std::endl;
+    bench.TimeReport( "    Timing 1 - solving puzzle part 1 : ", " msec", os );
+    bench.AddPhase( bench2.GetPhase( 0 ));
+    bench.SetAnswerString( sAnswer2 );
+    os << std::endl << "Answer to part 2: " << sAnswer2 << std::endl << std::endl;
+    bench.TimeReport( "    Timing 2 - solving puzzle part 2 : ", " msec", os );
+    os << "    Timing 1 + 2 - parts concurrently: " << dWallTime << " msec" << std::endl;
+}
+
+// runs the day, with the output to os
+void RunDay( DayEntryType &day, DriverOptionsType &options, flcBenchmark &bench, std::ostream &os = std::cout ) {
+    os << "========== " << day.sDay << " - Phase: " << Phase2string( options.nPhase ) << " ==========" << std::endl << std::endl;
+    day.fnSetPhase( options.nPhase );
+    bench.SetContext( day.sDay, Phase2string( options.nPhase ));
+
+    PartSolverType solver1 = GetPartSolver( day, options, 1 );
+    PartSolverType solver2 = GetPartSolver( day, options, 2 );
+    // engines that read the input themselves don't need the parsed input - skipping the parsing keeps the
+    // memory use of a streamed run bounded
+    bool bParse = !(options.bPart1 || options.bPart2) || (options.bPart1 && !solver1.bOwnInput) || (options.bPart2 && !solver2.bOwnInput);
+    if (bParse) {
+        bench.RunPhase( "input data preparation", day.fnParse );
+        bench.TimeReport( "    Timing 0 - input data preparation: ", " msec", os );
+    } else {
+        os << "    Timing 0 - input data preparation: skipped, the engines read the input themselves" << std::endl;
+    }
+
+    if (options.bConcurrent && options.bPart1 && options.bPart2 && aoc24Registry::Instance().HasConcurrentParts( day.sDay )) {
+        RunPartsConcurrently( day, options, solver1, solver2, bench, os );
+        os << std::endl;
+        return;
+    }
+    if (options.bPart1) {
+        std::string sAnswer;
+        bench.RunPhase( solver1.sPhaseName, [&]() { sAnswer = solver1.fnSolve(); } );
+        bench.SetAnswerString( sAnswer );
+        os << std::endl << "Answer to part 1: " << sAnswer << std::endl << std::endl;
+        bench.TimeReport( "    Timing 1 - solving puzzle part 1 : ", " msec", os );
+    }
+    if (options.bPart2) {
+        std::string sAnswer;
+        bench.RunPhase( solver2.sPhaseName, [&]() { sAnswer = solver2.fnSolve(); } );
+        bench.SetAnswerString( sAnswer );
+        os << std::endl << "Answer to part 2: " << sAnswer << std::endl << std::endl;
+        bench.TimeReport( "    Timing 2 - solving puzzle part 2 : ", " msec", os );
+    }
+    os << std::endl;
+}
+
+// runs the days on options.nJobs threads. Each day has its own benchmark object and output buffer, and
+// as soon as a day and all days before it are done, its output is printed and its results are added to
+// bench - so the output is in the same order as with a single job
+void RunDaysConcurrently( std::vector<DayEntryType *> &vToRun, DriverOptionsType &options, flcBenchmark &bench ) {
+    int nDays = (int)vToRun.size();
+    std::vector<std::unique_ptr<flcBenchmark>> vBench;
+    std::vector<std::stringstream> vOutput( nDays );
+    std::vector<std::promise<void>> vDone( nDays );
+    std::vector<std::future<void>> vFinished;
+    for (int i = 0; i < nDays; i++) {
+        vBench.push_back( std::make_unique<flcBenchmark>( bench.GetWarmup(), bench.GetRepeat()));
+        vFinished.push_back( vDone[i].get_future());
+    }
+    std::atomic<int> nNext( 0 );
+    auto worker = [&]() {
+        for (int i = nNext++; i < nDays; i = nNext++) {
+            RunDay( *vToRun[i], options, *vBench[i], vOutput[i] );
+            vDone[i].set_value();
+        }
+    };
+    std::vector<std::thread> vThreads;
+    for (int t = 0; t < std::min( options.nJobs, nDays ); t++) {
+        vThreads.emplace_back( worker );
+    }
+    for (int i = 0; i < nDays; i++) {
+        vFinished[i].wait();
+        std::cout << vOutput[i].str() << std::flush;
+        for (int p = 0; p < vBench[i]->GetNrPhases(); p++) {
+            bench.AddPhase( vBench[i]->GetPhase( p ));
+        }
+    }
+    for (auto &t : vThreads) {
+        t.join();
+    }
+}
+
+// runs the day on a generated input per scale, and reports how the time of each phase grows with the
+// size of the input. Returns the nr of super-linear phases, or -1 if the input can't be generated
+int RunScaling( DayEntryType &day, DriverOptionsType &options, flcBenchmark &bench ) {
+    int nDay = atoi( day.sDay.c_str() + 3 );
+    if (!HasInputGenerator( nDay )) {
+        std::cout << "ERROR: RunScaling() --> no input generator for: " << day.sDay << std::endl << std::endl;
+        return -1;
+    }
+    std::cout << "========== " << day.sDay << " - Scaling ==========" << std::endl << std::endl;
+    // the phases to time, parsing always included
+    std::vector<std::pair<std::string, std::function<std::string()>>> vPhases;
+    vPhases.push_back( { "input data preparation", [&]() { day.fnParse(); return std::string(); } } );
+    if (options.bPart1) vPhases.push_back( { "solving puzzle part 1", day.fnPart1 } );
+    if (options.bPart2) vPhases.push_back( { "solving puzzle part 2", day.fnPart2 } );
+    std::vector<ScalingSeriesType> vSeries( vPhases.size());
+    for (size_t p = 0; p < vPhases.size(); p++) {
+        vSeries[p].sName = day.sDay + " " + vPhases[p].first;
+    }
+
+    aoc24Registry &registry = aoc24Registry::Instance();
+    std::string sTempFile = (std::filesystem::temp_directory_path() / ("aoc24_scaling_" + day.sDay + ".txt")).string();
+    registry.SetInputFile( sTempFile );
+    day.fnSetPhase( AOC24_PUZZLE );
+    int nResult = 0;
+    for (double dScale : options.vScales) {
+        flcGenParams params;
+        params.dScale = dScale;
+        long long nBytes = GenerateInput( nDay, sTempFile, options.nSeed, params );
+        if (nBytes < 0) {
+            nResult = -1;
+            break;
+        }
+        std::stringstream ssContext;
+        ssContext << "SCALE " << dScale;
+        bench.SetContext( day.sDay, ssContext.str());
+
+        std::cout << "    scale " << dScale << " (" << nBytes << " bytes):";
+        for (size_t p = 0; p < vPhases.size(); p++) {
+            std::string sAnswer;
+            bench.RunPhase( vPhases[p].first, [&]() { sAnswer = vPhases[p].second(); } );
+            bench.SetAnswerString( sAnswer );
+            double dMedian = bench.GetPhase( bench.GetNrPhases() - 1 ).stats.dMedian;
+            vSeries[p].vScale.push_back( dScale );
+            vSeries[p].vSize.push_back( (double)nBytes );
+            vSeries[p].vTime.push_back( dMedian );
+            std::cout << "  " << dMedian << " msec";
+        }
+        std::cout << std::endl;
+    }
+    std::filesystem::remove( sTempFile );
+    registry.SetInputFile( "" );
+    std::cout << std::endl;
+    if (nResult == 0) {
+        nResult = flcScaling::Report( vSeries );
+    }
+    return nResult;
+}
+
+// small hash of an artifact, for the report
+std::string ArtifactDigest( const std::string &sArtifact ) {
+    if (sArtifact.empty()) {
+        return "-";
+    }
+    uint64_t nHash = flcInputCache::HashContent( sArtifact );
+    std::stringstream ss;
+    ss << std::hex << std::setw( 8 ) << std::setfill( '0' ) << (uint32_t)(nHash ^ (nHash >> 32));    // folded to 32 bits
+    return ss.str();
+}
+
+// runs all engines of the parts of the day that have more than one, on the puzzle input and on the
+// generated inputs, and compares them against the reference engine (the one named "reference", or else
+// the first one). Returns the nr of mismatches, or -1 if an input can't be generated
+int RunVerify( DayEntryType &day, DriverOptionsType &options, flcBenchmark &bench ) {
+    aoc24Registry &registry = aoc24Registry::Instance();
+    std::vector<std::vector<EngineEntryType>> vPartEngines;
+    std::vector<int> vParts;
+    for (int nPart = 1; nPart <= 2; nPart++) {
+        std::vector<EngineEntryType> vEngines = registry.GetEngines( day.sDay, nPart );
+        if (vEngines.size() > 1 && (nPart == 1 ? options.bPart1 : options.bPart2)) {
+            // the reference goes first
+            std::stable_partition( vEngines.begin(), vEngines.end(), []( const EngineEntryType &e ) { return e.sEngine == "reference"; } );
+            vPartEngines.push_back( vEngines );
+            vParts.push_back( nPart );
+        }
+    }
+    if (vParts.empty()) {
+        return 0;
+    }
+    std::cout << "========== " << day.sDay << " - Verify ==========" << std::endl << std::endl;
+
+    // the inputs: the puzzle input, and the generated ones
+    int nDay = atoi( day.sDay.c_str() + 3 );
+    std::vector<double> vScales = options.vScales.empty() ? std::vector<double>{ 0.1, 0.5, 1.0, 2.0 } : options.vScales;
+    int nGenerated = HasInputGenerator( nDay ) ? options.nVerify : 0;
+    if (nGenerated < options.nVerify) {
+        std::cout << "WARNING: RunVerify() --> no input generator for " << day.sDay << ", only the puzzle input is used" << std::endl;
+    }
+    std::string sTempFile = (std::filesystem::temp_directory_path() / ("aoc24_verify_" + day.sDay + ".txt")).string();
+
+    std::cout << "    " << std::left << std::setw( 26 ) << "input" << std::setw( 6 ) << "part" << std::setw( 12 ) << "engine"
+              << std::setw( 22 ) << "answer" << std::setw( 10 ) << "artifact" << std::right << std::setw( 14 ) << "median msec"
+              << std::setw( 10 ) << "speedup" << std::endl;
+    std::ios_base::fmtflags oldFlags = std::cout.flags();
+    std::streamsize nOldPrecision = std::cout.precision();
+    int nMismatches = 0;
+    for (int nInput = -1; nInput < nGenerated; nInput++) {
+        std::stringstream ssInput;
+        if (nInput < 0) {
+            registry.SetInputFile( "" );
+            ssInput << "puzzle";
+        } else {
+            flcGenParams params;
+            params.dScale = vScales[nInput % vScales.size()];
+            unsigned long long nSeed = options.nSeed + nInput;
+            if (GenerateInput( nDay, sTempFile, nSeed, params ) < 0) {
+                nMismatches = -1;
+                break;
+            }
+            registry.SetInputFile( sTempFile );
+            ssInput << "scale " << params.dScale << " seed " << nSeed;
+        }
+        day.fnSetPhase( AOC24_PUZZLE );
+        bench.SetContext( day.sDay, "VERIFY " + ssInput.str());
+        bench.RunPhase( "input data preparation", day.fnParse );
+
+        for (size_t p = 0; p < vParts.size(); p++) {
+            std::string sRefAnswer, sRefArtifact;
+            double dRefTime = 0.0;
+            for (size_t e = 0; e < vPartEngines[p].size(); e++) {
+                EngineEntryType &engine = vPartEngines[p][e];
+                std::string sAnswer;
+                bench.RunPhase( "solving puzzle part " + std::to_string( vParts[p] ) + " (" + engine.sEngine + ")", [&]() { sAnswer = engine.fnSolve(); } );
+                bench.SetAnswerString( sAnswer );
+                double dTime = bench.GetPhase( bench.GetNrPhases() - 1 ).stats.dMedian;
+                std::string sArtifact = engine.fnArtifact ? engine.fnArtifact() : "";
+                if (e == 0) {
+                    sRefAnswer   = sAnswer;
+                    sRefArtifact = sArtifact;
+                    dRefTime     = dTime;
+                }
+                std::cout << "    " << std::left << std::setw( 26 ) << (e == 0 && p == 0 ? ssInput.str() : "")
+                          << std::setw( 6 ) << (e == 0 ? std::to_string( vParts[p] ) : "") << std::setw( 12 ) << engine.sEngine
+                          << std::setw( 22 ) << sAnswer << std::setw( 10 ) << ArtifactDigest( sArtifact ) << std::right
+                          << std::setw( 14 ) << std::fixed << std::setprecision( 4 ) << dTime
+                          << std::setw( 10 ) << std::setprecision( 2 ) << (dTime > 0.0 ? dRefTime / dTime : 0.0);
+                std::cout.flags( oldFlags );
+                std::cout.precision( nOldPrecision );
+                if (sAnswer != sRefAnswer) {
+                    std::cout << "   ANSWER MISMATCH";
+                    nMismatches += 1;
+                } else if (sArtifact != sRefArtifact) {
+                    std::cout << "   ARTIFACT MISMATCH";
+                    nMismatches += 1;
+                }
+                std::cout << std::endl;
+            }
+        }
+    }
+    std::filesystem::remove( sTempFile );
+    registry.SetInputFile( "" );
+    if (nMismatches >= 0) {
+        std::cout << nMismatches << " mismatch(es)" << std::endl;
+    }
+    std::cout << std::endl;
+    return nMismatches;
+}
+
+// ==========   MAIN()
+
+int main( int argc, char *argv[] )
+{
+    DriverOptionsType options;
+    if (!ParseOptions( argc, argv, options ) || options.bHelp) {
+        PrintUsage( argv[0] );
+        return options.bHelp ? 0 : 1;
+    }
+    aoc24Registry &registry = aoc24Registry::Instance();
+    if (options.bList) {
+        for (auto &e : registry.GetDays()) {
+            std::cout << e.sDay << std::endl;
+        }
+        return 0;
+    }
+
+    // collect the days to run
+    std::vector<DayEntryType *> vToRun;
+    if (options.vDays.empty()) {
+        for (auto &e : registry.GetDays()) {
+            vToRun.push_back( &e );
+        }
+    } else {
+        for (auto &sDay : options.vDays) {
+            DayEntryType *pDay = registry.FindDay( sDay );
+            if (pDay == nullptr) {
+                std::cout << "ERROR: main() --> day not available: " << sDay << std::endl;
+                return 1;
+            }
+            vToRun.push_back( pDay );
+        }
+    }
+    if (!options.sInputFile.empty()) {
+        if (!options.vScales.empty() || options.nVerify >= 0) {
+            std::cout << "ERROR: main() --> --input can't be combined with --scaling or --verify" << std::endl;
+            return 1;
+        }
+        if (vToRun.size() != 1) {
+            std::cout << "ERROR: main() --> --input can only be used when a single day is selected" << std::endl;
+            return 1;
+        }
+        registry.SetInputFile( options.sInputFile );
+    }
+    if ((options.bConcurrent || options.nJobs > 1) && (!options.vScales.empty() || options.nVerify >= 0)) {
+        std::cout << "ERROR: main() --> --concurrent and --jobs can't be combined with --scaling or --verify" << std::endl;
+        return 1;
+    }
+    if (!options.sEngine.empty() && (!options.vScales.empty() || options.nVerify >= 0)) {
+        std::cout << "ERROR: main() --> --engine can't be combined with --scaling or --verify" << std::endl;
+        return 1;
+    }
+    if (!options.sEngine.empty()) {
+        // a misspelled engine would silently run the default solvers
+        bool bEngineFound = false;
+        for (auto pDay : vToRun) {
+            for (int nPart = 1; nPart <= 2 && !bEngineFound; nPart++) {
+                bEngineFound = registry.FindEngine( pDay->sDay, nPart, options.sEngine ) != nullptr;
+            }
+        }
+        if (!bEngineFound) {
+            std::cout << "ERROR: main() --> no selected day has an engine named: " << options.sEngine << std::endl;
+            return 1;
+        }
+    }
+
+    flcBenchmark bench( argc, argv );
+    if (options.nVerify >= 0) {
+        // exit code 2 signals mismatches, 1 that an input couldn't be generated
+        int nMismatches = 0;
+        bool bError = false;
+        for (auto pDay : vToRun) {
+            int nDayMismatches = RunVerify( *pDay, options, bench );
+            bError = bError || nDayMismatches < 0;
+            nMismatches += std::max( nDayMismatches, 0 );
+        }
+        bench.WriteResults();
+        return bError ? 1 : (nMismatches > 0 ? 2 : 0);
+    }
+    if (!options.vScales.empty()) {
+        // exit code 2 signals super-linear phases, 1 that an input couldn't be generated
+        int nFlagged = 0;
+        bool bError = false;
+        for (auto pDay : vToRun) {
+            int nDayFlagged = RunScaling( *pDay, options, bench );
+            bError = bError || nDayFlagged < 0;
+            nFlagged += std::max( nDayFlagged, 0 );
+        }
+        bench.WriteResults();
+        return bError ? 1 : (nFlagged > 0 ? 2 : 0);
+    }
+    flcTimer suiteTimer;
+    if (options.nJobs > 1) {
+        RunDaysConcurrently( vToRun, options, bench );
+    } else {
+        for (auto pDay : vToRun) {
+            RunDay( *pDay, options, bench );
+        }
+    }
+    suiteTimer.TimeReport( "Total time for " + std::to_string( vToRun.size()) + " day(s): " );
+    std::cout << std::endl;
+
+    bench.SummaryReport();
+
+    // exit code 2 signals regressions against the baseline, 1 that results couldn't be written or read
+    int nFlagged = bench.WriteResults();
+    return (nFlagged < 0) ? 1 : (nFlagged > 0 ? 2 : 0);
+}
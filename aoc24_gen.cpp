@@ -0,0 +1,84 @@
+// AoC 2024 - synthetic input generator
+// ====================================
+
+// date:  2025-02-03
+// by:    Joseph21 (Joseph21-6147)
+
+// Generates input files in the format of the puzzle input of a day, but of any size, to see how the
+// solutions scale (see flcInputGen for the generators). Build it with the libs:
+//
+//     g++ -std=c++17 -O2 -o aoc24_gen aoc24_gen.cpp <libs>.cpp
+//
+// and run a day on the result with the driver, e.g.
+//
+//     aoc24_gen --day 9 --scale 1000 --output big09.txt
+//     aoc24 --day 9 --input big09.txt
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "flcInputGen.h"
+
+// ==========   MAIN
+
+void PrintUsage( const char *sProgName ) {
+    std::cout << "usage: " << sProgName << " --day <d> [options]" << std::endl;
+    std::cout << "    --day <d>         day to generate input for" << std::endl;
+    std::cout << "    --scale <f>       size relative to the puzzle input (default: 1)" << std::endl;
+    std::cout << "    --seed <n>        seed of the random generator (default: 2024)" << std::endl;
+    std::cout << "    --output <file>   output file (default: dayNN.input.generated.txt)" << std::endl;
+    std::cout << "    --dup <f>         day 01: fraction of duplicate values (default: 0.2)" << std::endl;
+    std::cout << "available days:" << std::endl;
+    for (auto &gen : InputGeneratorList()) {
+        std::cout << "    " << (gen.first < 10 ? "0" : "") << gen.first << "  " << gen.second << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+int main( int argc, char *argv[] ) {
+    int nDay = 0;
+    unsigned long long nSeed = 2024;
+    std::string sOutput;
+    flcGenParams params;
+    bool bOk = true;
+    for (int i = 1; i < argc && bOk; i++) {
+        bool bNeedsValue = strcmp( argv[i], "--day" ) == 0 || strcmp( argv[i], "--scale" ) == 0 || strcmp( argv[i], "--seed" ) == 0 ||
+                           strcmp( argv[i], "--output" ) == 0 || strcmp( argv[i], "--dup" ) == 0;
+        if (!bNeedsValue) {
+            if (strcmp( argv[i], "--help" ) != 0) {
+                std::cout << "ERROR: main() --> unknown argument: " << argv[i] << std::endl;
+            }
+            bOk = false;
+        } else if (i + 1 >= argc) {
+            std::cout << "ERROR: main() --> missing value for argument: " << argv[i] << std::endl;
+            bOk = false;
+        } else {
+            const char *sArg = argv[i++];
+            if (strcmp( sArg, "--day"    ) == 0) nDay = atoi( argv[i] + (strncmp( argv[i], "day", 3 ) == 0 ? 3 : 0));
+            if (strcmp( sArg, "--scale"  ) == 0) params.dScale = atof( argv[i] );
+            if (strcmp( sArg, "--seed"   ) == 0) nSeed = strtoull( argv[i], nullptr, 10 );
+            if (strcmp( sArg, "--output" ) == 0) sOutput = argv[i];
+            if (strcmp( sArg, "--dup"    ) == 0) params.dDup = atof( argv[i] );
+        }
+    }
+    if (bOk && !HasInputGenerator( nDay )) {
+        std::cout << "ERROR: main() --> no generator for day: " << nDay << std::endl;
+        bOk = false;
+    }
+    if (!bOk) {
+        PrintUsage( argv[0] );
+        return 1;
+    }
+    if (sOutput.empty()) {
+        sOutput = std::string( "day" ) + (nDay < 10 ? "0" : "") + std::to_string( nDay ) + ".input.generated.txt";
+    }
+    long long nBytes = GenerateInput( nDay, sOutput, nSeed, params );
+    if (nBytes < 0) {
+        return 1;
+    }
+    std::cout << "day " << nDay << ", scale " << params.dScale << ", seed " << nSeed << ": "
+              << nBytes << " bytes written to " << sOutput << std::endl;
+    return 0;
+}
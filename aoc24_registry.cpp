@@ -0,0 +1,82 @@
+// AoC 2024 - registry of day solvers
+// ==================================
+
+// date:  2025-01-16
+// by:    Joseph21 (Joseph21-6147)
+
+#include <algorithm>
+#include <iostream>
+
+#include "aoc24_registry.h"
+
+// ==============================/ Class aoc24Registry /==============================
+
+aoc24Registry &aoc24Registry::Instance() {
+    static aoc24Registry instance;
+    return instance;
+}
+
+bool aoc24Registry::Register( const DayEntryType &dayEntry ) {
+    if (FindDay( dayEntry.sDay ) != nullptr) {
+        std::cout << "ERROR: aoc24Registry::Register() --> day registered twice: " << dayEntry.sDay << std::endl;
+        return false;
+    }
+    m_vDays.push_back( dayEntry );
+    std::sort(
+        m_vDays.begin(), m_vDays.end(),
+        []( const DayEntryType &a, const DayEntryType &b ) {
+            return a.sDay < b.sDay;
+        }
+    );
+    return true;
+}
+
+DayEntryType *aoc24Registry::FindDay( const std::string &sDay ) {
+    for (auto &e : m_vDays) {
+        if (e.sDay == sDay) {
+            return &e;
+        }
+    }
+    return nullptr;
+}
+
+bool aoc24Registry::RegisterEngine( const EngineEntryType &engineEntry ) {
+    for (auto &e : m_vEngines) {
+        if (e.sDay == engineEntry.sDay && e.nPart == engineEntry.nPart && e.sEngine == engineEntry.sEngine) {
+            std::cout << "ERROR: aoc24Registry::RegisterEngine() --> engine registered twice: " << engineEntry.sDay
+                      << " part " << engineEntry.nPart << " " << engineEntry.sEngine << std::endl;
+            return false;
+        }
+    }
+    m_vEngines.push_back( engineEntry );
+    return true;
+}
+
+std::vector<EngineEntryType> aoc24Registry::GetEngines( const std::string &sDay, int nPart ) {
+    std::vector<EngineEntryType> vResult;
+    for (auto &e : m_vEngines) {
+        if (e.sDay == sDay && e.nPart == nPart) {
+            vResult.push_back( e );
+        }
+    }
+    return vResult;
+}
+
+EngineEntryType *aoc24Registry::FindEngine( const std::string &sDay, int nPart, const std::string &sEngine ) {
+    for (auto &e : m_vEngines) {
+        if (e.sDay == sDay && e.nPart == nPart && e.sEngine == sEngine) {
+            return &e;
+        }
+    }
+    return nullptr;
+}
+
+// ==========   INPUT FILE NAMES
+
+std::string GetInputFileName( const std::string &sDay, const std::string &sKind ) {
+    std::string sOverride = aoc24Registry::Instance().GetInputFile();
+    if (!sOverride.empty()) {
+        return sOverride;
+    }
+    return sDay + ".input." + sKind + ".txt";
+}
@@ -0,0 +1,170 @@
+// AoC 2024 - registry of day solvers
+// ==================================
+
+// date:  2025-01-16
+// by:    Joseph21 (Joseph21-6147)
+
+// Each dayNN.aoc24.cpp can be built as a program of its own, or - when compiled with AOC24_DRIVER
+// defined - be linked together with all other days into the aoc24 driver program (see aoc24_driver.cpp).
+// In the latter case the day has no main(), but registers its phase functions here instead:
+//
+//     AOC24_REGISTER_DAY( day01 );
+//
+// where day01 is the namespace that holds that day's glbProgPhase, PrepareInput(), SolvePart1() and
+// SolvePart2(). The answers of the parts are converted to strings, so that the driver can handle all
+// days in the same way.
+//
+// The input file names of the TEST and PUZZLE phases are obtained via GetInputFileName(), so that the
+// driver can point a day to another input file.
+//
+// A day can also register more than one implementation (engine) of a part, e.g. the original straight
+// forward solution as reference, next to an optimized one:
+//
+//     AOC24_REGISTER_ENGINE( day09, 2, reference, SolvePart2_reference, Part2Artifact );
+//     AOC24_REGISTER_ENGINE( day09, 2, optimized, SolvePart2          , Part2Artifact );
+//
+// The --verify mode of the driver runs all engines of a part on the same inputs, and checks that they
+// give the same answer, and the same artifact: a text representation of an intermediate result (e.g.
+// the final disk layout of day 09), which catches errors that happen to give the right answer. In a
+// normal run, --engine <name> runs engine <name> instead of SolvePart1() / SolvePart2() for the parts that
+// have an engine by that name.
+//
+// A day whose parts share no state besides the (read only) input snapshot can declare that its parts may
+// run at the same time, on different threads:
+//
+//     AOC24_CONCURRENT_PARTS( day01 );
+//
+// The --concurrent mode of the driver then runs part 1 and part 2 of that day concurrently. Days where
+// part 2 builds on the results of part 1 (e.g. days 11, 16, 20 and 23), or where both parts use the same
+// global scratch data (e.g. the map of day 08 or the registers of day 17), must not declare this.
+
+#ifndef AOC24_REGISTRY_H
+#define AOC24_REGISTRY_H
+
+#include <functional>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// program phases as used by the days: 0 = EXAMPLE, 1 = TEST, 2 = PUZZLE
+#define AOC24_EXAMPLE 0
+#define AOC24_TEST    1
+#define AOC24_PUZZLE  2
+
+// the entry points of one day
+typedef struct sDayEntryStruct {
+    std::string                  sDay;          // e.g. "day01"
+    std::function<void( int )>   fnSetPhase;    // sets the program phase (EXAMPLE, TEST, PUZZLE)
+    std::function<void()>        fnParse;       // reads and parses the input data
+    std::function<std::string()> fnPart1;       // solve part 1, returns the answer
+    std::function<std::string()> fnPart2;       // solve part 2, returns the answer
+} DayEntryType;
+
+// one implementation of a part of a day
+typedef struct sEngineEntryStruct {
+    std::string                  sDay;          // e.g. "day09"
+    int                          nPart;         // 1 or 2
+    std::string                  sEngine;       // e.g. "reference" or "optimized"
+    std::function<std::string()> fnSolve;       // solves the part, returns the answer
+    std::function<std::string()> fnArtifact;    // the artifact of the most recent fnSolve() call
+    bool                         bOwnInput = false;    // reads the input itself, it doesn't need PrepareInput()
+} EngineEntryType;
+
+class aoc24Registry {
+public:
+    // there's one registry per program run
+    static aoc24Registry &Instance();
+
+    // adds a day, returns false if a day with the same name was registered already
+    bool Register( const DayEntryType &dayEntry );
+
+    // all registered days, sorted on name
+    std::vector<DayEntryType> &GetDays() { return m_vDays; }
+    // returns nullptr if sDay is not registered
+    DayEntryType *FindDay( const std::string &sDay );
+
+    // adds an engine, returns false if that day and part already have an engine with the same name
+    bool RegisterEngine( const EngineEntryType &engineEntry );
+    // the engines of a part, in order of registration
+    std::vector<EngineEntryType> GetEngines( const std::string &sDay, int nPart );
+    // returns nullptr if the part has no engine named sEngine
+    EngineEntryType *FindEngine( const std::string &sDay, int nPart, const std::string &sEngine );
+
+    // marks the parts of sDay as independent of each other, see AOC24_CONCURRENT_PARTS()
+    void SetConcurrentParts( const std::string &sDay ) { m_sConcurrentParts.insert( sDay ); }
+    bool HasConcurrentParts( const std::string &sDay ) { return m_sConcurrentParts.count( sDay ) > 0; }
+
+    // if set (not empty), GetInputFileName() returns this file name instead of the default one
+    void SetInputFile( const std::string &sFileName ) { m_sInputFile = sFileName; }
+    std::string GetInputFile() { return m_sInputFile; }
+
+private:
+    aoc24Registry() {}
+
+    std::vector<DayEntryType> m_vDays;
+    std::vector<EngineEntryType> m_vEngines;
+    std::set<std::string> m_sConcurrentParts;
+    std::string m_sInputFile;
+};
+
+// returns the name of the input file for day sDay and phase sKind ("test" or "puzzle"), which is
+// "<sDay>.input.<sKind>.txt" unless the registry holds another input file name
+std::string GetInputFileName( const std::string &sDay, const std::string &sKind );
+
+// converts an answer of any type that can be streamed to a string
+template <typename T>
+std::string AnswerToString( const T &answer ) {
+    std::stringstream ss;
+    ss << answer;
+    return ss.str();
+}
+
+// a static object of this type registers a day at program start up
+class aoc24DayRegistrar {
+public:
+    aoc24DayRegistrar( const DayEntryType &dayEntry ) { aoc24Registry::Instance().Register( dayEntry ); }
+};
+
+class aoc24EngineRegistrar {
+public:
+    aoc24EngineRegistrar( const EngineEntryType &engineEntry ) { aoc24Registry::Instance().RegisterEngine( engineEntry ); }
+};
+
+class aoc24ConcurrentPartsRegistrar {
+public:
+    aoc24ConcurrentPartsRegistrar( const std::string &sDay ) { aoc24Registry::Instance().SetConcurrentParts( sDay ); }
+};
+
+#define AOC24_REGISTER_DAY( ns )                                                                \
+    static aoc24DayRegistrar ns##_registrar( {                                                  \
+        DAY_STRING,                                                                             \
+        []( int nPhase ) { ns::glbProgPhase = (ns::eProgPhase)nPhase; },                        \
+        []() { ns::PrepareInput(); },                                                           \
+        []() { return AnswerToString( ns::SolvePart1()); },                                     \
+        []() { return AnswerToString( ns::SolvePart2()); }                                      \
+    } )
+
+// registers fnSolve of namespace ns as engine 'name' of part nPart, with fnArtifact giving its artifact
+#define AOC24_REGISTER_ENGINE( ns, nPart, name, fnSolve, fnArtifact )                           \
+    static aoc24EngineRegistrar ns##_engine_##nPart##_##name( {                                 \
+        DAY_STRING, nPart, #name,                                                               \
+        []() { return AnswerToString( ns::fnSolve()); },                                        \
+        []() { return ns::fnArtifact(); }                                                       \
+    } )
+
+// same, for an engine that reads and parses the input itself (like the streamed engines of flcPipeline.h).
+// If all parts that run use such an engine, the driver skips the input data preparation
+#define AOC24_REGISTER_OWN_INPUT_ENGINE( ns, nPart, name, fnSolve, fnArtifact )                 \
+    static aoc24EngineRegistrar ns##_engine_##nPart##_##name( {                                 \
+        DAY_STRING, nPart, #name,                                                               \
+        []() { return AnswerToString( ns::fnSolve()); },                                        \
+        []() { return ns::fnArtifact(); },                                                      \
+        true                                                                                    \
+    } )
+
+// declares that part 1 and part 2 of namespace ns may run at the same time
+#define AOC24_CONCURRENT_PARTS( ns )                                                            \
+    static aoc24ConcurrentPartsRegistrar ns##_concurrent_parts( DAY_STRING )
+
+#endif // AOC24_REGISTRY_H
@@ -13,9 +13,17 @@
 #include <vector>
 
 #include "../flcTimer.h"
+#include "../flcBenchmark.h"
+#include "../flcInputFile.h"
+#include "../flcInputCache.h"
+#include "../aoc24_registry.h"
+#include "../flcSnapshot.h"
 #include "../parse_functions.h"
+#include "../parse_numbers.h"
 #include "my_utility.h"
 
+namespace day01 {
+
 // ==========   PROGRAM PHASING
 
 enum eProgPhase {     // what programming phase are you in - set at start of main()
@@ -40,6 +48,8 @@ typedef struct {
     int left, rght;
 } DatumType;
 typedef std::vector<DatumType> DataStream;
+// identifies the layout of DatumType in the input cache - change it if the layout changes
+#define INPUT_CACHE_TAG  DAY_STRING ".v1"
 
 // ==========   INPUT DATA FUNCTIONS
 
@@ -59,20 +69,23 @@ void GetData_EXAMPLE( DataStream &dData ) {
 // file input - this function reads text file content one line at a time - adapt code to match your need for line parsing!
 void ReadInputData( const std::string sFileName, DataStream &vData ) {
 
-    std::ifstream dataFileStream( sFileName );
+    flcInputFile dataFile( sFileName );
     vData.clear();
-    std::string sLine;
-    while (getline( dataFileStream, sLine )) {
-        std::string sLeft, sRght;
+    // with --cache, the parsed data of an earlier run is reused if the input file didn't change
+    if (flcInputCache::Load( dataFile, INPUT_CACHE_TAG, vData )) {
+        return;
+    }
+    for (std::string_view sLine : dataFile.Lines()) {
+        std::string_view sLeft, sRght;
         split_token_dlmtd( "   ", sLine, sLeft, sRght );
-        DatumType cDatum = { stoi( sLeft ), stoi( sRght ) };
+        DatumType cDatum = { to_int( sLeft ), to_int( sRght ) };
         vData.push_back( cDatum );
     }
-    dataFileStream.close();
+    flcInputCache::Save( dataFile, INPUT_CACHE_TAG, vData );
 }
 
-void GetData_TEST(   DataStream &dData ) { std::string sInputFile = DAY_STRING; sInputFile.append( ".input.test.txt"   ); ReadInputData( sInputFile, dData ); }
-void GetData_PUZZLE( DataStream &dData ) { std::string sInputFile = DAY_STRING; sInputFile.append( ".input.puzzle.txt" ); ReadInputData( sInputFile, dData ); }
+void GetData_TEST(   DataStream &dData ) { std::string sInputFile = GetInputFileName( DAY_STRING, "test"   ); ReadInputData( sInputFile, dData ); }
+void GetData_PUZZLE( DataStream &dData ) { std::string sInputFile = GetInputFileName( DAY_STRING, "puzzle" ); ReadInputData( sInputFile, dData ); }
 
 // ==========   CONSOLE OUTPUT FUNCTIONS
 
@@ -113,82 +126,117 @@ void GetInput( DataStream &dData, bool bDisplay = false ) {
 
 // ==========   PUZZLE SPECIFIC SOLUTIONS
 
-void SortInputData( DataStream &dData ) {
-    std::vector<int> vLeft, vRght;
+// the left and right columns, each sorted on its own
+void SortedColumns( const DataStream &dData, std::vector<int> &vLeft, std::vector<int> &vRght ) {
+    vLeft.clear();
+    vRght.clear();
     for (auto &e : dData) {
         vLeft.push_back( e.left );
         vRght.push_back( e.rght );
     }
     std::sort( vLeft.begin(), vLeft.end() );
     std::sort( vRght.begin(), vRght.end() );
-
-    for (int i = 0; i < (int)vLeft.size(); i++) {
-        dData[i].left = vLeft[i];
-        dData[i].rght = vRght[i];
-    }
 }
 
-int CumulatedDistance( DataStream &dData ) {
-    int nResult = 0;
-    for (auto e : dData) {
-        nResult += abs( e.left - e.rght );
+long long CumulatedDistance( const std::vector<int> &vLeft, const std::vector<int> &vRght ) {
+    long long nResult = 0;
+    for (int i = 0; i < (int)vLeft.size(); i++) {
+        nResult += abs( vLeft[i] - vRght[i] );
     }
     return nResult;
 }
 
 // ----- PART 2
 
-int GetSimilarityScore( DataStream &dData ) {
+long long GetSimilarityScore( const DataStream &dData ) {
     std::vector<int> vLeft, vRght;
     for (auto &e : dData) {
         vLeft.push_back( e.left );
         vRght.push_back( e.rght );
     }
 
-    int nResult = 0;
+    long long nResult = 0;
     for (int i = 0; i < (int)vLeft.size(); i++) {
         int nCurVal = vLeft[i];
         int nFactor = std::count( vRght.begin(), vRght.end(), nCurVal );
-        nResult += nCurVal * nFactor;
+        nResult += (long long)nCurVal * nFactor;
     }
     return nResult;
 }
 
+// ==========   PHASE FUNCTIONS
+
+flcSnapshot<DataStream> glbInputData;   // parsed input data - the parts view it read only
+
+// phase 0 - get input data, depending on the glbProgPhase (example, test, puzzle)
+void PrepareInput() {
+    DataStream inputData;
+    GetInput( inputData, glbProgPhase != PUZZLE );
+    glbInputData = MakeSnapshot( std::move( inputData ));
+}
+
+long long SolvePart1() {
+    std::vector<int> vLeft, vRght;
+    SortedColumns( *glbInputData, vLeft, vRght );
+    return CumulatedDistance( vLeft, vRght );
+}
+
+long long SolvePart2() {
+    return GetSimilarityScore( *glbInputData );
+}
+
+}   // namespace day01
+
 // ==========   MAIN()
 
-int main()
+#ifdef AOC24_DRIVER
+
+// in the aoc24 driver program this day registers its phase functions instead of having a main()
+AOC24_REGISTER_DAY( day01 );
+AOC24_CONCURRENT_PARTS( day01 );
+
+#else
+
+using namespace day01;
+
+int main( int argc, char *argv[] )
 {
     glbProgPhase = PUZZLE;     // program phase to EXAMPLE, TEST or PUZZLE
     std::cout << "Phase: " << ProgPhase2string() << std::endl << std::endl;
-    flcTimer tmr;
+    flcBenchmark bench( argc, argv );   // use --warmup <n> and --repeat <n> to get timing statistics
+    bench.SetContext( DAY_STRING, ProgPhase2string());
 
-/* ========== */   tmr.StartTiming();   // ============================================vvvvv
+/* ========== */   bench.RunPhase( "input data preparation", PrepareInput );   // =====================vvvvv
 
-    // get input data, depending on the glbProgPhase (example, test, puzzle)
-    DataStream inputData;
-    GetInput( inputData, glbProgPhase != PUZZLE );
-    DataStream part2Data = inputData;
-    std::cout << "Data stats - size of data stream " << inputData.size() << std::endl << std::endl;
+    std::cout << "Data stats - size of data stream " << glbInputData->size() << std::endl << std::endl;
 
-/* ========== */   tmr.TimeReport( "    Timing 0 - input data preparation: " );   // =========================^^^^^vvvvv
+/* ========== */   bench.TimeReport( "    Timing 0 - input data preparation: " );   // =========================^^^^^vvvvv
 
     // part 1 code here
 
-    SortInputData( inputData );
-    int nCumulatedDistances = CumulatedDistance( inputData );
+    long long nCumulatedDistances;
+    bench.RunPhase( "solving puzzle part 1", [&]() { nCumulatedDistances = SolvePart1(); } );
+    bench.SetAnswer( nCumulatedDistances );
 
     std::cout << std::endl << "Answer to part 1: cumulated distances = " << nCumulatedDistances << std::endl << std::endl;
 
-/* ========== */   tmr.TimeReport( "    Timing 1 - solving puzzle part 1 : " );   // =========================^^^^^vvvvv
+/* ========== */   bench.TimeReport( "    Timing 1 - solving puzzle part 1 : " );   // =========================^^^^^vvvvv
 
     // part 2 code here
 
-    inputData = part2Data; // get fresh untouched copy of input data
-    int nSimScore = GetSimilarityScore( inputData );
+    long long nSimScore;
+    bench.RunPhase( "solving puzzle part 2", [&]() { nSimScore = SolvePart2(); } );
+    bench.SetAnswer( nSimScore );
 
     std::cout << std::endl << "Answer to part 2: total similarity score = " << nSimScore << std::endl << std::endl;
 
-/* ========== */   tmr.TimeReport( "    Timing 2 - solving puzzle part 2 : " );   // ==============================^^^^^
+/* ========== */   bench.TimeReport( "    Timing 2 - solving puzzle part 2 : " );   // ==============================^^^^^
+
+    if (bench.GetRepeat() > 1) {
+        bench.SummaryReport();
+    }
 
     return 0;
 }
+
+#endif // AOC24_DRIVER
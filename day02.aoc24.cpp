@@ -13,9 +13,18 @@
 #include <vector>
 
 #include "../flcTimer.h"
+#include "../flcBenchmark.h"
+#include "../flcInputFile.h"
+#include "../flcThreadPool.h"
+#include "../aoc24_registry.h"
+#include "../flcSnapshot.h"
+#include "../flcPipeline.h"
 #include "../parse_functions.h"
+#include "../parse_numbers.h"
 #include "my_utility.h"
 
+namespace day02 {
+
 // ==========   PROGRAM PHASING
 
 enum eProgPhase {     // what programming phase are you in - set at start of main()
@@ -55,29 +64,28 @@ void GetData_EXAMPLE( DataStream &dData ) {
     cDatum = { 1, 3, 6, 7, 9 }; dData.push_back( cDatum );
 }
 
+// a report is a line of levels, separated by spaces
+DatumType ParseReport( std::string_view sLine ) {
+    DatumType cDatum;
+    parse_list( sLine, ' ', cDatum );
+    return cDatum;
+}
+
 // file input - this function reads text file content one line at a time - adapt code to match your need for line parsing!
 void ReadInputData( const std::string sFileName, DataStream &vData ) {
 
-    std::ifstream dataFileStream( sFileName );
+    flcInputFile dataFile( sFileName );
     vData.clear();
-    std::string sLine;
-    while (getline( dataFileStream, sLine )) {
-        DatumType cDatum;
-        while (sLine.length() > 0) {
-            std::string sLevel = get_token_dlmtd( " ", sLine );
-            if (sLevel.length() > 0) {
-                cDatum.push_back( stoi( sLevel ) );
-            }
-        }
+    for (std::string_view sLine : dataFile.Lines()) {
+        DatumType cDatum = ParseReport( sLine );
         if (!cDatum.empty()) {
             vData.push_back( cDatum );
         }
     }
-    dataFileStream.close();
 }
 
-void GetData_TEST(   DataStream &dData ) { std::string sInputFile = DAY_STRING; sInputFile.append( ".input.test.txt"   ); ReadInputData( sInputFile, dData ); }
-void GetData_PUZZLE( DataStream &dData ) { std::string sInputFile = DAY_STRING; sInputFile.append( ".input.puzzle.txt" ); ReadInputData( sInputFile, dData ); }
+void GetData_TEST(   DataStream &dData ) { std::string sInputFile = GetInputFileName( DAY_STRING, "test"   ); ReadInputData( sInputFile, dData ); }
+void GetData_PUZZLE( DataStream &dData ) { std::string sInputFile = GetInputFileName( DAY_STRING, "puzzle" ); ReadInputData( sInputFile, dData ); }
 
 // ==========   CONSOLE OUTPUT FUNCTIONS
 
@@ -125,7 +133,7 @@ bool IsGraduallyDecreasing( int a, int b ) { return (b < a) && (b >= a - 3); }
 
 // a report is safe if all elements are either decreasing, and pairwise gradually decreasing,
 // or increasing and pairwise gradually increasing
-bool IsSafe1( DatumType &dDatum ) {
+bool IsSafe1( const DatumType &dDatum ) {
     bool bAllIncreasing = true;
     bool bAllDecreasing = true;
     bool bValid = bAllIncreasing || bAllDecreasing;
@@ -149,7 +157,7 @@ bool IsSafe1( DatumType &dDatum ) {
 // ----- PART 2
 
 // if the report (line with levels) is not safe as is, try if it becomes safe by removing any level
-bool IsSafe2( DatumType &dDatum ) {
+bool IsSafe2( const DatumType &dDatum ) {
     bool bSafe = IsSafe1( dDatum );
 
     // if not safe as is, attempt to make the report safe by removing any of its levels
@@ -168,52 +176,133 @@ bool IsSafe2( DatumType &dDatum ) {
     return bSafe;
 }
 
+// ==========   PHASE FUNCTIONS
+
+flcSnapshot<DataStream> glbInputData;   // parsed input data - the parts view it read only
+
+// phase 0 - get input data, depending on the glbProgPhase (example, test, puzzle)
+void PrepareInput() {
+    DataStream inputData;
+    GetInput( inputData, glbProgPhase != PUZZLE );
+    glbInputData = MakeSnapshot( std::move( inputData ));
+}
+
+// the reports are independent of each other, so they are checked in parallel
+int SolvePart1() {
+    const DataStream &inputData = *glbInputData;
+    int nTotalSafe1 = parallel_reduce( 0, (int)inputData.size(), 0,
+        [&]( int i ) { return IsSafe1( inputData[i] ) ? 1 : 0; },
+        []( int a, int b ) { return a + b; }
+    );
+    return nTotalSafe1;
+}
+
+int SolvePart2() {
+    const DataStream &inputData = *glbInputData;
+    int nTotalSafe2 = parallel_reduce( 0, (int)inputData.size(), 0,
+        [&]( int i ) { return IsSafe2( inputData[i] ) ? 1 : 0; },
+        []( int a, int b ) { return a + b; }
+    );
+    return nTotalSafe2;
+}
+
+// ----- STREAMED VERSION
+
+PipelineStatsType glbStreamStats[2];   // per part, of the last streamed run - the parts may run concurrently
+
+// parses the reports and checks them at the same time: the reports go from the input file through a
+// bounded queue to the consumer tasks (see flcPipeline.h), without building the data stream. The
+// example data is not in a file, so that is streamed from the hard coded reports
+int CountSafeReports_streamed( bool (*fnIsSafe)( const DatumType & ), PipelineStatsType &stats ) {
+    return pipeline_reduce<DatumType>(
+        [&]( auto &&emit ) {
+            if (glbProgPhase == EXAMPLE) {
+                DataStream exampleData;
+                GetData_EXAMPLE( exampleData );
+                for (auto &cDatum : exampleData) {
+                    emit( std::move( cDatum ));
+                }
+                return;
+            }
+            flcInputFile dataFile( GetInputFileName( DAY_STRING, glbProgPhase == TEST ? "test" : "puzzle" ) );
+            for (std::string_view sLine : dataFile.Lines()) {
+                DatumType cDatum = ParseReport( sLine );
+                if (!cDatum.empty()) {
+                    emit( std::move( cDatum ));
+                }
+            }
+        },
+        0,
+        [&]( const DatumType &cDatum ) { return fnIsSafe( cDatum ) ? 1 : 0; },
+        []( int a, int b ) { return a + b; },
+        &stats
+    );
+}
+
+int SolvePart1_streamed() { return CountSafeReports_streamed( IsSafe1, glbStreamStats[0] ); }
+int SolvePart2_streamed() { return CountSafeReports_streamed( IsSafe2, glbStreamStats[1] ); }
+
+// the nr of reports that were checked - catches reports that got lost in the queue
+std::string ParsedArtifact()    { return std::to_string( glbInputData->size()); }
+std::string StreamedArtifact1() { return std::to_string( glbStreamStats[0].nRecords ); }
+std::string StreamedArtifact2() { return std::to_string( glbStreamStats[1].nRecords ); }
+
+}   // namespace day02
+
 // ==========   MAIN()
 
-int main()
+#ifdef AOC24_DRIVER
+
+// in the aoc24 driver program this day registers its phase functions instead of having a main()
+AOC24_REGISTER_DAY( day02 );
+AOC24_CONCURRENT_PARTS( day02 );
+AOC24_REGISTER_ENGINE( day02, 1, reference, SolvePart1         , ParsedArtifact   );
+AOC24_REGISTER_OWN_INPUT_ENGINE( day02, 1, streamed, SolvePart1_streamed, StreamedArtifact1 );
+AOC24_REGISTER_ENGINE( day02, 2, reference, SolvePart2         , ParsedArtifact   );
+AOC24_REGISTER_OWN_INPUT_ENGINE( day02, 2, streamed, SolvePart2_streamed, StreamedArtifact2 );
+
+#else
+
+using namespace day02;
+
+int main( int argc, char *argv[] )
 {
     glbProgPhase = PUZZLE;     // program phase to EXAMPLE, TEST or PUZZLE
     std::cout << "Phase: " << ProgPhase2string() << std::endl << std::endl;
-    flcTimer tmr;
+    flcBenchmark bench( argc, argv );   // use --warmup <n> and --repeat <n> to get timing statistics
+    bench.SetContext( DAY_STRING, ProgPhase2string());
 
-/* ========== */   tmr.StartTiming();   // ============================================vvvvv
+/* ========== */   bench.RunPhase( "input data preparation", PrepareInput );   // =====================vvvvv
 
-    // get input data, depending on the glbProgPhase (example, test, puzzle)
-    DataStream inputData;
-    GetInput( inputData, glbProgPhase != PUZZLE );
-    DataStream part2Data = inputData;
-    std::cout << "Data stats - size of data stream " << inputData.size() << std::endl << std::endl;
+    std::cout << "Data stats - size of data stream " << glbInputData->size() << std::endl << std::endl;
 
-/* ========== */   tmr.TimeReport( "    Timing 0 - input data preparation: " );   // =========================^^^^^vvvvv
+/* ========== */   bench.TimeReport( "    Timing 0 - input data preparation: " );   // =========================^^^^^vvvvv
 
     // part 1 code here
 
-    int nTotalSafe1 = 0;
-    for (int i = 0; i < (int)inputData.size(); i++) {
-        if (IsSafe1( inputData[i] )) {
-            nTotalSafe1 += 1;
-//            std::cout << "Index: " << i << " is safe" << std::endl;
-        }
-    }
+    int nTotalSafe1;
+    bench.RunPhase( "solving puzzle part 1", [&]() { nTotalSafe1 = SolvePart1(); } );
+    bench.SetAnswer( nTotalSafe1 );
 
     std::cout << std::endl << "Answer to part 1: total safe = " << nTotalSafe1 << std::endl << std::endl;
 
-/* ========== */   tmr.TimeReport( "    Timing 1 - solving puzzle part 1 : " );   // =========================^^^^^vvvvv
+/* ========== */   bench.TimeReport( "    Timing 1 - solving puzzle part 1 : " );   // =========================^^^^^vvvvv
 
     // part 2 code here
 
-    inputData = part2Data; // get fresh untouched copy of input data
-    int nTotalSafe2 = 0;
-    for (int i = 0; i < (int)inputData.size(); i++) {
-        if (IsSafe2( inputData[i] )) {
-            nTotalSafe2 += 1;
-//            std::cout << "Index: " << i << " is safe" << std::endl;
-        }
-    }
+    int nTotalSafe2;
+    bench.RunPhase( "solving puzzle part 2", [&]() { nTotalSafe2 = SolvePart2(); } );
+    bench.SetAnswer( nTotalSafe2 );
 
     std::cout << std::endl << "Answer to part 2: total safe = " << nTotalSafe2 << std::endl << std::endl;
 
-/* ========== */   tmr.TimeReport( "    Timing 2 - solving puzzle part 2 : " );   // ==============================^^^^^
+/* ========== */   bench.TimeReport( "    Timing 2 - solving puzzle part 2 : " );   // ==============================^^^^^
+
+    if (bench.GetRepeat() > 1) {
+        bench.SummaryReport();
+    }
 
     return 0;
 }
+
+#endif // AOC24_DRIVER
@@ -13,9 +13,16 @@
 #include <vector>
 
 #include "../flcTimer.h"
+#include "../flcBenchmark.h"
+#include "../flcInputFile.h"
+#include "../aoc24_registry.h"
+#include "../flcSnapshot.h"
 #include "../parse_functions.h"
+#include "../parse_numbers.h"
 #include "my_utility.h"
 
+namespace day03 {
+
 // ==========   PROGRAM PHASING
 
 enum eProgPhase {     // what programming phase are you in - set at start of main()
@@ -54,17 +61,15 @@ void GetData_EXAMPLE( DataStream &dData ) {
 // file input - this function reads text file content one line at a time - adapt code to match your need for line parsing!
 void ReadInputData( const std::string sFileName, DataStream &vData ) {
 
-    std::ifstream dataFileStream( sFileName );
+    flcInputFile dataFile( sFileName );
     vData.clear();
-    std::string sLine;
-    while (getline( dataFileStream, sLine )) {
-        vData.push_back( sLine );
+    for (std::string_view sLine : dataFile.Lines()) {
+        vData.emplace_back( sLine );
     }
-    dataFileStream.close();
 }
 
-void GetData_TEST(   DataStream &dData ) { std::string sInputFile = DAY_STRING; sInputFile.append( ".input.test.txt"   ); ReadInputData( sInputFile, dData ); }
-void GetData_PUZZLE( DataStream &dData ) { std::string sInputFile = DAY_STRING; sInputFile.append( ".input.puzzle.txt" ); ReadInputData( sInputFile, dData ); }
+void GetData_TEST(   DataStream &dData ) { std::string sInputFile = GetInputFileName( DAY_STRING, "test"   ); ReadInputData( sInputFile, dData ); }
+void GetData_PUZZLE( DataStream &dData ) { std::string sInputFile = GetInputFileName( DAY_STRING, "puzzle" ); ReadInputData( sInputFile, dData ); }
 
 // ==========   CONSOLE OUTPUT FUNCTIONS
 
@@ -104,10 +109,13 @@ void GetInput( DataStream &dData, bool bDisplay = false ) {
 
 // ==========   PUZZLE SPECIFIC SOLUTIONS
 
+// The parse functions work on a string_view cursor into the input data: cutting off a token just moves
+// the start of the view, so nothing is copied.
+
 // generic keyword parsing function:
 //     if the head of iDatum matches sKeyWord, then that part of iDatum is cut off and true is returned
 //     else false is returned and iDatum is not changed
-bool ParseKeyword( DatumType &iDatum, std::string sKeyWord ) {
+bool ParseKeyword( std::string_view &iDatum, std::string_view sKeyWord ) {
     bool bSuccess = false;
     if (iDatum.length() >= sKeyWord.length()) {
         bool bMatch = true;
@@ -117,43 +125,43 @@ bool ParseKeyword( DatumType &iDatum, std::string sKeyWord ) {
         bSuccess = bMatch;
     }
     if (bSuccess) {
-        std::string sRemove = get_token_sized( sKeyWord.length(), iDatum );
+        get_token_sized( sKeyWord.length(), iDatum );
     }
     return bSuccess;
 }
 
-bool ParseKeywordMUL( DatumType &iDatum ) {
+bool ParseKeywordMUL( std::string_view &iDatum ) {
     return ParseKeyword( iDatum, "mul" );
 }
 
-bool ParseLeftPar( DatumType &iDatum ) {
+bool ParseLeftPar( std::string_view &iDatum ) {
     if (
         iDatum.length() >= 1 &&
         iDatum[0] == '('
     ) {
-        std::string sRemove = get_token_sized( 1, iDatum );
+        get_token_sized( 1, iDatum );
         return true;
     }
     return false;
 }
 
-bool ParseRghtPar( DatumType &iDatum ) {
+bool ParseRghtPar( std::string_view &iDatum ) {
     if (
         iDatum.length() >= 1 &&
         iDatum[0] == ')'
     ) {
-        std::string sRemove = get_token_sized( 1, iDatum );
+        get_token_sized( 1, iDatum );
         return true;
     }
     return false;
 }
 
-bool ParseComma( DatumType &iDatum ) {
+bool ParseComma( std::string_view &iDatum ) {
     if (
         iDatum.length() >= 1 &&
         iDatum[0] == ','
     ) {
-        std::string sRemove = get_token_sized( 1, iDatum );
+        get_token_sized( 1, iDatum );
         return true;
     }
     return false;
@@ -163,26 +171,20 @@ bool IsNumeric( char c ) {
     return (c >= '0' && c <= '9');
 }
 
-bool ParseArg( DatumType &iDatum, int &nArg ) {
-    if (iDatum.length() >= 1) {
-        bool bNumeric = IsNumeric( iDatum[0] );
-        std::string sArg;
-        int i = 0;
-        while (bNumeric && i < (int)iDatum.length() && i < 3) {
-            sArg.push_back( iDatum[i] );
-            i += 1;
-            bNumeric = IsNumeric( iDatum[i] );
-        }
-        if (sArg.length() > 0) {
-            nArg = stoi( sArg );
-            std::string sRemove = get_token_sized( sArg.length(), iDatum );
-            return true;
-        }
+// an argument is 1 to 3 digits
+bool ParseArg( std::string_view &iDatum, int &nArg ) {
+    size_t nDigits = 0;
+    while (nDigits < iDatum.length() && nDigits < 3 && IsNumeric( iDatum[nDigits] )) {
+        nDigits += 1;
+    }
+    if (nDigits > 0) {
+        nArg = to_int( get_token_sized( nDigits, iDatum ));
+        return true;
     }
     return false;
 }
 
-bool ParseMul( DatumType &iDatum, int &a, int &b ) {
+bool ParseMul( std::string_view &iDatum, int &a, int &b ) {
     bool bSuccess = false;
     if (ParseKeywordMUL( iDatum )) {
         if (ParseLeftPar( iDatum )) {
@@ -206,54 +208,41 @@ bool ParseMul( DatumType &iDatum, int &a, int &b ) {
 
 // For part 2 I first created a generic keyword parser, and partly rebuild part 1 with it.
 
-bool ParseDo(   DatumType &iDatum ) { return ParseKeyword( iDatum, "do()"    ); }
-bool ParseDont( DatumType &iDatum ) { return ParseKeyword( iDatum, "don't()" ); }
+bool ParseDo(   std::string_view &iDatum ) { return ParseKeyword( iDatum, "do()"    ); }
+bool ParseDont( std::string_view &iDatum ) { return ParseKeyword( iDatum, "don't()" ); }
 
-// ==========   MAIN()
+// ==========   PHASE FUNCTIONS
 
-int main()
-{
-    glbProgPhase = PUZZLE;     // program phase to EXAMPLE, TEST or PUZZLE
-    std::cout << "Phase: " << ProgPhase2string() << std::endl << std::endl;
-    flcTimer tmr;
+flcSnapshot<DataStream> glbInputData;   // parsed input data - the parts view it read only
 
-/* ========== */   tmr.StartTiming();   // ============================================vvvvv
-
-    // get input data, depending on the glbProgPhase (example, test, puzzle)
+// phase 0 - get input data, depending on the glbProgPhase (example, test, puzzle)
+void PrepareInput() {
     DataStream inputData;
     GetInput( inputData, glbProgPhase != PUZZLE );
-    DataStream part2Data = inputData;
-    std::cout << "Data stats - size of data stream " << inputData.size() << std::endl << std::endl;
-
-/* ========== */   tmr.TimeReport( "    Timing 0 - input data preparation: " );   // =========================^^^^^vvvvv
-
-    // part 1 code here
-
-    int nCumulatedResult1 = 0;
+    glbInputData = MakeSnapshot( std::move( inputData ));
+}
 
-    for (int i = 0; i < (int)inputData.size(); i++) {
-        DatumType curDatum = inputData[i];
+long long SolvePart1() {
+    long long nCumulatedResult1 = 0;
+    for (int i = 0; i < (int)glbInputData->size(); i++) {
+        std::string_view curDatum = (*glbInputData)[i];
         while (curDatum.length() > 0) {
             int n1, n2;
             if (ParseMul( curDatum, n1, n2 )) {
                 nCumulatedResult1 += n1 * n2;
             } else {
-                std::string sRemove = get_token_sized( 1, curDatum );
+                get_token_sized( 1, curDatum );
             }
         }
     }
+    return nCumulatedResult1;
+}
 
-    std::cout << std::endl << "Answer to part 1: cumulated result = " << nCumulatedResult1 << std::endl << std::endl;
-
-/* ========== */   tmr.TimeReport( "    Timing 1 - solving puzzle part 1 : " );   // =========================^^^^^vvvvv
-
-    // part 2 code here
-
-    int nCumulatedResult2 = 0;
+long long SolvePart2() {
+    long long nCumulatedResult2 = 0;
     bool bEnabled = true;
-
-    for (int i = 0; i < (int)inputData.size(); i++) {
-        DatumType curDatum = inputData[i];
+    for (int i = 0; i < (int)glbInputData->size(); i++) {
+        std::string_view curDatum = (*glbInputData)[i];
         while (curDatum.length() > 0) {
             int n1, n2;
             if (ParseMul( curDatum, n1, n2 )) {
@@ -265,14 +254,65 @@ int main()
             } else if (ParseDont( curDatum )) {
                 bEnabled = false;
             } else {
-                std::string sRemove = get_token_sized( 1, curDatum );
+                get_token_sized( 1, curDatum );
             }
         }
     }
+    return nCumulatedResult2;
+}
+
+}   // namespace day03
+
+// ==========   MAIN()
+
+#ifdef AOC24_DRIVER
+
+// in the aoc24 driver program this day registers its phase functions instead of having a main()
+AOC24_REGISTER_DAY( day03 );
+AOC24_CONCURRENT_PARTS( day03 );
+
+#else
+
+using namespace day03;
+
+int main( int argc, char *argv[] )
+{
+    glbProgPhase = PUZZLE;     // program phase to EXAMPLE, TEST or PUZZLE
+    std::cout << "Phase: " << ProgPhase2string() << std::endl << std::endl;
+    flcBenchmark bench( argc, argv );   // use --warmup <n> and --repeat <n> to get timing statistics
+    bench.SetContext( DAY_STRING, ProgPhase2string());
+
+/* ========== */   bench.RunPhase( "input data preparation", PrepareInput );   // =====================vvvvv
+
+    std::cout << "Data stats - size of data stream " << glbInputData->size() << std::endl << std::endl;
+
+/* ========== */   bench.TimeReport( "    Timing 0 - input data preparation: " );   // =========================^^^^^vvvvv
+
+    // part 1 code here
+
+    long long nCumulatedResult1;
+    bench.RunPhase( "solving puzzle part 1", [&]() { nCumulatedResult1 = SolvePart1(); } );
+    bench.SetAnswer( nCumulatedResult1 );
+
+    std::cout << std::endl << "Answer to part 1: cumulated result = " << nCumulatedResult1 << std::endl << std::endl;
+
+/* ========== */   bench.TimeReport( "    Timing 1 - solving puzzle part 1 : " );   // =========================^^^^^vvvvv
+
+    // part 2 code here
+
+    long long nCumulatedResult2;
+    bench.RunPhase( "solving puzzle part 2", [&]() { nCumulatedResult2 = SolvePart2(); } );
+    bench.SetAnswer( nCumulatedResult2 );
 
     std::cout << std::endl << "Answer to part 2: total similarity score = " << nCumulatedResult2 << std::endl << std::endl;
 
-/* ========== */   tmr.TimeReport( "    Timing 2 - solving puzzle part 2 : " );   // ==============================^^^^^
+/* ========== */   bench.TimeReport( "    Timing 2 - solving puzzle part 2 : " );   // ==============================^^^^^
+
+    if (bench.GetRepeat() > 1) {
+        bench.SummaryReport();
+    }
 
     return 0;
 }
+
+#endif // AOC24_DRIVER
@@ -13,9 +13,17 @@
 #include <vector>
 
 #include "../flcTimer.h"
+#include "../flcBenchmark.h"
+#include "../flcInputFile.h"
+#include "../aoc24_registry.h"
+#include "../flcSnapshot.h"
+#include "../flcGrid.h"
+#include "../flcBitGrid.h"
 #include "../parse_functions.h"
 #include "my_utility.h"
 
+namespace day04 {
+
 // ==========   PROGRAM PHASING
 
 enum eProgPhase {     // what programming phase are you in - set at start of main()
@@ -62,17 +70,15 @@ void GetData_EXAMPLE( DataStream &dData ) {
 // file input - this function reads text file content one line at a time - adapt code to match your need for line parsing!
 void ReadInputData( const std::string sFileName, DataStream &vData ) {
 
-    std::ifstream dataFileStream( sFileName );
+    flcInputFile dataFile( sFileName );
     vData.clear();
-    std::string sLine;
-    while (getline( dataFileStream, sLine )) {
-        vData.push_back( sLine );
+    for (std::string_view sLine : dataFile.Lines()) {
+        vData.emplace_back( sLine );
     }
-    dataFileStream.close();
 }
 
-void GetData_TEST(   DataStream &dData ) { std::string sInputFile = DAY_STRING; sInputFile.append( ".input.test.txt"   ); ReadInputData( sInputFile, dData ); }
-void GetData_PUZZLE( DataStream &dData ) { std::string sInputFile = DAY_STRING; sInputFile.append( ".input.puzzle.txt" ); ReadInputData( sInputFile, dData ); }
+void GetData_TEST(   DataStream &dData ) { std::string sInputFile = GetInputFileName( DAY_STRING, "test"   ); ReadInputData( sInputFile, dData ); }
+void GetData_PUZZLE( DataStream &dData ) { std::string sInputFile = GetInputFileName( DAY_STRING, "puzzle" ); ReadInputData( sInputFile, dData ); }
 
 // ==========   CONSOLE OUTPUT FUNCTIONS
 
@@ -111,151 +117,131 @@ void GetInput( DataStream &dData, bool bDisplay = false ) {
 
 // ==========   PUZZLE SPECIFIC SOLUTIONS
 
-bool MatchChar( char a, char b ) { return a == b; }
-
-// provides 8 coordinate offset patterns
-std::vector<int> vOffsets1 = {
-    0,  0, +1,  0, +2,  0, +3,  0,  // horizontal to right
-    0,  0, -1,  0, -2,  0, -3,  0,  //               left
-    0,  0,  0, +1,  0, +2,  0, +3,  // vertical down
-    0,  0,  0, -1,  0, -2,  0, -3,  //          up
-    0,  0, +1, -1, +2, -2, +3, -3,  // diagonal right up
-    0,  0, +1, +1, +2, +2, +3, +3,  //                down
-    0,  0, -1, -1, -2, -2, -3, -3,  // diagonal left up
-    0,  0, -1, +1, -2, +2, -3, +3   //               down
-};
-
-// count the number of matches for "XMAS", where the "X" is at position (x, y) in the input data
-int MatchPosition1( DataStream &inputData, int x, int y ) {
-    int inputHeight = inputData.size();
-    int inputWidth  = inputData[0].length();
-    int nCountMatches = 0;
-
-    auto in_bounds = [=]( int x, int y ) {
-        return (x >= 0 && x < inputWidth && y >= 0 && y < inputHeight);
+// the letters of the puzzle are split into one bit grid per letter. A word is matched in direction
+// (dx, dy) for all cells at once: the cell must hold the first letter, and the grid of the i-th letter
+// shifted back i steps must be set in that cell too
+typedef struct sLetterGridsStruct {
+    flcBitGrid X, M, A, S;
+} LetterGrids;
+
+LetterGrids GetLetterGrids( const DataStream &vData ) {
+    return {
+        BitGridFromLines( vData, 'X' ),
+        BitGridFromLines( vData, 'M' ),
+        BitGridFromLines( vData, 'A' ),
+        BitGridFromLines( vData, 'S' )
     };
-
-    for (int dir = 0; dir < 8; dir ++) {
-        bool bMatch = true;
-        for (int i = 0; i < 4 && bMatch; i++) {
-            int tmpx = vOffsets1[ 8 * dir + 2 * i + 0 ];
-            int tmpy = vOffsets1[ 8 * dir + 2 * i + 1 ];
-
-            char cCharToMatch = "XMAS"[i];
-
-            bMatch = in_bounds( x + tmpx, y + tmpy ) &&
-                     MatchChar( cCharToMatch, inputData[ (y + tmpy) ][ (x + tmpx) ]);
-        }
-        // if bMatch comes out of the loop being true, then all 4 characters must have matched
-        if (bMatch) {
-            nCountMatches += 1;
-        }
-    }
-    return nCountMatches;
 }
 
-// iterate over all positions of the input data and cumulate matches
-int FindAllMatches1( DataStream &inputData ) {
-    int inputHeight = inputData.size();
-    int inputWidth  = inputData[0].length();
+// count the number of matches for "XMAS" in all 8 directions of the direction table (see flcGrid.h)
+int FindAllMatches1( LetterGrids &letters ) {
     int nCountMatches = 0;
-
-    for (int y = 0; y < inputHeight; y++) {
-        for (int x = 0; x < inputWidth; x++) {
-            nCountMatches += MatchPosition1( inputData, x, y );
-        }
+    for (int dir = 0; dir < 8; dir++) {
+        int dx = glbDirX8[dir], dy = glbDirY8[dir];
+        flcBitGrid match = letters.X;
+        match &= letters.M.Shifted( -1 * dx, -1 * dy );
+        match &= letters.A.Shifted( -2 * dx, -2 * dy );
+        match &= letters.S.Shifted( -3 * dx, -3 * dy );
+        nCountMatches += match.Count();
     }
     return nCountMatches;
 }
 
 // ----- PART 2
 
-// provides 4 coordinate offset patterns
-std::vector<int> vOffsets2 = {
-    -1, +1,  0,  0, +1, -1,  // diagonal right up
-    -1, -1,  0,  0, +1, +1,  //                down
-    +1, +1,  0,  0, -1, -1,  // diagonal left up
-    +1, -1,  0,  0, -1, +1,  //               down
-};
-
-// count the number of matches for "MAS", where the "A" is at position (x, y) in the input data
-// if there are two matches, then it counts as one X-"MAS" match, so one is returned
-int MatchPosition2( DataStream &inputData, int x, int y ) {
-    int inputHeight = inputData.size();
-    int inputWidth  = inputData[0].length();
-    int nCountMatches = 0;
+// the "A" cells that have a "MAS" running through them in diagonal direction nDir: the "M" is one step
+// against the direction, the "S" one step along it
+flcBitGrid MatchDiagonal( LetterGrids &letters, int nDir ) {
+    int dx = glbDirX8[nDir], dy = glbDirY8[nDir];
+    flcBitGrid match = letters.A;
+    match &= letters.M.Shifted( +dx, +dy );
+    match &= letters.S.Shifted( -dx, -dy );
+    return match;
+}
 
-    auto in_bounds = [=]( int x, int y ) {
-        return (x >= 0 && x < inputWidth && y >= 0 && y < inputHeight);
-    };
+// an X-"MAS" needs a match on both diagonals: up right or down left (directions 1 and 5 of the 8
+// direction table), and down right or up left (directions 3 and 7)
+int FindAllMatches2( LetterGrids &letters ) {
+    flcBitGrid diag1 = MatchDiagonal( letters, 1 ) | MatchDiagonal( letters, 5 );
+    flcBitGrid diag2 = MatchDiagonal( letters, 3 ) | MatchDiagonal( letters, 7 );
+    diag1 &= diag2;
+    return diag1.Count();
+}
 
-    for (int dir = 0; dir < 4; dir ++) {
-        bool bMatch = true;
-        for (int i = 0; i < 3 && bMatch; i++) {
-            int tmpx = vOffsets2[ 6 * dir + 2 * i + 0 ];
-            int tmpy = vOffsets2[ 6 * dir + 2 * i + 1 ];
 
-            char cCharToMatch = "MAS"[i];
+// ==========   PHASE FUNCTIONS
 
-            bMatch = in_bounds( x + tmpx, y + tmpy ) &&
-                     MatchChar( cCharToMatch, inputData[ (y + tmpy) ][ (x + tmpx) ]);
-        }
-        if (bMatch) {
-            nCountMatches += 1;
-        }
-    }
-    // if there were 2 matches, they must have been in an X shape
-    return (nCountMatches == 2) ? 1 : 0;
+flcSnapshot<DataStream> glbInputData;   // parsed input data - the parts view it read only
+
+// phase 0 - get input data, depending on the glbProgPhase (example, test, puzzle)
+void PrepareInput() {
+    DataStream inputData;
+    GetInput( inputData, glbProgPhase != PUZZLE );
+    glbInputData = MakeSnapshot( std::move( inputData ));
 }
 
-// iterate over all positions of the input data and cumulate matches
-int FindAllMatches2( DataStream &inputData ) {
-    int inputHeight = inputData.size();
-    int inputWidth  = inputData[0].length();
-    int nCountMatches = 0;
+int SolvePart1() {
+    LetterGrids letters = GetLetterGrids( *glbInputData );
+    return FindAllMatches1( letters );
+}
 
-    for (int y = 0; y < inputHeight; y++) {
-        for (int x = 0; x < inputWidth; x++) {
-            nCountMatches += MatchPosition2( inputData, x, y );
-        }
-    }
-    return nCountMatches;
+int SolvePart2() {
+    LetterGrids letters = GetLetterGrids( *glbInputData );
+    return FindAllMatches2( letters );
 }
 
+}   // namespace day04
 
 // ==========   MAIN()
 
-int main()
+#ifdef AOC24_DRIVER
+
+// in the aoc24 driver program this day registers its phase functions instead of having a main()
+AOC24_REGISTER_DAY( day04 );
+AOC24_CONCURRENT_PARTS( day04 );
+
+#else
+
+using namespace day04;
+
+int main( int argc, char *argv[] )
 {
     glbProgPhase = PUZZLE;     // program phase to EXAMPLE, TEST or PUZZLE
     std::cout << "Phase: " << ProgPhase2string() << std::endl << std::endl;
-    flcTimer tmr;
+    flcBenchmark bench( argc, argv );   // use --warmup <n> and --repeat <n> to get timing statistics
+    bench.SetContext( DAY_STRING, ProgPhase2string());
 
-/* ========== */   tmr.StartTiming();   // ============================================vvvvv
+/* ========== */   bench.RunPhase( "input data preparation", PrepareInput );   // =====================vvvvv
 
-    // get input data, depending on the glbProgPhase (example, test, puzzle)
-    DataStream inputData;
-    GetInput( inputData, glbProgPhase != PUZZLE );
-    DataStream part2Data = inputData;
-    std::cout << "Data stats - size of data stream " << inputData.size() << std::endl << std::endl;
+    std::cout << "Data stats - size of data stream " << glbInputData->size() << std::endl << std::endl;
 
-/* ========== */   tmr.TimeReport( "    Timing 0 - input data preparation: " );   // =========================^^^^^vvvvv
+/* ========== */   bench.TimeReport( "    Timing 0 - input data preparation: " );   // =========================^^^^^vvvvv
 
     // part 1 code here
 
-    int nTotalMatches1 = FindAllMatches1( inputData );
+    int nTotalMatches1;
+    bench.RunPhase( "solving puzzle part 1", [&]() { nTotalMatches1 = SolvePart1(); } );
+    bench.SetAnswer( nTotalMatches1 );
 
     std::cout << std::endl << "Answer to part 1: total matches = " << nTotalMatches1 << std::endl << std::endl;
 
-/* ========== */   tmr.TimeReport( "    Timing 1 - solving puzzle part 1 : " );   // =========================^^^^^vvvvv
+/* ========== */   bench.TimeReport( "    Timing 1 - solving puzzle part 1 : " );   // =========================^^^^^vvvvv
 
     // part 2 code here
 
-    int nTotalMatches2 = FindAllMatches2( inputData );
+    int nTotalMatches2;
+    bench.RunPhase( "solving puzzle part 2", [&]() { nTotalMatches2 = SolvePart2(); } );
+    bench.SetAnswer( nTotalMatches2 );
 
     std::cout << std::endl << "Answer to part 2: total matches = " << nTotalMatches2  << std::endl << std::endl;
 
-/* ========== */   tmr.TimeReport( "    Timing 2 - solving puzzle part 2 : " );   // ==============================^^^^^
+/* ========== */   bench.TimeReport( "    Timing 2 - solving puzzle part 2 : " );   // ==============================^^^^^
+
+    if (bench.GetRepeat() > 1) {
+        bench.SummaryReport();
+    }
 
     return 0;
 }
+
+#endif // AOC24_DRIVER
@@ -11,11 +11,20 @@
 #include <algorithm>
 #include <numeric>
 #include <vector>
+#include <memory>
 
 #include "../flcTimer.h"
+#include "../flcBenchmark.h"
+#include "../flcInputFile.h"
+#include "../aoc24_registry.h"
+#include "../flcSnapshot.h"
+#include "../flcPipeline.h"
 #include "../parse_functions.h"
+#include "../parse_numbers.h"
 #include "my_utility.h"
 
+namespace day05 {
+
 // ==========   PROGRAM PHASING
 
 enum eProgPhase {     // what programming phase are you in - set at start of main()
@@ -86,39 +95,42 @@ void GetData_EXAMPLE( DataStream &dData, UORStream &uData ) {
     cDatum = { 97,13,75,29,47 }; dData.push_back( cDatum );
 }
 
+// a rule is a line like "47|53", an update a line like "75,47,61,53,29"
+UORType ParseRule( std::string_view sLine ) {
+    std::string_view sLeft, sRght;
+    split_token_dlmtd( "|", sLine, sLeft, sRght );
+    return { to_int( sLeft ), to_int( sRght ) };
+}
+
+DatumType ParseUpdate( std::string_view sLine ) {
+    DatumType cDatum;
+    parse_list( sLine, ',', cDatum );
+    return cDatum;
+}
+
 // file input - this function reads text file content one line at a time - adapt code to match your need for line parsing!
 void ReadInputData( const std::string sFileName, DataStream &vData, UORStream &uData ) {
 
-    std::ifstream dataFileStream( sFileName );
+    flcInputFile dataFile( sFileName );
     vData.clear();
     uData.clear();
-    std::string sLine;
     bool bUORphase = true;
 
-    while (getline( dataFileStream, sLine )) {
+    for (std::string_view sLine : dataFile.Lines()) {
         if (sLine.length() == 0) {
             bUORphase = false;
         } else {
             if (bUORphase) {
-                std::string sLeft, sRght;
-                split_token_dlmtd( "|", sLine, sLeft, sRght );
-                UORType uDatum = { stoi( sLeft ), stoi( sRght ) };
-                uData.push_back( uDatum );
+                uData.push_back( ParseRule( sLine ));
             } else {
-                DatumType cDatum;
-                while (sLine.length() > 0) {
-                    std::string sNumber = get_token_dlmtd( ",", sLine );
-                    cDatum.push_back( stoi( sNumber ));
-                }
-                vData.push_back( cDatum );
+                vData.push_back( ParseUpdate( sLine ));
             }
         }
     }
-    dataFileStream.close();
 }
 
-void GetData_TEST(   DataStream &dData, UORStream &uData ) { std::string sInputFile = DAY_STRING; sInputFile.append( ".input.test.txt"   ); ReadInputData( sInputFile, dData, uData ); }
-void GetData_PUZZLE( DataStream &dData, UORStream &uData ) { std::string sInputFile = DAY_STRING; sInputFile.append( ".input.puzzle.txt" ); ReadInputData( sInputFile, dData, uData ); }
+void GetData_TEST(   DataStream &dData, UORStream &uData ) { std::string sInputFile = GetInputFileName( DAY_STRING, "test"   ); ReadInputData( sInputFile, dData, uData ); }
+void GetData_PUZZLE( DataStream &dData, UORStream &uData ) { std::string sInputFile = GetInputFileName( DAY_STRING, "puzzle" ); ReadInputData( sInputFile, dData, uData ); }
 
 // ==========   CONSOLE OUTPUT FUNCTIONS
 
@@ -170,7 +182,7 @@ void GetInput( DataStream &dData, UORStream &uData, bool bDisplay = false ) {
 
 // ==========   PUZZLE SPECIFIC SOLUTIONS
 
-int GetMiddlePageNumber( DatumType &cData ) {
+int GetMiddlePageNumber( const DatumType &cData ) {
     int nNrPages = (int)cData.size();
     if (nNrPages % 2 == 0) {
         std::cout << "ERROR: even nr of pages!!" << std::endl;
@@ -178,7 +190,7 @@ int GetMiddlePageNumber( DatumType &cData ) {
     return cData[ nNrPages / 2 ];
 }
 
-bool CheckOrder( UORStream &uData, int nLeftVal, int nRghtVal ) {
+bool CheckOrder( const UORStream &uData, int nLeftVal, int nRghtVal ) {
     for (int i = 0; i < (int)uData.size(); i++) {
         UORType curUOR = uData[i];
         if (curUOR.left == nRghtVal && curUOR.rght == nLeftVal) {
@@ -188,7 +200,7 @@ bool CheckOrder( UORStream &uData, int nLeftVal, int nRghtVal ) {
     return true;
 }
 
-bool IsCorrectlyOrdered( UORStream &uData, DatumType &cData ) {
+bool IsCorrectlyOrdered( const UORStream &uData, const DatumType &cData ) {
     bool bStillCorrect = true;
 
     for (int i = 0; i < (int)cData.size() - 1 && bStillCorrect; i++) {
@@ -204,7 +216,7 @@ bool IsCorrectlyOrdered( UORStream &uData, DatumType &cData ) {
 // ----- PART 2
 
 // for part 2: if ordering is not correct, the nLeftIx and nRghtIx contain the indices where the violating ordering was found
-bool IsCorrectlyOrdered2( UORStream &uData, DatumType &cData, int &nLeftIx, int &nRghtIx ) {
+bool IsCorrectlyOrdered2( const UORStream &uData, const DatumType &cData, int &nLeftIx, int &nRghtIx ) {
     bool bStillCorrect = true;
 
     for (int i = 0; i < (int)cData.size() - 1 && bStillCorrect; i++) {
@@ -228,37 +240,30 @@ void SwapElements( DatumType &cData, int nIndex1, int nIndex2 ) {
     cData[nIndex2] = nTmp;
 }
 
-void CorrectOrdering( UORStream &uData, DatumType &cData ) {
+void CorrectOrdering( const UORStream &uData, DatumType &cData ) {
     int n1, n2;
     while (!IsCorrectlyOrdered2( uData, cData, n1, n2 )) {
         SwapElements( cData, n1, n2 );
     }
 }
 
-// ==========   MAIN()
-
-int main()
-{
-    glbProgPhase = PUZZLE;     // program phase to EXAMPLE, TEST or PUZZLE
-    std::cout << "Phase: " << ProgPhase2string() << std::endl << std::endl;
-    flcTimer tmr;
+// ==========   PHASE FUNCTIONS
 
-/* ========== */   tmr.StartTiming();   // ============================================vvvvv
+flcSnapshot<DataStream> glbInputData;   // parsed input data - the parts view it read only
+flcSnapshot<UORStream>  glbUORData;
 
-    // get input data, depending on the glbProgPhase (example, test, puzzle)
+// phase 0 - get input data, depending on the glbProgPhase (example, test, puzzle)
+void PrepareInput() {
     DataStream inputData;
-    UORStream uorData;
+    UORStream  uorData;
     GetInput( inputData, uorData, glbProgPhase != PUZZLE );
-    DataStream part2Data = inputData;
-    UORStream uor2Data = uorData;
-
-    std::cout << "Data stats - size of uor stream  " << uorData.size() << std::endl << std::endl;
-    std::cout << "Data stats - size of data stream " << inputData.size() << std::endl << std::endl;
-
-/* ========== */   tmr.TimeReport( "    Timing 0 - input data preparation: " );   // =========================^^^^^vvvvv
-
-    // part 1 code here
+    glbInputData = MakeSnapshot( std::move( inputData ));
+    glbUORData   = MakeSnapshot( std::move( uorData ));
+}
 
+int SolvePart1() {
+    const DataStream &inputData = *glbInputData;
+    const UORStream  &uorData   = *glbUORData;
     int nSumMiddlePageNumbers1 = 0;
     for (int i = 0; i < (int)inputData.size(); i++) {
 //        std::cout << "Update " << i << ":" << std::endl;
@@ -272,16 +277,13 @@ int main()
         }
 //        std::cout << std::endl;
     }
+    return nSumMiddlePageNumbers1;
+}
 
-    std::cout << std::endl << "Answer to part 1: sum of all middle page numbers of correct updates = " << nSumMiddlePageNumbers1 << std::endl << std::endl;
-
-/* ========== */   tmr.TimeReport( "    Timing 1 - solving puzzle part 1 : " );   // =========================^^^^^vvvvv
-
-    // part 2 code here
-
-    uorData = uor2Data;
-    inputData = part2Data;
-
+// only the updates that are reordered are copied
+int SolvePart2() {
+    flcCowVector<DatumType> inputData( glbInputData );
+    const UORStream &uorData = *glbUORData;
     int nSumMiddlePageNumbers2 = 0;
     for (int i = 0; i < (int)inputData.size(); i++) {
 //        std::cout << "Update " << i << ":" << std::endl;
@@ -290,17 +292,134 @@ int main()
 //            std::cout << "is CORRECTLY ordered" << std::endl;
         } else {
 //            std::cout << "is NOT correctly ordered " << std::endl;
-            CorrectOrdering( uorData, inputData[i] );
+            CorrectOrdering( uorData, inputData.Write( i ));
             int nMidPnr = GetMiddlePageNumber( inputData[i] );
 //            std::cout << "mid page number after correction is: " << nMidPnr << std::endl;
             nSumMiddlePageNumbers2 += nMidPnr;
         }
 //        std::cout << std::endl;
     }
+    return nSumMiddlePageNumbers2;
+}
+
+// ----- STREAMED VERSION
+
+PipelineStatsType glbStreamStats[2];   // per part, of the last streamed run - the parts may run concurrently
+
+// the rules are needed for every update, so they are read first. Then the updates are parsed and checked
+// at the same time, through the pipeline of flcPipeline.h. fnValue gets its own copy of the update, which
+// it may reorder. The example data is not in a file, so those updates are streamed from the hard coded ones
+int SumMiddlePageNumbers_streamed( int (*fnValue)( const UORStream &, DatumType & ), PipelineStatsType &stats ) {
+    std::unique_ptr<flcInputFile> pDataFile;
+    DataStream exampleData;
+    UORStream uorData;
+    std::string_view sLine;
+    if (glbProgPhase == EXAMPLE) {
+        GetData_EXAMPLE( exampleData, uorData );
+    } else {
+        pDataFile = std::make_unique<flcInputFile>( GetInputFileName( DAY_STRING, glbProgPhase == TEST ? "test" : "puzzle" ) );
+        while (pDataFile->NextLine( sLine ) && !sLine.empty()) {
+            uorData.push_back( ParseRule( sLine ));
+        }
+    }
+    return pipeline_reduce<DatumType>(
+        [&]( auto &&emit ) {
+            if (glbProgPhase == EXAMPLE) {
+                for (auto &cDatum : exampleData) {
+                    emit( std::move( cDatum ));
+                }
+                return;
+            }
+            while (pDataFile->NextLine( sLine )) {
+                if (!sLine.empty()) {
+                    emit( ParseUpdate( sLine ));
+                }
+            }
+        },
+        0,
+        [&]( DatumType &cDatum ) { return fnValue( uorData, cDatum ); },
+        []( int a, int b ) { return a + b; },
+        &stats
+    );
+}
+
+int UpdateValue1( const UORStream &uorData, DatumType &cDatum ) {
+    return IsCorrectlyOrdered( uorData, cDatum ) ? GetMiddlePageNumber( cDatum ) : 0;
+}
+
+int UpdateValue2( const UORStream &uorData, DatumType &cDatum ) {
+    if (IsCorrectlyOrdered( uorData, cDatum )) {
+        return 0;
+    }
+    CorrectOrdering( uorData, cDatum );
+    return GetMiddlePageNumber( cDatum );
+}
+
+int SolvePart1_streamed() { return SumMiddlePageNumbers_streamed( UpdateValue1, glbStreamStats[0] ); }
+int SolvePart2_streamed() { return SumMiddlePageNumbers_streamed( UpdateValue2, glbStreamStats[1] ); }
+
+// the nr of updates that were checked - catches updates that got lost in the queue
+std::string ParsedArtifact()    { return std::to_string( glbInputData->size()); }
+std::string StreamedArtifact1() { return std::to_string( glbStreamStats[0].nRecords ); }
+std::string StreamedArtifact2() { return std::to_string( glbStreamStats[1].nRecords ); }
+
+}   // namespace day05
+
+// ==========   MAIN()
+
+#ifdef AOC24_DRIVER
+
+// in the aoc24 driver program this day registers its phase functions instead of having a main()
+AOC24_REGISTER_DAY( day05 );
+AOC24_CONCURRENT_PARTS( day05 );
+AOC24_REGISTER_ENGINE( day05, 1, reference, SolvePart1         , ParsedArtifact   );
+AOC24_REGISTER_OWN_INPUT_ENGINE( day05, 1, streamed, SolvePart1_streamed, StreamedArtifact1 );
+AOC24_REGISTER_ENGINE( day05, 2, reference, SolvePart2         , ParsedArtifact   );
+AOC24_REGISTER_OWN_INPUT_ENGINE( day05, 2, streamed, SolvePart2_streamed, StreamedArtifact2 );
+
+#else
+
+using namespace day05;
+
+int main( int argc, char *argv[] )
+{
+    glbProgPhase = PUZZLE;     // program phase to EXAMPLE, TEST or PUZZLE
+    std::cout << "Phase: " << ProgPhase2string() << std::endl << std::endl;
+    flcBenchmark bench( argc, argv );   // use --warmup <n> and --repeat <n> to get timing statistics
+    bench.SetContext( DAY_STRING, ProgPhase2string());
+
+/* ========== */   bench.RunPhase( "input data preparation", PrepareInput );   // =====================vvvvv
+
+    std::cout << "Data stats - size of uor stream  " << glbUORData->size()  << std::endl << std::endl;
+    std::cout << "Data stats - size of data stream " << glbInputData->size() << std::endl << std::endl;
+
+/* ========== */   bench.TimeReport( "    Timing 0 - input data preparation: " );   // =========================^^^^^vvvvv
+
+    // part 1 code here
+
+    int nSumMiddlePageNumbers1;
+    bench.RunPhase( "solving puzzle part 1", [&]() { nSumMiddlePageNumbers1 = SolvePart1(); } );
+    bench.SetAnswer( nSumMiddlePageNumbers1 );
+
+    std::cout << std::endl << "Answer to part 1: sum of all middle page numbers of correct updates = " << nSumMiddlePageNumbers1 << std::endl << std::endl;
+
+/* ========== */   bench.TimeReport( "    Timing 1 - solving puzzle part 1 : " );   // =========================^^^^^vvvvv
+
+    // part 2 code here
+
+    int nSumMiddlePageNumbers2;
+    bench.RunPhase( "solving puzzle part 2", [&]() { nSumMiddlePageNumbers2 = SolvePart2(); } );
+    bench.SetAnswer( nSumMiddlePageNumbers2 );
 
     std::cout << std::endl << "Answer to part 2: sum of all middle page numbers of corrected updates = " << nSumMiddlePageNumbers2 << std::endl << std::endl;
 
-/* ========== */   tmr.TimeReport( "    Timing 2 - solving puzzle part 2 : " );   // ==============================^^^^^
+/* ========== */   bench.TimeReport( "    Timing 2 - solving puzzle part 2 : " );   // ==============================^^^^^
+
+    if (bench.GetRepeat() > 1) {
+        bench.SummaryReport();
+    }
 
     return 0;
 }
+
+#endif // AOC24_DRIVER
@@ -14,9 +14,17 @@
 #include <set>
 
 #include "../flcTimer.h"
+#include "../flcBenchmark.h"
+#include "../flcInputFile.h"
+#include "../flcThreadPool.h"
+#include "../aoc24_registry.h"
+#include "../flcSnapshot.h"
+#include "../flcGrid.h"
 #include "../parse_functions.h"
 #include "my_utility.h"
 
+namespace day06 {
+
 // ==========   PROGRAM PHASING
 
 enum eProgPhase {     // what programming phase are you in - set at start of main()
@@ -64,17 +72,15 @@ void GetData_EXAMPLE( DataStream &dData ) {
 // file input - this function reads text file content one line at a time - adapt code to match your need for line parsing!
 void ReadInputData( const std::string sFileName, DataStream &vData ) {
 
-    std::ifstream dataFileStream( sFileName );
+    flcInputFile dataFile( sFileName );
     vData.clear();
-    std::string sLine;
-    while (getline( dataFileStream, sLine )) {
-        vData.push_back( sLine );
+    for (std::string_view sLine : dataFile.Lines()) {
+        vData.emplace_back( sLine );
     }
-    dataFileStream.close();
 }
 
-void GetData_TEST(   DataStream &dData ) { std::string sInputFile = DAY_STRING; sInputFile.append( ".input.test.txt"   ); ReadInputData( sInputFile, dData ); }
-void GetData_PUZZLE( DataStream &dData ) { std::string sInputFile = DAY_STRING; sInputFile.append( ".input.puzzle.txt" ); ReadInputData( sInputFile, dData ); }
+void GetData_TEST(   DataStream &dData ) { std::string sInputFile = GetInputFileName( DAY_STRING, "test"   ); ReadInputData( sInputFile, dData ); }
+void GetData_PUZZLE( DataStream &dData ) { std::string sInputFile = GetInputFileName( DAY_STRING, "puzzle" ); ReadInputData( sInputFile, dData ); }
 
 // ==========   CONSOLE OUTPUT FUNCTIONS
 
@@ -115,6 +121,132 @@ void GetInput( DataStream &dData, bool bDisplay = false ) {
 
 //#define EMPTY '.'
 //#define OBSTR '#'
+#define OUTSD 'O'     // sentinel value in the border around the map
+
+// the map is an flcGrid with a border of 1 cell, so the guard can always take one step and then check
+// if she has left the map, instead of bounds checking every step. Locations are flat grid indices
+
+#define UP 0          // same order as the direction table in flcGrid.h
+#define RT 1
+#define DN 2
+#define LT 3
+
+// guard - the start location and direction are kept in glbGuard, each walk works on its own copy
+typedef struct sGuardStruct {
+    int nLoc;
+    int nDir;
+} GuardType;
+
+GuardType glbGuard;
+
+void InitGuard( flcGrid<char> &grid ) {
+    for (int y = 0; y < grid.Height(); y++) {
+        for (int x = 0; x < grid.Width(); x++) {
+            switch (grid( x, y )) {
+                case '.': break;
+                case '#': break;
+                case '^': glbGuard = { grid.Index( x, y ), UP }; break;
+                case '>': glbGuard = { grid.Index( x, y ), RT }; break;
+                case 'v': glbGuard = { grid.Index( x, y ), DN }; break;
+                case '<': glbGuard = { grid.Index( x, y ), LT }; break;
+                default: std::cout << "ERROR: InitGuard() --> unidentified cell content: " << grid( x, y ) << std::endl;
+            }
+        }
+    }
+}
+
+// the guard is on the map as long as she's not on a border cell
+bool InBounds( flcGrid<char> &grid, GuardType &guard ) {
+    return grid[guard.nLoc] != OUTSD;
+}
+
+// nAddedObstr is the flat index of an additional obstruction, or -1 if there's none
+bool GuardObstructed( flcGrid<char> &grid, GuardType &guard, int nAddedObstr ) {
+    int nNext = guard.nLoc + grid.Offset4( guard.nDir );
+    return grid[nNext] == '#' || nNext == nAddedObstr;
+}
+
+void OneStep( flcGrid<char> &grid, GuardType &guard, int nAddedObstr = -1 ) {
+
+    auto guard_step = [&]() {
+        guard.nLoc += grid.Offset4( guard.nDir );
+    };
+
+    auto guard_rotate = [&]() {
+        guard.nDir = (guard.nDir + 1) % 4;
+    };
+
+    if (GuardObstructed( grid, guard, nAddedObstr )) {
+        guard_rotate();
+    } else {
+        guard_step();
+    }
+}
+
+int Walk1( flcGrid<char> &grid ) {
+    // the visited locations are marked in a grid of the same layout, instead of collected in a std::set
+    flcGrid<char> vVisited( grid.Width(), grid.Height(), 0, grid.Border());
+    GuardType guard = glbGuard;
+    int nVisited = 0;
+    while (InBounds( grid, guard )) {
+        if (!vVisited[guard.nLoc]) {
+            vVisited[guard.nLoc] = 1;
+            nVisited += 1;
+        }
+        OneStep( grid, guard );
+    }
+    return nVisited;
+}
+
+// ----- PART 2
+
+// Faster version of part 2. An added obstruction only makes a difference if it's on the route of part 1,
+// so only those cells are candidates. Moreover, with the obstruction the guard walks the same route up
+// to the moment she first arrives in front of it, so the walk for a candidate can start there.
+typedef struct sCandidateStruct {
+    int       nObstr;    // flat index of the added obstruction
+    GuardType start;     // state of the guard just before she first walks into it
+} CandidateType;
+
+std::vector<CandidateType> RouteCandidates( flcGrid<char> &grid ) {
+    flcGrid<char> vSeen( grid.Width(), grid.Height(), 0, grid.Border());
+    std::vector<CandidateType> vResult;
+    GuardType guard = glbGuard;
+    vSeen[guard.nLoc] = 1;
+    while (InBounds( grid, guard )) {
+        int nNext = guard.nLoc + grid.Offset4( guard.nDir );
+        if (grid[nNext] == '.' && !vSeen[nNext]) {
+            vSeen[nNext] = 1;
+            vResult.push_back( { nNext, guard } );
+        }
+        OneStep( grid, guard );
+    }
+    return vResult;
+}
+
+// The guard is in a loop if she arrives at a location in a direction she had at that location before.
+// The (location, direction) pairs are stamped with nStamp, which is different for each walk, so the
+// stamps don't have to be cleared between walks. The map itself is not changed - the added obstruction
+// is passed separately - so that walks can run in parallel on the same map
+bool Walk2_stamped( flcGrid<char> &grid, std::vector<int> &vStamps, int nStamp, GuardType guard, int addedObstr ) {
+    while (InBounds( grid, guard )) {
+        int &nCell = vStamps[guard.nLoc * 4 + guard.nDir];
+        if (nCell == nStamp) {
+            return true;
+        }
+        nCell = nStamp;
+        OneStep( grid, guard, addedObstr );
+    }
+    return false;
+}
+
+// ----- REFERENCE VERSION
+
+// the first version of part 2, kept as the oracle for --verify: the map is a vector of strings in which
+// the added obstruction is put (and removed again), the guard is global, and the visited (location,
+// direction) pairs are kept in a std::set. Every empty cell is tried, one after the other. It shares no
+// code with the versions above
+namespace original {
 
 typedef struct sLocationStruct {
     int x, y;
@@ -129,12 +261,6 @@ typedef struct sLocationStruct {
 
 } LocationType;
 
-#define UP 0
-#define RT 1
-#define DN 2
-#define LT 3
-
-// guard
 LocationType glbGuardLoc;
 int glbGuardDir;
 
@@ -202,17 +328,6 @@ void OneStep( DataStream &dData ) {
     }
 }
 
-int Walk1( DataStream &dData ) {
-    std::set<LocationType> vVisited;
-    while (InBounds( glbGuardLoc )) {
-        vVisited.insert( glbGuardLoc );
-        OneStep( dData );
-    }
-    return vVisited.size();
-}
-
-// ----- PART 2
-
 typedef struct sPositionStruct {
     LocationType loc;
     int dir;
@@ -224,14 +339,6 @@ typedef struct sPositionStruct {
 
 } PosType;
 
-// WARNING: although it works, this method is very time consuming!
-// Better check on the sizes of the container before or after insertion, that makes the difference between a
-// couple of hours or 12 seconds solution time...
-bool InLoop( PosType curPos, std::set<PosType> prevVisited ) {
-    auto search = prevVisited.find( curPos );
-    return search != prevVisited.end();
-}
-
 bool Walk2( DataStream &dData, LocationType addedObstr ) {
 
     dData[addedObstr.y][addedObstr.x] = '#';
@@ -260,52 +367,133 @@ bool Walk2( DataStream &dData, LocationType addedObstr ) {
     return bLooped;
 }
 
+}   // namespace original
+
+// ==========   PHASE FUNCTIONS
+
+flcSnapshot<DataStream> glbInputData;   // parsed input data - the parts view it read only
+
+// phase 0 - get input data, depending on the glbProgPhase (example, test, puzzle)
+void PrepareInput() {
+    DataStream inputData;
+    GetInput( inputData, glbProgPhase != PUZZLE );
+    glbInputData = MakeSnapshot( std::move( inputData ));
+}
+
+int SolvePart1() {
+    flcGrid<char> grid = GridFromLines( *glbInputData, 1, OUTSD );   // the map of the parts, with a border
+    InitGuard( grid );
+    return Walk1( grid );
+}
+
+// the cells where an added obstruction makes the guard loop, as artifact for the --verify mode of the
+// driver. The walks write different cells, so they can set them in parallel
+flcGrid<char> glbLoopCells;
+
+// the candidate obstructions are independent of each other, so they are tried in parallel. Each thread of
+// the pool needs its own stamp array
+int SolvePart2() {
+    flcGrid<char> grid = GridFromLines( *glbInputData, 1, OUTSD );   // the map of the parts, with a border
+    InitGuard( grid );
+    std::vector<CandidateType> vCandidates = RouteCandidates( grid );
+    std::vector<std::vector<int>> vStamps( flcThreadPool::Instance().GetThreadCount(), std::vector<int>( grid.Size() * 4, 0 ));
+    glbLoopCells = flcGrid<char>( grid.Width(), grid.Height(), 0, grid.Border());
+    int nNrObstructions = parallel_reduce( 0, (int)vCandidates.size(), 0,
+        [&]( int i ) {
+            CandidateType &c = vCandidates[i];
+            bool bLooped = Walk2_stamped( grid, vStamps[flcThreadPool::WorkerIndex()], i + 1, c.start, c.nObstr );
+            glbLoopCells[c.nObstr] = bLooped;
+            return bLooped ? 1 : 0;
+        },
+        []( int a, int b ) { return a + b; }
+    );
+    return nNrObstructions;
+}
+
+// the original version (see namespace original), on its own copy of the map. The loop cells go in the
+// same layout as those of SolvePart2(), so that the artifacts can be compared
+int SolvePart2_reference() {
+    DataStream inputData = *glbInputData;
+    original::InitGuard( inputData );
+    glbLoopCells = flcGrid<char>( original::glbMapSizeX, original::glbMapSizeY, 0, 1 );
+    int nNrObstructions = 0;
+    for (int y = 0; y < original::glbMapSizeY; y++) {
+        for (int x = 0; x < original::glbMapSizeX; x++) {
+            // attempt next additional obstruction, but only on empty locations
+            if (inputData[y][x] == '.') {
+                if (original::Walk2( inputData, { x, y } )) {
+                    glbLoopCells( x, y ) = 1;
+                    nNrObstructions += 1;
+                }
+            }
+        }
+    }
+    return nNrObstructions;
+}
+
+std::string Part2Artifact() {
+    std::string sResult;
+    for (int i = 0; i < glbLoopCells.Size(); i++) {
+        if (glbLoopCells[i]) {
+            sResult.append( std::to_string( i ) + " " );
+        }
+    }
+    return sResult;
+}
+
+}   // namespace day06
+
 // ==========   MAIN()
 
-int main()
+#ifdef AOC24_DRIVER
+
+// in the aoc24 driver program this day registers its phase functions instead of having a main()
+AOC24_REGISTER_DAY( day06 );
+AOC24_REGISTER_ENGINE( day06, 2, reference, SolvePart2_reference, Part2Artifact );
+AOC24_REGISTER_ENGINE( day06, 2, optimized, SolvePart2          , Part2Artifact );
+
+#else
+
+using namespace day06;
+
+int main( int argc, char *argv[] )
 {
     glbProgPhase = PUZZLE;     // program phase to EXAMPLE, TEST or PUZZLE
     std::cout << "Phase: " << ProgPhase2string() << std::endl << std::endl;
-    flcTimer tmr;
+    flcBenchmark bench( argc, argv );   // use --warmup <n> and --repeat <n> to get timing statistics
+    bench.SetContext( DAY_STRING, ProgPhase2string());
 
-/* ========== */   tmr.StartTiming();   // ============================================vvvvv
+/* ========== */   bench.RunPhase( "input data preparation", PrepareInput );   // =====================vvvvv
 
-    // get input data, depending on the glbProgPhase (example, test, puzzle)
-    DataStream inputData;
-    GetInput( inputData, glbProgPhase != PUZZLE );
-    DataStream part2Data = inputData;
-    std::cout << "Data stats - size of data stream " << inputData.size() << std::endl << std::endl;
+    std::cout << "Data stats - size of data stream " << glbInputData->size() << std::endl << std::endl;
 
-/* ========== */   tmr.TimeReport( "    Timing 0 - input data preparation: " );   // =========================^^^^^vvvvv
+/* ========== */   bench.TimeReport( "    Timing 0 - input data preparation: " );   // =========================^^^^^vvvvv
 
     // part 1 code here
 
-    InitGuard( inputData );
-    int nVisited = Walk1( inputData );
+    int nVisited;
+    bench.RunPhase( "solving puzzle part 1", [&]() { nVisited = SolvePart1(); } );
+    bench.SetAnswer( nVisited );
 
     std::cout << std::endl << "Answer to part 1: nr of distinct cells visited = " << nVisited << std::endl << std::endl;
 
-/* ========== */   tmr.TimeReport( "    Timing 1 - solving puzzle part 1 : " );   // =========================^^^^^vvvvv
+/* ========== */   bench.TimeReport( "    Timing 1 - solving puzzle part 1 : " );   // =========================^^^^^vvvvv
 
     // part 2 code here
-    inputData = part2Data;
-    InitGuard( inputData );
 
-    int nNrObstructions = 0;
-    for (int y = 0; y < glbMapSizeY; y++) {
-        for (int x = 0; x < glbMapSizeX; x++) {
-            // attempt next additional obstruction, but only on empty locations
-            if (inputData[y][x] == '.') {
-                if (Walk2( inputData, { x, y } )) {
-                    nNrObstructions += 1;
-                }
-            }
-        }
-    }
+    int nNrObstructions;
+    bench.RunPhase( "solving puzzle part 2", [&]() { nNrObstructions = SolvePart2(); } );
+    bench.SetAnswer( nNrObstructions );
 
     std::cout << std::endl << "Answer to part 2: number of added obstructions that leads to looped outcome = " << nNrObstructions << std::endl << std::endl;
 
-/* ========== */   tmr.TimeReport( "    Timing 2 - solving puzzle part 2 : " );   // ==============================^^^^^
+/* ========== */   bench.TimeReport( "    Timing 2 - solving puzzle part 2 : " );   // ==============================^^^^^
+
+    if (bench.GetRepeat() > 1) {
+        bench.SummaryReport();
+    }
 
     return 0;
 }
+
+#endif // AOC24_DRIVER
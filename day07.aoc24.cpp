@@ -13,9 +13,18 @@
 #include <vector>
 
 #include "../flcTimer.h"
+#include "../flcBenchmark.h"
+#include "../flcInputFile.h"
+#include "../flcThreadPool.h"
+#include "../aoc24_registry.h"
+#include "../flcSnapshot.h"
+#include "../flcPipeline.h"
 #include "../parse_functions.h"
+#include "../parse_numbers.h"
 #include "my_utility.h"
 
+namespace day07 {
+
 // ==========   PROGRAM PHASING
 
 enum eProgPhase {     // what programming phase are you in - set at start of main()
@@ -62,27 +71,27 @@ void GetData_EXAMPLE( DataStream &dData ) {
     cDatum = {    292, { 11,  6, 16, 20 } }; dData.push_back( cDatum );
 }
 
+// an equation is a line like "3267: 81 40 27"
+DatumType ParseEquation( std::string_view sLine ) {
+    std::string_view sTestVal = get_token_dlmtd( ": ", sLine );
+    DatumType cDatum;
+    cDatum.testValue = to_ll( sTestVal );
+    parse_list( sLine, ' ', cDatum.vNrs );
+    return cDatum;
+}
+
 // file input - this function reads text file content one line at a time - adapt code to match your need for line parsing!
 void ReadInputData( const std::string sFileName, DataStream &vData ) {
 
-    std::ifstream dataFileStream( sFileName );
+    flcInputFile dataFile( sFileName );
     vData.clear();
-    std::string sLine;
-    while (getline( dataFileStream, sLine )) {
-        std::string sTestVal = get_token_dlmtd( ": ", sLine );
-        DatumType cDatum;
-        cDatum.testValue = stoll( sTestVal );
-        while (sLine.length() > 0) {
-            std::string sOperand = get_token_dlmtd( " ", sLine );
-            cDatum.vNrs.push_back( stoll( sOperand ));
-        }
-        vData.push_back( cDatum );
+    for (std::string_view sLine : dataFile.Lines()) {
+        vData.push_back( ParseEquation( sLine ));
     }
-    dataFileStream.close();
 }
 
-void GetData_TEST(   DataStream &dData ) { std::string sInputFile = DAY_STRING; sInputFile.append( ".input.test.txt"   ); ReadInputData( sInputFile, dData ); }
-void GetData_PUZZLE( DataStream &dData ) { std::string sInputFile = DAY_STRING; sInputFile.append( ".input.puzzle.txt" ); ReadInputData( sInputFile, dData ); }
+void GetData_TEST(   DataStream &dData ) { std::string sInputFile = GetInputFileName( DAY_STRING, "test"   ); ReadInputData( sInputFile, dData ); }
+void GetData_PUZZLE( DataStream &dData ) { std::string sInputFile = GetInputFileName( DAY_STRING, "puzzle" ); ReadInputData( sInputFile, dData ); }
 
 // ==========   CONSOLE OUTPUT FUNCTIONS
 
@@ -127,7 +136,7 @@ void GetInput( DataStream &dData, bool bDisplay = false ) {
 
 // creates a tree (on stack) of all possible combinations of operators and operands by recursive calls until all operands are processed
 // the tree is pruned if the intermediate result already becomes larger than the test value
-bool FitOperators( DatumType cDatum, int curIndex, long long curValue, std::vector<char> &vOperators ) {
+bool FitOperators( const DatumType &cDatum, int curIndex, long long curValue, std::vector<char> &vOperators ) {
     bool bResult = false;
 
     // if there are no more operands, the result is only true if the intermediate value equals the test value
@@ -170,7 +179,7 @@ long long NrConcatenate( long long a, long long b ) {
 }
 
 // variation on FitOperators() including the concat operator on top of plus and times
-bool FitOperators2( DatumType cDatum, int curIndex, long long curValue, std::vector<char> &vOperators ) {
+bool FitOperators2( const DatumType &cDatum, int curIndex, long long curValue, std::vector<char> &vOperators ) {
     bool bResult = false;
 
     // if there are no more operands, the result is only true if the intermediate value equals the test value
@@ -206,29 +215,22 @@ bool FitOperators2( DatumType cDatum, int curIndex, long long curValue, std::vec
     return bResult;
 }
 
-// ==========   MAIN()
-
-int main()
-{
-    glbProgPhase = PUZZLE;     // program phase to EXAMPLE, TEST or PUZZLE
-    std::cout << "Phase: " << ProgPhase2string() << std::endl << std::endl;
-    flcTimer tmr;
+// ==========   PHASE FUNCTIONS
 
-/* ========== */   tmr.StartTiming();   // ============================================vvvvv
+flcSnapshot<DataStream> glbInputData;   // parsed input data - the parts view it read only
 
-    // get input data, depending on the glbProgPhase (example, test, puzzle)
+// phase 0 - get input data, depending on the glbProgPhase (example, test, puzzle)
+void PrepareInput() {
     DataStream inputData;
     GetInput( inputData, glbProgPhase != PUZZLE );
-    DataStream part2Data = inputData;
-    std::cout << "Data stats - size of data stream " << inputData.size() << std::endl << std::endl;
-
-/* ========== */   tmr.TimeReport( "    Timing 0 - input data preparation: " );   // =========================^^^^^vvvvv
-
-    // part 1 code here
+    glbInputData = MakeSnapshot( std::move( inputData ));
+}
 
+long long SolvePart1() {
+    const DataStream &inputData = *glbInputData;
     long long  nTotalCalibrationResult = 0;
     for (int i = 0; i < (int)inputData.size(); i++) {
-        DatumType curDatum = inputData[i];
+        const DatumType &curDatum = inputData[i];
         std::vector<char> vOps;
         if (FitOperators( curDatum, 0, 0, vOps )) {
 //            std::cout << "datum index: " << i << " results in operator match!" << std::endl;
@@ -237,29 +239,121 @@ int main()
 //            std::cout << "datum index: " << i << " does NOT result in operator match!" << std::endl;
         }
     }
+    return nTotalCalibrationResult;
+}
+
+// the equations are independent of each other, but their cost grows exponentially with the nr of
+// operands - so they are spread over the threads of the work stealing pool
+long long SolvePart2() {
+    const DataStream &inputData = *glbInputData;
+    long long  nTotalCalibrationResult2 = parallel_reduce( 0, (int)inputData.size(), 0LL,
+        [&]( int i ) {
+            const DatumType &curDatum = inputData[i];
+            std::vector<char> vOps;
+            return FitOperators2( curDatum, 0, 0, vOps ) ? curDatum.testValue : 0LL;
+        },
+        []( long long a, long long b ) { return a + b; }
+    );
+    return nTotalCalibrationResult2;
+}
+
+// ----- STREAMED VERSION
+
+PipelineStatsType glbStreamStats[2];   // per part, of the last streamed run - the parts may run concurrently
+
+// parses the equations and tries to fit them at the same time, through the pipeline of flcPipeline.h -
+// the cost of an equation varies a lot, and the consumers take the next batch as soon as they're done.
+// The example data is not in a file, so that is streamed from the hard coded equations
+long long CalibrationResult_streamed( bool (*fnFit)( const DatumType &, int, long long, std::vector<char> & ), PipelineStatsType &stats ) {
+    return pipeline_reduce<DatumType>(
+        [&]( auto &&emit ) {
+            if (glbProgPhase == EXAMPLE) {
+                DataStream exampleData;
+                GetData_EXAMPLE( exampleData );
+                for (auto &cDatum : exampleData) {
+                    emit( std::move( cDatum ));
+                }
+                return;
+            }
+            flcInputFile dataFile( GetInputFileName( DAY_STRING, glbProgPhase == TEST ? "test" : "puzzle" ) );
+            for (std::string_view sLine : dataFile.Lines()) {
+                emit( ParseEquation( sLine ));
+            }
+        },
+        0LL,
+        [&]( const DatumType &cDatum ) {
+            std::vector<char> vOps;
+            return fnFit( cDatum, 0, 0, vOps ) ? cDatum.testValue : 0LL;
+        },
+        []( long long a, long long b ) { return a + b; },
+        &stats
+    );
+}
+
+long long SolvePart1_streamed() { return CalibrationResult_streamed( FitOperators , glbStreamStats[0] ); }
+long long SolvePart2_streamed() { return CalibrationResult_streamed( FitOperators2, glbStreamStats[1] ); }
+
+// the nr of equations that were tried - catches equations that got lost in the queue
+std::string ParsedArtifact()    { return std::to_string( glbInputData->size()); }
+std::string StreamedArtifact1() { return std::to_string( glbStreamStats[0].nRecords ); }
+std::string StreamedArtifact2() { return std::to_string( glbStreamStats[1].nRecords ); }
+
+}   // namespace day07
+
+// ==========   MAIN()
+
+#ifdef AOC24_DRIVER
+
+// in the aoc24 driver program this day registers its phase functions instead of having a main()
+AOC24_REGISTER_DAY( day07 );
+AOC24_CONCURRENT_PARTS( day07 );
+AOC24_REGISTER_ENGINE( day07, 1, reference, SolvePart1         , ParsedArtifact   );
+AOC24_REGISTER_OWN_INPUT_ENGINE( day07, 1, streamed, SolvePart1_streamed, StreamedArtifact1 );
+AOC24_REGISTER_ENGINE( day07, 2, reference, SolvePart2         , ParsedArtifact   );
+AOC24_REGISTER_OWN_INPUT_ENGINE( day07, 2, streamed, SolvePart2_streamed, StreamedArtifact2 );
+
+#else
+
+using namespace day07;
+
+int main( int argc, char *argv[] )
+{
+    glbProgPhase = PUZZLE;     // program phase to EXAMPLE, TEST or PUZZLE
+    std::cout << "Phase: " << ProgPhase2string() << std::endl << std::endl;
+    flcBenchmark bench( argc, argv );   // use --warmup <n> and --repeat <n> to get timing statistics
+    bench.SetContext( DAY_STRING, ProgPhase2string());
+
+/* ========== */   bench.RunPhase( "input data preparation", PrepareInput );   // =====================vvvvv
+
+    std::cout << "Data stats - size of data stream " << glbInputData->size() << std::endl << std::endl;
+
+/* ========== */   bench.TimeReport( "    Timing 0 - input data preparation: " );   // =========================^^^^^vvvvv
+
+    // part 1 code here
+
+    long long nTotalCalibrationResult;
+    bench.RunPhase( "solving puzzle part 1", [&]() { nTotalCalibrationResult = SolvePart1(); } );
+    bench.SetAnswer( nTotalCalibrationResult );
 
     std::cout << std::endl << "Answer to part 1: total calibration result = " << nTotalCalibrationResult << std::endl << std::endl;
 
-/* ========== */   tmr.TimeReport( "    Timing 1 - solving puzzle part 1 : " );   // =========================^^^^^vvvvv
+/* ========== */   bench.TimeReport( "    Timing 1 - solving puzzle part 1 : " );   // =========================^^^^^vvvvv
 
     // part 2 code here
-    inputData = part2Data;
 
-    long long  nTotalCalibrationResult2 = 0;
-    for (int i = 0; i < (int)inputData.size(); i++) {
-        DatumType curDatum = inputData[i];
-        std::vector<char> vOps;
-        if (FitOperators2( curDatum, 0, 0, vOps )) {
-//            std::cout << "datum index: " << i << " results in operator match!" << std::endl;
-            nTotalCalibrationResult2 += curDatum.testValue;
-        } else {
-//            std::cout << "datum index: " << i << " does NOT result in operator match!" << std::endl;
-        }
-    }
+    long long nTotalCalibrationResult2;
+    bench.RunPhase( "solving puzzle part 2", [&]() { nTotalCalibrationResult2 = SolvePart2(); } );
+    bench.SetAnswer( nTotalCalibrationResult2 );
 
     std::cout << std::endl << "Answer to part 2: total calibration result = " << nTotalCalibrationResult2 << std::endl << std::endl;
 
-/* ========== */   tmr.TimeReport( "    Timing 2 - solving puzzle part 2 : " );   // ==============================^^^^^
+/* ========== */   bench.TimeReport( "    Timing 2 - solving puzzle part 2 : " );   // ==============================^^^^^
+
+    if (bench.GetRepeat() > 1) {
+        bench.SummaryReport();
+    }
 
     return 0;
 }
+
+#endif // AOC24_DRIVER
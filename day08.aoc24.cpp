@@ -14,9 +14,17 @@
 #include <set>
 
 #include "../flcTimer.h"
+#include "../flcBenchmark.h"
+#include "../flcInputFile.h"
+#include "../aoc24_registry.h"
+#include "../flcSnapshot.h"
+#include "../flcCoord.h"
+#include "../flcGrid.h"
 #include "../parse_functions.h"
 #include "my_utility.h"
 
+namespace day08 {
+
 // ==========   PROGRAM PHASING
 
 enum eProgPhase {     // what programming phase are you in - set at start of main()
@@ -77,17 +85,15 @@ void GetData_EXAMPLE( DataStream &dData ) {
 // file input - this function reads text file content one line at a time - adapt code to match your need for line parsing!
 void ReadInputData( const std::string sFileName, DataStream &vData ) {
 
-    std::ifstream dataFileStream( sFileName );
+    flcInputFile dataFile( sFileName );
     vData.clear();
-    std::string sLine;
-    while (getline( dataFileStream, sLine )) {
-        vData.push_back( sLine );
+    for (std::string_view sLine : dataFile.Lines()) {
+        vData.emplace_back( sLine );
     }
-    dataFileStream.close();
 }
 
-void GetData_TEST(   DataStream &dData ) { std::string sInputFile = DAY_STRING; sInputFile.append( ".input.test.txt"   ); ReadInputData( sInputFile, dData ); }
-void GetData_PUZZLE( DataStream &dData ) { std::string sInputFile = DAY_STRING; sInputFile.append( ".input.puzzle.txt" ); ReadInputData( sInputFile, dData ); }
+void GetData_TEST(   DataStream &dData ) { std::string sInputFile = GetInputFileName( DAY_STRING, "test"   ); ReadInputData( sInputFile, dData ); }
+void GetData_PUZZLE( DataStream &dData ) { std::string sInputFile = GetInputFileName( DAY_STRING, "puzzle" ); ReadInputData( sInputFile, dData ); }
 
 // ==========   CONSOLE OUTPUT FUNCTIONS
 
@@ -125,11 +131,10 @@ void GetInput( DataStream &dData, bool bDisplay = false ) {
 
 // ==========   PUZZLE SPECIFIC SOLUTIONS
 
-int glbMapX, glbMapY;    // contains map sizes - call InitMap() to fill these
+flcGrid<char> glbMap;    // contains the map - call InitMap() to fill it
 
-void InitMap( DataStream &dMap ) {
-    glbMapY = (int)dMap.size();
-    glbMapX = (int)dMap[0].length();
+void InitMap( const DataStream &dMap ) {
+    glbMap = GridFromLines( dMap );
 }
 
 // location type - the operator < is there to apply them in a std::set
@@ -147,7 +152,7 @@ typedef struct sLocationStruct {
 } LocType;
 
 bool InBounds( int x, int y ) {
-    return (x >= 0 && x < glbMapX && y >= 0 && y < glbMapY);
+    return glbMap.InBounds( x, y );
 }
 bool InBounds( LocType loc ) { return InBounds( loc.x, loc.y ); }   // overloaded version for LocType argument
 
@@ -169,12 +174,12 @@ void PrintAntenna( AntennaType &curAntenna ) {
     std::cout << " location = " << curAntenna.loc.to_string() << std::endl;
 }
 
-void GetAntennaList( DataStream &dMap, std::vector<AntennaType> &vAntennas ) {
+void GetAntennaList( flcGrid<char> &dMap, std::vector<AntennaType> &vAntennas ) {
     vAntennas.clear();
-    for (int y = 0; y < glbMapY; y++) {
-        for (int x = 0; x < glbMapX; x++) {
-            if (dMap[y][x] != '.') {
-                AntennaType newAntenna = { { x, y }, dMap[y][x] };
+    for (int y = 0; y < dMap.Height(); y++) {
+        for (int x = 0; x < dMap.Width(); x++) {
+            if (dMap( x, y ) != '.') {
+                AntennaType newAntenna = { { x, y }, dMap( x, y ) };
                 vAntennas.push_back( newAntenna );
             }
         }
@@ -184,7 +189,7 @@ void GetAntennaList( DataStream &dMap, std::vector<AntennaType> &vAntennas ) {
 }
 
 // ASSUMPTION: vAntenna's is sorted
-void GetNodeSet( DataStream &dMap, std::vector<AntennaType> &vAntennas, std::set<LocType> &vNodes ) {
+void GetNodeSet( std::vector<AntennaType> &vAntennas, flcCoordSet &vNodes ) {
     vNodes.clear();
     int curIndex = 0;
     while (curIndex < (int)vAntennas.size()) {
@@ -200,8 +205,8 @@ void GetNodeSet( DataStream &dMap, std::vector<AntennaType> &vAntennas, std::set
             LocType node1 = { vAntennas[  curIndex].loc.x + diffX, vAntennas[  curIndex].loc.y + diffY };
             LocType node2 = { vAntennas[otherIndex].loc.x - diffX, vAntennas[otherIndex].loc.y - diffY };
 
-            if (InBounds( node1 )) { vNodes.insert( node1 ); }
-            if (InBounds( node2 )) { vNodes.insert( node2 ); }
+            if (InBounds( node1 )) { vNodes.Insert( node1.x, node1.y ); }
+            if (InBounds( node2 )) { vNodes.Insert( node2.x, node2.y ); }
 
             otherIndex += 1;
         }
@@ -218,7 +223,7 @@ LocType LocAdd( LocType &a, LocType &b ) { LocType result = { a.x + b.x, a.y + b
 LocType LocMul( LocType &a, int n      ) { LocType result = { a.x * n  , a.y * n   }; return result; }
 
 // ASSUMPTION: vAntenna's is sorted
-void GetNodeSet2( DataStream &dMap, std::vector<AntennaType> &vAntennas, std::set<LocType> &vNodes ) {
+void GetNodeSet2( std::vector<AntennaType> &vAntennas, flcCoordSet &vNodes ) {
     vNodes.clear();
     int curIndex = 0;
     while (curIndex < (int)vAntennas.size()) {
@@ -238,7 +243,7 @@ void GetNodeSet2( DataStream &dMap, std::vector<AntennaType> &vAntennas, std::se
                 LocType auxLoc = LocMul( locDiff, i );
                 LocType node1 = LocAdd( vAntennas[  curIndex].loc, auxLoc );
                 if (InBounds( node1 )) {
-                    vNodes.insert( node1 );
+                    vNodes.Insert( node1.x, node1.y );
                 } else {
                     bOOB = true;
                 }
@@ -248,7 +253,7 @@ void GetNodeSet2( DataStream &dMap, std::vector<AntennaType> &vAntennas, std::se
                 LocType auxLoc = LocMul( locDiff, i );
                 LocType node2 = LocSub( vAntennas[otherIndex].loc, auxLoc );
                 if (InBounds( node2 )) {
-                    vNodes.insert( node2 );
+                    vNodes.Insert( node2.x, node2.y );
                 } else {
                     bOOB = true;
                 }
@@ -259,52 +264,86 @@ void GetNodeSet2( DataStream &dMap, std::vector<AntennaType> &vAntennas, std::se
     }
 }
 
+// ==========   PHASE FUNCTIONS
+
+flcSnapshot<DataStream> glbInputData;   // parsed input data - the parts view it read only
+
+// phase 0 - get input data, depending on the glbProgPhase (example, test, puzzle)
+void PrepareInput() {
+    DataStream inputData;
+    GetInput( inputData, glbProgPhase != PUZZLE );
+    glbInputData = MakeSnapshot( std::move( inputData ));
+}
+
+int SolvePart1() {
+    std::vector<AntennaType> vAntennaList;
+    InitMap( *glbInputData );
+    flcCoordSet vNodeSet( glbMap.Width(), glbMap.Height());
+    GetAntennaList( glbMap, vAntennaList );
+    GetNodeSet( vAntennaList, vNodeSet );
+    return vNodeSet.size();
+}
+
+int SolvePart2() {
+    std::vector<AntennaType> vAntennaList;
+    InitMap( *glbInputData );
+    flcCoordSet vNodeSet( glbMap.Width(), glbMap.Height());
+    GetAntennaList( glbMap, vAntennaList );
+    GetNodeSet2( vAntennaList, vNodeSet );
+    return vNodeSet.size();
+}
+
+}   // namespace day08
+
 // ==========   MAIN()
 
-int main()
+#ifdef AOC24_DRIVER
+
+// in the aoc24 driver program this day registers its phase functions instead of having a main()
+AOC24_REGISTER_DAY( day08 );
+
+#else
+
+using namespace day08;
+
+int main( int argc, char *argv[] )
 {
     glbProgPhase = PUZZLE;     // program phase to EXAMPLE, TEST or PUZZLE
     std::cout << "Phase: " << ProgPhase2string() << std::endl << std::endl;
-    flcTimer tmr;
+    flcBenchmark bench( argc, argv );   // use --warmup <n> and --repeat <n> to get timing statistics
+    bench.SetContext( DAY_STRING, ProgPhase2string());
 
-/* ========== */   tmr.StartTiming();   // ============================================vvvvv
+/* ========== */   bench.RunPhase( "input data preparation", PrepareInput );   // =====================vvvvv
 
-    // get input data, depending on the glbProgPhase (example, test, puzzle)
-    DataStream inputData;
-    GetInput( inputData, glbProgPhase != PUZZLE );
-    DataStream part2Data = inputData;
-    std::cout << "Data stats - size of data stream " << inputData.size() << std::endl << std::endl;
+    std::cout << "Data stats - size of data stream " << glbInputData->size() << std::endl << std::endl;
 
-/* ========== */   tmr.TimeReport( "    Timing 0 - input data preparation: " );   // =========================^^^^^vvvvv
+/* ========== */   bench.TimeReport( "    Timing 0 - input data preparation: " );   // =========================^^^^^vvvvv
 
     // part 1 code here
 
-    std::vector<AntennaType> vAntennaList;
-    std::set<LocType> vNodeSet;
-
-    InitMap( inputData );
-    GetAntennaList( inputData, vAntennaList );
-    GetNodeSet( inputData, vAntennaList, vNodeSet );
-
-    int nTotalNodes = vNodeSet.size();
+    int nTotalNodes;
+    bench.RunPhase( "solving puzzle part 1", [&]() { nTotalNodes = SolvePart1(); } );
+    bench.SetAnswer( nTotalNodes );
 
     std::cout << std::endl << "Answer to part 1: nr of antinodes within map bounds = " << nTotalNodes << std::endl << std::endl;
 
-/* ========== */   tmr.TimeReport( "    Timing 1 - solving puzzle part 1 : " );   // =========================^^^^^vvvvv
+/* ========== */   bench.TimeReport( "    Timing 1 - solving puzzle part 1 : " );   // =========================^^^^^vvvvv
 
     // part 2 code here
 
-    inputData = part2Data; // get fresh untouched copy of input data
-
-    InitMap( inputData );
-    GetAntennaList( inputData, vAntennaList );
-    GetNodeSet2( inputData, vAntennaList, vNodeSet );
-
-    int nTotalNodes2 = vNodeSet.size();
+    int nTotalNodes2;
+    bench.RunPhase( "solving puzzle part 2", [&]() { nTotalNodes2 = SolvePart2(); } );
+    bench.SetAnswer( nTotalNodes2 );
 
     std::cout << std::endl << "Answer to part 2: nr of antinodes within map bounds = " << nTotalNodes2 << std::endl << std::endl;
 
-/* ========== */   tmr.TimeReport( "    Timing 2 - solving puzzle part 2 : " );   // ==============================^^^^^
+/* ========== */   bench.TimeReport( "    Timing 2 - solving puzzle part 2 : " );   // ==============================^^^^^
+
+    if (bench.GetRepeat() > 1) {
+        bench.SummaryReport();
+    }
 
     return 0;
 }
+
+#endif // AOC24_DRIVER
@@ -7,16 +7,25 @@
 #define DAY_STRING  "day09"
 
 #include <iostream>
+#include <cstdint>
 #include <fstream>
 #include <algorithm>
 #include <numeric>
 #include <vector>
 #include <list>
+#include <queue>
+#include <functional>
 
 #include "../flcTimer.h"
+#include "../flcBenchmark.h"
+#include "../flcInputFile.h"
+#include "../aoc24_registry.h"
+#include "../flcSnapshot.h"
 #include "../parse_functions.h"
 #include "my_utility.h"
 
+namespace day09 {
+
 // ==========   PROGRAM PHASING
 
 enum eProgPhase {     // what programming phase are you in - set at start of main()
@@ -54,17 +63,15 @@ void GetData_EXAMPLE( DataStream &dData ) {
 // file input - this function reads text file content one line at a time - adapt code to match your need for line parsing!
 void ReadInputData( const std::string sFileName, DataStream &vData ) {
 
-    std::ifstream dataFileStream( sFileName );
+    flcInputFile dataFile( sFileName );
     vData.clear();
-    std::string sLine;
-    while (getline( dataFileStream, sLine )) {
+    for (std::string_view sLine : dataFile.Lines()) {
         vData.append( sLine );
     }
-    dataFileStream.close();
 }
 
-void GetData_TEST(   DataStream &dData ) { std::string sInputFile = DAY_STRING; sInputFile.append( ".input.test.txt"   ); ReadInputData( sInputFile, dData ); }
-void GetData_PUZZLE( DataStream &dData ) { std::string sInputFile = DAY_STRING; sInputFile.append( ".input.puzzle.txt" ); ReadInputData( sInputFile, dData ); }
+void GetData_TEST(   DataStream &dData ) { std::string sInputFile = GetInputFileName( DAY_STRING, "test"   ); ReadInputData( sInputFile, dData ); }
+void GetData_PUZZLE( DataStream &dData ) { std::string sInputFile = GetInputFileName( DAY_STRING, "puzzle" ); ReadInputData( sInputFile, dData ); }
 
 // ==========   CONSOLE OUTPUT FUNCTIONS
 
@@ -164,7 +171,7 @@ int ctoi( char c ) {
 }
 
 // processes the input data into a stream (std::list) of BlockType elements
-void ProcessInput( DataStream &dData, BlockStream &vBlocks ) {
+void ProcessInput( const DataStream &dData, BlockStream &vBlocks ) {
 
     vBlocks.clear();
 
@@ -245,18 +252,21 @@ void Defragment1( BlockStream &vOld ) {
     }
 }
 
-long long FileCheckSum1( BlockType &b, int nStartBlock ) {
-    long long result = 0;
+// NOTE: the check sums are kept in a uint64_t, so they wrap around modulo 2^64 instead of overflowing. The
+// puzzle input is far from that, but generated disk maps of scale 300 or more reach it. Both engines of
+// part 2 wrap the same way, so they can still be compared
+uint64_t FileCheckSum1( BlockType &b, int nStartBlock ) {
+    uint64_t result = 0;
     if (b.nId != -1) {
         for (int i = 0; i < b.nLength; i++) {
-            result += (nStartBlock + i) * b.nId;
+            result += (uint64_t)nStartBlock * b.nId + (uint64_t)i * b.nId;
         }
     }
     return result;
 }
 
-long long SystemCheckSum1( BlockStream &bs ) {
-    long long result = 0;
+uint64_t SystemCheckSum1( BlockStream &bs ) {
+    uint64_t result = 0;
     int nBlockCount = 0;
     for (auto &e : bs) {
         result += FileCheckSum1( e, nBlockCount );
@@ -358,66 +368,196 @@ void Defragment2( BlockStream &vOld ) {
 }
 
 
-long long FileCheckSum2( BlockType &b ) {
-    long long result = 0;
+uint64_t FileCheckSum2( BlockType &b ) {
+    uint64_t result = 0;
     if (b.nId != -1) {
         for (int i = 0; i < b.nLength; i++) {
-            result += (b.nAddress + i) * b.nId;
+            result += (uint64_t)b.nAddress * b.nId + (uint64_t)i * b.nId;
         }
     }
     return result;
 }
 
-long long SystemCheckSum2( BlockStream &bs ) {
-    long long result = 0;
+uint64_t SystemCheckSum2( BlockStream &bs ) {
+    uint64_t result = 0;
     for (auto &e : bs) {
         result += FileCheckSum2( e );
     }
     return result;
 
 }
-// ==========   MAIN()
 
-int main()
-{
-    glbProgPhase = PUZZLE;     // program phase to EXAMPLE, TEST or PUZZLE
-    std::cout << "Phase: " << ProgPhase2string() << std::endl << std::endl;
-    flcTimer tmr;
+// The list version above searches the free spaces from the front for every file, which makes it
+// quadratic in the nr of files. Since a free space is never longer than 9 blocks, the free spaces can be
+// kept in 10 min heaps on address instead, one per length. The leftmost fitting space for a file of
+// length n is then the lowest of the tops of heaps n..9. Filling a space leaves a shorter one (or
+// none), which goes into the heap of its new length
+typedef struct sFileStruct {
+    int nAddress;
+    int nLength;
+} FileType;
+
+void Defragment2_heaps( const DataStream &dData, std::vector<FileType> &vFiles ) {
+    typedef std::priority_queue<int, std::vector<int>, std::greater<int>> SpaceHeap;
+    SpaceHeap vSpaces[10];
+    vFiles.clear();
+    int nAddress = 0;
+    for (int i = 0; i < (int)dData.size(); i++) {
+        int nLength = ctoi( dData[i] );
+        if (nLength < 0 || nLength > 9) {
+            std::cout << "ERROR: Defragment2_heaps() --> not a digit: " << dData[i] << std::endl;
+            nLength = 0;
+        }
+        if (i % 2 == 0) {
+            vFiles.push_back( { nAddress, nLength } );
+        } else if (nLength > 0) {
+            vSpaces[nLength].push( nAddress );
+        }
+        nAddress += nLength;
+    }
+    for (int nId = (int)vFiles.size() - 1; nId >= 0; nId--) {
+        FileType &file = vFiles[nId];
+        if (file.nLength == 0) {
+            continue;    // nothing to move
+        }
+        int nBest = -1;
+        for (int nLen = file.nLength; nLen <= 9; nLen++) {
+            if (!vSpaces[nLen].empty() && vSpaces[nLen].top() < file.nAddress &&
+                (nBest == -1 || vSpaces[nLen].top() < vSpaces[nBest].top())) {
+                nBest = nLen;
+            }
+        }
+        if (nBest != -1) {
+            int nSpace = vSpaces[nBest].top();
+            vSpaces[nBest].pop();
+            file.nAddress = nSpace;
+            if (nBest > file.nLength) {
+                vSpaces[nBest - file.nLength].push( nSpace + file.nLength );
+            }
+        }
+    }
+}
+
+uint64_t SystemCheckSum2( std::vector<FileType> &vFiles ) {
+    uint64_t result = 0;
+    for (int nId = 0; nId < (int)vFiles.size(); nId++) {
+        // sum of the addresses nAddress .. nAddress + nLength - 1, times the ID
+        uint64_t n = vFiles[nId].nLength;
+        result += (uint64_t)nId * (n * vFiles[nId].nAddress + n * (n - 1) / 2);
+    }
+    return result;
+}
 
-/* ========== */   tmr.StartTiming();   // ============================================vvvvv
+// ==========   PHASE FUNCTIONS
 
-    // get input data, depending on the glbProgPhase (example, test, puzzle)
+flcSnapshot<DataStream> glbInputData;   // parsed input data - the parts view it read only
+
+// phase 0 - get input data, depending on the glbProgPhase (example, test, puzzle)
+void PrepareInput() {
     DataStream inputData;
     GetInput( inputData, glbProgPhase != PUZZLE );
-    DataStream part2Data = inputData;
-    std::cout << "Data stats - size of data stream " << inputData.size() << std::endl << std::endl;
-
-/* ========== */   tmr.TimeReport( "    Timing 0 - input data preparation: " );   // =========================^^^^^vvvvv
+    glbInputData = MakeSnapshot( std::move( inputData ));
+}
 
-    // part 1 code here
+uint64_t SolvePart1() {
+    const DataStream &inputData = *glbInputData;
     BlockStream vBlockData;
     ProcessInput( inputData, vBlockData );
     Defragment1( vBlockData );
+    return SystemCheckSum1( vBlockData );
+}
 
-    long long llCheckSum1 = SystemCheckSum1( vBlockData );
+// the final address of each file after part 2, as artifact for the --verify mode of the driver. Where
+// a file of length 0 ends up doesn't matter, these get -1
+std::vector<int> glbFileAddresses;
 
-    std::cout << std::endl << "Answer to part 1: system check sum = " << llCheckSum1 << std::endl << std::endl;
+uint64_t SolvePart2() {
+    std::vector<FileType> vFiles;
+    Defragment2_heaps( *glbInputData, vFiles );
+    glbFileAddresses.clear();
+    for (auto &f : vFiles) {
+        glbFileAddresses.push_back( f.nLength > 0 ? f.nAddress : -1 );
+    }
+    return SystemCheckSum2( vFiles );
+}
 
-/* ========== */   tmr.TimeReport( "    Timing 1 - solving puzzle part 1 : " );   // =========================^^^^^vvvvv
+// the original list based version, kept as reference for the optimized one
+uint64_t SolvePart2_reference() {
+    const DataStream &inputData = *glbInputData;
+    BlockStream vBlockData;
+    ProcessInput( inputData, vBlockData );
+    Defragment2( vBlockData );
+    glbFileAddresses.assign( (inputData.size() + 1) / 2, -1 );
+    for (auto &b : vBlockData) {
+        if (b.nId != -1 && b.nLength > 0) {
+            glbFileAddresses[b.nId] = b.nAddress;
+        }
+    }
+    return SystemCheckSum2( vBlockData );
+}
 
-    inputData = part2Data; // get fresh untouched copy of input data
+std::string Part2Artifact() {
+    std::string sResult;
+    for (int nAddress : glbFileAddresses) {
+        sResult.append( std::to_string( nAddress ) + " " );
+    }
+    return sResult;
+}
+
+}   // namespace day09
+
+// ==========   MAIN()
+
+#ifdef AOC24_DRIVER
+
+// in the aoc24 driver program this day registers its phase functions instead of having a main()
+AOC24_REGISTER_DAY( day09 );
+AOC24_CONCURRENT_PARTS( day09 );
+AOC24_REGISTER_ENGINE( day09, 2, reference, SolvePart2_reference, Part2Artifact );
+AOC24_REGISTER_ENGINE( day09, 2, optimized, SolvePart2          , Part2Artifact );
+
+#else
+
+using namespace day09;
+
+int main( int argc, char *argv[] )
+{
+    glbProgPhase = PUZZLE;     // program phase to EXAMPLE, TEST or PUZZLE
+    std::cout << "Phase: " << ProgPhase2string() << std::endl << std::endl;
+    flcBenchmark bench( argc, argv );   // use --warmup <n> and --repeat <n> to get timing statistics
+    bench.SetContext( DAY_STRING, ProgPhase2string());
+
+/* ========== */   bench.RunPhase( "input data preparation", PrepareInput );   // =====================vvvvv
+
+    std::cout << "Data stats - size of data stream " << glbInputData->size() << std::endl << std::endl;
+
+/* ========== */   bench.TimeReport( "    Timing 0 - input data preparation: " );   // =========================^^^^^vvvvv
+
+    // part 1 code here
+
+    uint64_t nCheckSum1;
+    bench.RunPhase( "solving puzzle part 1", [&]() { nCheckSum1 = SolvePart1(); } );
+    bench.SetAnswer( nCheckSum1 );
+
+    std::cout << std::endl << "Answer to part 1: system check sum = " << nCheckSum1 << std::endl << std::endl;
+
+/* ========== */   bench.TimeReport( "    Timing 1 - solving puzzle part 1 : " );   // =========================^^^^^vvvvv
 
     // part 2 code here
-    vBlockData.clear();
-    ProcessInput( inputData, vBlockData );
-    Defragment2( vBlockData );
 
-    long long llCheckSum2 = SystemCheckSum2( vBlockData );
+    uint64_t nCheckSum2;
+    bench.RunPhase( "solving puzzle part 2", [&]() { nCheckSum2 = SolvePart2(); } );
+    bench.SetAnswer( nCheckSum2 );
 
+    std::cout << std::endl << "Answer to part 2: system check sum = " << nCheckSum2 << std::endl << std::endl;
 
-    std::cout << std::endl << "Answer to part 2: system check sum = " << llCheckSum2 << std::endl << std::endl;
+/* ========== */   bench.TimeReport( "    Timing 2 - solving puzzle part 2 : " );   // ==============================^^^^^
 
-/* ========== */   tmr.TimeReport( "    Timing 2 - solving puzzle part 2 : " );   // ==============================^^^^^
+    if (bench.GetRepeat() > 1) {
+        bench.SummaryReport();
+    }
 
     return 0;
 }
+
+#endif // AOC24_DRIVER
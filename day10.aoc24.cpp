@@ -14,9 +14,18 @@
 #include <set>
 
 #include "../flcTimer.h"
+#include "../flcBenchmark.h"
+#include "../flcInputFile.h"
+#include "../flcThreadPool.h"
+#include "../aoc24_registry.h"
+#include "../flcSnapshot.h"
+#include "../flcBitGrid.h"
+#include "../flcGrid.h"
 #include "../parse_functions.h"
 #include "my_utility.h"
 
+namespace day10 {
+
 // ==========   PROGRAM PHASING
 
 enum eProgPhase {     // what programming phase are you in - set at start of main()
@@ -61,17 +70,15 @@ void GetData_EXAMPLE( DataStream &dData ) {
 // file input - this function reads text file content one line at a time - adapt code to match your need for line parsing!
 void ReadInputData( const std::string sFileName, DataStream &vData ) {
 
-    std::ifstream dataFileStream( sFileName );
+    flcInputFile dataFile( sFileName );
     vData.clear();
-    std::string sLine;
-    while (getline( dataFileStream, sLine )) {
-        vData.push_back( sLine );
+    for (std::string_view sLine : dataFile.Lines()) {
+        vData.emplace_back( sLine );
     }
-    dataFileStream.close();
 }
 
-void GetData_TEST(   DataStream &dData ) { std::string sInputFile = DAY_STRING; sInputFile.append( ".input.test.txt"   ); ReadInputData( sInputFile, dData ); }
-void GetData_PUZZLE( DataStream &dData ) { std::string sInputFile = DAY_STRING; sInputFile.append( ".input.puzzle.txt" ); ReadInputData( sInputFile, dData ); }
+void GetData_TEST(   DataStream &dData ) { std::string sInputFile = GetInputFileName( DAY_STRING, "test"   ); ReadInputData( sInputFile, dData ); }
+void GetData_PUZZLE( DataStream &dData ) { std::string sInputFile = GetInputFileName( DAY_STRING, "puzzle" ); ReadInputData( sInputFile, dData ); }
 
 // ==========   CONSOLE OUTPUT FUNCTIONS
 
@@ -110,147 +117,162 @@ void GetInput( DataStream &dData, bool bDisplay = false ) {
 
 // ==========   PUZZLE SPECIFIC SOLUTIONS
 
-// convenience type - locations on the map. The operators are for applying this type in
-// combination with std::set etc
-typedef struct sLocationStruct {
-    int x, y;
+// for part 1 the map is split into 10 bit grids, one per height. The end points that can be reached
+// from a trail head are found by growing the trail head one height at a time: the cells of height h + 1
+// that neighbour the cells reached at height h
+typedef std::vector<flcBitGrid> HeightLayers;
 
-    bool operator == (const sLocationStruct &rhs ) { return (this->x == rhs.x && this->y == rhs.y); }
-    bool operator < (const sLocationStruct &rhs ) const {
-        return ( this->x <  rhs.x) ||
-               ((this->x == rhs.x) && (this->y < rhs.y));
+HeightLayers GetHeightLayers( const DataStream &mapData ) {
+    HeightLayers vLayers;
+    for (char c = '0'; c <= '9'; c++) {
+        vLayers.push_back( BitGridFromLines( mapData, c ));
     }
-} LocType;
-typedef std::set<LocType> LocSet;
-
-// is denoted location in bounds of the map?
-bool InBounds( DataStream &mapData, int x, int y ) {
-    return (x >= 0 && x < (int)mapData[0].length() && y >= 0 && y < (int)mapData.size());
-}
-bool InBounds( DataStream &mapData, LocType &loc ) {
-    return InBounds( mapData, loc.x, loc.y );
-}
-
-// does denoted map location match char c?
-bool MatchPosition( DataStream &mapData, int x, int y, char c ) {
-    return InBounds( mapData, x, y ) && mapData[y][x] == c;
+    return vLayers;
 }
 
-// works out all hiking trail end points starting from location (x, y) in the map
-// the end points are returned in the std::set lSet
-void AnalyseTrail( DataStream &mapData, int x, int y, char startChar, LocSet &lSet ) {
-    if (MatchPosition( mapData, x, y, startChar )) {
-        if (startChar == '9') {
-            // recursion end condition
-            lSet.insert( { x, y } );
-        } else {
-            // attempt all next directions using recursion
-            AnalyseTrail( mapData, x    , y - 1, startChar + 1, lSet );
-            AnalyseTrail( mapData, x    , y + 1, startChar + 1, lSet );
-            AnalyseTrail( mapData, x - 1, y    , startChar + 1, lSet );
-            AnalyseTrail( mapData, x + 1, y    , startChar + 1, lSet );
-        }
+// Trail head score: the nr of height 9 cells that can be reached from trail head (x, y)
+int AnalysePosition( HeightLayers &vLayers, int x, int y ) {
+    flcBitGrid reached( vLayers[0].Width(), vLayers[0].Height());
+    reached.Set( x, y );
+    for (int h = 1; h <= 9 && reached.Any(); h++) {
+        reached = reached.Dilated4();
+        reached &= vLayers[h];
     }
+    return reached.Count();
 }
 
-// Trail head score: gather all possible trail endpoints in lSet, and returns its size
-int AnalysePosition( DataStream &mapData, int x, int y ) {
-    LocSet lSet;
-    AnalyseTrail( mapData, x, y, '0', lSet );
-    return lSet.size();
+// the recursion of part 2 works on an flcGrid with a border of 1 cell holding '.', which never matches
+// a height. So it can step off the map without bounds checks. Locations are flat grid indices
+
+// does denoted map location match char c?
+bool MatchPosition( flcGrid<char> &mapData, int nLoc, char c ) {
+    return mapData[nLoc] == c;
 }
 
 // ----- PART 2
 
 // for part 2 we need to gather unique trails instead of unique end points, so I need
 // a std::set of trails
-typedef std::vector<LocType> TrailType;
+typedef std::vector<int> TrailType;
 typedef std::set<TrailType> TrailSet;
 
-// returns the number of hiking trails starting from location (x, y) in the map
-void AnalyseTrail2( DataStream &mapData, int x, int y, char startChar, TrailType &curTrail, TrailSet &tSet ) {
+// returns the number of hiking trails starting from location nLoc in the map
+void AnalyseTrail2( flcGrid<char> &mapData, int nLoc, char startChar, TrailType &curTrail, TrailSet &tSet ) {
     // a hiking trail starts with 0, ends with 9 and has an even, gradual uphill slope
     // so it must have values 0 1 2 ... 9
-    if (MatchPosition( mapData, x, y, startChar )) {
-        curTrail.push_back( { x, y } );
+    if (MatchPosition( mapData, nLoc, startChar )) {
+        curTrail.push_back( nLoc );
         if (startChar == '9') {
             tSet.insert( curTrail );
         } else {
-            // make local copies of current trail
-            TrailType upTrail = curTrail;
-            TrailType dnTrail = curTrail;
-            TrailType ltTrail = curTrail;
-            TrailType rtTrail = curTrail;
-            // recursive calls in all cardinal directions
-            AnalyseTrail2( mapData, x    , y - 1, startChar + 1, upTrail, tSet );
-            AnalyseTrail2( mapData, x    , y + 1, startChar + 1, dnTrail, tSet );
-            AnalyseTrail2( mapData, x - 1, y    , startChar + 1, ltTrail, tSet );
-            AnalyseTrail2( mapData, x + 1, y    , startChar + 1, rtTrail, tSet );
+            // recursive calls in all cardinal directions, each on a local copy of the current trail
+            for (int dir = 0; dir < 4; dir++) {
+                TrailType nextTrail = curTrail;
+                AnalyseTrail2( mapData, nLoc + mapData.Offset4( dir ), startChar + 1, nextTrail, tSet );
+            }
         }
     }
 }
 
 // Trail head rating: gather the set of unique trails in tSet, and return the number
-int AnalysePosition2( DataStream &mapData, int x, int y ) {
+int AnalysePosition2( flcGrid<char> &mapData, int nLoc ) {
     TrailType trl;
     TrailSet tSet;
-    AnalyseTrail2( mapData, x, y, '0', trl, tSet );
+    AnalyseTrail2( mapData, nLoc, '0', trl, tSet );
     return tSet.size();
 }
 
+// ==========   PHASE FUNCTIONS
+
+flcSnapshot<DataStream> glbInputData;   // parsed input data - the parts view it read only
+
+// phase 0 - get input data, depending on the glbProgPhase (example, test, puzzle)
+void PrepareInput() {
+    DataStream inputData;
+    GetInput( inputData, glbProgPhase != PUZZLE );
+    glbInputData = MakeSnapshot( std::move( inputData ));
+}
+
+int SolvePart1() {
+    HeightLayers vLayers = GetHeightLayers( *glbInputData );
+    int nTrailHeadScoreSum = 0;
+    for (CoordType trailHead : vLayers[0]) {
+        int nRes = AnalysePosition( vLayers, trailHead.x, trailHead.y );
+//        std::cout << "Map position (" << trailHead.x << ", " << trailHead.y << ") has a score of " << nRes << std::endl;
+        nTrailHeadScoreSum += nRes;
+    }
+    return nTrailHeadScoreSum;
+}
+
+// the trail heads are independent of each other, so they are rated in parallel - one row of the map per
+// iteration
+int SolvePart2() {
+    flcGrid<char> mapData = GridFromLines( *glbInputData, 1, '.' );   // the map with a border
+    int nTrailHeadRatingSum = parallel_reduce( 0, mapData.Height(), 0,
+        [&]( int y ) {
+            int nRowSum = 0;
+            for (int x = 0; x < mapData.Width(); x++) {
+                nRowSum += AnalysePosition2( mapData, mapData.Index( x, y ));
+            }
+            return nRowSum;
+        },
+        []( int a, int b ) { return a + b; }
+    );
+    return nTrailHeadRatingSum;
+}
+
+}   // namespace day10
+
 // ==========   MAIN()
 
-int main()
+#ifdef AOC24_DRIVER
+
+// in the aoc24 driver program this day registers its phase functions instead of having a main()
+AOC24_REGISTER_DAY( day10 );
+AOC24_CONCURRENT_PARTS( day10 );
+
+#else
+
+using namespace day10;
+
+int main( int argc, char *argv[] )
 {
     glbProgPhase = PUZZLE;     // program phase to EXAMPLE, TEST or PUZZLE
     std::cout << "Phase: " << ProgPhase2string() << std::endl << std::endl;
-    flcTimer tmr;
+    flcBenchmark bench( argc, argv );   // use --warmup <n> and --repeat <n> to get timing statistics
+    bench.SetContext( DAY_STRING, ProgPhase2string());
 
-/* ========== */   tmr.StartTiming();   // ============================================vvvvv
+/* ========== */   bench.RunPhase( "input data preparation", PrepareInput );   // =====================vvvvv
 
-    // get input data, depending on the glbProgPhase (example, test, puzzle)
-    DataStream inputData;
-    GetInput( inputData, glbProgPhase != PUZZLE );
-    DataStream part2Data = inputData;
-    std::cout << "Data stats - size of data stream " << inputData.size() << std::endl << std::endl;
+    std::cout << "Data stats - size of data stream " << glbInputData->size() << std::endl << std::endl;
 
-/* ========== */   tmr.TimeReport( "    Timing 0 - input data preparation: " );   // =========================^^^^^vvvvv
+/* ========== */   bench.TimeReport( "    Timing 0 - input data preparation: " );   // =========================^^^^^vvvvv
 
     // part 1 code here
 
-    int nTrailHeadScoreSum = 0;
-    for (int y = 0; y < (int)inputData.size(); y++) {
-        for (int x = 0; x < (int)inputData[0].length(); x++) {
-            int nRes = AnalysePosition( inputData, x, y );
-//            if (nRes > 0) {
-//                std::cout << "Map position (" << x << ", " << y << ") has a score of " << nRes << std::endl;
-//            }
-            nTrailHeadScoreSum += nRes;
-        }
-    }
+    int nTrailHeadScoreSum;
+    bench.RunPhase( "solving puzzle part 1", [&]() { nTrailHeadScoreSum = SolvePart1(); } );
+    bench.SetAnswer( nTrailHeadScoreSum );
 
     std::cout << std::endl << "Answer to part 1: Sum of all trail head scores = " << nTrailHeadScoreSum << std::endl << std::endl;
 
-/* ========== */   tmr.TimeReport( "    Timing 1 - solving puzzle part 1 : " );   // =========================^^^^^vvvvv
-
-    inputData = part2Data; // get fresh untouched copy of input data
+/* ========== */   bench.TimeReport( "    Timing 1 - solving puzzle part 1 : " );   // =========================^^^^^vvvvv
 
     // part 2 code here
 
-    int nTrailHeadRatingSum = 0;
-    for (int y = 0; y < (int)inputData.size(); y++) {
-        for (int x = 0; x < (int)inputData[0].length(); x++) {
-            int nRes = AnalysePosition2( inputData, x, y );
-//            if (nRes > 0) {
-//                std::cout << "Map position (" << x << ", " << y << ") has a rating of " << nRes << std::endl;
-//            }
-            nTrailHeadRatingSum += nRes;
-        }
-    }
+    int nTrailHeadRatingSum;
+    bench.RunPhase( "solving puzzle part 2", [&]() { nTrailHeadRatingSum = SolvePart2(); } );
+    bench.SetAnswer( nTrailHeadRatingSum );
 
     std::cout << std::endl << "Answer to part 2: Sum of all trail head ratings = " << nTrailHeadRatingSum << std::endl << std::endl;
 
-/* ========== */   tmr.TimeReport( "    Timing 2 - solving puzzle part 2 : " );   // ==============================^^^^^
+/* ========== */   bench.TimeReport( "    Timing 2 - solving puzzle part 2 : " );   // ==============================^^^^^
+
+    if (bench.GetRepeat() > 1) {
+        bench.SummaryReport();
+    }
 
     return 0;
 }
+
+#endif // AOC24_DRIVER
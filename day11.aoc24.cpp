@@ -14,9 +14,17 @@
 #include <map>
 
 #include "../flcTimer.h"
+#include "../flcBenchmark.h"
+#include "../flcInputFile.h"
+#include "../aoc24_registry.h"
+#include "../flcSnapshot.h"
+#include "../flcArtifactCache.h"
 #include "../parse_functions.h"
+#include "../parse_numbers.h"
 #include "my_utility.h"
 
+namespace day11 {
+
 // ==========   PROGRAM PHASING
 
 enum eProgPhase {     // what programming phase are you in - set at start of main()
@@ -54,20 +62,15 @@ void GetData_EXAMPLE( DataStream &dData ) {
 // file input - this function reads text file content one line at a time - adapt code to match your need for line parsing!
 void ReadInputData( const std::string sFileName, DataStream &vData ) {
 
-    std::ifstream dataFileStream( sFileName );
+    flcInputFile dataFile( sFileName );
     vData.clear();
-    std::string sLine;
-    while (getline( dataFileStream, sLine )) {
-        while (sLine.length() > 0) {
-            std::string sNumber = get_token_dlmtd( " ", sLine );
-            vData.push_back( stoll( sNumber ));
-        }
+    for (std::string_view sLine : dataFile.Lines()) {
+        parse_list( sLine, ' ', vData );
     }
-    dataFileStream.close();
 }
 
-void GetData_TEST(   DataStream &dData ) { std::string sInputFile = DAY_STRING; sInputFile.append( ".input.test.txt"   ); ReadInputData( sInputFile, dData ); }
-void GetData_PUZZLE( DataStream &dData ) { std::string sInputFile = DAY_STRING; sInputFile.append( ".input.puzzle.txt" ); ReadInputData( sInputFile, dData ); }
+void GetData_TEST(   DataStream &dData ) { std::string sInputFile = GetInputFileName( DAY_STRING, "test"   ); ReadInputData( sInputFile, dData ); }
+void GetData_PUZZLE( DataStream &dData ) { std::string sInputFile = GetInputFileName( DAY_STRING, "puzzle" ); ReadInputData( sInputFile, dData ); }
 
 // ==========   CONSOLE OUTPUT FUNCTIONS
 
@@ -154,7 +157,7 @@ long long GetCopies( EntryType mapEntry ) { return mapEntry.second; }
 
 // inits the three global maps from the input data. The data is categorized and put
 // in the appropriate map as is. Since all data are unique, all entries get copies = 1
-void InitMaps( DataStream &dData ) {
+void InitMaps( const DataStream &dData ) {
     mapZero.clear();
     mapEven.clear();
     mapOthr.clear();
@@ -279,26 +282,31 @@ long long GetNrStones() {
 // it overflowed for 75 blinks
 
 
-// ==========   MAIN()
+// ==========   PHASE FUNCTIONS
 
-int main()
-{
-    glbProgPhase = PUZZLE;     // program phase to EXAMPLE, TEST or PUZZLE
-    std::cout << "Phase: " << ProgPhase2string() << std::endl << std::endl;
-    flcTimer tmr;
+flcSnapshot<DataStream> glbInputData;   // parsed input data - the parts view it read only
+uint64_t glbInputHash;                  // the key of the artifacts of this input
 
-/* ========== */   tmr.StartTiming();   // ============================================vvvvv
+// part 2 continues where part 1 left off - the state of the maps after 25 blinks is shared with part 2
+// as artifact "day11.blinks25", so that part 2 can be repeated, or run on its own
+typedef struct sBlinkStateStruct {
+    EntryMap mZero, mEven, mOthr;
+} BlinkStateType;
 
-    // get input data, depending on the glbProgPhase (example, test, puzzle)
+// phase 0 - get input data, depending on the glbProgPhase (example, test, puzzle)
+void PrepareInput() {
     DataStream inputData;
     GetInput( inputData, glbProgPhase != PUZZLE );
-    DataStream part2Data = inputData;
-    std::cout << "Data stats - size of data stream " << inputData.size() << std::endl << std::endl;
-
-/* ========== */   tmr.TimeReport( "    Timing 0 - input data preparation: " );   // =========================^^^^^vvvvv
-
-    // part 1 code here
+    std::vector<std::string> vLines;
+    for (auto &e : inputData) {
+        vLines.push_back( std::to_string( e ));
+    }
+    glbInputHash = flcArtifactCache::HashLines( vLines );
+    glbInputData = MakeSnapshot( std::move( inputData ));
+}
 
+// the state of the maps after the first 25 blinks
+BlinkStateType Blink25( const DataStream &inputData ) {
     // fill global maps from input data
     InitMaps( inputData );
 //    PrintMap( mapZero, "ZERO map - after init" );
@@ -315,21 +323,86 @@ int main()
 //        }
 //        std::cout << "nr of stones = " << GetNrStones() << std::endl;
     }
+    return { mapZero, mapEven, mapOthr };
+}
 
-    std::cout << std::endl << "Answer to part 1: nr of stones after 25 blinks = " << GetNrStones() << std::endl << std::endl;
-
-/* ========== */   tmr.TimeReport( "    Timing 1 - solving puzzle part 1 : " );   // =========================^^^^^vvvvv
+long long SolvePart1() {
+    std::shared_ptr<const BlinkStateType> pState = flcArtifactCache::Instance().Produce<BlinkStateType>( glbInputHash, "day11.blinks25",
+        []() { return Blink25( *glbInputData ); }
+    );
+    mapZero = pState->mZero;
+    mapEven = pState->mEven;
+    mapOthr = pState->mOthr;
+    return GetNrStones();
+}
 
-    // part 2 code here
+// the state after 25 blinks comes from part 1 - it's only computed here if part 2 runs on its own
+long long SolvePart2() {
+    std::shared_ptr<const BlinkStateType> pState = flcArtifactCache::Instance().Consume<BlinkStateType>( glbInputHash, "day11.blinks25",
+        []() { return Blink25( *glbInputData ); }
+    );
+    mapZero = pState->mZero;
+    mapEven = pState->mEven;
+    mapOthr = pState->mOthr;
     for (int i = 26; i <= 75; i++) {
         OneBlink();
 //        std::cout << "After " << i << " blinks ... ";
 //        std::cout << "nr of stones = " << GetNrStones() << std::endl;
     }
+    return GetNrStones();
+}
+
+}   // namespace day11
+
+// ==========   MAIN()
+
+#ifdef AOC24_DRIVER
+
+// in the aoc24 driver program this day registers its phase functions instead of having a main()
+AOC24_REGISTER_DAY( day11 );
 
-    std::cout << std::endl << "Answer to part 2: nr of stones after 75 blinks = " << GetNrStones() << std::endl << std::endl;
+#else
 
-/* ========== */   tmr.TimeReport( "    Timing 2 - solving puzzle part 2 : " );   // ==============================^^^^^
+using namespace day11;
+
+int main( int argc, char *argv[] )
+{
+    glbProgPhase = PUZZLE;     // program phase to EXAMPLE, TEST or PUZZLE
+    std::cout << "Phase: " << ProgPhase2string() << std::endl << std::endl;
+    flcBenchmark bench( argc, argv );   // use --warmup <n> and --repeat <n> to get timing statistics
+    bench.SetContext( DAY_STRING, ProgPhase2string());
+
+/* ========== */   bench.RunPhase( "input data preparation", PrepareInput );   // =====================vvvvv
+
+    std::cout << "Data stats - size of data stream " << glbInputData->size() << std::endl << std::endl;
+
+/* ========== */   bench.TimeReport( "    Timing 0 - input data preparation: " );   // =========================^^^^^vvvvv
+
+    // part 1 code here
+
+    long long nNrStones1;
+    bench.RunPhase( "solving puzzle part 1", [&]() { nNrStones1 = SolvePart1(); } );
+    bench.SetAnswer( nNrStones1 );
+
+    std::cout << std::endl << "Answer to part 1: nr of stones after 25 blinks = " << nNrStones1 << std::endl << std::endl;
+
+/* ========== */   bench.TimeReport( "    Timing 1 - solving puzzle part 1 : " );   // =========================^^^^^vvvvv
+
+    // part 2 code here
+
+    long long nNrStones2;
+    bench.RunPhase( "solving puzzle part 2", [&]() { nNrStones2 = SolvePart2(); } );
+    bench.SetAnswer( nNrStones2 );
+
+    std::cout << std::endl << "Answer to part 2: nr of stones after 75 blinks = " << nNrStones2 << std::endl << std::endl;
+
+/* ========== */   bench.TimeReport( "    Timing 2 - solving puzzle part 2 : " );   // ==============================^^^^^
+
+    if (bench.GetRepeat() > 1) {
+        bench.SummaryReport();
+    }
 
     return 0;
 }
+
+#endif // AOC24_DRIVER
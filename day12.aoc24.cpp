@@ -14,9 +14,16 @@
 #include <deque>
 
 #include "../flcTimer.h"
+#include "../flcBenchmark.h"
+#include "../flcInputFile.h"
+#include "../aoc24_registry.h"
+#include "../flcSnapshot.h"
+#include "../flcArtifactCache.h"
 #include "../parse_functions.h"
 #include "my_utility.h"
 
+namespace day12 {
+
 // ==========   PROGRAM PHASING
 
 enum eProgPhase {     // what programming phase are you in - set at start of main()
@@ -58,17 +65,15 @@ void GetData_EXAMPLE( DataStream &dData ) {
 // file input - this function reads text file content one line at a time - adapt code to match your need for line parsing!
 void ReadInputData( const std::string sFileName, DataStream &vData ) {
 
-    std::ifstream dataFileStream( sFileName );
+    flcInputFile dataFile( sFileName );
     vData.clear();
-    std::string sLine;
-    while (getline( dataFileStream, sLine )) {
-        vData.push_back( sLine );
+    for (std::string_view sLine : dataFile.Lines()) {
+        vData.emplace_back( sLine );
     }
-    dataFileStream.close();
 }
 
-void GetData_TEST(   DataStream &dData ) { std::string sInputFile = DAY_STRING; sInputFile.append( ".input.test.txt"   ); ReadInputData( sInputFile, dData ); }
-void GetData_PUZZLE( DataStream &dData ) { std::string sInputFile = DAY_STRING; sInputFile.append( ".input.puzzle.txt" ); ReadInputData( sInputFile, dData ); }
+void GetData_TEST(   DataStream &dData ) { std::string sInputFile = GetInputFileName( DAY_STRING, "test"   ); ReadInputData( sInputFile, dData ); }
+void GetData_PUZZLE( DataStream &dData ) { std::string sInputFile = GetInputFileName( DAY_STRING, "puzzle" ); ReadInputData( sInputFile, dData ); }
 
 // ==========   CONSOLE OUTPUT FUNCTIONS
 
@@ -168,8 +173,8 @@ typedef struct sRegionStruct {
 } RegionType;
 typedef std::vector<RegionType> RegionStream;
 
-int GetArea( RegionType &r ) { return r.vLocs.size(); }
-int GetPerimeter( RegionType &r ) { return r.perim; }
+int GetArea( const RegionType &r ) { return r.vLocs.size(); }
+int GetPerimeter( const RegionType &r ) { return r.perim; }
 
 // output one region
 void PrintRegion( RegionType &r ) {
@@ -194,11 +199,11 @@ void PrintRegionStream( RegionStream &rs ) {
 }
 
 // returns whether location (x, y) is within map boundaries
-bool InBounds( PlotMap &pm, int x, int y ) {
+bool InBounds( const PlotMap &pm, int x, int y ) {
     return x >= 0 && x < (int)pm[0].size() && y >= 0 && y < (int)pm.size();
 }
 // overloaded version for LocType
-bool InBounds( PlotMap &pm, LocType &loc ) {
+bool InBounds( const PlotMap &pm, const LocType &loc ) {
     return InBounds( pm, loc.x, loc.y );
 }
 
@@ -252,7 +257,7 @@ void FindRegion( PlotMap &pm, int x, int y, RegionStream &rs ) {
 }
 
 // populate plot map (pm) from input data (ds), and analyse all regions from it in rs
-void InitPlotStream( DataStream &ds, PlotMap &pm, RegionStream &rs ) {
+void InitPlotStream( const DataStream &ds, PlotMap &pm, RegionStream &rs ) {
 
     // clear old contents (if any)
     for (int y = 0; y < (int)pm.size(); y++) {
@@ -318,9 +323,9 @@ void AnalyzePerimeters( PlotMap &pm, RegionStream &rs ) {
 
 // function to determine number of external corners of a plot
 // we only need to examine the bFenced flag of this plot
-int GetExternalCorners( PlotMap &pm, int x, int y ) {
+int GetExternalCorners( const PlotMap &pm, int x, int y ) {
     int nCorners = 0;
-    PlotType &curPlot = pm[y][x];
+    const PlotType &curPlot = pm[y][x];
     if (curPlot.bFenced[UP] && curPlot.bFenced[RT]) nCorners += 1;
     if (curPlot.bFenced[RT] && curPlot.bFenced[DN]) nCorners += 1;
     if (curPlot.bFenced[DN] && curPlot.bFenced[LT]) nCorners += 1;
@@ -331,9 +336,9 @@ int GetExternalCorners( PlotMap &pm, int x, int y ) {
 // function to determine number of internal corners of a plot
 // note that neighbours bFenced values must be checked for this
 // which also necessitates checking on map boundaries
-int GetInternalCorners( PlotMap &pm, int x, int y ) {
+int GetInternalCorners( const PlotMap &pm, int x, int y ) {
     int nCorners = 0;
-    PlotType &curPlot = pm[y][x];
+    const PlotType &curPlot = pm[y][x];
     char curId = curPlot.c;
     LocType locUP = { curPlot.x + vGlbOffsets[UP].x, curPlot.y + vGlbOffsets[UP].y };
     LocType locRT = { curPlot.x + vGlbOffsets[RT].x, curPlot.y + vGlbOffsets[RT].y };
@@ -371,12 +376,12 @@ int GetInternalCorners( PlotMap &pm, int x, int y ) {
 }
 
 // function to count all corners of a cell
-int GetNrCorners( PlotMap &pm, int x, int y ) {
+int GetNrCorners( const PlotMap &pm, int x, int y ) {
     return GetExternalCorners( pm, x, y ) + GetInternalCorners( pm, x, y );
 }
 
 // function to count all corners of a region (the number of sides == number of corners)
-int GetNrCorners( PlotMap &pm, RegionType &r ) {
+int GetNrCorners( const PlotMap &pm, const RegionType &r ) {
     int nCorners = 0;
     for (int i = 0; i < (int)r.vLocs.size(); i++) {
         nCorners += GetNrCorners( pm, r.vLocs[i].x, r.vLocs[i].y );
@@ -385,59 +390,118 @@ int GetNrCorners( PlotMap &pm, RegionType &r ) {
 }
 
 
-// ==========   MAIN()
+// ==========   PHASE FUNCTIONS
 
-int main()
-{
-    glbProgPhase = PUZZLE;     // program phase to EXAMPLE, TEST or PUZZLE
-    std::cout << "Phase: " << ProgPhase2string() << std::endl << std::endl;
-    flcTimer tmr;
+flcSnapshot<DataStream> glbInputData;   // parsed input data - the parts view it read only
+uint64_t glbInputHash;                  // the key of the artifacts of this input
 
-/* ========== */   tmr.StartTiming();   // ============================================vvvvv
+// the plot map and regions are built in part 1, and shared with part 2 as artifact "day12.regions".
+// Part 2 uses them read only
+typedef struct sRegionDataStruct {
+    PlotMap      pm;
+    RegionStream rs;
+} RegionDataType;
 
-    // get input data, depending on the glbProgPhase (example, test, puzzle)
+// phase 0 - get input data, depending on the glbProgPhase (example, test, puzzle)
+void PrepareInput() {
     DataStream inputData;
     GetInput( inputData, glbProgPhase != PUZZLE );
-    DataStream part2Data = inputData;
-    std::cout << "Data stats - size of data stream " << inputData.size() << std::endl << std::endl;
-
-/* ========== */   tmr.TimeReport( "    Timing 0 - input data preparation: " );   // =========================^^^^^vvvvv
-
-    // part 1 code here
-
-    PlotMap glbPM;
-    RegionStream glbRS;
-    InitPlotStream( inputData, glbPM, glbRS );
+    glbInputHash = flcArtifactCache::HashLines( inputData );
+    glbInputData = MakeSnapshot( std::move( inputData ));
+}
 
+// the plot map and regions of the input, with the perimeters analysed
+RegionDataType AnalyzeRegions( const DataStream &inputData ) {
+    RegionDataType cData;
+    InitPlotStream( inputData, cData.pm, cData.rs );
 //    std::cout << "After InitPlotStream()" << std::endl;
-//    PrintPlotStream( glbPM );
-//    PrintRegionStream( glbRS );
-
-    AnalyzePerimeters( glbPM, glbRS );
+//    PrintPlotStream( cData.pm );
+//    PrintRegionStream( cData.rs );
 
+    AnalyzePerimeters( cData.pm, cData.rs );
 //    std::cout << "After AnalyzePerimeters()" << std::endl;
-//    PrintPlotStream( glbPM );
-//    PrintRegionStream( glbRS );
+//    PrintPlotStream( cData.pm );
+//    PrintRegionStream( cData.rs );
+    return cData;
+}
 
+int SolvePart1() {
+    std::shared_ptr<const RegionDataType> pData = flcArtifactCache::Instance().Produce<RegionDataType>( glbInputHash, "day12.regions",
+        []() { return AnalyzeRegions( *glbInputData ); }
+    );
+    const RegionStream &rs = pData->rs;
     int nTotalPrice1 = 0;
-    for (int i = 0; i < (int)glbRS.size(); i++) {
-        nTotalPrice1 += (GetArea( glbRS[i] ) * GetPerimeter( glbRS[i] ));
+    for (int i = 0; i < (int)rs.size(); i++) {
+        nTotalPrice1 += (GetArea( rs[i] ) * GetPerimeter( rs[i] ));
+    }
+    return nTotalPrice1;
+}
+
+// the regions come from part 1 - they are only analysed here if part 2 runs on its own
+int SolvePart2() {
+    std::shared_ptr<const RegionDataType> pData = flcArtifactCache::Instance().Consume<RegionDataType>( glbInputHash, "day12.regions",
+        []() { return AnalyzeRegions( *glbInputData ); }
+    );
+    const PlotMap      &pm = pData->pm;
+    const RegionStream &rs = pData->rs;
+    int nTotalPrice2 = 0;
+    for (int i = 0; i < (int)rs.size(); i++) {
+        nTotalPrice2 += (GetArea( rs[i] ) * GetNrCorners( pm, rs[i] ));
     }
+    return nTotalPrice2;
+}
+
+}   // namespace day12
+
+// ==========   MAIN()
+
+#ifdef AOC24_DRIVER
+
+// in the aoc24 driver program this day registers its phase functions instead of having a main()
+AOC24_REGISTER_DAY( day12 );
+
+#else
+
+using namespace day12;
+
+int main( int argc, char *argv[] )
+{
+    glbProgPhase = PUZZLE;     // program phase to EXAMPLE, TEST or PUZZLE
+    std::cout << "Phase: " << ProgPhase2string() << std::endl << std::endl;
+    flcBenchmark bench( argc, argv );   // use --warmup <n> and --repeat <n> to get timing statistics
+    bench.SetContext( DAY_STRING, ProgPhase2string());
+
+/* ========== */   bench.RunPhase( "input data preparation", PrepareInput );   // =====================vvvvv
+
+    std::cout << "Data stats - size of data stream " << glbInputData->size() << std::endl << std::endl;
+
+/* ========== */   bench.TimeReport( "    Timing 0 - input data preparation: " );   // =========================^^^^^vvvvv
+
+    // part 1 code here
+
+    int nTotalPrice1;
+    bench.RunPhase( "solving puzzle part 1", [&]() { nTotalPrice1 = SolvePart1(); } );
+    bench.SetAnswer( nTotalPrice1 );
 
     std::cout << std::endl << "Answer to part 1: total fencing price = " << nTotalPrice1 << std::endl << std::endl;
 
-/* ========== */   tmr.TimeReport( "    Timing 1 - solving puzzle part 1 : " );   // =========================^^^^^vvvvv
+/* ========== */   bench.TimeReport( "    Timing 1 - solving puzzle part 1 : " );   // =========================^^^^^vvvvv
 
     // part 2 code here
 
-    int nTotalPrice2 = 0;
-    for (int i = 0; i < (int)glbRS.size(); i++) {
-        nTotalPrice2 += (GetArea( glbRS[i] ) * GetNrCorners( glbPM, glbRS[i] ));
-    }
+    int nTotalPrice2;
+    bench.RunPhase( "solving puzzle part 2", [&]() { nTotalPrice2 = SolvePart2(); } );
+    bench.SetAnswer( nTotalPrice2 );
 
     std::cout << std::endl << "Answer to part 2: total fencing (discounted) price = " << nTotalPrice2 << std::endl << std::endl;
 
-/* ========== */   tmr.TimeReport( "    Timing 2 - solving puzzle part 2 : " );   // ==============================^^^^^
+/* ========== */   bench.TimeReport( "    Timing 2 - solving puzzle part 2 : " );   // ==============================^^^^^
+
+    if (bench.GetRepeat() > 1) {
+        bench.SummaryReport();
+    }
 
     return 0;
 }
+
+#endif // AOC24_DRIVER
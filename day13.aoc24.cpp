@@ -13,9 +13,18 @@
 #include <vector>
 
 #include "../flcTimer.h"
+#include "../flcBenchmark.h"
+#include "../flcInputFile.h"
+#include "../flcInputCache.h"
+#include "../aoc24_registry.h"
+#include "../flcSnapshot.h"
+#include "../flcPipeline.h"
 #include "../parse_functions.h"
+#include "../parse_numbers.h"
 #include "my_utility.h"
 
+namespace day13 {
+
 // ==========   PROGRAM PHASING
 
 enum eProgPhase {     // what programming phase are you in - set at start of main()
@@ -42,6 +51,8 @@ typedef struct {
     long long px, py;  // location of prize
 } DatumType;
 typedef std::vector<DatumType> DataStream;
+// identifies the layout of DatumType in the input cache - change it if the layout changes
+#define INPUT_CACHE_TAG  DAY_STRING ".v1"
 
 // ==========   INPUT DATA FUNCTIONS
 
@@ -57,39 +68,52 @@ void GetData_EXAMPLE( DataStream &dData ) {
     cDatum = { 69, 23, 27, 71, 18641, 10279 }; dData.push_back( cDatum );
 }
 
-// file input - this function reads text file content one line at a time - adapt code to match your need for line parsing!
-void ReadInputData( const std::string sFileName, DataStream &vData ) {
+// reads the next claw machine (4 lines, the last one empty) from dataFile. Returns false at the end of the file
+bool ParseMachine( flcInputFile &dataFile, DatumType &cDatum ) {
+    std::string_view sLine;
+    if (!dataFile.NextLine( sLine )) {
+        return false;
+    }
+    std::string_view sIgnore, sAX, sAY, sBX, sBY, sPX, sPY;
 
-    std::ifstream dataFileStream( sFileName );
-    vData.clear();
-    std::string sLine;
-    while (getline( dataFileStream, sLine )) {
-        std::string sIgnore, sAX, sAY, sBX, sBY, sPX, sPY;
+    sIgnore = get_token_dlmtd( "Button A: X", sLine );   // button A line
+    sAX     = get_token_dlmtd( ", Y", sLine );
+    sAY     = sLine;
 
-        sIgnore = get_token_dlmtd( "Button A: X", sLine );   // button A line
-        sAX     = get_token_dlmtd( ", Y", sLine );
-        sAY     = sLine;
+    dataFile.NextLine( sLine );
+    sIgnore = get_token_dlmtd( "Button B: X", sLine );   // button B line
+    sBX     = get_token_dlmtd( ", Y+", sLine );
+    sBY     = sLine;
 
-        getline( dataFileStream, sLine );
-        sIgnore = get_token_dlmtd( "Button B: X", sLine );   // button B line
-        sBX     = get_token_dlmtd( ", Y+", sLine );
-        sBY     = sLine;
+    dataFile.NextLine( sLine );
+    sIgnore = get_token_dlmtd( "Prize: X=", sLine );     // prize line
+    sPX     = get_token_dlmtd( ", Y=", sLine );
+    sPY     = sLine;
 
-        getline( dataFileStream, sLine );
-        sIgnore = get_token_dlmtd( "Prize: X=", sLine );     // prize line
-        sPX     = get_token_dlmtd( ", Y=", sLine );
-        sPY     = sLine;
+    dataFile.NextLine( sLine );                          // empty line
 
-        getline( dataFileStream, sLine );                    // empty line
+    cDatum = { to_ll( sAX ), to_ll( sAY ), to_ll( sBX ), to_ll( sBY ), to_ll( sPX ), to_ll( sPY ) };
+    return true;
+}
 
-        DatumType cDatum = { stoll( sAX ), stoll( sAY ), stoll( sBX ), stoll( sBY ), stoll( sPX ), stoll( sPY ) };
+// file input - this function reads text file content one line at a time - adapt code to match your need for line parsing!
+void ReadInputData( const std::string sFileName, DataStream &vData ) {
+
+    flcInputFile dataFile( sFileName );
+    vData.clear();
+    // with --cache, the parsed data of an earlier run is reused if the input file didn't change
+    if (flcInputCache::Load( dataFile, INPUT_CACHE_TAG, vData )) {
+        return;
+    }
+    DatumType cDatum;
+    while (ParseMachine( dataFile, cDatum )) {
         vData.push_back( cDatum );
     }
-    dataFileStream.close();
+    flcInputCache::Save( dataFile, INPUT_CACHE_TAG, vData );
 }
 
-void GetData_TEST(   DataStream &dData ) { std::string sInputFile = DAY_STRING; sInputFile.append( ".input.test.txt"   ); ReadInputData( sInputFile, dData ); }
-void GetData_PUZZLE( DataStream &dData ) { std::string sInputFile = DAY_STRING; sInputFile.append( ".input.puzzle.txt" ); ReadInputData( sInputFile, dData ); }
+void GetData_TEST(   DataStream &dData ) { std::string sInputFile = GetInputFileName( DAY_STRING, "test"   ); ReadInputData( sInputFile, dData ); }
+void GetData_PUZZLE( DataStream &dData ) { std::string sInputFile = GetInputFileName( DAY_STRING, "puzzle" ); ReadInputData( sInputFile, dData ); }
 
 // ==========   CONSOLE OUTPUT FUNCTIONS
 
@@ -132,82 +156,170 @@ void GetInput( DataStream &dData, bool bDisplay = false ) {
 
 // applied Cramers rule, see: https://en.wikipedia.org/wiki/Cramer%27s_rule
 
-long long FindA( DatumType &d ) { return (d.px * d.by - d.py * d.bx) / (d.ax * d.by - d.ay * d.bx); }
-long long FindB( DatumType &d ) { return (d.ax * d.py - d.ay * d.px) / (d.ax * d.by - d.ay * d.bx); }
+long long FindA( const DatumType &d ) { return (d.px * d.by - d.py * d.bx) / (d.ax * d.by - d.ay * d.bx); }
+long long FindB( const DatumType &d ) { return (d.ax * d.py - d.ay * d.px) / (d.ax * d.by - d.ay * d.bx); }
 
 // ----- PART 2
 
-// add 10^13 to each prize x and y value
-void PreProcessInputData( DataStream &ds ) {
-    for (int i = 0; i < (int)ds.size(); i++) {
-        DatumType &d = ds[i];
-        d.px += 10000000000000;
-        d.py += 10000000000000;
+// the machine with 10^13 added to the prize x and y value
+DatumType PreProcessDatum( const DatumType &d ) {
+    DatumType result = d;
+    result.px += 10000000000000;
+    result.py += 10000000000000;
+    return result;
+}
+
+// ==========   PHASE FUNCTIONS
+
+flcSnapshot<DataStream> glbInputData;   // parsed input data - the parts view it read only
+
+// phase 0 - get input data, depending on the glbProgPhase (example, test, puzzle)
+void PrepareInput() {
+    DataStream inputData;
+    GetInput( inputData, glbProgPhase != PUZZLE );
+    glbInputData = MakeSnapshot( std::move( inputData ));
+}
+
+// nr of tokens to win the prize of machine d, or 0 if it can't be won
+int MachineCost1( const DatumType &d ) {
+    int A = FindA( d );
+    int B = FindB( d );
+    bool bSolutionFound = (
+        A >= 0 && B >= 0 &&    // a button can't be pressed a negative nr of times
+        A * d.ax + B * d.bx == d.px &&
+        A * d.ay + B * d.by == d.py
+    );
+    return bSolutionFound ? A * 3 + B * 1 : 0;
+}
+
+// same, for the prize positions of part 2
+long long MachineCost2( const DatumType &cDatum ) {
+    // each machine is changed on its own copy, instead of copying the whole input
+    DatumType d = PreProcessDatum( cDatum );
+    long long A = FindA( d );
+    long long B = FindB( d );
+    bool bSolutionFound = (
+        A >= 0 && B >= 0 &&    // a button can't be pressed a negative nr of times
+        A * d.ax + B * d.bx == d.px &&
+        A * d.ay + B * d.by == d.py
+    );
+    return bSolutionFound ? A * 3 + B * 1 : 0;
+}
+
+int SolvePart1() {
+    const DataStream &inputData = *glbInputData;
+    int nFewestTokens = 0;
+    for (int i = 0; i < (int)inputData.size(); i++) {
+        nFewestTokens += MachineCost1( inputData[i] );
+    }
+    return nFewestTokens;
+}
+
+long long SolvePart2() {
+    const DataStream &inputData = *glbInputData;
+    long long nFewestTokens2 = 0;
+    for (int i = 0; i < (int)inputData.size(); i++) {
+        nFewestTokens2 += MachineCost2( inputData[i] );
     }
+    return nFewestTokens2;
+}
+
+// ----- STREAMED VERSION
+
+PipelineStatsType glbStreamStats[2];   // per part, of the last streamed run - the parts may run concurrently
+
+// parses the claw machines and solves them at the same time, through the pipeline of flcPipeline.h. This
+// reads the input file itself, so it doesn't use the input cache. The example data is not in a file, so
+// that is streamed from the hard coded machines
+template <typename T>
+T FewestTokens_streamed( T (*fnCost)( const DatumType & ), PipelineStatsType &stats ) {
+    return pipeline_reduce<DatumType>(
+        [&]( auto &&emit ) {
+            if (glbProgPhase == EXAMPLE) {
+                DataStream exampleData;
+                GetData_EXAMPLE( exampleData );
+                for (auto &cDatum : exampleData) {
+                    emit( std::move( cDatum ));
+                }
+                return;
+            }
+            flcInputFile dataFile( GetInputFileName( DAY_STRING, glbProgPhase == TEST ? "test" : "puzzle" ) );
+            DatumType cDatum;
+            while (ParseMachine( dataFile, cDatum )) {
+                emit( std::move( cDatum ));
+            }
+        },
+        T( 0 ),
+        fnCost,
+        []( T a, T b ) { return a + b; },
+        &stats
+    );
 }
 
+int       SolvePart1_streamed() { return FewestTokens_streamed( MachineCost1, glbStreamStats[0] ); }
+long long SolvePart2_streamed() { return FewestTokens_streamed( MachineCost2, glbStreamStats[1] ); }
+
+// the nr of machines that were solved - catches machines that got lost in the queue
+std::string ParsedArtifact()    { return std::to_string( glbInputData->size()); }
+std::string StreamedArtifact1() { return std::to_string( glbStreamStats[0].nRecords ); }
+std::string StreamedArtifact2() { return std::to_string( glbStreamStats[1].nRecords ); }
+
+}   // namespace day13
+
 // ==========   MAIN()
 
-int main()
+#ifdef AOC24_DRIVER
+
+// in the aoc24 driver program this day registers its phase functions instead of having a main()
+AOC24_REGISTER_DAY( day13 );
+AOC24_CONCURRENT_PARTS( day13 );
+AOC24_REGISTER_ENGINE( day13, 1, reference, SolvePart1         , ParsedArtifact   );
+AOC24_REGISTER_OWN_INPUT_ENGINE( day13, 1, streamed, SolvePart1_streamed, StreamedArtifact1 );
+AOC24_REGISTER_ENGINE( day13, 2, reference, SolvePart2         , ParsedArtifact   );
+AOC24_REGISTER_OWN_INPUT_ENGINE( day13, 2, streamed, SolvePart2_streamed, StreamedArtifact2 );
+
+#else
+
+using namespace day13;
+
+int main( int argc, char *argv[] )
 {
     glbProgPhase = PUZZLE;     // program phase to EXAMPLE, TEST or PUZZLE
     std::cout << "Phase: " << ProgPhase2string() << std::endl << std::endl;
-    flcTimer tmr;
+    flcBenchmark bench( argc, argv );   // use --warmup <n> and --repeat <n> to get timing statistics
+    bench.SetContext( DAY_STRING, ProgPhase2string());
 
-/* ========== */   tmr.StartTiming();   // ============================================vvvvv
+/* ========== */   bench.RunPhase( "input data preparation", PrepareInput );   // =====================vvvvv
 
-    // get input data, depending on the glbProgPhase (example, test, puzzle)
-    DataStream inputData;
-    GetInput( inputData, glbProgPhase != PUZZLE );
-    DataStream part2Data = inputData;
-    std::cout << "Data stats - size of data stream " << inputData.size() << std::endl << std::endl;
+    std::cout << "Data stats - size of data stream " << glbInputData->size() << std::endl << std::endl;
 
-/* ========== */   tmr.TimeReport( "    Timing 0 - input data preparation: " );   // =========================^^^^^vvvvv
+/* ========== */   bench.TimeReport( "    Timing 0 - input data preparation: " );   // =========================^^^^^vvvvv
 
     // part 1 code here
 
-    int nFewestTokens = 0;
-    for (int i = 0; i < (int)inputData.size(); i++) {
+    int nFewestTokens;
+    bench.RunPhase( "solving puzzle part 1", [&]() { nFewestTokens = SolvePart1(); } );
+    bench.SetAnswer( nFewestTokens );
 
-        int A = FindA( inputData[i] );
-        int B = FindB( inputData[i] );
-        bool bSolutionFound = (
-            A * inputData[i].ax + B * inputData[i].bx == inputData[i].px &&
-            A * inputData[i].ay + B * inputData[i].by == inputData[i].py
-        );
-        if (bSolutionFound) {
-            int cost = A * 3 + B * 1;
-            nFewestTokens += cost;
-//            std::cout << "Solution for data set " << i + 1 << " where (A, B) = (" << A << ", " << B << "), cost = " << cost << ", fewest tokens = " << nFewestTokens << std::endl;
-        }
-    }
     std::cout << std::endl << "Answer to part 1: fewest tokens to spend to win all prizes = " << nFewestTokens << std::endl << std::endl;
 
-/* ========== */   tmr.TimeReport( "    Timing 1 - solving puzzle part 1 : " );   // =========================^^^^^vvvvv
-
-    inputData = part2Data; // get fresh untouched copy of input data
+/* ========== */   bench.TimeReport( "    Timing 1 - solving puzzle part 1 : " );   // =========================^^^^^vvvvv
 
     // part 2 code here
-    PreProcessInputData( inputData );
 
-    long long nFewestTokens2 = 0;
-    for (int i = 0; i < (int)inputData.size(); i++) {
+    long long nFewestTokens2;
+    bench.RunPhase( "solving puzzle part 2", [&]() { nFewestTokens2 = SolvePart2(); } );
+    bench.SetAnswer( nFewestTokens2 );
 
-        long long A = FindA( inputData[i] );
-        long long B = FindB( inputData[i] );
-        bool bSolutionFound = (
-            A * inputData[i].ax + B * inputData[i].bx == inputData[i].px &&
-            A * inputData[i].ay + B * inputData[i].by == inputData[i].py
-        );
-        if (bSolutionFound) {
-            long long cost = A * 3 + B * 1;
-            nFewestTokens2 += cost;
-//            std::cout << "Solution for data set " << i + 1 << " where (A, B) = (" << A << ", " << B << "), cost = " << cost << ", fewest tokens = " << nFewestTokens2 << std::endl;
-        }
-    }
     std::cout << std::endl << "Answer to part 2: fewest tokens to spend to win all prizes = " << nFewestTokens2<< std::endl << std::endl;
 
-/* ========== */   tmr.TimeReport( "    Timing 2 - solving puzzle part 2 : " );   // ==============================^^^^^
+/* ========== */   bench.TimeReport( "    Timing 2 - solving puzzle part 2 : " );   // ==============================^^^^^
+
+    if (bench.GetRepeat() > 1) {
+        bench.SummaryReport();
+    }
 
     return 0;
 }
+
+#endif // AOC24_DRIVER
@@ -14,9 +14,17 @@
 #include <set>
 
 #include "../flcTimer.h"
+#include "../flcBenchmark.h"
+#include "../flcInputFile.h"
+#include "../flcInputCache.h"
+#include "../aoc24_registry.h"
+#include "../flcSnapshot.h"
 #include "../parse_functions.h"
+#include "../parse_numbers.h"
 #include "my_utility.h"
 
+namespace day14 {
+
 // ==========   PROGRAM PHASING
 
 enum eProgPhase {     // what programming phase are you in - set at start of main()
@@ -74,6 +82,8 @@ typedef struct {
     LocType vel;
 } DatumType;
 typedef std::vector<DatumType> DataStream;
+// identifies the layout of DatumType in the input cache - change it if the layout changes
+#define INPUT_CACHE_TAG  DAY_STRING ".v1"
 
 int glbMapX, glbMapY;
 
@@ -102,25 +112,28 @@ void GetData_EXAMPLE( DataStream &dData ) {
 // file input - this function reads text file content one line at a time - adapt code to match your need for line parsing!
 void ReadInputData( const std::string sFileName, DataStream &vData ) {
 
-    std::ifstream dataFileStream( sFileName );
+    flcInputFile dataFile( sFileName );
     vData.clear();
-    std::string sLine;
-    while (getline( dataFileStream, sLine )) {
-        std::string sIgnore, sPX, sPY, sVX, sVY;
+    // with --cache, the parsed data of an earlier run is reused if the input file didn't change
+    if (flcInputCache::Load( dataFile, INPUT_CACHE_TAG, vData )) {
+        return;
+    }
+    for (std::string_view sLine : dataFile.Lines()) {
+        std::string_view sIgnore, sPX, sPY, sVX, sVY;
         sIgnore = get_token_dlmtd( "p=" , sLine );
         sPX     = get_token_dlmtd( ","  , sLine );
         sPY     = get_token_dlmtd( " v=", sLine );
         sVX     = get_token_dlmtd( ","  , sLine );
         sVY     =                         sLine  ;
 
-        DatumType cDatum = { stoi( sPX ), stoi( sPY ), stoi( sVX ), stoi( sVY ) };
+        DatumType cDatum = { to_int( sPX ), to_int( sPY ), to_int( sVX ), to_int( sVY ) };
         vData.push_back( cDatum );
     }
-    dataFileStream.close();
+    flcInputCache::Save( dataFile, INPUT_CACHE_TAG, vData );
 }
 
-void GetData_TEST(   DataStream &dData ) { std::string sInputFile = DAY_STRING; sInputFile.append( ".input.test.txt"   ); ReadInputData( sInputFile, dData ); }
-void GetData_PUZZLE( DataStream &dData ) { std::string sInputFile = DAY_STRING; sInputFile.append( ".input.puzzle.txt" ); ReadInputData( sInputFile, dData ); }
+void GetData_TEST(   DataStream &dData ) { std::string sInputFile = GetInputFileName( DAY_STRING, "test"   ); ReadInputData( sInputFile, dData ); }
+void GetData_PUZZLE( DataStream &dData ) { std::string sInputFile = GetInputFileName( DAY_STRING, "puzzle" ); ReadInputData( sInputFile, dData ); }
 
 // ==========   CONSOLE OUTPUT FUNCTIONS
 
@@ -180,8 +193,7 @@ void SimulateOneSecond( DataStream &robData ) {
         DatumType newRobot = { NextPosition( robData[i] ), robData[i].vel };
         newData.push_back( newRobot );
     }
-    robData.clear();
-    robData = newData;
+    robData.swap( newData );
 }
 
 // quadrant numbering - this is the same as the puzzle description
@@ -196,7 +208,7 @@ int CountQuadrant( DataStream &robData, int nQuadrant ) {
         case  0: nLowX =               0; nLowY =               0; nHghX = glbMapX / 2; nHghY = glbMapY / 2; break;
         case  1: nLowX = glbMapX / 2 + 1; nLowY =               0; nHghX = glbMapX;     nHghY = glbMapY / 2; break;
         case  2: nLowX =               0; nLowY = glbMapY / 2 + 1; nHghX = glbMapX / 2; nHghY = glbMapY;     break;
-        case  3: nLowX = glbMapX / 2 + 1; nLowY = glbMapY / 2 + 1; nHghX = glbMapX;     nHghX = glbMapY;     break;
+        case  3: nLowX = glbMapX / 2 + 1; nLowY = glbMapY / 2 + 1; nHghX = glbMapX;     nHghY = glbMapY;     break;
         default: std::cout << "ERROR: CountQuadrant() --> unknown quadrant nr: " << nQuadrant << std::endl;
     }
     LocType lLow = { nLowX, nLowY };
@@ -495,65 +507,99 @@ bool CouldBeTree9( DataStream &robData ) {
     return nNr8connected >= int( robData.size() * fUsePerc );
 }
 
-// ==========   MAIN()
-
-int main()
-{
-    glbProgPhase = PUZZLE;     // program phase to EXAMPLE, TEST or PUZZLE
-    std::cout << "Phase: " << ProgPhase2string() << std::endl << std::endl;
-    flcTimer tmr;
+// ==========   PHASE FUNCTIONS
 
-/* ========== */   tmr.StartTiming();   // ============================================vvvvv
+flcSnapshot<DataStream> glbInputData;   // parsed input data - the parts view it read only
 
-    // get input data, depending on the glbProgPhase (example, test, puzzle)
+// phase 0 - get input data, depending on the glbProgPhase (example, test, puzzle)
+void PrepareInput() {
     DataStream inputData;
     GetInput( inputData, glbProgPhase != PUZZLE );
-    DataStream part2Data = inputData;
-    std::cout << "Data stats - size of data stream " << inputData.size() << std::endl << std::endl;
-
-/* ========== */   tmr.TimeReport( "    Timing 0 - input data preparation: " );   // =========================^^^^^vvvvv
-
-    // part 1 code here
+    glbInputData = MakeSnapshot( std::move( inputData ));
+}
 
+// the robots move all the time, so the parts work on a copy-on-write view of the input
+long long SolvePart1() {
+    flcCowView<DataStream> robots( glbInputData );
+    DataStream &inputData = robots.Write();
     for (int i = 1; i <= 100; i++) {
         SimulateOneSecond( inputData );
     }
-//    std::cout << "After simulating 100 seconds --- " << std::endl;
-    int nSafetyFactor = 1;
+    long long nSafetyFactor = 1;
     for (int i = 0; i < 4; i++) {
         int nRobCount = CountQuadrant( inputData, i );
         nSafetyFactor *= nRobCount;
-//        std::cout << "nr of robots in quadrant: " << i << " = " << nRobCount << ", current safety factor = " << nSafetyFactor << std::endl;
     }
+    return nSafetyFactor;
+}
 
-    std::cout << std::endl << "Answer to part 1: Safety factor after 100 seconds = " << nSafetyFactor << std::endl << std::endl;
-
-/* ========== */   tmr.TimeReport( "    Timing 1 - solving puzzle part 1 : " );   // =========================^^^^^vvvvv
-
-    inputData = part2Data; // get fresh untouched copy of input data
-
-    // part 2 code here
-//    DisplayMap( inputData );
-
+int SolvePart2() {
+    flcCowView<DataStream> robots( glbInputData );
+    DataStream &inputData = robots.Write();
     bool bHaltFlag = false;
     int nSecondsNeeded = 0;
     for (int i = 1; !bHaltFlag; i++) {
-
         SimulateOneSecond( inputData );
-
-//        DisplayMap( inputData );
-
         bHaltFlag = CouldBeTree9( inputData );
         if (bHaltFlag) {
             nSecondsNeeded = i;
-//            std::cout << "After: " << i << " simulated seconds - I think this a tree... " << std::endl << std::endl;
-//            DisplayMap( inputData );
         }
     }
+    return nSecondsNeeded;
+}
+
+}   // namespace day14
+
+// ==========   MAIN()
+
+#ifdef AOC24_DRIVER
+
+// in the aoc24 driver program this day registers its phase functions instead of having a main()
+AOC24_REGISTER_DAY( day14 );
+AOC24_CONCURRENT_PARTS( day14 );
+
+#else
+
+using namespace day14;
+
+int main( int argc, char *argv[] )
+{
+    glbProgPhase = PUZZLE;     // program phase to EXAMPLE, TEST or PUZZLE
+    std::cout << "Phase: " << ProgPhase2string() << std::endl << std::endl;
+    flcBenchmark bench( argc, argv );   // use --warmup <n> and --repeat <n> to get timing statistics
+    bench.SetContext( DAY_STRING, ProgPhase2string());
+
+/* ========== */   bench.RunPhase( "input data preparation", PrepareInput );   // =====================vvvvv
+
+    std::cout << "Data stats - size of data stream " << glbInputData->size() << std::endl << std::endl;
+
+/* ========== */   bench.TimeReport( "    Timing 0 - input data preparation: " );   // =========================^^^^^vvvvv
+
+    // part 1 code here
+
+    long long nSafetyFactor;
+    bench.RunPhase( "solving puzzle part 1", [&]() { nSafetyFactor = SolvePart1(); } );
+    bench.SetAnswer( nSafetyFactor );
+
+    std::cout << std::endl << "Answer to part 1: Safety factor after 100 seconds = " << nSafetyFactor << std::endl << std::endl;
+
+/* ========== */   bench.TimeReport( "    Timing 1 - solving puzzle part 1 : " );   // =========================^^^^^vvvvv
+
+    // part 2 code here
+
+    int nSecondsNeeded;
+    bench.RunPhase( "solving puzzle part 2", [&]() { nSecondsNeeded = SolvePart2(); } );
+    bench.SetAnswer( nSecondsNeeded );
 
     std::cout << std::endl << "Answer to part 2: simulated seconds to find easter egg = " << nSecondsNeeded << std::endl << std::endl;
 
-/* ========== */   tmr.TimeReport( "    Timing 2 - solving puzzle part 2 : " );   // ==============================^^^^^
+/* ========== */   bench.TimeReport( "    Timing 2 - solving puzzle part 2 : " );   // ==============================^^^^^
+
+    if (bench.GetRepeat() > 1) {
+        bench.SummaryReport();
+    }
 
     return 0;
 }
+
+#endif // AOC24_DRIVER
@@ -13,9 +13,15 @@
 #include <vector>
 
 #include "../flcTimer.h"
+#include "../flcBenchmark.h"
+#include "../flcInputFile.h"
+#include "../aoc24_registry.h"
+#include "../flcSnapshot.h"
 #include "../parse_functions.h"
 #include "my_utility.h"
 
+namespace day15 {
+
 // ==========   PROGRAM PHASING
 
 enum eProgPhase {     // what programming phase are you in - set at start of main()
@@ -113,27 +119,25 @@ void GetData_EXAMPLE( MapType &mData, DataStream &dData ) {
 // file input - this function reads text file content one line at a time - adapt code to match your need for line parsing!
 void ReadInputData( const std::string sFileName, MapType &mData, DataStream &vData ) {
 
-    std::ifstream dataFileStream( sFileName );
+    flcInputFile dataFile( sFileName );
     mData.clear();
     vData.clear();
     bool bMapPhase = true;
-    std::string sLine;
-    while (getline( dataFileStream, sLine )) {
+    for (std::string_view sLine : dataFile.Lines()) {
         if (sLine.length() == 0) {
             bMapPhase = false;
         } else {
             if (bMapPhase) {
-                mData.push_back( sLine );
+                mData.emplace_back( sLine );
             } else {
-                vData.push_back( sLine );
+                vData.emplace_back( sLine );
             }
         }
     }
-    dataFileStream.close();
 }
 
-void GetData_TEST(   MapType &mData, DataStream &dData ) { std::string sInputFile = DAY_STRING; sInputFile.append( ".input.test.txt"   ); ReadInputData( sInputFile, mData, dData ); }
-void GetData_PUZZLE( MapType &mData, DataStream &dData ) { std::string sInputFile = DAY_STRING; sInputFile.append( ".input.puzzle.txt" ); ReadInputData( sInputFile, mData, dData ); }
+void GetData_TEST(   MapType &mData, DataStream &dData ) { std::string sInputFile = GetInputFileName( DAY_STRING, "test"   ); ReadInputData( sInputFile, mData, dData ); }
+void GetData_PUZZLE( MapType &mData, DataStream &dData ) { std::string sInputFile = GetInputFileName( DAY_STRING, "puzzle" ); ReadInputData( sInputFile, mData, dData ); }
 
 // ==========   CONSOLE OUTPUT FUNCTIONS
 
@@ -196,7 +200,7 @@ int Char2Dir( char d ) {
 
 LocType glbRobPos;  // keep track of robot position in the map
 
-void ProcessMapInput( MapType &mData ) {
+void ProcessMapInput( const MapType &mData ) {
     for (int y = 0; y < glbMapY; y++) {
         for (int x = 0; x < glbMapX; x++) {
             if (mData[y][x] == '@') {
@@ -212,7 +216,7 @@ void ProcessMapInput( MapType &mData ) {
 // instead of character ^>v< use int values in range [0, 3]
 typedef std::vector<int> MovesType;
 
-void ProcessMoveInput( DataStream &iData, MovesType &movesData ) {
+void ProcessMoveInput( const DataStream &iData, MovesType &movesData ) {
     for (int i = 0; i < (int)iData.size(); i++) {
         for (int j = 0; j < (int)iData[i].length(); j++) {
             int nDir = Char2Dir( iData[i][j] );
@@ -317,10 +321,9 @@ int GetWarehouseScore( MapType &m ) {
 
 // ----- PART 2
 
-// enlarge the width of the map as per puzzle description
-void EnlargeMap( MapType &m ) {
-    MapType cm = m;  // make a copy
-    m.clear();
+// returns the map m with its width enlarged as per puzzle description
+MapType EnlargeMap( const MapType &cm ) {
+    MapType m;
 
     for (int y = 0; y < glbMapY; y++) {
         MapRowType newRow;
@@ -330,7 +333,7 @@ void EnlargeMap( MapType &m ) {
                 case 'O': newRow.append( "[]" ); break;
                 case '.': newRow.append( ".." ); break;
                 case '@': newRow.append( "@." ); break;
-                default: std::cout << "ERROR: EnlargeMap() --> unknown map value: " << m[y][x] << std::endl;
+                default: std::cout << "ERROR: EnlargeMap() --> unknown map value: " << cm[y][x] << std::endl;
             }
         }
         m.push_back( newRow );
@@ -346,6 +349,7 @@ void EnlargeMap( MapType &m ) {
             }
         }
     }
+    return m;
 }
 
 // return if the robot (or box) at position pos in the map mapData is blocked going in direction dir
@@ -432,74 +436,106 @@ int GetWarehouseScore2( MapType &m ) {
     return nResult;
 }
 
-// ==========   MAIN()
-
-int main()
-{
-    glbProgPhase = PUZZLE;     // program phase to EXAMPLE, TEST or PUZZLE
-    std::cout << "Phase: " << ProgPhase2string() << std::endl << std::endl;
-    flcTimer tmr;
+// ==========   PHASE FUNCTIONS
 
-/* ========== */   tmr.StartTiming();   // ============================================vvvvv
+flcSnapshot<MapType>    glbMapData;     // parsed input data - the parts view it read only
+flcSnapshot<DataStream> glbInputData;
 
-    // get input data, depending on the glbProgPhase (example, test, puzzle)
+// phase 0 - get input data, depending on the glbProgPhase (example, test, puzzle)
+void PrepareInput() {
     MapType    mapData;
     DataStream inputData;
     GetInput( mapData, inputData, glbProgPhase != PUZZLE );
-    // make copies to be used for part 2
-    MapType    part2Map  = mapData;
-    DataStream part2Data = inputData;
-
-    int nMoveAttempts = 0;
-    for (auto &e : inputData) { nMoveAttempts += e.length(); }
-    std::cout << "Data stats - size of map: (" << glbMapX << " x " << glbMapY << ") - size of data stream " << nMoveAttempts << std::endl << std::endl;
+    glbMapData   = MakeSnapshot( std::move( mapData ));
+    glbInputData = MakeSnapshot( std::move( inputData ));
+}
 
-/* ========== */   tmr.TimeReport( "    Timing 0 - input data preparation: " );   // =========================^^^^^vvvvv
+// the moves change the map all over, so part 1 works on a copy-on-write view of it
+int SolvePart1() {
+    flcCowView<MapType> warehouse( glbMapData );
+    const DataStream &inputData = *glbInputData;
+    // part 2 enlarges the map, so reset the map dimensions
+    glbMapX = warehouse.Read()[0].length();
+    glbMapY = warehouse.Read().size();
 
-    // part 1 code here
     MovesType movesData;
-
-    ProcessMapInput( mapData );
+    ProcessMapInput( warehouse.Read());
     ProcessMoveInput( inputData, movesData );
+    for (int i = 0; i < (int)movesData.size(); i++) {
+        OneMoveAttempt( warehouse.Write(), movesData[i] );
+    }
+    return GetWarehouseScore( warehouse.Write());
+}
 
-//    std::cout << "initial state" << std::endl;
-//    PrintMapDataStream( mapData );
+// part 2 builds its own (enlarged) map from the snapshot
+int SolvePart2() {
+    const DataStream &inputData = *glbInputData;
+    glbMapX = (*glbMapData)[0].length();
+    glbMapY = glbMapData->size();
 
+    MovesType movesData;
+    ProcessMoveInput( inputData, movesData );
+    MapType mapData = EnlargeMap( *glbMapData );
+    ProcessMapInput( mapData );
     for (int i = 0; i < (int)movesData.size(); i++) {
-        OneMoveAttempt( mapData, movesData[i] );
-
-//        std::cout << "Move = " << Dir2String( movesData[i] ) << std::endl;
-//        PrintMapDataStream( mapData );
+        OneMoveAttempt2( mapData, movesData[i] );
     }
+    return GetWarehouseScore2( mapData );
+}
 
-    int nScore = GetWarehouseScore( mapData );
+}   // namespace day15
 
-    std::cout << std::endl << "Answer to part 1: sum of all boxes' GPS coordinates = " << nScore << std::endl << std::endl;
+// ==========   MAIN()
 
-/* ========== */   tmr.TimeReport( "    Timing 1 - solving puzzle part 1 : " );   // =========================^^^^^vvvvv
+#ifdef AOC24_DRIVER
 
-    inputData = part2Data; // get fresh untouched copy of input data
-    mapData   = part2Map;
+// in the aoc24 driver program this day registers its phase functions instead of having a main()
+AOC24_REGISTER_DAY( day15 );
 
-    // part 2 code here
-    EnlargeMap( mapData );
-    ProcessMapInput( mapData );
+#else
 
-//    std::cout << "initial state" << std::endl;
-//    PrintMapDataStream( mapData );
+using namespace day15;
 
-    for (int i = 0; i < (int)movesData.size(); i++) {
-        OneMoveAttempt2( mapData, movesData[i] );
+int main( int argc, char *argv[] )
+{
+    glbProgPhase = PUZZLE;     // program phase to EXAMPLE, TEST or PUZZLE
+    std::cout << "Phase: " << ProgPhase2string() << std::endl << std::endl;
+    flcBenchmark bench( argc, argv );   // use --warmup <n> and --repeat <n> to get timing statistics
+    bench.SetContext( DAY_STRING, ProgPhase2string());
 
-//        std::cout << "Move = " << Dir2String( movesData[i] ) << std::endl;
-//        PrintMapDataStream( mapData );
-    }
+/* ========== */   bench.RunPhase( "input data preparation", PrepareInput );   // =====================vvvvv
+
+    int nMoveAttempts = 0;
+    for (auto &e : *glbInputData) { nMoveAttempts += e.length(); }
+    std::cout << "Data stats - size of map: (" << glbMapX << " x " << glbMapY << ") - size of data stream " << nMoveAttempts << std::endl << std::endl;
 
-    int nScore2 = GetWarehouseScore2( mapData );
+/* ========== */   bench.TimeReport( "    Timing 0 - input data preparation: " );   // =========================^^^^^vvvvv
+
+    // part 1 code here
+
+    int nScore;
+    bench.RunPhase( "solving puzzle part 1", [&]() { nScore = SolvePart1(); } );
+    bench.SetAnswer( nScore );
+
+    std::cout << std::endl << "Answer to part 1: sum of all boxes' GPS coordinates = " << nScore << std::endl << std::endl;
+
+/* ========== */   bench.TimeReport( "    Timing 1 - solving puzzle part 1 : " );   // =========================^^^^^vvvvv
+
+    // part 2 code here
+
+    int nScore2;
+    bench.RunPhase( "solving puzzle part 2", [&]() { nScore2 = SolvePart2(); } );
+    bench.SetAnswer( nScore2 );
 
     std::cout << std::endl << "Answer to part 2: sum of all boxes' GPS coordinates = " << nScore2 << std::endl << std::endl;
 
-/* ========== */   tmr.TimeReport( "    Timing 2 - solving puzzle part 2 : " );   // ==============================^^^^^
+/* ========== */   bench.TimeReport( "    Timing 2 - solving puzzle part 2 : " );   // ==============================^^^^^
+
+    if (bench.GetRepeat() > 1) {
+        bench.SummaryReport();
+    }
 
     return 0;
 }
+
+#endif // AOC24_DRIVER
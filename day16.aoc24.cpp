@@ -15,9 +15,20 @@
 #include <set>
 
 #include "../flcTimer.h"
+#include "../flcBenchmark.h"
+#include "../flcInputFile.h"
+#include "../aoc24_registry.h"
+#include "../flcSnapshot.h"
+#include "../flcArtifactCache.h"
+#include "../flcCoord.h"
+#include "../flcProfiler.h"
+#include "../flcGrid.h"
+#include "../flcPathFind.h"
 #include "../parse_functions.h"
 #include "my_utility.h"
 
+namespace day16 {
+
 // ==========   PROGRAM PHASING
 
 enum eProgPhase {     // what programming phase are you in - set at start of main()
@@ -132,17 +143,15 @@ void GetData_EXAMPLE( DataStream &dData ) {
 // file input - this function reads text file content one line at a time - adapt code to match your need for line parsing!
 void ReadInputData( const std::string sFileName, DataStream &vData ) {
 
-    std::ifstream dataFileStream( sFileName );
+    flcInputFile dataFile( sFileName );
     vData.clear();
-    std::string sLine;
-    while (getline( dataFileStream, sLine )) {
-        vData.push_back( sLine );
+    for (std::string_view sLine : dataFile.Lines()) {
+        vData.emplace_back( sLine );
     }
-    dataFileStream.close();
 }
 
-void GetData_TEST(   DataStream &dData ) { std::string sInputFile = DAY_STRING; sInputFile.append( ".input.test.txt"   ); ReadInputData( sInputFile, dData ); }
-void GetData_PUZZLE( DataStream &dData ) { std::string sInputFile = DAY_STRING; sInputFile.append( ".input.puzzle.txt" ); ReadInputData( sInputFile, dData ); }
+void GetData_TEST(   DataStream &dData ) { std::string sInputFile = GetInputFileName( DAY_STRING, "test"   ); ReadInputData( sInputFile, dData ); }
+void GetData_PUZZLE( DataStream &dData ) { std::string sInputFile = GetInputFileName( DAY_STRING, "puzzle" ); ReadInputData( sInputFile, dData ); }
 
 // ==========   CONSOLE OUTPUT FUNCTIONS
 
@@ -180,6 +189,116 @@ void GetInput( DataStream &dData, bool bDisplay = false ) {
 
 // ==========   PUZZLE SPECIFIC SOLUTIONS
 
+// The reindeer's state is its location plus the direction it faces, so each map cell gives 4 path
+// finding states: (y * glbMapX + x) * 4 + dir (see flcPathFind.h). There's no explicit graph - the
+// neighbour states are generated on the fly: stepping forward costs 1 point, turning 90 degrees
+// clockwise or counterclockwise costs 1000 points.
+#define STEP_WEIGHT    1
+#define TURN_WEIGHT 1000
+
+int GetState( LocType &pos, int dir ) { return (pos.y * glbMapX + pos.x) * 4 + dir; }
+LocType StatePos( int nState ) { return { (nState / 4) % glbMapX, (nState / 4) / glbMapX }; }
+int StateDir( int nState ) { return nState % 4; }
+
+// sets the map dimensions and gets the start and end locations from the input data map
+void InitMap( const DataStream &iData, LocType &strtPos, LocType &stopPos ) {
+    glbMapY = (int)iData.size();
+    glbMapX = (int)iData[0].length();
+    for (int y = 0; y < glbMapY; y++) {
+        for (int x = 0; x < glbMapX; x++) {
+            if (iData[y][x] == 'S') { strtPos = { x, y }; }
+            if (iData[y][x] == 'E') { stopPos = { x, y }; }
+        }
+    }
+}
+
+// get cardinal direction stepping from location fm to location to
+int GetDirection( LocType &fm, LocType &to ) {
+    int nResult = NO;
+    if (fm.x == to.x) {       // no horizontal movement
+        if (fm.y == to.y) {
+            nResult = NO;     // stand still (should not occur)
+        } else if (fm.y < to.y) {
+            nResult = DN;     // step down
+        } else {
+            nResult = UP;     // step up
+        }
+    } else if (fm.x < to.x) { // step to right
+        if (fm.y == to.y) {
+            nResult = RT;
+        } else {
+            nResult = NO;     // diagonal movement (should not occur)
+        }
+    } else {                  // step to left
+        if (fm.y == to.y) {
+            nResult = LT;
+        } else {
+            nResult = NO;     // diagonal movement (should not occur)
+        }
+    }
+    return nResult;
+}
+
+// Shortest paths from the start location (facing east) to all states. The weights are small integers,
+// so Dial's bucket queue variant of Dijkstra's algorithm is used. All shortest path predecessors are
+// kept, part 2 needs them
+flcPathResult AnalyseShortestPaths( const DataStream &iData, LocType &strtPos ) {
+    FLC_PROFILE_SCOPE( "AnalyseShortestPaths" );
+
+    auto fNeighbours = [&]( int nCur, auto &&visit ) {
+        LocType curPos = StatePos( nCur );
+        int dir = StateDir( nCur );
+        visit( GetState( curPos, (dir + 3) % 4 ), TURN_WEIGHT );
+        visit( GetState( curPos, (dir + 1) % 4 ), TURN_WEIGHT );
+        LocType nghbPos = { curPos.x + glbDirX4[dir], curPos.y + glbDirY4[dir] };
+        if (nghbPos.WithinBounds( { 0, 0 }, { glbMapX, glbMapY } ) && iData[nghbPos.y][nghbPos.x] != '#') {
+            visit( GetState( nghbPos, dir ), STEP_WEIGHT );
+        }
+    };
+    flcPathOptions options;
+    options.bAllPreds = true;
+    return PathDial( glbMapX * glbMapY * 4, { GetState( strtPos, RT ) }, fNeighbours, TURN_WEIGHT, options );
+}
+
+// the reindeer can arrive at the end location facing any direction. Returns the end states that have
+// the lowest score
+std::vector<int> GetBestStopStates( const flcPathResult &result, LocType &stopPos ) {
+    int nMinValue = PATH_INFINITY;
+    std::vector<int> vBest;
+    for (int d = UP; d <= LT; d++) {
+        int nState = GetState( stopPos, d );
+        if (result.Dist( nState ) < nMinValue) {
+            nMinValue = result.Dist( nState );
+            vBest.clear();
+        }
+        if (result.Dist( nState ) == nMinValue) {
+            vBest.push_back( nState );
+        }
+    }
+    return vBest;
+}
+
+// ----- PART 2
+
+// for part 2 - all states on any shortest path are found by backtracking the predecessor sets from the
+// best end states (see flcPathResult::OnShortestPaths()). Collect their map locations in resultSet.
+void CollectShortestPathLocations( const flcPathResult &result, std::vector<int> &vStopStates, flcCoordSet &resultSet ) {
+    std::vector<char> vOnPath = result.OnShortestPaths( vStopStates );
+    for (int nState = 0; nState < (int)vOnPath.size(); nState++) {
+        if (vOnPath[nState]) {
+            LocType curPos = StatePos( nState );
+            resultSet.Insert( curPos.x, curPos.y );
+        }
+    }
+}
+
+// ----- REFERENCE VERSION
+
+// the first version of part 1, kept as the oracle for --verify: an explicit graph with 4 nodes per map
+// cell, and Dijkstra's algorithm on a queue that is sorted on distance before each step. It shares no
+// code with the path finding above - not the state encoding, not the neighbour generation and not the
+// predecessor bookkeeping - so a bug in any of those shows up as a mismatch
+
 #define MY_INFINITY 100000000   // got overflow problems using INT_MAX...
 
 struct sGraphNodeStruct;     // forward declare, since edges need a pointer to graph node
@@ -203,51 +322,6 @@ typedef struct sGraphNodeStruct {
 } GraphNodeType;
 typedef std::vector<GraphNodeType> GraphType;
 
-void PrintNodeSummary( GraphNodeType *pNode, std::string sInsert ) {
-    if (pNode == nullptr) {
-        std::cout << "NULL";
-    } else {
-        std::cout << sInsert
-                  << "ID = " << pNode->nNodeID << ", @: " << pNode->pos.to_string() << "-" << Dir2String( pNode->dir )
-                  << ", distance: " << (pNode->nDistance == MY_INFINITY ? "INF" : std::to_string( pNode->nDistance ));
-    }
-}
-
-void PrintGraphNode( GraphNodeType &node, std::string sInsert, bool bEndLine = true ) {
-    std::cout << sInsert << "------------" << std::endl;
-
-    PrintNodeSummary( &node, sInsert );
-
-    std::cout << std::endl << sInsert << "# nghbrs: " << node.vNghbrs.size() << " [ ";
-    for (int i = 0; i < (int)node.vNghbrs.size(); i++) {
-        PrintNodeSummary( node.vNghbrs[i].pLink, "" );
-        std::cout << "-weight=" << node.vNghbrs[i].nWeight;
-        std::cout << ", ";
-    }
-    std::cout << "]" << std::endl << sInsert << "# parnts: " << node.vParents.size() << " [ ";
-    for (int i = 0; i < (int)node.vParents.size(); i++) {
-        PrintNodeSummary( node.vParents[i].pLink, "" );
-        std::cout << "-weight=" << node.vParents[i].nWeight;
-        std::cout << ", ";
-    }
-    std::cout << std::endl << sInsert << "------------" << std::endl;
-
-    if (bEndLine) {
-        std::cout << std::endl;
-    }
-}
-
-void PrintGraphNode( GraphNodeType *pNode, std::string sInsert, bool bEndLine = true ) {
-    if (pNode == nullptr) {
-        std::cout << sInsert << "NULL";
-        if (bEndLine) {
-            std::cout << std::endl;
-        }
-    } else {
-        PrintGraphNode( *pNode, sInsert, bEndLine );
-    }
-}
-
 // returns the node index of the node identified by the (unique) combination of nodePos and nodeDir
 int FindNodeIndex( GraphType &g, LocType &nodePos, int nodeDir ) {
     int nFoundIx = -1;
@@ -261,7 +335,7 @@ int FindNodeIndex( GraphType &g, LocType &nodePos, int nodeDir ) {
 
 // ppStrtNode is a pointer to a pointer, to enable changing the pointer from within the function
 // for the stop node a location is returned, not a pointer
-void CreateGraphFromInputData( DataStream &iData, GraphType &g, GraphNodeType **ppStrtNode, LocType &stopNodePos ) {
+void CreateGraphFromInputData( const DataStream &iData, GraphType &g, GraphNodeType **ppStrtNode, LocType &stopNodePos ) {
 
     // clear result parameters
     *ppStrtNode = nullptr;
@@ -343,33 +417,6 @@ void CreateGraphFromInputData( DataStream &iData, GraphType &g, GraphNodeType **
     stopNodePos = stopPos;
 }
 
-// get cardinal direction stepping from location fm to location to
-int GetDirection( LocType &fm, LocType &to ) {
-    int nResult = NO;
-    if (fm.x == to.x) {       // no horizontal movement
-        if (fm.y == to.y) {
-            nResult = NO;     // stand still (should not occur)
-        } else if (fm.y < to.y) {
-            nResult = DN;     // step down
-        } else {
-            nResult = UP;     // step up
-        }
-    } else if (fm.x < to.x) { // step to right
-        if (fm.y == to.y) {
-            nResult = RT;
-        } else {
-            nResult = NO;     // diagonal movement (should not occur)
-        }
-    } else {                  // step to left
-        if (fm.y == to.y) {
-            nResult = LT;
-        } else {
-            nResult = NO;     // diagonal movement (should not occur)
-        }
-    }
-    return nResult;
-}
-
 // used by Dijkstra's algorithm:
 // if the newly calculated distance value to pNghbNode trhough pCurNode is less then or equal to the old distance value of pNghbNode,
 // replace it (or add it as an alternative short path)
@@ -443,12 +490,12 @@ void AnalyseShortestPath1( GraphType &g, GraphNodeType *pStrt, LocType &stopPos
 }
 
 // a path is just a sequence of pointers to graph nodes
-typedef std::deque<GraphNodeType *> PathType;
+typedef std::deque<GraphNodeType *> GraphPathType;
 
 
 // extracts a shortest path from the graph after it was processed with Dijkstra's
-PathType ExtractPath1( GraphType &g, GraphNodeType *pStrt, LocType &stopNodePos ) {
-    PathType dResult;
+GraphPathType ExtractPath1( GraphType &g, GraphNodeType *pStrt, LocType &stopNodePos ) {
+    GraphPathType dResult;
 
     // We know the end node location, but not which of the four associated graph nodes actually is
     // the end node for the path. Find that first by looking at the smallest distance value
@@ -480,55 +527,8 @@ PathType ExtractPath1( GraphType &g, GraphNodeType *pStrt, LocType &stopNodePos
     return dResult;
 }
 
-// outputs the graph info as text data
-void PrintDataGraph1( GraphType &g ) {
-    for (int i = 0; i < (int)g.size(); i++) {
-        std::cout << "Index: " << i << ": ";
-        PrintGraphNode( &(g[i]), "" );
-    }
-}
-
-// outputs the graph info in a visual way. The path p is output along the direction / orientation of the nodes
-// that are in p
-void PrintVisualGraph1( GraphType &g, GraphNodeType *pStrt, LocType &posStop, PathType &p ) {
-    // create a printable map and init it with all blocks
-    DataStream printMap;
-    for (int y = 0; y < glbMapY; y++) {
-        std::string sRow;
-        for (int x = 0; x < glbMapX; x++) {
-            sRow.append( "#" );
-        }
-        printMap.push_back( sRow );
-    }
-    // put empty cells in it
-    for (int i = 0; i < (int)g.size(); i++) {
-        GraphNodeType curNode = g[i];
-        LocType curLoc = curNode.pos;
-        printMap[curLoc.y][curLoc.x] = '.';
-    }
-    // put path steps in it
-    for (int i = 0; i < (int)p.size(); i++) {
-        LocType &curLoc = p[i]->pos;
-        char cFill = 'O';
-        switch (p[i]->dir) {
-            case UP: cFill = '^'; break;
-            case RT: cFill = '>'; break;
-            case DN: cFill = 'v'; break;
-            case LT: cFill = '<'; break;
-        }
-        printMap[curLoc.y][curLoc.x] = cFill;
-    }
-    // put start and end positions in it
-    LocType strtLoc = pStrt->pos;
-    LocType stopLoc = posStop;
-    printMap[strtLoc.y][strtLoc.x] = 'S';
-    printMap[stopLoc.y][stopLoc.x] = 'E';
-    // output it to screen
-    PrintDataStream( printMap );
-}
-
 // for part 1, get the path score by accumulating the weights along the way of the path
-int GetPathScore( PathType &p ) {
+int GetPathScore( GraphPathType &p ) {
     int nResult = 0;
     for (int i = 0; i < (int)p.size(); i++) {
         // must be solved more sophisticated than this
@@ -539,144 +539,133 @@ int GetPathScore( PathType &p ) {
     return nResult;
 }
 
-// ----- PART 2
+// ==========   PHASE FUNCTIONS
 
-// for part 2 - back trace the graph, starting at the end node (pStop) and continuing until the start node
-// (pStrt). Collect all path positions in a std::set along the way. Use a recursive approach that can also be
-// used to deal with multiple shortest paths
-std::set<LocType> BacktrackShortestPaths( GraphType &g, GraphNodeType *pStop, GraphNodeType *pStrt ) {
-    std::set<LocType> resultSet;
-    if (pStop != nullptr) {
-        resultSet.insert( pStop->pos );
-        if (pStop != pStrt) {
-
-            // if there's only one parent available ...
-            if (pStop->vParents.size() == 1) {
-                // ... just follow the one parent that is available
-                std::set<LocType> tmpSet = BacktrackShortestPaths( g, pStop->vParents[0].pLink, pStrt );
-                // add the result to the resultSet
-                for (auto e : tmpSet) {
-                    resultSet.insert( e );
-                }
-            } else if (pStop->vParents.size() > 1) {
-                // If multiple parents exist, first select which ones have the same (shortest) path length.
-                // Each parent node is on one of the shortest paths if the distance of that parent node plus the weight
-                // to that parent node equals the distance of the current node!
-                std::vector<GraphNodeType *> vCandidates;
-                int nCurDistance = pStop->nDistance;
-                for (int i = 0; i < (int)pStop->vParents.size(); i++) {
-                    int nParentDistance = pStop->vParents[i].pLink->nDistance;
-                    int nParentWeight   = pStop->vParents[i].nWeight;
-                    if (nParentDistance + nParentWeight == nCurDistance) {
-                        vCandidates.push_back( pStop->vParents[i].pLink );
-                    }
-                }
-                // having filtered the candidates, process them
-                for (int i = 0; i < (int)vCandidates.size(); i++) {
-                    std::set<LocType> tmpSet = BacktrackShortestPaths( g, vCandidates[i], pStrt );
-                    // add the result to the resultSet
-                    for (auto e : tmpSet) {
-                        resultSet.insert( e );
-                    }
-                }
-            }
-        }
-    }
-    return resultSet;
+flcSnapshot<DataStream> glbInputData;   // parsed input data - the parts view it read only
+uint64_t glbInputHash;                  // the key of the artifacts of this input
+
+LocType glbSrcPos, glbDstPos;
+
+// phase 0 - get input data, depending on the glbProgPhase (example, test, puzzle)
+void PrepareInput() {
+    DataStream inputData;
+    GetInput( inputData, glbProgPhase != PUZZLE );
+    glbInputHash = flcArtifactCache::HashLines( inputData );
+    glbInputData = MakeSnapshot( std::move( inputData ));
 }
 
-// outputs the graph info in a visual way. The set of locations locs is plotted into the image
-void PrintVisualGraph2( GraphType &g, std::set<LocType> &locs ) {
-    // create a printable map and init it with all blocks
-    DataStream printMap;
-    for (int y = 0; y < glbMapY; y++) {
-        std::string sRow;
-        for (int x = 0; x < glbMapX; x++) {
-            sRow.append( "#" );
-        }
-        printMap.push_back( sRow );
-    }
-    // put empty cells in it
-    for (int i = 0; i < (int)g.size(); i++) {
-        GraphNodeType curNode = g[i];
-        LocType curLoc = curNode.pos;
-        printMap[curLoc.y][curLoc.x] = '.';
+std::vector<int> glbPart1Dist;   // distance per state of the last part 1 run - for the --verify artifact
+
+int SolvePart1() {
+    const DataStream &inputData = *glbInputData;
+    InitMap( inputData, glbSrcPos, glbDstPos );
+    // do the shortest path finding, and get the score of the best way to the end location. The paths are
+    // shared with part 2 as artifact "day16.paths" - part 2 uses them read only for backtracking
+    std::shared_ptr<const flcPathResult> pPaths = flcArtifactCache::Instance().Produce<flcPathResult>( glbInputHash, "day16.paths",
+        [&]() { return AnalyseShortestPaths( inputData, glbSrcPos ); }
+    );
+    glbPart1Dist.assign( glbMapX * glbMapY * 4, PATH_INFINITY );
+    for (int i = 0; i < (int)glbPart1Dist.size(); i++) {
+        glbPart1Dist[i] = pPaths->Dist( i );
+    }
+    std::vector<int> vStopStates = GetBestStopStates( *pPaths, glbDstPos );
+    return pPaths->Dist( vStopStates[0] );
+}
+
+// the reference version - the distances of its graph nodes are put in the states of the other version
+int SolvePart1_reference() {
+    const DataStream &inputData = *glbInputData;
+    GraphType graph;
+    GraphNodeType *pStrtNode = nullptr;
+    LocType stopPos;
+    CreateGraphFromInputData( inputData, graph, &pStrtNode, stopPos );
+    AnalyseShortestPath1( graph, pStrtNode, stopPos );
+    GraphPathType path = ExtractPath1( graph, pStrtNode, stopPos );
+
+    glbPart1Dist.assign( glbMapX * glbMapY * 4, PATH_INFINITY );
+    for (auto &node : graph) {
+        glbPart1Dist[GetState( node.pos, node.dir )] = (node.nDistance >= MY_INFINITY) ? PATH_INFINITY : node.nDistance;
     }
-    // put path locations in it
-    for (auto e : locs) {
-        printMap[e.y][e.x] = 'o';
+    return GetPathScore( path );
+}
+
+// the distances of all states, as artifact for the --verify mode of the driver
+std::string Part1Artifact() {
+    std::string sResult;
+    for (int nDist : glbPart1Dist) {
+        sResult.append( std::to_string( nDist ) + " " );
     }
-    // output it to screen
-    PrintDataStream( printMap );
+    return sResult;
 }
 
+// the shortest paths come from part 1 - they are only analysed here if part 2 runs on its own
+int SolvePart2() {
+    const DataStream &inputData = *glbInputData;
+    InitMap( inputData, glbSrcPos, glbDstPos );
+    std::shared_ptr<const flcPathResult> pPaths = flcArtifactCache::Instance().Consume<flcPathResult>( glbInputHash, "day16.paths",
+        [&]() { return AnalyseShortestPaths( inputData, glbSrcPos ); }
+    );
+    // first find which of the states of the destination map cell are the right ones to start backtracking
+    std::vector<int> vStopStates = GetBestStopStates( *pPaths, glbDstPos );
+    // start backtracking, collecting shortest path locations in pathPositions
+    flcCoordSet pathPositions( glbMapX, glbMapY );
+    CollectShortestPathLocations( *pPaths, vStopStates, pathPositions );
+    return pathPositions.size();
+}
+
+}   // namespace day16
+
 // ==========   MAIN()
 
-int main()
-{
-    glbProgPhase = TEST;     // program phase to EXAMPLE, TEST or PUZZLE
-    std::cout << "Phase: " << ProgPhase2string() << std::endl << std::endl;
-    flcTimer tmr;
+#ifdef AOC24_DRIVER
 
-/* ========== */   tmr.StartTiming();   // ============================================vvvvv
+// in the aoc24 driver program this day registers its phase functions instead of having a main()
+AOC24_REGISTER_DAY( day16 );
+AOC24_REGISTER_ENGINE( day16, 1, reference, SolvePart1_reference, Part1Artifact );
+AOC24_REGISTER_ENGINE( day16, 1, optimized, SolvePart1          , Part1Artifact );
 
-    // get input data, depending on the glbProgPhase (example, test, puzzle)
-    DataStream inputData;
-    GetInput( inputData, glbProgPhase != PUZZLE );
-    DataStream part2Data = inputData;
-    std::cout << "Data stats - size of data stream " << inputData.size() << std::endl << std::endl;
+#else
 
-/* ========== */   tmr.TimeReport( "    Timing 0 - input data preparation: " );   // =========================^^^^^vvvvv
+using namespace day16;
 
-    // part 1 code here
+int main( int argc, char *argv[] )
+{
+    glbProgPhase = TEST;     // program phase to EXAMPLE, TEST or PUZZLE
+    std::cout << "Phase: " << ProgPhase2string() << std::endl << std::endl;
+    flcBenchmark bench( argc, argv );   // use --warmup <n> and --repeat <n> to get timing statistics
+    bench.SetContext( DAY_STRING, ProgPhase2string());
 
-    // put input data into a workable data structure and get pointer to start node and location to end node
-    GraphType graph;
-    GraphNodeType *pSrc;
-    LocType posDst;
-    CreateGraphFromInputData( inputData, graph, &pSrc, posDst );
+/* ========== */   bench.RunPhase( "input data preparation", PrepareInput );   // =====================vvvvv
 
-    // call the function to do Dijkstra's shortest path finding
-    PathType dShortestPath;
+    std::cout << "Data stats - size of data stream " << glbInputData->size() << std::endl << std::endl;
 
-//    std::cout << "Graph after graph creation ..." << std::endl;
-//    PrintVisualGraph1( graph, pSrc, posDst, dShortestPath );
+/* ========== */   bench.TimeReport( "    Timing 0 - input data preparation: " );   // =========================^^^^^vvvvv
 
-    AnalyseShortestPath1( graph, pSrc, posDst );
-    // extract the shortest path from the graph
-    dShortestPath = ExtractPath1( graph, pSrc, posDst );
+    // part 1 code here
 
-//    std::cout << "Graph after shortest path analysis ..." << std::endl;
-//    PrintVisualGraph1( graph, pSrc, posDst, dShortestPath );
+    int nPathScore;
+    bench.RunPhase( "solving puzzle part 1", [&]() { nPathScore = SolvePart1(); } );
+    bench.SetAnswer( nPathScore );
 
-    std::cout << std::endl << "Answer to " << DAY_STRING << " part 1:  = " << GetPathScore( dShortestPath ) << std::endl << std::endl;
+    std::cout << std::endl << "Answer to " << DAY_STRING << " part 1:  = " << nPathScore << std::endl << std::endl;
 
-/* ========== */   tmr.TimeReport( "    Timing 1 - solving puzzle part 1 : " );   // =========================^^^^^vvvvv
+/* ========== */   bench.TimeReport( "    Timing 1 - solving puzzle part 1 : " );   // =========================^^^^^vvvvv
 
     // part 2 code here
 
-    // first find which of the subnodes of the destination map cell is the right one to start backtracking
-    int nMinValue = MY_INFINITY;
-    int nMinIndex = -1;
-    for (int d = UP; d <= LT; d++) {
-        int nDestIndex = FindNodeIndex( graph, posDst, d );
-        if (graph[nDestIndex].nDistance < nMinValue) {
-            nMinValue = graph[nDestIndex].nDistance;
-            nMinIndex = d;
-        }
-    }
-    int nBackTrackStartIx = FindNodeIndex( graph, posDst, nMinIndex );
-    GraphNodeType *pDst = &(graph[nBackTrackStartIx]);
-
-    // start backtracking, collecting shortest path locations in pathPositions
-    std::set<LocType> pathPositions = BacktrackShortestPaths( graph, pDst, pSrc );
+    int nPathPositions;
+    bench.RunPhase( "solving puzzle part 2", [&]() { nPathPositions = SolvePart2(); } );
+    bench.SetAnswer( nPathPositions );
 
-//    // print the result of the backtracking
-//    PrintVisualGraph2( graph, pathPositions );
+    std::cout << std::endl << "Answer to " << DAY_STRING << " part 2: = " << nPathPositions << std::endl << std::endl;
 
-    std::cout << std::endl << "Answer to " << DAY_STRING << " part 2: = " << pathPositions.size() << std::endl << std::endl;
+/* ========== */   bench.TimeReport( "    Timing 2 - solving puzzle part 2 : " );   // ==============================^^^^^
 
-/* ========== */   tmr.TimeReport( "    Timing 2 - solving puzzle part 2 : " );   // ==============================^^^^^
+    if (bench.GetRepeat() > 1) {
+        bench.SummaryReport();
+    }
 
     return 0;
 }
+
+#endif // AOC24_DRIVER
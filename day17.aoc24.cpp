@@ -13,9 +13,16 @@
 #include <vector>
 
 #include "../flcTimer.h"
+#include "../flcBenchmark.h"
+#include "../flcInputFile.h"
+#include "../aoc24_registry.h"
+#include "../flcSnapshot.h"
 #include "../parse_functions.h"
+#include "../parse_numbers.h"
 #include "my_utility.h"
 
+namespace day17 {
+
 // ==========   PROGRAM PHASING
 
 enum eProgPhase {     // what programming phase are you in - set at start of main()
@@ -75,36 +82,31 @@ void GetData_EXAMPLE( DataStream &dData ) {
 // file input - this function reads text file content one line at a time - adapt code to match your need for line parsing!
 void ReadInputData( const std::string sFileName, DataStream &vData ) {
 
-    std::ifstream dataFileStream( sFileName );
+    flcInputFile dataFile( sFileName );
     vData.clear();
-    std::string sLine, sIgnore;
+    std::string_view sLine, sIgnore;
 
     // get register data, three similar lines followed by an empty line
-    getline( dataFileStream, sLine );
+    dataFile.NextLine( sLine );
     sIgnore = get_token_dlmtd( "Register A: ", sLine );
-    regA = stoi( sLine );
-    getline( dataFileStream, sLine );
+    regA = to_ll( sLine );
+    dataFile.NextLine( sLine );
     sIgnore = get_token_dlmtd( "Register B: ", sLine );
-    regB = stoi( sLine );
-    getline( dataFileStream, sLine );
+    regB = to_ll( sLine );
+    dataFile.NextLine( sLine );
     sIgnore = get_token_dlmtd( "Register C: ", sLine );
-    regC = stoi( sLine );
+    regC = to_ll( sLine );
 
-    getline( dataFileStream, sLine );   // parse/remove empty line between register block and program data
+    dataFile.NextLine( sLine );   // parse/remove empty line between register block and program data
 
     // get program data, all numbers are in one line, separated by commas
-    getline( dataFileStream, sLine );
+    dataFile.NextLine( sLine );
     sIgnore = get_token_dlmtd( "Program: ", sLine );
-    while (sLine.length() > 0) {
-        std::string sNr = get_token_dlmtd( ",", sLine );
-        vData.push_back( stoi( sNr ));
-    }
-
-    dataFileStream.close();
+    parse_list( sLine, ',', vData );
 }
 
-void GetData_TEST(   DataStream &dData ) { std::string sInputFile = DAY_STRING; sInputFile.append( ".input.test.txt"   ); ReadInputData( sInputFile, dData ); }
-void GetData_PUZZLE( DataStream &dData ) { std::string sInputFile = DAY_STRING; sInputFile.append( ".input.puzzle.txt" ); ReadInputData( sInputFile, dData ); }
+void GetData_TEST(   DataStream &dData ) { std::string sInputFile = GetInputFileName( DAY_STRING, "test"   ); ReadInputData( sInputFile, dData ); }
+void GetData_PUZZLE( DataStream &dData ) { std::string sInputFile = GetInputFileName( DAY_STRING, "puzzle" ); ReadInputData( sInputFile, dData ); }
 
 // ==========   CONSOLE OUTPUT FUNCTIONS
 
@@ -209,7 +211,7 @@ void cdv( long long operand ) {
 // executes one instruction from progData, as indexed by glb var PC
 // if any output is done, it will be put in vOutput
 // returns true if not halted, false if halted
-bool OneInstruction( DataStream &progData, std::vector<long long> &vOutput ) {
+bool OneInstruction( const DataStream &progData, std::vector<long long> &vOutput ) {
     bool bNotHalted = true;
     if (PC >= (int)progData.size()) {
         bNotHalted = false;
@@ -231,7 +233,7 @@ bool OneInstruction( DataStream &progData, std::vector<long long> &vOutput ) {
     return bNotHalted;
 }
 
-std::vector<long long> RunProgram( DataStream &progData, long long strtA ) {
+std::vector<long long> RunProgram( const DataStream &progData, long long strtA ) {
 
     // reset status variables
     regA = strtA;
@@ -251,7 +253,7 @@ std::vector<long long> RunProgram( DataStream &progData, long long strtA ) {
 
 // checks on equality of progData and vOutput "at the back": vOutput is assumed to be less than or equal in size
 // than progData, so the last element of vOutput is compared with the last element of progData etc.
-bool IsSimilar( DataStream &progData, std::vector<long long> &vOutput, int nDigitsToProcess ) {
+bool IsSimilar( const DataStream &progData, std::vector<long long> &vOutput, int nDigitsToProcess ) {
 
     int nSizeDifference = progData.size() - vOutput.size();
     // needed this additional check to squash a nasty bug
@@ -265,7 +267,7 @@ bool IsSimilar( DataStream &progData, std::vector<long long> &vOutput, int nDigi
 
 // takes llCurA as initial A value, and looks for extension of llCurA such that the running of progData
 // on llCurA produces output that is identical to progData
-long long ExtractProgram( DataStream &progData, long long llCurA, int nDigitsToProcess ) {
+long long ExtractProgram( const DataStream &progData, long long llCurA, int nDigitsToProcess ) {
 
     long long llResult = -1;  // signals no match
     // attempt to expad current A value and check if running the program on it produces similar output
@@ -290,27 +292,22 @@ long long ExtractProgram( DataStream &progData, long long llCurA, int nDigitsToP
     return llResult;
 }
 
-// ==========   MAIN()
-
-int main()
-{
-    glbProgPhase = PUZZLE;     // program phase to EXAMPLE, TEST or PUZZLE
-    std::cout << "Phase: " << ProgPhase2string() << std::endl << std::endl;
-    flcTimer tmr;
+// ==========   PHASE FUNCTIONS
 
-/* ========== */   tmr.StartTiming();   // ============================================vvvvv
+flcSnapshot<DataStream> glbInputData;   // parsed input data - the parts view it read only
+long long  glbStrtA;       // initial value of register A from the input - regA itself is changed by running the program
 
-    // get input data, depending on the glbProgPhase (example, test, puzzle)
+// phase 0 - get input data, depending on the glbProgPhase (example, test, puzzle)
+void PrepareInput() {
     DataStream inputData;
     GetInput( inputData, glbProgPhase != PUZZLE );
-    DataStream part2Data = inputData;
-    std::cout << "Data stats - size of data stream " << inputData.size() << std::endl << std::endl;
-
-/* ========== */   tmr.TimeReport( "    Timing 0 - input data preparation: " );   // =========================^^^^^vvvvv
-
-    // part 1 code here
-    std::vector<long long> glbOutput = RunProgram( inputData, regA );
+    glbInputData = MakeSnapshot( std::move( inputData ));
+    glbStrtA = regA;
+}
 
+std::string SolvePart1() {
+    const DataStream &inputData = *glbInputData;
+    std::vector<long long> glbOutput = RunProgram( inputData, glbStrtA );
     std::string sAnswer1;
     for (int i = 0; i < (int)glbOutput.size(); i++) {
         sAnswer1.append( std::to_string( glbOutput[i] ));
@@ -318,19 +315,65 @@ int main()
             sAnswer1.append( "," );
         }
     }
+    return sAnswer1;
+}
 
-    std::cout << std::endl << "Answer to part 1:  = " << sAnswer1 << std::endl << std::endl;
+long long SolvePart2() {
+    const DataStream &inputData = *glbInputData;
+    return ExtractProgram( inputData, 0, (int)inputData.size() - 1 );
+}
+
+}   // namespace day17
+
+// ==========   MAIN()
+
+#ifdef AOC24_DRIVER
 
-/* ========== */   tmr.TimeReport( "    Timing 1 - solving puzzle part 1 : " );   // =========================^^^^^vvvvv
+// in the aoc24 driver program this day registers its phase functions instead of having a main()
+AOC24_REGISTER_DAY( day17 );
 
-    inputData = part2Data; // get fresh untouched copy of input data
+#else
+
+using namespace day17;
+
+int main( int argc, char *argv[] )
+{
+    glbProgPhase = PUZZLE;     // program phase to EXAMPLE, TEST or PUZZLE
+    std::cout << "Phase: " << ProgPhase2string() << std::endl << std::endl;
+    flcBenchmark bench( argc, argv );   // use --warmup <n> and --repeat <n> to get timing statistics
+    bench.SetContext( DAY_STRING, ProgPhase2string());
+
+/* ========== */   bench.RunPhase( "input data preparation", PrepareInput );   // =====================vvvvv
+
+    std::cout << "Data stats - size of data stream " << glbInputData->size() << std::endl << std::endl;
+
+/* ========== */   bench.TimeReport( "    Timing 0 - input data preparation: " );   // =========================^^^^^vvvvv
+
+    // part 1 code here
+
+    std::string sAnswer1;
+    bench.RunPhase( "solving puzzle part 1", [&]() { sAnswer1 = SolvePart1(); } );
+    bench.SetAnswer( sAnswer1 );
+
+    std::cout << std::endl << "Answer to part 1:  = " << sAnswer1 << std::endl << std::endl;
+
+/* ========== */   bench.TimeReport( "    Timing 1 - solving puzzle part 1 : " );   // =========================^^^^^vvvvv
 
     // part 2 code here
-    long long resultA = ExtractProgram( inputData, 0, (int)inputData.size() - 1 );
+
+    long long resultA;
+    bench.RunPhase( "solving puzzle part 2", [&]() { resultA = SolvePart2(); } );
+    bench.SetAnswer( resultA );
 
     std::cout << std::endl << "Answer to part 2: = " << resultA << std::endl << std::endl;
 
-/* ========== */   tmr.TimeReport( "    Timing 2 - solving puzzle part 2 : " );   // ==============================^^^^^
+/* ========== */   bench.TimeReport( "    Timing 2 - solving puzzle part 2 : " );   // ==============================^^^^^
+
+    if (bench.GetRepeat() > 1) {
+        bench.SummaryReport();
+    }
 
     return 0;
 }
+
+#endif // AOC24_DRIVER
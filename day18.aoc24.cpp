@@ -11,15 +11,22 @@
 #include <algorithm>
 #include <numeric>
 #include <vector>
-#include <deque>
-#include <list>
-#include <cfloat>
-#include <cmath>
 
 #include "../flcTimer.h"
+#include "../flcBenchmark.h"
+#include "../flcInputFile.h"
+#include "../aoc24_registry.h"
+#include "../flcSnapshot.h"
+#include "../flcProfiler.h"
+#include "../flcBitGrid.h"
+#include "../flcGrid.h"
+#include "../flcPathFind.h"
 #include "../parse_functions.h"
+#include "../parse_numbers.h"
 #include "my_utility.h"
 
+namespace day18 {
+
 // ==========   PROGRAM PHASING
 
 enum eProgPhase {     // what programming phase are you in - set at start of main()
@@ -44,7 +51,7 @@ typedef struct sLocStruct {
     int x, y;
 
     // convenience function
-    std::string to_string() {
+    std::string to_string() const {
         std::string sResult = "(" + std::to_string( x ) + ", " + std::to_string( y ) + ")";
         return sResult;
     }
@@ -110,20 +117,18 @@ void GetData_EXAMPLE( DataStream &dData ) {
 // file input - this function reads text file content one line at a time - adapt code to match your need for line parsing!
 void ReadInputData( const std::string sFileName, DataStream &vData ) {
 
-    std::ifstream dataFileStream( sFileName );
+    flcInputFile dataFile( sFileName );
     vData.clear();
-    std::string sLine;
-    while (getline( dataFileStream, sLine )) {
-        std::string sLeft, sRght;
+    for (std::string_view sLine : dataFile.Lines()) {
+        std::string_view sLeft, sRght;
         split_token_dlmtd( ",", sLine, sLeft, sRght );
-        DatumType cDatum = { stoi( sLeft ), stoi( sRght ) };
+        DatumType cDatum = { to_int( sLeft ), to_int( sRght ) };
         vData.push_back( cDatum );
     }
-    dataFileStream.close();
 }
 
-void GetData_TEST(   DataStream &dData ) { std::string sInputFile = DAY_STRING; sInputFile.append( ".input.test.txt"   ); ReadInputData( sInputFile, dData ); }
-void GetData_PUZZLE( DataStream &dData ) { std::string sInputFile = DAY_STRING; sInputFile.append( ".input.puzzle.txt" ); ReadInputData( sInputFile, dData ); }
+void GetData_TEST(   DataStream &dData ) { std::string sInputFile = GetInputFileName( DAY_STRING, "test"   ); ReadInputData( sInputFile, dData ); }
+void GetData_PUZZLE( DataStream &dData ) { std::string sInputFile = GetInputFileName( DAY_STRING, "puzzle" ); ReadInputData( sInputFile, dData ); }
 
 // ==========   CONSOLE OUTPUT FUNCTIONS
 
@@ -164,21 +169,12 @@ void GetInput( DataStream &dData, bool bDisplay = false ) {
 
 // ------------ PATH FINDING STUFF HERE ---------------
 
-typedef struct sNode {
-    bool bObstacle = false;			// Is the node an obstruction?
-    bool bVisited  = false;			// Have we searched this node before?
-    float fGlobalGoal;				// Distance to goal so far
-    float fLocalGoal;				// Distance to goal if we took the alternative route
-    LocType pos;					// Nodes position in 2D space
-    std::vector<sNode*> vecNeighbours;	// Connections to neighbours
-    sNode* parent;					// Node connecting to this node that offers shortest parent
-} NodeType;
-
-NodeType *nodes     = nullptr;      // a pointer to the space
-
-NodeType *nodeStart = nullptr;      // a pointer to start and end node in space
-NodeType *nodeEnd   = nullptr;
+// the memory space is a grid of glbSpaceW x glbSpaceH cells, holding '#' for corrupted and '.' for free
+// cells. The path finding states are the cell indices y * glbSpaceW + x (see flcPathFind.h)
+flcGrid<char> glbSpace;
 
+int StartState() { return 0; }
+int EndState()   { return (glbSpaceH - 1) * glbSpaceW + (glbSpaceW - 1); }
 
 void InitMap() {
     // set 2D space dimensions
@@ -187,135 +183,35 @@ void InitMap() {
     } else {
         glbSpaceW = 71; glbSpaceH = 71;
     }
-    // Create a 2D array of nodes - this is for convenience of rendering and construction
-    // and is not required for the algorithm to work - the nodes could be placed anywhere
-    // in any space, in multiple dimensions...
-    nodes = new NodeType[glbSpaceW * glbSpaceH];
-    for (int y = 0; y < glbSpaceH; y++) {
-        for (int x = 0; x < glbSpaceW; x++) {
-            nodes[y * glbSpaceW + x].pos = { x, y }; // ...because we give each node its own coordinates
-            nodes[y * glbSpaceW + x].bObstacle = false;
-            nodes[y * glbSpaceW + x].bVisited  = false;
-            nodes[y * glbSpaceW + x].parent = nullptr;
-        }
-    }
-
-    // Create connections - in this case nodes are on a regular grid
-    for (int y = 0; y < glbSpaceH; y++) {
-        for (int x = 0; x < glbSpaceW; x++) {
-            if(y > 0)
-                nodes[y * glbSpaceW + x].vecNeighbours.push_back(&nodes[(y - 1) * glbSpaceW + (x + 0)]);
-            if(y < glbSpaceH - 1)
-                nodes[y * glbSpaceW + x].vecNeighbours.push_back(&nodes[(y + 1) * glbSpaceW + (x + 0)]);
-            if (x > 0)
-                nodes[y * glbSpaceW + x].vecNeighbours.push_back(&nodes[(y + 0) * glbSpaceW + (x - 1)]);
-            if(x < glbSpaceW - 1)
-                nodes[y * glbSpaceW + x].vecNeighbours.push_back(&nodes[(y + 0) * glbSpaceW + (x + 1)]);
-        }
-    }
-
-    // Manually position the start and end markers so they are not nullptr
-    nodeStart = &nodes[             0  * glbSpaceW +              0 ];
-    nodeEnd   = &nodes[(glbSpaceH - 1) * glbSpaceW + (glbSpaceW - 1)];
+    glbSpace.Init( glbSpaceW, glbSpaceH, '.' );
 }
 
-// data structure to hold paths
-typedef std::deque<NodeType*> PathType;
+// data structure to hold paths - the sequence of states from start to end
+typedef std::vector<int> PathType;
 
+// A* from start to end, using the manhattan distance to the end as heuristic. Returns the shortest path,
+// or an empty path if the end can't be reached
+PathType Solve_AStar() {
+    FLC_PROFILE_SCOPE( "Solve_AStar" );
 
-bool Solve_AStar() {
-
-    // Reset Navigation Graph - default all node states
-    for (int y = 0; y < glbSpaceH; y++) {
-        for (int x = 0; x < glbSpaceW; x++) {
-            nodes[y * glbSpaceW + x].bVisited = false;
-            nodes[y * glbSpaceW + x].fGlobalGoal = FLT_MAX;  // INFINITY;
-            nodes[y * glbSpaceW + x].fLocalGoal  = FLT_MAX;  // INFINITY;
-            nodes[y * glbSpaceW + x].parent = nullptr;	// No parents
+    auto fNeighbours = []( int nCur, auto &&visit ) {
+        int x = nCur % glbSpaceW, y = nCur / glbSpaceW;
+        for (int dir = 0; dir < 4; dir++) {
+            int nx = x + glbDirX4[dir], ny = y + glbDirY4[dir];
+            if (glbSpace.InBounds( nx, ny ) && glbSpace( nx, ny ) != '#') {
+                visit( ny * glbSpaceW + nx, 1 );
+            }
         }
-    }
-
-    auto distance = [](NodeType *a, NodeType *b) { // For convenience
-        return sqrtf((a->pos.x - b->pos.x) * (a->pos.x - b->pos.x) + (a->pos.y - b->pos.y) * (a->pos.y - b->pos.y));
     };
-
-    auto heuristic = [distance](NodeType *a, NodeType *b) { // So we can experiment with heuristic
-        return distance(a, b);
+    auto fHeuristic = []( int nState ) {
+        return (glbSpaceW - 1 - nState % glbSpaceW) + (glbSpaceH - 1 - nState / glbSpaceW);
     };
-
-    // Setup starting conditions
-    NodeType *nodeCurrent = nodeStart;
-    nodeStart->fLocalGoal = 0.0f;
-    nodeStart->fGlobalGoal = heuristic(nodeStart, nodeEnd);
-
-    // Add start node to not tested list - this will ensure it gets tested.
-    // As the algorithm progresses, newly discovered nodes get added to this
-    // list, and will themselves be tested later
-    std::list<NodeType*> listNotTestedNodes;
-    listNotTestedNodes.push_back(nodeStart);
-
-    // if the not tested list contains nodes, there may be better paths
-    // which have not yet been explored. However, we will also stop
-    // searching when we reach the target - there may well be better
-    // paths but this one will do - it wont be the longest.
-
-//    while (!listNotTestedNodes.empty() && nodeCurrent != nodeEnd) { // Find absolutely shortest path // && nodeCurrent != nodeEnd)
-    while (!listNotTestedNodes.empty()) { // Find absolutely shortest path // && nodeCurrent != nodeEnd)
-        // if you stop stop searching when you reach the end, you'll just have a path, but not
-        // necessarily the shortest one. So out comment "&& nodeCurrent != nodeEnd" if you
-        // want to have the absolute shortest path
-
-        // Sort Untested nodes by global goal, so lowest is first
-        listNotTestedNodes.sort(
-            [](const NodeType * lhs, const NodeType * rhs) {
-                return lhs->fGlobalGoal < rhs->fGlobalGoal;
-            }
-        );
-
-        // Front of listNotTestedNodes is potentially the lowest distance node. Our
-        // list may also contain nodes that have been visited, so ditch these...
-        while(!listNotTestedNodes.empty() && listNotTestedNodes.front()->bVisited)
-            listNotTestedNodes.pop_front();
-
-        // ...or abort because there are no valid nodes left to test
-        if (!listNotTestedNodes.empty()) {
-
-            nodeCurrent = listNotTestedNodes.front();
-            nodeCurrent->bVisited = true; // We only explore a node once
-
-            // Check each of this node's neighbours...
-            for (auto nodeNeighbour : nodeCurrent->vecNeighbours) {
-                // ... and only if the neighbour is not visited and is
-                // not an obstacle, add it to NotTested List
-                if (!nodeNeighbour->bVisited && !nodeNeighbour->bObstacle)
-                    listNotTestedNodes.push_back(nodeNeighbour);
-
-                // Calculate the neighbours potential lowest parent distance
-                // the graph is not weighted so each step to a neighbour is just 1
-                float fPossiblyLowerGoal = nodeCurrent->fLocalGoal + 1;
-
-                // If choosing to path through this node is a lower distance than what
-                // the neighbour currently has set, update the neighbour to use this node
-                // as the path source, and set its distance scores as necessary
-                if (fPossiblyLowerGoal < nodeNeighbour->fLocalGoal) {
-                    nodeNeighbour->parent = nodeCurrent;
-                    nodeNeighbour->fLocalGoal = fPossiblyLowerGoal;
-
-                    // The best path length to the neighbour being tested has changed, so
-                    // update the neighbour's score. The heuristic is used to globally bias
-                    // the path algorithm, so it knows if its getting better or worse. At some
-                    // point the algo will realise this path is worse and abandon it, and then go
-                    // and search along the next best path.
-                    nodeNeighbour->fGlobalGoal = nodeNeighbour->fLocalGoal + heuristic(nodeNeighbour, nodeEnd);
-                }
-            }
-        }
-    }
-
-    return true;
+    flcPathOptions options;
+    options.nTarget = EndState();
+    flcPathResult result = PathAStar( glbSpaceW * glbSpaceH, { StartState() }, fNeighbours, fHeuristic, options );
+    return result.PathTo( EndState());
 }
 
-
 // ------------ END OF PATH FINDING STUFF ---------------
 
 // Create a visual image to put on screen.
@@ -327,17 +223,13 @@ void PrintVisualSpace( const std::string &sMsg, PathType &p ) {
     for (int y = 0; y < glbSpaceH; y++) {
         std::string sRow;
         for (int x = 0; x < glbSpaceW; x++) {
-            if (nodes[y * glbSpaceW + x].bObstacle) {
-                sRow.append( "#" );
-            } else {
-                sRow.append( "." );
-            }
+            sRow.push_back( glbSpace( x, y ));
         }
         sMap.push_back( sRow );
     }
     // add path nodes to it
     for (int i = 0; i < (int)p.size(); i++) {
-        sMap[p[i]->pos.y][p[i]->pos.x] = 'O';
+        sMap[p[i] / glbSpaceW][p[i] % glbSpaceW] = 'O';
     }
     // now output it
     for (int y = 0; y < (int)sMap.size(); y++) {
@@ -346,98 +238,140 @@ void PrintVisualSpace( const std::string &sMsg, PathType &p ) {
     std::cout << std::endl;
 }
 
-// After A* has run, get the shortest path from it. Note: if no path was found,
-// an empty PathType container will be returned
-PathType ExtractPath() {
-    PathType result;
-    NodeType *cachPtr = nullptr;
-    for (NodeType *ptr = nodeEnd; ptr != nullptr; ptr = ptr->parent) {
-        result.push_front( ptr );
-        cachPtr = ptr;
-    }
-    if (cachPtr != nodeStart) {
-        result.clear();
-    }
-    return result;
-}
-
 // ----- PART 2
 
-/* Didn't need additional code for part 2, just adapted ExtractPath() a little to cope with non complete paths
- * and applied the existing functions in a slightly different way.
+/* Part 2 originally ran A* again after each added byte. Whether the exit can be reached doesn't need a
+ * shortest path, only the set of reachable cells, and that is a bitboard flood fill. Since adding bytes
+ * can only block paths, a binary search over the nr of corrupted bytes finds the first blocking byte.
  */
 
-// ==========   MAIN()
+// returns true if the exit can still be reached from the start when the first nBytes from the input
+// stream are corrupted
+bool ExitReachable( const DataStream &inputData, int nBytes ) {
+    FLC_PROFILE_SCOPE( "ExitReachable" );
+    flcBitGrid freeCells( glbSpaceW, glbSpaceH );
+    freeCells.SetAll();
+    for (int i = 0; i < nBytes; i++) {
+        freeCells.Reset( inputData[i].x, inputData[i].y );
+    }
+    flcBitGrid reached( glbSpaceW, glbSpaceH );
+    if (freeCells.Test( 0, 0 )) {
+        reached.Set( 0, 0 );
+    }
+    // grow the reached area until it contains the exit, or doesn't grow anymore
+    while (!reached.Test( glbSpaceW - 1, glbSpaceH - 1 ) && reached.FloodStep( freeCells ))
+        ;
+    return reached.Test( glbSpaceW - 1, glbSpaceH - 1 );
+}
 
-int main()
-{
-    glbProgPhase = PUZZLE;     // program phase to EXAMPLE, TEST or PUZZLE
-    std::cout << "Phase: " << ProgPhase2string() << std::endl << std::endl;
-    flcTimer tmr;
+// ==========   PHASE FUNCTIONS
 
-/* ========== */   tmr.StartTiming();   // ============================================vvvvv
+flcSnapshot<DataStream> glbInputData;   // parsed input data - the parts view it read only
 
-    // get input data, depending on the glbProgPhase (example, test, puzzle)
+// phase 0 - get input data, depending on the glbProgPhase (example, test, puzzle)
+void PrepareInput() {
     DataStream inputData;
     GetInput( inputData, glbProgPhase != PUZZLE );
-    DataStream part2Data = inputData;
-    std::cout << "Data stats - size of data stream " << inputData.size() << std::endl << std::endl;
-
-/* ========== */   tmr.TimeReport( "    Timing 0 - input data preparation: " );   // =========================^^^^^vvvvv
+    glbInputData = MakeSnapshot( std::move( inputData ));
+}
 
-    // part 1 code here
+// resets all obstacles in the space, and corrupts the first nBytes from the input stream
+void CorruptFirstBytes( const DataStream &inputData, int nBytes ) {
+    glbSpace.Fill( '.' );
+    for (int i = 0; i < nBytes; i++) {
+        LocType curPos = inputData[i];
+        glbSpace( curPos.x, curPos.y ) = '#';
+    }
+}
 
+int SolvePart1() {
+    const DataStream &inputData = *glbInputData;
     InitMap();
-    PathType foundPath;
-
-//    PrintVisualSpace( "after InitMap()", foundPath );
-
     // corrupt first n bytes from input stream
     int nBytesToCorrupt = (glbProgPhase != PUZZLE ? 12 : 1024);
-    for (int i = 0; i < nBytesToCorrupt; i++) {
-        LocType curPos = inputData[i];
-        nodes[curPos.y * glbSpaceW + curPos.x].bObstacle = true;
+    CorruptFirstBytes( inputData, nBytesToCorrupt );
+    // run A* algo and get the shortest path from it
+    PathType foundPath = Solve_AStar();
+    return foundPath.size() - 1;
+}
+
+// returns the index of the first byte that blocks the path to the exit
+int SolvePart2() {
+    const DataStream &inputData = *glbInputData;
+    InitMap();
+    // start from the situation of part 1: with the first n bytes of input stream corrupted the exit is reachable
+    int nStartFromByte = (glbProgPhase != PUZZLE ? 12 : 1024);
+
+    // invariant: the exit is reachable with nLow bytes corrupted, and not with nHigh bytes corrupted
+    int nLow  = nStartFromByte;
+    int nHigh = (int)inputData.size();
+    if (ExitReachable( inputData, nHigh )) {
+        std::cout << "ERROR: SolvePart2() --> exit is still reachable after all bytes are corrupted" << std::endl;
+        return -1;
     }
+    while (nHigh - nLow > 1) {
+        int nMid = nLow + (nHigh - nLow) / 2;
+        if (ExitReachable( inputData, nMid )) {
+            nLow  = nMid;
+        } else {
+            nHigh = nMid;
+        }
+    }
+    // corrupting nHigh bytes blocks the exit, so the last of them is the blocking one
+    return nHigh - 1;
+}
 
-//    PrintVisualSpace( "after first 12 bytes were corrupted", foundPath );
+}   // namespace day18
 
-    // run A* algo and extra shortest path afterwards
-    Solve_AStar();
-    foundPath = ExtractPath();
+// ==========   MAIN()
 
-//    PrintVisualSpace( "after running A* algo", foundPath );
+#ifdef AOC24_DRIVER
 
-    std::cout << std::endl << "Answer to part 1: shortest path # steps = " << foundPath.size() - 1 << std::endl << std::endl;
+// in the aoc24 driver program this day registers its phase functions instead of having a main()
+AOC24_REGISTER_DAY( day18 );
 
-/* ========== */   tmr.TimeReport( "    Timing 1 - solving puzzle part 1 : " );   // =========================^^^^^vvvvv
+#else
 
-    inputData = part2Data; // get fresh untouched copy of input data
+using namespace day18;
 
-    // part 2 code here
+int main( int argc, char *argv[] )
+{
+    glbProgPhase = PUZZLE;     // program phase to EXAMPLE, TEST or PUZZLE
+    std::cout << "Phase: " << ProgPhase2string() << std::endl << std::endl;
+    flcBenchmark bench( argc, argv );   // use --warmup <n> and --repeat <n> to get timing statistics
+    bench.SetContext( DAY_STRING, ProgPhase2string());
 
-    // corrupt first n bytes from input stream
-    int nStartFromByte = (glbProgPhase != PUZZLE ? 12 : 1024);
-    bool bFound = false;
-    int nCacheIndex = -1;
-    for (int i = nStartFromByte; !bFound; i++) {
-        // corrupt the next byte from the input data
-        LocType curPos = inputData[i];
-        nodes[curPos.y * glbSpaceW + curPos.x].bObstacle = true;
+/* ========== */   bench.RunPhase( "input data preparation", PrepareInput );   // =====================vvvvv
 
-        // run A* algo and extra shortest path afterwards
-        Solve_AStar();
-        foundPath = ExtractPath();
+    std::cout << "Data stats - size of data stream " << glbInputData->size() << std::endl << std::endl;
 
-        // if no shortest path was found, terminate the loop and store the index
-        if (foundPath.size() == 0) {
-            bFound = true;
-            nCacheIndex = i;
-        }
-    }
+/* ========== */   bench.TimeReport( "    Timing 0 - input data preparation: " );   // =========================^^^^^vvvvv
+
+    // part 1 code here
 
-    std::cout << std::endl << "Answer to part 2: blocking location found at index = " << nCacheIndex << " being = " << inputData[nCacheIndex].to_string() << std::endl << std::endl;
+    int nPathSteps;
+    bench.RunPhase( "solving puzzle part 1", [&]() { nPathSteps = SolvePart1(); } );
+    bench.SetAnswer( nPathSteps );
 
-/* ========== */   tmr.TimeReport( "    Timing 2 - solving puzzle part 2 : " );   // ==============================^^^^^
+    std::cout << std::endl << "Answer to part 1: shortest path # steps = " << nPathSteps << std::endl << std::endl;
+
+/* ========== */   bench.TimeReport( "    Timing 1 - solving puzzle part 1 : " );   // =========================^^^^^vvvvv
+
+    // part 2 code here
+
+    int nCacheIndex;
+    bench.RunPhase( "solving puzzle part 2", [&]() { nCacheIndex = SolvePart2(); } );
+    bench.SetAnswer( nCacheIndex );
+
+    std::cout << std::endl << "Answer to part 2: blocking location found at index = " << nCacheIndex << " being = " << (*glbInputData)[nCacheIndex].to_string() << std::endl << std::endl;
+
+/* ========== */   bench.TimeReport( "    Timing 2 - solving puzzle part 2 : " );   // ==============================^^^^^
+
+    if (bench.GetRepeat() > 1) {
+        bench.SummaryReport();
+    }
 
     return 0;
 }
+
+#endif // AOC24_DRIVER
@@ -13,11 +13,21 @@
 #include <vector>
 #include <deque>
 #include <map>
+#include <memory>
 
 #include "../flcTimer.h"
+#include "../flcBenchmark.h"
+#include "../flcInputFile.h"
+#include "../flcThreadPool.h"
+#include "../aoc24_registry.h"
+#include "../flcSnapshot.h"
+#include "../flcArtifactCache.h"
+#include "../flcPipeline.h"
 #include "../parse_functions.h"
 #include "my_utility.h"
 
+namespace day19 {
+
 // ==========   PROGRAM PHASING
 
 enum eProgPhase {     // what programming phase are you in - set at start of main()
@@ -66,30 +76,33 @@ void GetData_EXAMPLE( DataStream &patternData, DataStream &designData  ) {
 }
 
 // file input - this function reads text file content one line at a time - adapt code to match your need for line parsing!
+// the first line of the input has the patterns, like "r, wr, b, g, bwu, rb, gb, br"
+void ParsePatterns( std::string_view sLineView, DataStream &patternData ) {
+    while (sLineView.length() > 0) {
+        patternData.emplace_back( get_token_dlmtd( ", ", sLineView ));
+    }
+}
+
 void ReadInputData( const std::string sFileName, DataStream &patternData, DataStream &designData ) {
 
-    std::ifstream dataFileStream( sFileName );
+    flcInputFile dataFile( sFileName );
     patternData.clear();
     designData.clear();
-    std::string sLine;
+    std::string_view sLineView;
 
     // line with patterns
-    getline( dataFileStream, sLine );
-    while (sLine.length() > 0) {
-        std::string sPattern = get_token_dlmtd( ", ", sLine );
-        patternData.push_back( sPattern );
-    }
+    dataFile.NextLine( sLineView );
+    ParsePatterns( sLineView, patternData );
     // empty line
-    getline( dataFileStream, sLine );
+    dataFile.NextLine( sLineView );
     // multiple lines with designs
-    while (getline( dataFileStream, sLine )) {
-        designData.push_back( sLine );
+    while (dataFile.NextLine( sLineView )) {
+        designData.emplace_back( sLineView );
     }
-    dataFileStream.close();
 }
 
-void GetData_TEST(   DataStream &patternData, DataStream &designData ) { std::string sInputFile = DAY_STRING; sInputFile.append( ".input.test.txt"   ); ReadInputData( sInputFile, patternData, designData ); }
-void GetData_PUZZLE( DataStream &patternData, DataStream &designData ) { std::string sInputFile = DAY_STRING; sInputFile.append( ".input.puzzle.txt" ); ReadInputData( sInputFile, patternData, designData ); }
+void GetData_TEST(   DataStream &patternData, DataStream &designData ) { std::string sInputFile = GetInputFileName( DAY_STRING, "test"   ); ReadInputData( sInputFile, patternData, designData ); }
+void GetData_PUZZLE( DataStream &patternData, DataStream &designData ) { std::string sInputFile = GetInputFileName( DAY_STRING, "puzzle" ); ReadInputData( sInputFile, patternData, designData ); }
 
 // ==========   CONSOLE OUTPUT FUNCTIONS
 
@@ -203,10 +216,11 @@ bool AttemptOneDesign_recursive( const DataStream &patterns, const DatumType &de
 
                 // recursively determine if a full match can be found
                 bFoundFullMatch = AttemptOneDesign_recursive( patterns, partCopy, bOutput );
-                // store that result for memoization
-                mapOutcomes.insert( make_pair( partOrg, (bFoundFullMatch ? 1 : 0)));
             }
         }
+        // store the result for memoization - only after all patterns are tried, since insert() doesn't
+        // overwrite an earlier (negative) outcome
+        mapOutcomes.insert( make_pair( partOrg, (bFoundFullMatch ? 1 : 0)));
     }
     return bFoundFullMatch;
 }
@@ -255,7 +269,7 @@ bool AttemptOneDesign_iterative( DataStream &patterns, DatumType &design, bool b
     return bFoundFullMatch;
 }
 
-int MatchAllDesigns( DataStream &patterns, DataStream &designs ) {
+int MatchAllDesigns( const DataStream &patterns, const DataStream &designs ) {
 
     mapOutcomes.clear();
     mapOutcomes.insert( make_pair( "", 1 ));   // the trivial solution: an empty string always matches
@@ -278,23 +292,25 @@ int MatchAllDesigns( DataStream &patterns, DataStream &designs ) {
 
 // ----- PART 2
 
-void PrintMemoization2() {
-    for (auto &e : mapOutcomes) {
+void PrintMemoization2( OutcomesMap &mOutcomes ) {
+    for (auto &e : mOutcomes) {
         std::cout << "(sub)design: _" << e.first << "_ has " << e.second << " solutions" << std::endl;
     }
     std::cout << std::endl;
 }
 
 
-long long AttemptOneDesign_recursive2( const DataStream &patterns, const DatumType &designTrail, bool bOutput = false ) {
+// the memoization map is passed as a parameter, so that designs can be matched in parallel, each thread
+// using its own map
+long long AttemptOneDesign_recursive2( const DataStream &patterns, const DatumType &designTrail, OutcomesMap &mOutcomes, bool bOutput = false ) {
 
     // make a copy of the parameter to prevent it being adapted
     DatumType partOrg = designTrail;
     long long llFoundMatches = 0;
 
     // see if an outcome for this design string is already known
-    OutcomesMap::iterator iter = mapOutcomes.find( partOrg );
-    if (iter != mapOutcomes.end()) {
+    OutcomesMap::iterator iter = mOutcomes.find( partOrg );
+    if (iter != mOutcomes.end()) {
         // if it is known, use the result
         llFoundMatches = (*iter).second;
         if (bOutput) {
@@ -319,84 +335,323 @@ long long AttemptOneDesign_recursive2( const DataStream &patterns, const DatumTy
                 }
 
                 // recursively determine if a full match can be found
-                long long llLocalMatches = AttemptOneDesign_recursive2( patterns, partCopy, bOutput );
+                long long llLocalMatches = AttemptOneDesign_recursive2( patterns, partCopy, mOutcomes, bOutput );
                 // store that result for memoization
-                mapOutcomes.insert( make_pair( partCopy, llLocalMatches ));
+                mOutcomes.insert( make_pair( partCopy, llLocalMatches ));
 
                 llFoundMatches += llLocalMatches;
             }
         }
-        mapOutcomes.insert( make_pair( partOrg, llFoundMatches ));
+        mOutcomes.insert( make_pair( partOrg, llFoundMatches ));
 
     }
     return llFoundMatches;
 }
 
 
-void ProcessPatterns( DataStream &patterns, bool bOutput = false ) {
+void ProcessPatterns( const DataStream &patterns, OutcomesMap &mOutcomes, bool bOutput = false ) {
 
     for (int i = 0; i < (int)patterns.size(); i++) {
-        long long llNrMatches = AttemptOneDesign_recursive2( patterns, patterns[i], bOutput );
-        mapOutcomes.insert( make_pair( patterns[i], llNrMatches ));
+        long long llNrMatches = AttemptOneDesign_recursive2( patterns, patterns[i], mOutcomes, bOutput );
+        mOutcomes.insert( make_pair( patterns[i], llNrMatches ));
     }
 }
 
-long long MatchAllDesigns2( DataStream &patterns, DataStream &designs, bool bOutput = false ) {
+// the designs are independent of each other, so they are matched in parallel. Each thread of the pool
+// has its own memoization map, which all start from the results for the patterns themselves
+long long MatchAllDesigns2( const DataStream &patterns, const DataStream &designs, bool bOutput = false ) {
 
-    mapOutcomes.clear();
-    mapOutcomes.insert( make_pair( "", 1 ));   // the trivial solution: an empty string always matches
-    ProcessPatterns( patterns, bOutput );
+    OutcomesMap mInitial;
+    mInitial.insert( make_pair( "", 1 ));   // the trivial solution: an empty string always matches
+    ProcessPatterns( patterns, mInitial, bOutput );
     if (bOutput) {
-        PrintMemoization2();
+        PrintMemoization2( mInitial );
     }
+    std::vector<OutcomesMap> vOutcomes( flcThreadPool::Instance().GetThreadCount(), mInitial );
+
+    long long llCnt = parallel_reduce( 0, (int)designs.size(), 0LL,
+        [&]( int i ) {
+            OutcomesMap &mOutcomes = vOutcomes[flcThreadPool::WorkerIndex()];
+            return AttemptOneDesign_recursive2( patterns, designs[i], mOutcomes, bOutput );
+        },
+        []( long long a, long long b ) { return a + b; }
+    );
+    return llCnt;
+}
 
-    long long llCnt = 0;
-    for (int i = 0; i < (int)designs.size(); i++) {
-        long long localCount = AttemptOneDesign_recursive2( patterns, designs[i], bOutput );
-        llCnt += localCount;
-//        std::cout << "design with index: " << i << " = " << designs[i]
-//                  << " yields " << localCount << " possibilities, total nr = " << llCnt << " (memo size: " << mapOutcomes.size() << ")" << std::endl;
+// ----- OPTIMIZED VERSION (BOTH PARTS)
+
+// The memoization above is keyed on the remaining design string, so each lookup copies and hashes a
+// string, and each pattern is tried separately. Instead, all patterns go in a trie, and per design the
+// nr of arrangements of each suffix is counted from the back to the front: the count at position i is
+// the sum of the counts at i + length( p ) over the patterns p that match at position i. Walking the trie
+// from position i finds all those patterns in one go.
+class PatternTrie {
+public:
+    PatternTrie( const DataStream &patterns ) {
+        // the children are indexed on a compact alphabet of the characters that occur in the patterns
+        m_vCharIndex.assign( 256, -1 );
+        for (auto &p : patterns) {
+            for (unsigned char c : p) {
+                if (m_vCharIndex[c] < 0) {
+                    m_vCharIndex[c] = m_nAlphabet++;
+                }
+            }
+        }
+        NewNode();
+        for (auto &p : patterns) {
+            int nNode = 0;
+            for (unsigned char c : p) {
+                int nSlot = nNode * m_nAlphabet + m_vCharIndex[c];
+                if (m_vChildren[nSlot] == 0) {
+                    int nNew = NewNode();    // this resizes m_vChildren, so don't hold a reference into it
+                    m_vChildren[nSlot] = nNew;
+                }
+                nNode = m_vChildren[nSlot];
+            }
+            m_vIsPattern[nNode] = 1;
+        }
     }
-    return llCnt;
+
+    // nr of ways the design can be made from the patterns - with bAnyOnly it's just 0 or 1
+    long long CountArrangements( const std::string &sDesign, bool bAnyOnly, std::vector<long long> &vCount ) const {
+        int n = (int)sDesign.length();
+        vCount.assign( n + 1, 0 );
+        vCount[n] = 1;
+        for (int i = n - 1; i >= 0; i--) {
+            long long llSum = 0;
+            int nNode = 0;
+            for (int j = i; j < n && (!bAnyOnly || llSum == 0); j++) {
+                int nChar = m_vCharIndex[(unsigned char)sDesign[j]];
+                nNode = (nChar < 0) ? 0 : m_vChildren[nNode * m_nAlphabet + nChar];
+                if (nNode == 0) {
+                    break;
+                }
+                if (m_vIsPattern[nNode]) {
+                    llSum += vCount[j + 1];
+                }
+            }
+            vCount[i] = bAnyOnly ? (llSum > 0) : llSum;
+        }
+        return vCount[0];
+    }
+
+private:
+    int NewNode() {
+        m_vChildren.resize( m_vChildren.size() + m_nAlphabet, 0 );
+        m_vIsPattern.push_back( 0 );
+        return (int)m_vIsPattern.size() - 1;
+    }
+
+    std::vector<int>  m_vCharIndex;
+    int               m_nAlphabet = 0;
+    std::vector<int>  m_vChildren;     // per node m_nAlphabet child node nrs, 0 is no child (the root is never a child)
+    std::vector<char> m_vIsPattern;
+};
+
+// ==========   PHASE FUNCTIONS
+
+flcSnapshot<DataStream> glbPatternData, glbDesignData;   // parsed input data - the parts view it read only
+uint64_t glbPatternHash;                                  // the key of the trie artifact
+
+// phase 0 - get input data, depending on the glbProgPhase (example, test, puzzle)
+void PrepareInput() {
+    DataStream patternData, designData;
+    GetInput( patternData, designData, glbProgPhase != PUZZLE );
+    glbPatternHash = flcArtifactCache::HashLines( patternData );
+    glbPatternData = MakeSnapshot( std::move( patternData ));
+    glbDesignData  = MakeSnapshot( std::move( designData ));
+}
+
+// the outcome per design, as artifact for the --verify mode of the driver
+std::vector<long long> glbDesignCounts;
+
+// counts (or with bAnyOnly checks) the arrangements of all designs with the trie. The designs are
+// independent, so they are done in parallel. The trie only depends on the patterns: part 1 builds it,
+// and shares it with part 2 as artifact "day19.trie"
+long long MatchAllDesigns_trie( bool bAnyOnly ) {
+    const DataStream &designData = *glbDesignData;
+    auto fnBuild = []() { return PatternTrie( *glbPatternData ); };
+    flcArtifactCache &cache = flcArtifactCache::Instance();
+    std::shared_ptr<const PatternTrie> pTrie = bAnyOnly ? cache.Produce<PatternTrie>( glbPatternHash, "day19.trie", fnBuild )
+                                                        : cache.Consume<PatternTrie>( glbPatternHash, "day19.trie", fnBuild );
+    const PatternTrie &trie = *pTrie;
+    std::vector<std::vector<long long>> vCounts( flcThreadPool::Instance().GetThreadCount());
+    glbDesignCounts.assign( designData.size(), 0 );
+    return parallel_reduce( 0, (int)designData.size(), 0LL,
+        [&]( int i ) {
+            glbDesignCounts[i] = trie.CountArrangements( designData[i], bAnyOnly, vCounts[flcThreadPool::WorkerIndex()] );
+            return glbDesignCounts[i];
+        },
+        []( long long a, long long b ) { return a + b; }
+    );
 }
 
+int SolvePart1() {
+    return (int)MatchAllDesigns_trie( true );
+}
+
+long long SolvePart2() {
+    return MatchAllDesigns_trie( false );
+}
+
+std::string DesignArtifact() {
+    std::string sResult;
+    for (long long llCount : glbDesignCounts) {
+        sResult.append( std::to_string( llCount ) + " " );
+    }
+    return sResult;
+}
+
+// the original versions with memoization on the remaining design string, kept as reference for the
+// optimized ones
+int SolvePart1_reference() {
+    return MatchAllDesigns( *glbPatternData, *glbDesignData );
+}
+
+long long SolvePart2_reference() {
+    return MatchAllDesigns2( *glbPatternData, *glbDesignData, false );
+}
+
+// the artifacts of the reference versions are collected afterwards, so they don't count in their timing.
+// Part 1 can use the memoization map that's left behind, part 2 needs a new one
+std::string DesignArtifact1_reference() {
+    glbDesignCounts.clear();
+    for (auto &d : *glbDesignData) {
+        glbDesignCounts.push_back( AttemptOneDesign_recursive( *glbPatternData, d ) ? 1 : 0 );
+    }
+    return DesignArtifact();
+}
+
+std::string DesignArtifact2_reference() {
+    OutcomesMap mOutcomes;
+    mOutcomes.insert( make_pair( "", 1 ));
+    ProcessPatterns( *glbPatternData, mOutcomes );
+    glbDesignCounts.clear();
+    for (auto &d : *glbDesignData) {
+        glbDesignCounts.push_back( AttemptOneDesign_recursive2( *glbPatternData, d, mOutcomes ));
+    }
+    return DesignArtifact();
+}
+
+// ----- STREAMED VERSION (BOTH PARTS)
+
+// a design on its way through the pipeline, with the place where its outcome goes
+typedef struct sStreamedDesignStruct {
+    std::string sDesign;
+    long long  *pCount;
+} StreamedDesignType;
+
+// the patterns are needed for every design, so they are read first and put in the trie. Then the designs
+// are parsed and counted at the same time, through the pipeline of flcPipeline.h. The outcomes go in a
+// deque, which the producer can grow while the consumers write to the elements that are already there.
+// The example data is not in a file, so those designs are streamed from the hard coded ones
+long long MatchAllDesigns_streamed( bool bAnyOnly ) {
+    std::unique_ptr<flcInputFile> pDataFile;
+    std::string_view sLineView;
+    DataStream patternData, exampleDesigns;
+    if (glbProgPhase == EXAMPLE) {
+        GetData_EXAMPLE( patternData, exampleDesigns );
+    } else {
+        pDataFile = std::make_unique<flcInputFile>( GetInputFileName( DAY_STRING, glbProgPhase == TEST ? "test" : "puzzle" ) );
+        pDataFile->NextLine( sLineView );
+        ParsePatterns( sLineView, patternData );
+        pDataFile->NextLine( sLineView );
+    }
+
+    uint64_t nPatternHash = flcArtifactCache::HashLines( patternData );
+    auto fnBuild = [&]() { return PatternTrie( patternData ); };
+    flcArtifactCache &cache = flcArtifactCache::Instance();
+    std::shared_ptr<const PatternTrie> pTrie = bAnyOnly ? cache.Produce<PatternTrie>( nPatternHash, "day19.trie", fnBuild )
+                                                        : cache.Consume<PatternTrie>( nPatternHash, "day19.trie", fnBuild );
+    const PatternTrie &trie = *pTrie;
+    std::deque<long long> dCounts;
+    long long llResult = pipeline_reduce<StreamedDesignType>(
+        [&]( auto &&emit ) {
+            if (glbProgPhase == EXAMPLE) {
+                for (auto &sDesign : exampleDesigns) {
+                    dCounts.push_back( 0 );
+                    emit( { std::move( sDesign ), &dCounts.back() } );
+                }
+                return;
+            }
+            while (pDataFile->NextLine( sLineView )) {
+                dCounts.push_back( 0 );
+                emit( { std::string( sLineView ), &dCounts.back() } );
+            }
+        },
+        0LL,
+        [&]( const StreamedDesignType &cDesign ) {
+            static thread_local std::vector<long long> vCount;    // scratch per consumer thread
+            *cDesign.pCount = trie.CountArrangements( cDesign.sDesign, bAnyOnly, vCount );
+            return *cDesign.pCount;
+        },
+        []( long long a, long long b ) { return a + b; }
+    );
+    glbDesignCounts.assign( dCounts.begin(), dCounts.end());
+    return llResult;
+}
+
+int       SolvePart1_streamed() { return (int)MatchAllDesigns_streamed( true  ); }
+long long SolvePart2_streamed() { return      MatchAllDesigns_streamed( false ); }
+
+}   // namespace day19
+
 // ==========   MAIN()
 
-int main()
+#ifdef AOC24_DRIVER
+
+// in the aoc24 driver program this day registers its phase functions instead of having a main()
+AOC24_REGISTER_DAY( day19 );
+AOC24_REGISTER_ENGINE( day19, 1, reference, SolvePart1_reference, DesignArtifact1_reference );
+AOC24_REGISTER_ENGINE( day19, 1, optimized, SolvePart1          , DesignArtifact );
+AOC24_REGISTER_OWN_INPUT_ENGINE( day19, 1, streamed, SolvePart1_streamed, DesignArtifact );
+AOC24_REGISTER_ENGINE( day19, 2, reference, SolvePart2_reference, DesignArtifact2_reference );
+AOC24_REGISTER_ENGINE( day19, 2, optimized, SolvePart2          , DesignArtifact );
+AOC24_REGISTER_OWN_INPUT_ENGINE( day19, 2, streamed, SolvePart2_streamed, DesignArtifact );
+
+#else
+
+using namespace day19;
+
+int main( int argc, char *argv[] )
 {
     glbProgPhase = PUZZLE;     // program phase to EXAMPLE, TEST or PUZZLE
     std::cout << "Phase: " << ProgPhase2string() << std::endl << std::endl;
-    flcTimer tmr;
+    flcBenchmark bench( argc, argv );   // use --warmup <n> and --repeat <n> to get timing statistics
+    bench.SetContext( DAY_STRING, ProgPhase2string());
 
-/* ========== */   tmr.StartTiming();   // ============================================vvvvv
+/* ========== */   bench.RunPhase( "input data preparation", PrepareInput );   // =====================vvvvv
 
-    // get input data, depending on the glbProgPhase (example, test, puzzle)
-    DataStream patternData, designData;
-    GetInput( patternData, designData, glbProgPhase != PUZZLE );
-    DataStream part2PatternData = patternData;
-    DataStream part2DesignData  = designData;
-    std::cout << "Data stats - size of data streams: " << patternData.size() << " patterns and " << designData.size() << " designs" << std::endl << std::endl;
+    std::cout << "Data stats - size of data streams: " << glbPatternData->size() << " patterns and " << glbDesignData->size() << " designs" << std::endl << std::endl;
 
-/* ========== */   tmr.TimeReport( "    Timing 0 - input data preparation: " );   // =========================^^^^^vvvvv
+/* ========== */   bench.TimeReport( "    Timing 0 - input data preparation: " );   // =========================^^^^^vvvvv
 
     // part 1 code here
-    int nDesignsPossible = MatchAllDesigns( patternData, designData );
-//    PrintMemoization();
 
+    int nDesignsPossible;
+    bench.RunPhase( "solving puzzle part 1", [&]() { nDesignsPossible = SolvePart1(); } );
+    bench.SetAnswer( nDesignsPossible );
 
     std::cout << std::endl << "Answer to part 1: number of designs possible = " << nDesignsPossible << std::endl << std::endl;
 
-/* ========== */   tmr.TimeReport( "    Timing 1 - solving puzzle part 1 : " );   // =========================^^^^^vvvvv
-
-    patternData = part2PatternData; // get fresh untouched copy of input data
-    designData  = part2DesignData;
+/* ========== */   bench.TimeReport( "    Timing 1 - solving puzzle part 1 : " );   // =========================^^^^^vvvvv
 
     // part 2 code here
-    long long nCombinationsPossible = MatchAllDesigns2( patternData, designData, false );
+
+    long long nCombinationsPossible;
+    bench.RunPhase( "solving puzzle part 2", [&]() { nCombinationsPossible = SolvePart2(); } );
+    bench.SetAnswer( nCombinationsPossible );
 
     std::cout << std::endl << "Answer to part 2: number of combinations possible = " << nCombinationsPossible << std::endl << std::endl;
 
-/* ========== */   tmr.TimeReport( "    Timing 2 - solving puzzle part 2 : " );   // ==============================^^^^^
+/* ========== */   bench.TimeReport( "    Timing 2 - solving puzzle part 2 : " );   // ==============================^^^^^
+
+    if (bench.GetRepeat() > 1) {
+        bench.SummaryReport();
+    }
 
     return 0;
 }
+
+#endif // AOC24_DRIVER
@@ -11,16 +11,24 @@
 #include <algorithm>
 #include <numeric>
 #include <vector>
-#include <deque>
-#include <list>
-#include <cfloat>
-#include <cmath>
 #include <set>
+#include <cstdlib>
 
 #include "../flcTimer.h"
+#include "../flcBenchmark.h"
+#include "../flcInputFile.h"
+#include "../aoc24_registry.h"
+#include "../flcSnapshot.h"
+#include "../flcArtifactCache.h"
+#include "../flcCoord.h"
+#include "../flcProfiler.h"
+#include "../flcGrid.h"
+#include "../flcPathFind.h"
 #include "../parse_functions.h"
 #include "my_utility.h"
 
+namespace day20 {
+
 // ==========   PROGRAM PHASING
 
 enum eProgPhase {     // what programming phase are you in - set at start of main()
@@ -99,17 +107,15 @@ void GetData_EXAMPLE( DataStream &dData ) {
 // file input - this function reads text file content one line at a time - adapt code to match your need for line parsing!
 void ReadInputData( const std::string sFileName, DataStream &vData ) {
 
-    std::ifstream dataFileStream( sFileName );
+    flcInputFile dataFile( sFileName );
     vData.clear();
-    std::string sLine;
-    while (getline( dataFileStream, sLine )) {
-        vData.push_back( sLine );
+    for (std::string_view sLine : dataFile.Lines()) {
+        vData.emplace_back( sLine );
     }
-    dataFileStream.close();
 }
 
-void GetData_TEST(   DataStream &dData ) { std::string sInputFile = DAY_STRING; sInputFile.append( ".input.test.txt"   ); ReadInputData( sInputFile, dData ); }
-void GetData_PUZZLE( DataStream &dData ) { std::string sInputFile = DAY_STRING; sInputFile.append( ".input.puzzle.txt" ); ReadInputData( sInputFile, dData ); }
+void GetData_TEST(   DataStream &dData ) { std::string sInputFile = GetInputFileName( DAY_STRING, "test"   ); ReadInputData( sInputFile, dData ); }
+void GetData_PUZZLE( DataStream &dData ) { std::string sInputFile = GetInputFileName( DAY_STRING, "puzzle" ); ReadInputData( sInputFile, dData ); }
 
 // ==========   CONSOLE OUTPUT FUNCTIONS
 
@@ -153,24 +159,9 @@ LocType glbStart, glbEnd;  // to hold start and end point locations in the map
 
 // ------------ PATH FINDING STUFF HERE ---------------
 
-typedef struct sNode {
-    bool bObstacle = false;			// Is the node an obstruction?
-    bool bVisited  = false;			// Have we searched this node before?
-    float fGlobalGoal;				// Distance to goal so far
-    float fLocalGoal;				// Distance to goal if we took the alternative route
-    LocType pos;					// Nodes position in 2D space
-    std::vector<sNode*> vNeighbours;	// Connections to neighbours
-    sNode* parent;					// Node connecting to this node that offers shortest parent
-} NodeType;
-
-NodeType *nodes     = nullptr;      // a pointer to the space
-
-NodeType *nodeStart = nullptr;      // a pointer to start and end node in space
-NodeType *nodeEnd   = nullptr;
-
-// initialises the map dimensions and start and end point variables, and then sets up the
-// noded model needed for A* algorithm
-void InitMap( DataStream &m ) {
+// initialises the map dimensions and start and end point variables
+void InitMap( const DataStream &m ) {
+    FLC_PROFILE_SCOPE( "InitMap" );
 
     // init map dimensions
     glbMapY = (int)m.size();
@@ -186,144 +177,83 @@ void InitMap( DataStream &m ) {
             }
         }
     }
-
-    // Create a 2D array of nodes - this is for convenience of rendering and construction
-    // and is not required for the algorithm to work - the nodes could be placed anywhere
-    // in any space, in multiple dimensions...
-    nodes = new NodeType[glbMapX * glbMapY];
-    for (int y = 0; y < glbMapY; y++) {
-        for (int x = 0; x < glbMapX; x++) {
-            nodes[y * glbMapX + x].pos       = { x, y }; // ...because we give each node its own coordinates
-            nodes[y * glbMapX + x].bObstacle = (m[y][x] == '#');
-            nodes[y * glbMapX + x].bVisited  = false;
-            nodes[y * glbMapX + x].parent    = nullptr;
-        }
-    }
-    // Create connections - in this case nodes are on a regular grid
-    for (int y = 0; y < glbMapY; y++) {
-        for (int x = 0; x < glbMapX; x++) {
-            if (y >           0) nodes[y * glbMapX + x].vNeighbours.push_back(&nodes[(y - 1) * glbMapX + (x + 0)]);
-            if (y < glbMapY - 1) nodes[y * glbMapX + x].vNeighbours.push_back(&nodes[(y + 1) * glbMapX + (x + 0)]);
-            if (x >           0) nodes[y * glbMapX + x].vNeighbours.push_back(&nodes[(y + 0) * glbMapX + (x - 1)]);
-            if (x < glbMapX - 1) nodes[y * glbMapX + x].vNeighbours.push_back(&nodes[(y + 0) * glbMapX + (x + 1)]);
-        }
-    }
-    // Manually position the start and end markers so they are not nullptr
-    nodeStart = &nodes[glbStart.y * glbMapX + glbStart.x ];
-    nodeEnd   = &nodes[glbEnd.y   * glbMapX + glbEnd.x   ];
 }
 
-// data structure to hold paths
-typedef struct sPathStepStruct {
-    int nr;
-    NodeType *pNode;
-} PathStep;
-typedef std::deque<PathStep> PathType;
-
-// see javidx9's vid on path finding
-bool Solve_AStar() {
-
-    // Reset Navigation Graph - default all node states
-    for (int y = 0; y < glbMapY; y++) {
-        for (int x = 0; x < glbMapX; x++) {
-            nodes[y * glbMapX + x].bVisited    = false;
-            nodes[y * glbMapX + x].fGlobalGoal = FLT_MAX;  // INFINITY;
-            nodes[y * glbMapX + x].fLocalGoal  = FLT_MAX;  // INFINITY;
-            nodes[y * glbMapX + x].parent      = nullptr;  // No parents
+// data structure to hold paths - the locations from start to end, so the index of a location is its step nr
+typedef std::vector<LocType> PathType;
+
+// the race track has unit steps, so a breadth first search finds the shortest path. The path finding
+// states are the map cell indices y * glbMapX + x (see flcPathFind.h)
+// Note: if no path was found, an empty PathType container will be returned
+PathType Solve_BFS( const DataStream &m ) {
+    FLC_PROFILE_SCOPE( "Solve_BFS" );
+
+    auto fNeighbours = [&]( int nCur, auto &&visit ) {
+        int x = nCur % glbMapX, y = nCur / glbMapX;
+        for (int dir = 0; dir < 4; dir++) {
+            int nx = x + glbDirX4[dir], ny = y + glbDirY4[dir];
+            if (nx >= 0 && nx < glbMapX && ny >= 0 && ny < glbMapY && m[ny][nx] != '#') {
+                visit( ny * glbMapX + nx, 1 );
+            }
         }
-    }
-
-    auto distance = [](NodeType *a, NodeType *b) { // For convenience
-        return sqrtf((a->pos.x - b->pos.x) * (a->pos.x - b->pos.x) + (a->pos.y - b->pos.y) * (a->pos.y - b->pos.y));
     };
+    flcPathOptions options;
+    options.nTarget = glbEnd.y * glbMapX + glbEnd.x;
+    flcPathResult result = PathBFS( glbMapX * glbMapY, { glbStart.y * glbMapX + glbStart.x }, fNeighbours, options );
 
-    auto heuristic = [distance](NodeType *a, NodeType *b) { // So we can experiment with heuristic
-        return distance(a, b);
-    };
+    PathType vPath;
+    for (int nState : result.PathTo( options.nTarget )) {
+        vPath.push_back( { nState % glbMapX, nState / glbMapX } );
+    }
+    return vPath;
+}
 
-    // Setup starting conditions
-    NodeType *nodeCurrent = nodeStart;
-    nodeStart->fLocalGoal = 0.0f;
-    nodeStart->fGlobalGoal = heuristic(nodeStart, nodeEnd);
-
-    // Add start node to not tested list - this will ensure it gets tested.
-    // As the algorithm progresses, newly discovered nodes get added to this
-    // list, and will themselves be tested later
-    std::list<NodeType*> listNotTestedNodes;
-    listNotTestedNodes.push_back(nodeStart);
-
-    // if the not tested list contains nodes, there may be better paths
-    // which have not yet been explored. However, we will also stop
-    // searching when we reach the target - there may well be better
-    // paths but this one will do - it wont be the longest.
-
-//    while (!listNotTestedNodes.empty() && nodeCurrent != nodeEnd) { // Find absolutely shortest path // && nodeCurrent != nodeEnd)
-    while (!listNotTestedNodes.empty()) { // Find absolutely shortest path // && nodeCurrent != nodeEnd)
-        // if you stop stop searching when you reach the end, you'll just have a path, but not
-        // necessarily the shortest one. So out comment "&& nodeCurrent != nodeEnd" if you
-        // want to have the absolute shortest path
-
-        // Sort Untested nodes by global goal, so lowest is first
-        listNotTestedNodes.sort(
-            [](const NodeType * lhs, const NodeType * rhs) {
-                return lhs->fGlobalGoal < rhs->fGlobalGoal;
+// the same search as a 0-1 breadth first search, as a cross check of Solve_BFS() for --verify. Each cell
+// has an entry state 2 * c and an exit state 2 * c + 1: going from the entry to the exit of a cell costs 0,
+// stepping from the exit of a cell to the entry of a neighbour costs 1. So the distances of the entry
+// states are those of the plain BFS
+PathType Solve_01BFS( const DataStream &m ) {
+    FLC_PROFILE_SCOPE( "Solve_01BFS" );
+
+    auto fNeighbours = [&]( int nCur, auto &&visit ) {
+        if (nCur % 2 == 0) {
+            visit( nCur + 1, 0 );
+            return;
+        }
+        int x = (nCur / 2) % glbMapX, y = (nCur / 2) / glbMapX;
+        for (int dir = 0; dir < 4; dir++) {
+            int nx = x + glbDirX4[dir], ny = y + glbDirY4[dir];
+            if (nx >= 0 && nx < glbMapX && ny >= 0 && ny < glbMapY && m[ny][nx] != '#') {
+                visit( 2 * (ny * glbMapX + nx), 1 );
             }
-        );
+        }
+    };
+    flcPathOptions options;
+    options.nTarget = 2 * (glbEnd.y * glbMapX + glbEnd.x);
+    flcPathResult result = Path01BFS( 2 * glbMapX * glbMapY, { 2 * (glbStart.y * glbMapX + glbStart.x) }, fNeighbours, options );
 
-        // Front of listNotTestedNodes is potentially the lowest distance node. Our
-        // list may also contain nodes that have been visited, so ditch these...
-        while(!listNotTestedNodes.empty() && listNotTestedNodes.front()->bVisited)
-            listNotTestedNodes.pop_front();
-
-        // ...or abort because there are no valid nodes left to test
-        if (!listNotTestedNodes.empty()) {
-
-            nodeCurrent = listNotTestedNodes.front();
-            nodeCurrent->bVisited = true; // We only explore a node once
-
-            // Check each of this node's neighbours...
-            for (auto nodeNeighbour : nodeCurrent->vNeighbours) {
-                // ... and only if the neighbour is not visited and is
-                // not an obstacle, add it to NotTested List
-                if (!nodeNeighbour->bVisited && !nodeNeighbour->bObstacle)
-                    listNotTestedNodes.push_back(nodeNeighbour);
-
-                // Calculate the neighbours potential lowest parent distance
-                // the graph is not weighted so each step to a neighbour is just 1
-                float fPossiblyLowerGoal = nodeCurrent->fLocalGoal + 1;
-
-                // If choosing to path through this node is a lower distance than what
-                // the neighbour currently has set, update the neighbour to use this node
-                // as the path source, and set its distance scores as necessary
-                if (fPossiblyLowerGoal < nodeNeighbour->fLocalGoal) {
-                    nodeNeighbour->parent = nodeCurrent;
-                    nodeNeighbour->fLocalGoal = fPossiblyLowerGoal;
-
-                    // The best path length to the neighbour being tested has changed, so
-                    // update the neighbour's score. The heuristic is used to globally bias
-                    // the path algorithm, so it knows if its getting better or worse. At some
-                    // point the algo will realise this path is worse and abandon it, and then go
-                    // and search along the next best path.
-                    nodeNeighbour->fGlobalGoal = nodeNeighbour->fLocalGoal + heuristic(nodeNeighbour, nodeEnd);
-                }
-            }
+    // the path runs through the entry and the exit state of each cell - only the entry states are kept
+    PathType vPath;
+    for (int nState : result.PathTo( options.nTarget )) {
+        if (nState % 2 == 0) {
+            vPath.push_back( { (nState / 2) % glbMapX, (nState / 2) / glbMapX } );
         }
     }
-
-    return true;
+    return vPath;
 }
 
 // ------------ END OF PATH FINDING STUFF ---------------
 
-// converts the global map addressed via the "nodes" pointer to a printable, character based version
+// converts the map m to a printable, character based version
 // Puts the steps from path p into that map as character 'O'
-DataStream GetVisualMap( PathType &p ) {
+DataStream GetVisualMap( const DataStream &m, const PathType &p ) {
+    FLC_PROFILE_SCOPE( "GetVisualMap" );
     // create and populate character field representing the map
     DataStream vResultMap;
     for (int y = 0; y < glbMapY; y++) {
         std::string sRow;
         for (int x = 0; x < glbMapX; x++) {
-            if (nodes[y * glbMapX + x].bObstacle) {
+            if (m[y][x] == '#') {
                 sRow.append( "#" );
             } else {
                 sRow.append( "." );
@@ -333,13 +263,13 @@ DataStream GetVisualMap( PathType &p ) {
     }
     // add path nodes to it
     for (int i = 0; i < (int)p.size(); i++) {
-        vResultMap[p[i].pNode->pos.y][p[i].pNode->pos.x] = 'O';
+        vResultMap[p[i].y][p[i].x] = 'O';
     }
     return vResultMap;
 }
 
 // Prints a visual image of the map to screen
-void PrintVisualMap( const std::string &sMsg, PathType &p ) {
+void PrintVisualMap( const std::string &sMsg, DataStream &m, PathType &p ) {
     // print message
     std::cout << sMsg << std::endl << std::endl;
     // stats
@@ -350,7 +280,7 @@ void PrintVisualMap( const std::string &sMsg, PathType &p ) {
     std::cout << std::endl;
 
     // prepare and populate visual map
-    DataStream vMap = GetVisualMap( p );
+    DataStream vMap = GetVisualMap( m, p );
     // output it
     for (int y = 0; y < (int)vMap.size(); y++) {
         std::cout << vMap[y] << std::endl;
@@ -358,27 +288,6 @@ void PrintVisualMap( const std::string &sMsg, PathType &p ) {
     std::cout << std::endl;
 }
 
-// After A* has run, get the shortest path from the nodes graph. Note: if no path was found,
-// an empty PathType container will be returned
-PathType ExtractPath() {
-    PathType result;
-    NodeType *cachPtr = nullptr; // to check if the path is complete
-    int nCntr = 0;
-    // walk the nodes graph following the chain of parent pointers
-    // store pointer to the node and step number per path step
-    for (NodeType *ptr = nodeEnd; ptr != nullptr; ptr = ptr->parent) {
-        result.push_front( { nCntr, ptr } );
-        cachPtr = ptr;
-        nCntr += 1;
-    }
-    // previous loop terminated with nullptr ptr, so check if it arrived at the start node
-    if (cachPtr != nodeStart) {
-        // if the start node wasn't reached, the path is not complete, so clear it
-        result.clear();
-    }
-    return result;
-}
-
 // a CheatType struct has two locations, and two indices into the path that are
 // connected (short cut) by the cheat
 typedef struct sCheatStruct {
@@ -413,23 +322,33 @@ LocType Neighbour( LocType &cur, int nDir ) {
     return result;
 }
 
-// if pos is a location that corresponds with a step in path p, then the index of that step is returned
-// this is the same as the step number.
-// If not found, -1 is returned.
-int GetPathStep( PathType &p, LocType &pos ) {
-    int nFound = -1;
-    for (int i = 0; i < (int)p.size() && nFound == -1; i++) {
-        if (p[i].pNode->pos == pos) {
-            nFound = i;
-        }
+// maps the locations of a path to their step numbers, so that looking up a step doesn't need a
+// linear search over the path
+typedef flcCoordMap<int> PathStepMap;
+
+void IndexPath( const PathType &p, PathStepMap &mSteps ) {
+    mSteps.clear();
+    mSteps.Reserve( p.size());
+    for (int i = 0; i < (int)p.size(); i++) {
+        mSteps.Insert( p[i].x, p[i].y, i );
     }
-    return nFound;
+}
+
+// if pos is a location that corresponds with a step in the indexed path, then the index of that step
+// is returned - this is the same as the step number.
+// If not found, -1 is returned.
+int GetPathStep( PathStepMap &mSteps, LocType &pos ) {
+    int *pFound = mSteps.Find( pos.x, pos.y );
+    return (pFound == nullptr) ? -1 : *pFound;
 }
 
 // analyses, collects and returns all cheat options based on the input shortest path pShortest
-CheatStream GetCheatOptions1( PathType &pShortest ) {
-    DataStream vMap = GetVisualMap( pShortest );
+CheatStream GetCheatOptions1( const DataStream &m, const PathType &pShortest ) {
+    FLC_PROFILE_SCOPE( "GetCheatOptions1" );
+    DataStream vMap = GetVisualMap( m, pShortest );
     CheatStream vResultCheats;
+    PathStepMap mSteps;
+    IndexPath( pShortest, mSteps );
 
     // lambda to help addressing of map
     auto GetMapValue = [=]( DataStream &m, LocType &p ) -> char {
@@ -442,7 +361,7 @@ CheatStream GetCheatOptions1( PathType &pShortest ) {
         // if current location is a step in the shortest path
         // and another step in the shortest path is available within 1 or 2 separating wall locations
         // then these 1 or 2 separating wall locations are a cheat option
-        LocType curLoc = pShortest[i].pNode->pos;
+        LocType curLoc = pShortest[i];
         int curStep = i;
 
         // iterate all four directions
@@ -455,7 +374,7 @@ CheatStream GetCheatOptions1( PathType &pShortest ) {
                 InBounds( nghbr1 ) && GetMapValue( vMap, nghbr1 ) == '#' &&
                 InBounds( nghbr2 ) && GetMapValue( vMap, nghbr2 ) == 'O'
             ) {
-                int nextStep = GetPathStep( pShortest, nghbr2 );
+                int nextStep = GetPathStep( mSteps, nghbr2 );
                 if (nextStep > curStep) {
                     // this situation has 2 possible cheats, so add them both --> no! the examples show otherwise!!
 //                    vResultCheats.push_back( { curLoc, nghbr1, curStep, nextStep } );
@@ -468,7 +387,7 @@ CheatStream GetCheatOptions1( PathType &pShortest ) {
                 InBounds( nghbr2 ) && GetMapValue( vMap, nghbr2 ) == '#' &&  // could this also be a '.'?
                 InBounds( nghbr3 ) && GetMapValue( vMap, nghbr3 ) == 'O'
             ) {
-                int nextStep = GetPathStep( pShortest, nghbr3 );
+                int nextStep = GetPathStep( mSteps, nghbr3 );
                 if (nextStep > curStep) {
                     // this situation has only one possible cheat, so add it
                     vResultCheats.push_back( { nghbr1, nghbr2, curStep, nextStep } );
@@ -489,12 +408,12 @@ int GetStepsSaved1( CheatType &c ) {
 // part 2 is a generalization of part 1. Instead of cheat options having 1 or two steps, you now have a set of cheat options
 // having at most 20 steps. A set of locations is created to help examine what the cheat options are.
 
-typedef std::set<LocType> FieldType;
+typedef flcCoordSet FieldType;
 
 // for testing/debugging
 void PrintField( FieldType &f ) {
     for (auto e : f ) {
-        std::cout << e.to_string() << std::endl;
+        std::cout << "(" << e.x << ", " << e.y << ")" << std::endl;
     }
     std::cout << std::endl;
 
@@ -503,8 +422,9 @@ void PrintField( FieldType &f ) {
 // Create a set of offsets (from coord (0, 0)) with a radius of nFieldSize. The radius is the maximum
 // manhattan distance of the offset from (0, 0).
 FieldType GetCheatField( int nFieldSize, bool bOutput = false ) {
+    FLC_PROFILE_SCOPE( "GetCheatField" );
 
-    FieldType vResult;
+    FieldType vResult( 2 * nFieldSize + 1, 2 * nFieldSize + 1, -nFieldSize, -nFieldSize );
     for (int v = UP; v <= DN; v += 2) {   // iterate over 4 quadrants (= combination of a vert + hor direction)
         int yFactor = vOffsets[v].y;
         for (int h = RT; h <= LT; h += 2) {
@@ -513,7 +433,7 @@ FieldType GetCheatField( int nFieldSize, bool bOutput = false ) {
             for (int yOffset = 0; yOffset <= nFieldSize; yOffset++) {
                 int xStart = (yOffset == 0) ? xFactor : 0;
                 for (int xOffset = xStart; xOffset <= nFieldSize - yOffset; xOffset++) {
-                    vResult.insert( { xOffset * xFactor, yOffset * yFactor } );
+                    vResult.Insert( xOffset * xFactor, yOffset * yFactor );
                 }
             }
         }
@@ -528,8 +448,11 @@ FieldType GetCheatField( int nFieldSize, bool bOutput = false ) {
 
 // this function analyses all cheat options using the set of location in parameter cField.
 // it returns a std::vector of CheatType structs.
-CheatStream GetCheatOptions2( PathType &pShortest, FieldType &cField ) {
+CheatStream GetCheatOptions2( const PathType &pShortest, FieldType &cField ) {
+    FLC_PROFILE_SCOPE( "GetCheatOptions2" );
     CheatStream vResultCheats;
+    PathStepMap mSteps;
+    IndexPath( pShortest, mSteps );
 
     // debug info
 //    int nPathLen = pShortest.size();
@@ -541,19 +464,19 @@ CheatStream GetCheatOptions2( PathType &pShortest, FieldType &cField ) {
     // look for shortcuts by walking along the shortest path for the uncheated map
     for (int i = 0; i < (int)pShortest.size(); i++) {
 
-        LocType curLoc = pShortest[i].pNode->pos;
+        LocType curLoc = pShortest[i];
         int curStep = i;
 
         // iterate all offsets in the cheat field, apply them on the current location, and
         // see which ones land on a path location that is indeed a shortcut (and not a cycle backwards)
-        for (auto &e : cField) {
-            LocType curOffset = e;
+        for (auto e : cField) {
+            LocType curOffset = { e.x, e.y };
 
             // If the other (trial) location is in bounds and is indeed a short cut, we found a cheat
             LocType otherLoc = { curLoc.x + curOffset.x, curLoc.y + curOffset.y };
             if (InBounds( otherLoc )) {
 
-                int otherStep = GetPathStep( pShortest, otherLoc );
+                int otherStep = GetPathStep( mSteps, otherLoc );
                 if (otherStep > curStep) {     // Note: this if clause also covers the case where otherStep == -1
                     vResultCheats.push_back( { curLoc, otherLoc, curStep, otherStep } );
                 }
@@ -572,55 +495,35 @@ int GetStepsSaved2( CheatType &c ) {
     return c.n2 - c.n1 - ManhattanDistance( c.s1, c.s2 );
 }
 
-// ==========   MAIN()
-
-int main()
-{
-    glbProgPhase = PUZZLE;     // program phase to EXAMPLE, TEST or PUZZLE
-    std::cout << "Phase: " << ProgPhase2string() << std::endl << std::endl;
-    flcTimer tmr;
+// ==========   PHASE FUNCTIONS
 
-/* ========== */   tmr.StartTiming();   // ============================================vvvvv
+flcSnapshot<DataStream> glbInputData;   // parsed input data - the parts view it read only
+uint64_t glbInputHash;                  // the key of the artifacts of this input
 
-    // get input data, depending on the glbProgPhase (example, test, puzzle)
+// phase 0 - get input data, depending on the glbProgPhase (example, test, puzzle)
+void PrepareInput() {
     DataStream inputData;
     GetInput( inputData, glbProgPhase != PUZZLE );
-    DataStream part2Data = inputData;
-    std::cout << "Data stats - size of data stream " << inputData.size() << std::endl << std::endl;
-
-/* ========== */   tmr.TimeReport( "    Timing 0 - input data preparation: " );   // =========================^^^^^vvvvv
+    glbInputHash = flcArtifactCache::HashLines( inputData );
+    glbInputData = MakeSnapshot( std::move( inputData ));
+}
 
-    // part 1 code here
+// the shortest path (the race track) is found in part 1, and shared with part 2 as artifact "day20.path".
+// It's a vector of plain locations, so it can be persisted with --artifacts
+std::shared_ptr<const PathType> ShortestPath( bool bProduce ) {
+    const DataStream &inputData = *glbInputData;
     InitMap( inputData );
-    PathType vPath;
-
-//    PrintVisualMap( "after init, before A*: ", vPath );
-
-    Solve_AStar();
-    vPath = ExtractPath();
-
-//    PrintVisualMap( "after A*: ", vPath );
+    auto fnCompute = [&]() { return Solve_BFS( inputData ); };
+    flcArtifactCache &cache = flcArtifactCache::Instance();
+    return bProduce ? cache.Produce<PathType>( glbInputHash, "day20.path", fnCompute )
+                    : cache.Consume<PathType>( glbInputHash, "day20.path", fnCompute );
+}
 
-    CheatStream vCheatOptions = GetCheatOptions1( vPath );
+std::shared_ptr<const PathType> glbPart1Path;   // the path of the last part 1 run - for the --verify artifact
 
+int CountCheats1( const DataStream &inputData, const PathType &path ) {
+    CheatStream vCheatOptions = GetCheatOptions1( inputData, path );
     // sort cheat options so that you can count them per yield
-//    std::sort(
-//        vCheatOptions.begin(),
-//        vCheatOptions.end(),
-//        []( CheatType &a, CheatType &b ) {
-//            return GetStepsSaved1( a ) < GetStepsSaved1( b );
-//        }
-//    );
-
-//    for (int i = 0; i < (int)vCheatOptions.size(); i++) {
-//        CheatType &curCheat = vCheatOptions[i];
-//        std::cout << "Cheat option: " << i << " = "
-//                  << curCheat.s1.to_string() << ", " << curCheat.s2.to_string()
-//                  << " from path step: " << curCheat.n1 << " to step: " << curCheat.n2
-//                  << " saves: " << GetStepsSaved1( curCheat ) << " steps..."
-//                  << std::endl;
-//    }
-
     int nCheckNr = (glbProgPhase == PUZZLE ? 100 : 0);
     int nrOptions = std::count_if(
         vCheatOptions.begin(),
@@ -629,47 +532,41 @@ int main()
             return GetStepsSaved1( c ) >= nCheckNr;
         }
     );
+    return nrOptions;
+}
 
+int SolvePart1() {
+    glbPart1Path = ShortestPath( true );
+    return CountCheats1( *glbInputData, *glbPart1Path );
+}
 
-    std::cout << std::endl << "Answer to " << DAY_STRING << " part 1:  = " << nrOptions << std::endl << std::endl;
-
-/* ========== */   tmr.TimeReport( "    Timing 1 - solving puzzle part 1 : " );   // =========================^^^^^vvvvv
-
-    inputData = part2Data; // get fresh untouched copy of input data
+// the same, with the path found by the 0-1 BFS - not shared with part 2
+int SolvePart1_01bfs() {
+    const DataStream &inputData = *glbInputData;
+    InitMap( inputData );
+    glbPart1Path = std::make_shared<const PathType>( Solve_01BFS( inputData ));
+    return CountCheats1( inputData, *glbPart1Path );
+}
 
-    // part 2 code here
+// the race track, as artifact for the --verify mode of the driver
+std::string PathArtifact() {
+    std::string sResult;
+    for (auto &loc : *glbPart1Path) {
+        sResult.append( std::to_string( loc.x ) + "," + std::to_string( loc.y ) + " " );
+    }
+    return sResult;
+}
 
+int SolvePart2() {
+    std::shared_ptr<const PathType> pPath = ShortestPath( false );
     // create coordinate field with radius 20 and exclusion zone at the center
-    FieldType fullField = GetCheatField( 20, false );
-    FieldType exclField = GetCheatField(  1, false );
-    FieldType cheatField;
-    std::set_difference(
-        fullField.begin(), fullField.end(),
-        exclField.begin(), exclField.end(),
-        std::inserter( cheatField, cheatField.begin() )
-    );
-
-//    PrintField( cheatField );
-
-    CheatStream vCheatOptions2 = GetCheatOptions2( vPath, cheatField );
-
-//    std::sort(
-//        vCheatOptions2.begin(),
-//        vCheatOptions2.end(),
-//        []( CheatType &a, CheatType &b ) {
-//            return GetStepsSaved2( a ) < GetStepsSaved2( b );
-//        }
-//    );
-
-//    for (int i = 0; i < (int)vCheatOptions2.size(); i++) {
-//        CheatType &curCheat = vCheatOptions2[i];
-//        std::cout << "Cheat option " << i << " = "
-//                  << curCheat.s1.to_string() << ", " << curCheat.s2.to_string()
-//                  << " from path step: " << curCheat.n1 << " to step: " << curCheat.n2
-//                  << " saves: " << GetStepsSaved2( curCheat ) << " steps..."
-//                  << std::endl;
-//    }
+    FieldType cheatField = GetCheatField( 20, false );
+    FieldType exclField  = GetCheatField(  1, false );
+    for (auto e : exclField) {
+        cheatField.Erase( e.x, e.y );
+    }
 
+    CheatStream vCheatOptions2 = GetCheatOptions2( *pPath, cheatField );
     int nCheckNr2 = (glbProgPhase == PUZZLE ? 100 : 50);
     int nrOptions2 = std::count_if(
         vCheatOptions2.begin(),
@@ -678,10 +575,62 @@ int main()
             return GetStepsSaved2( c ) >= nCheckNr2;
         }
     );
+    return nrOptions2;
+}
+
+}   // namespace day20
+
+// ==========   MAIN()
+
+#ifdef AOC24_DRIVER
+
+// in the aoc24 driver program this day registers its phase functions instead of having a main()
+AOC24_REGISTER_DAY( day20 );
+AOC24_REGISTER_ENGINE( day20, 1, reference, SolvePart1      , PathArtifact );
+AOC24_REGISTER_ENGINE( day20, 1, bfs01    , SolvePart1_01bfs, PathArtifact );
+
+#else
+
+using namespace day20;
+
+int main( int argc, char *argv[] )
+{
+    glbProgPhase = PUZZLE;     // program phase to EXAMPLE, TEST or PUZZLE
+    std::cout << "Phase: " << ProgPhase2string() << std::endl << std::endl;
+    flcBenchmark bench( argc, argv );   // use --warmup <n> and --repeat <n> to get timing statistics
+    bench.SetContext( DAY_STRING, ProgPhase2string());
+
+/* ========== */   bench.RunPhase( "input data preparation", PrepareInput );   // =====================vvvvv
+
+    std::cout << "Data stats - size of data stream " << glbInputData->size() << std::endl << std::endl;
+
+/* ========== */   bench.TimeReport( "    Timing 0 - input data preparation: " );   // =========================^^^^^vvvvv
+
+    // part 1 code here
+
+    int nrOptions;
+    bench.RunPhase( "solving puzzle part 1", [&]() { nrOptions = SolvePart1(); } );
+    bench.SetAnswer( nrOptions );
+
+    std::cout << std::endl << "Answer to " << DAY_STRING << " part 1:  = " << nrOptions << std::endl << std::endl;
+
+/* ========== */   bench.TimeReport( "    Timing 1 - solving puzzle part 1 : " );   // =========================^^^^^vvvvv
+
+    // part 2 code here
+
+    int nrOptions2;
+    bench.RunPhase( "solving puzzle part 2", [&]() { nrOptions2 = SolvePart2(); } );
+    bench.SetAnswer( nrOptions2 );
 
     std::cout << std::endl << "Answer to " << DAY_STRING << " part 2: = " << nrOptions2 << std::endl << std::endl;
 
-/* ========== */   tmr.TimeReport( "    Timing 2 - solving puzzle part 2 : " );   // ==============================^^^^^
+/* ========== */   bench.TimeReport( "    Timing 2 - solving puzzle part 2 : " );   // ==============================^^^^^
+
+    if (bench.GetRepeat() > 1) {
+        bench.SummaryReport();
+    }
 
     return 0;
 }
+
+#endif // AOC24_DRIVER
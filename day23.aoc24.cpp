@@ -16,9 +16,18 @@
 #include <deque>
 
 #include "../flcTimer.h"
+#include "../flcBenchmark.h"
+#include "../flcInputFile.h"
+#include "../flcInputCache.h"
+#include "../flcThreadPool.h"
+#include "../flcArena.h"
+#include "../aoc24_registry.h"
+#include "../flcSnapshot.h"
 #include "../parse_functions.h"
 #include "my_utility.h"
 
+namespace day23 {
+
 // ==========   PROGRAM PHASING
 
 enum eProgPhase {     // what programming phase are you in - set at start of main()
@@ -38,11 +47,14 @@ std::string ProgPhase2string() {
 
 // ==========   INPUT DATA STRUCTURES          <<<<< ========== adapt to match columns of input file
 
-// the data consists of tuples (pairs) of computers indicated with two character names
+// the data consists of tuples (pairs) of computers indicated with two character names - stored as
+// zero terminated char arrays, so that the data stream can be cached as flat records
 typedef struct {
-    std::string c1, c2;
+    char c1[3], c2[3];
 } DatumType;
 typedef std::vector<DatumType> DataStream;
+// identifies the layout of DatumType in the input cache - change it if the layout changes
+#define INPUT_CACHE_TAG  DAY_STRING ".v1"
 
 // ==========   INPUT DATA FUNCTIONS
 
@@ -88,20 +100,25 @@ void GetData_EXAMPLE( DataStream &dData ) {
 // file input - this function reads text file content one line at a time - adapt code to match your need for line parsing!
 void ReadInputData( const std::string sFileName, DataStream &vData ) {
 
-    std::ifstream dataFileStream( sFileName );
+    flcInputFile dataFile( sFileName );
     vData.clear();
-    std::string sLine;
-    while (getline( dataFileStream, sLine )) {
-        std::string sC1, sC2;
+    // with --cache, the parsed data of an earlier run is reused if the input file didn't change
+    if (flcInputCache::Load( dataFile, INPUT_CACHE_TAG, vData )) {
+        return;
+    }
+    for (std::string_view sLine : dataFile.Lines()) {
+        std::string_view sC1, sC2;
         split_token_dlmtd( "-", sLine, sC1, sC2 );
-        DatumType cDatum = { sC1, sC2 };
+        DatumType cDatum = {};
+        sC1.copy( cDatum.c1, 2 );
+        sC2.copy( cDatum.c2, 2 );
         vData.push_back( cDatum );
     }
-    dataFileStream.close();
+    flcInputCache::Save( dataFile, INPUT_CACHE_TAG, vData );
 }
 
-void GetData_TEST(   DataStream &dData ) { std::string sInputFile = DAY_STRING; sInputFile.append( ".input.test.txt"   ); ReadInputData( sInputFile, dData ); }
-void GetData_PUZZLE( DataStream &dData ) { std::string sInputFile = DAY_STRING; sInputFile.append( ".input.puzzle.txt" ); ReadInputData( sInputFile, dData ); }
+void GetData_TEST(   DataStream &dData ) { std::string sInputFile = GetInputFileName( DAY_STRING, "test"   ); ReadInputData( sInputFile, dData ); }
+void GetData_PUZZLE( DataStream &dData ) { std::string sInputFile = GetInputFileName( DAY_STRING, "puzzle" ); ReadInputData( sInputFile, dData ); }
 
 // ==========   CONSOLE OUTPUT FUNCTIONS
 
@@ -143,12 +160,16 @@ void GetInput( DataStream &dData, bool bDisplay = false ) {
 
 struct sGraphNode;  // forward declare
 
-// a GraphType object is a std::map of graph nodes, searchable by their id string
-typedef std::map<std::string, sGraphNode *> GraphType;
+// a GraphType object is a std::map of graph nodes, searchable by their id string. The graph nodes and
+// the map entries are all allocated in one arena, and freed together when the graph is assembled again
+typedef std::map<std::string, sGraphNode *, std::less<std::string>,
+                 flcArenaAllocator<std::pair<const std::string, sGraphNode *>>> GraphType;
 
 typedef struct sGraphNode {
     std::string sComputer;
     GraphType vNeighbours;    // set of neighbours is not a graph, but needs the same functionality
+
+    sGraphNode( flcArena &arena ) : vNeighbours( GraphType::allocator_type( arena )) {}
 } GraphNodeType;
 
 void PrintGraphNode( GraphNodeType *pNode ) {
@@ -164,8 +185,8 @@ void PrintGraphNode( GraphNodeType *pNode ) {
     }
 }
 
-GraphNodeType *NewGraphNode( std::string &sCompID ) {
-    GraphNodeType *pRes = new GraphNodeType;
+GraphNodeType *NewGraphNode( flcArena &arena, std::string &sCompID ) {
+    GraphNodeType *pRes = arena.New<GraphNodeType>( arena );
     pRes->sComputer = sCompID;
     return pRes;
 }
@@ -216,7 +237,8 @@ void PrintGraph( GraphType &g, std::string sMsg = "" ) {
     }
 }
 
-void AssembleGraph( GraphType &g, DataStream &gData ) {
+// the nodes are created in arena, which must be the arena g allocates from
+void AssembleGraph( flcArena &arena, GraphType &g, const DataStream &gData ) {
     g.clear();
     for (int i = 0; i < (int)gData.size(); i++) {
 
@@ -226,7 +248,7 @@ void AssembleGraph( GraphType &g, DataStream &gData ) {
         GraphNodeType *p1 = FindGraphNode( g, sComp1 );
         if (p1 == nullptr) {
             // if the graph node didn't exist yet, create and insert it (while retaining the pointer)
-            p1 = NewGraphNode( sComp1 );
+            p1 = NewGraphNode( arena, sComp1 );
             AddGraphNode( g, p1 );
         }
 
@@ -234,7 +256,7 @@ void AssembleGraph( GraphType &g, DataStream &gData ) {
         GraphNodeType *p2 = FindGraphNode( g, sComp2 );
         if (p2 == nullptr) {
             // if the graph node didn't exist yet, create and insert it (while retaining the pointer)
-            p2 = NewGraphNode( sComp2 );
+            p2 = NewGraphNode( arena, sComp2 );
             AddGraphNode( g, p2 );
         }
         // now add the connection between the two nodes
@@ -352,38 +374,39 @@ CliqueType GetCliqueFromNode( GraphType &g, GraphNodeType *strtNode ) {
     return vResult;
 }
 
-// ==========   MAIN()
+// ==========   PHASE FUNCTIONS
 
-int main()
-{
-    glbProgPhase = PUZZLE;     // program phase to EXAMPLE, TEST or PUZZLE
-    std::cout << "Phase: " << ProgPhase2string() << std::endl << std::endl;
-    flcTimer tmr;
+flcSnapshot<DataStream> glbInputData;   // parsed input data - the parts view it read only
 
-/* ========== */   tmr.StartTiming();   // ============================================vvvvv
+flcArena  glbGraphArena;   // holds all nodes and map entries of glbGraph
+GraphType glbGraph{ GraphType::allocator_type( glbGraphArena ) };    // the graph is assembled in part 1, and used read only in part 2
 
-    // get input data, depending on the glbProgPhase (example, test, puzzle)
+// the graph lives in an arena, so it isn't shared as an artifact. Instead these count the inputs, so
+// that part 2 can tell whether glbGraph was assembled from the current one
+int glbInputNr = 0;
+int glbGraphNr = -1;
+
+// phase 0 - get input data, depending on the glbProgPhase (example, test, puzzle)
+void PrepareInput() {
     DataStream inputData;
     GetInput( inputData, glbProgPhase != PUZZLE );
-    DataStream part2Data = inputData;
-    std::cout << "Data stats - size of data stream " << inputData.size() << std::endl << std::endl;
-
-/* ========== */   tmr.TimeReport( "    Timing 0 - input data preparation: " );   // =========================^^^^^vvvvv
-
-    // part 1 code here
-    GraphType glbGraph;
-    AssembleGraph( glbGraph, inputData );
+    glbInputData = MakeSnapshot( std::move( inputData ));
+    glbInputNr += 1;
+}
 
-//    PrintGraph( glbGraph, "Graph after assembly" );
+void BuildGraph() {
+    // drop the graph of a previous run before its memory is reused
+    glbGraph.clear();
+    glbGraphArena.Reset();
+    AssembleGraph( glbGraphArena, glbGraph, *glbInputData );
+    glbGraphNr = glbInputNr;
+}
 
+int SolvePart1() {
+    BuildGraph();
     std::set<TripletType> sSetsOfThree;
     FindSetsOfThree( glbGraph, sSetsOfThree );
 
-//    std::cout << "Sets of three before filtering: " << std::endl;
-//    for (auto s : sSetsOfThree) {
-//        std::cout << s.ToString() << std::endl;
-//    }
-
     // filter all triplets without any t-starting computers in it
     std::set<TripletType> sAuxSet;
     for (auto &s : sSetsOfThree) {
@@ -393,51 +416,85 @@ int main()
     }
     sSetsOfThree.clear();
     sSetsOfThree = sAuxSet;
+    return sSetsOfThree.size();
+}
+
+// the cliques per start node are independent of each other, so they are searched in parallel. The
+// reduction keeps the first largest clique in the order of the graph, like a serial loop would
+std::string SolvePart2() {
+    // the graph comes from part 1 - it's only assembled here if part 2 runs on its own
+    if (glbGraphNr != glbInputNr) {
+        BuildGraph();
+    }
+    std::vector<GraphNodeType *> vNodes;
+    for (auto &n : glbGraph) {
+        vNodes.push_back( n.second );
+    }
+    CliqueType vLongestClique = parallel_reduce( 0, (int)vNodes.size(), CliqueType(),
+        [&]( int i ) { return GetCliqueFromNode( glbGraph, vNodes[i] ); },
+        []( const CliqueType &a, const CliqueType &b ) { return (b.size() > a.size()) ? b : a; }
+    );
+    // assemble longest clique as a string to output the answer
+    std::string sLongestClique;
+    for (int i = 0; i < (int)vLongestClique.size(); i++) {
+        sLongestClique.append( vLongestClique[i] );
+        sLongestClique.append( "," );
+    }
+    sLongestClique = sLongestClique.substr( 0, sLongestClique.length() - 1 ); // strip off trailing ','
+    return sLongestClique;
+}
 
-//    std::cout << "Sets of three after filtering: " << std::endl;
-//    for (auto s : sSetsOfThree) {
-//        std::cout << s.ToString() << std::endl;
-//    }
+}   // namespace day23
 
-    std::cout << std::endl << "Answer to " << DAY_STRING << " part 1: nr of sets of three containing at least one t started id = " << sSetsOfThree.size() << std::endl << std::endl;
+// ==========   MAIN()
 
-/* ========== */   tmr.TimeReport( "    Timing 1 - solving puzzle part 1 : " );   // =========================^^^^^vvvvv
+#ifdef AOC24_DRIVER
 
-    inputData = part2Data; // get fresh untouched copy of input data
+// in the aoc24 driver program this day registers its phase functions instead of having a main()
+AOC24_REGISTER_DAY( day23 );
 
-    // part 2 code here
+#else
 
-    CliqueType vLongestClique;
-    int nMaxLen = -1;
-    for (auto n : glbGraph) {
+using namespace day23;
 
-        CliqueType curClique = GetCliqueFromNode( glbGraph, n.second );
+int main( int argc, char *argv[] )
+{
+    glbProgPhase = PUZZLE;     // program phase to EXAMPLE, TEST or PUZZLE
+    std::cout << "Phase: " << ProgPhase2string() << std::endl << std::endl;
+    flcBenchmark bench( argc, argv );   // use --warmup <n> and --repeat <n> to get timing statistics
+    bench.SetContext( DAY_STRING, ProgPhase2string());
 
-        if (nMaxLen < (int)curClique.size()) {
-            vLongestClique = curClique;
-            nMaxLen = curClique.size();
-        }
+/* ========== */   bench.RunPhase( "input data preparation", PrepareInput );   // =====================vvvvv
 
-//        std::cout << "Node: ";
-//        PrintGraphNode( n.second );
-//        std::cout << " clique - size: " << curClique.size() << ", elements: ";
-//        for (int i = 0; i < (int)curClique.size(); i++) {
-//            std::cout << curClique[i] << ",";
-//        }
-//        std::cout << std::endl;
-    }
+    std::cout << "Data stats - size of data stream " << glbInputData->size() << std::endl << std::endl;
+
+/* ========== */   bench.TimeReport( "    Timing 0 - input data preparation: " );   // =========================^^^^^vvvvv
+
+    // part 1 code here
+
+    int nSetsOfThree;
+    bench.RunPhase( "solving puzzle part 1", [&]() { nSetsOfThree = SolvePart1(); } );
+    bench.SetAnswer( nSetsOfThree );
+
+    std::cout << std::endl << "Answer to " << DAY_STRING << " part 1: nr of sets of three containing at least one t started id = " << nSetsOfThree << std::endl << std::endl;
+
+/* ========== */   bench.TimeReport( "    Timing 1 - solving puzzle part 1 : " );   // =========================^^^^^vvvvv
+
+    // part 2 code here
 
-    // assemble longest clique as a string to output the answer
     std::string sLongestClique;
-    for (int i = 0; i < (int)vLongestClique.size(); i++) {
-        sLongestClique.append( vLongestClique[i] );
-        sLongestClique.append( "," );
-    }
-    sLongestClique = sLongestClique.substr( 0, sLongestClique.length() - 1 ); // strip off trailing ','
+    bench.RunPhase( "solving puzzle part 2", [&]() { sLongestClique = SolvePart2(); } );
+    bench.SetAnswer( sLongestClique );
 
     std::cout << std::endl << "Answer to " << DAY_STRING << " part 2: largest sub graph with full connectivity = " << sLongestClique << std::endl << std::endl;
 
-/* ========== */   tmr.TimeReport( "    Timing 2 - solving puzzle part 2 : " );   // ==============================^^^^^
+/* ========== */   bench.TimeReport( "    Timing 2 - solving puzzle part 2 : " );   // ==============================^^^^^
+
+    if (bench.GetRepeat() > 1) {
+        bench.SummaryReport();
+    }
 
     return 0;
 }
+
+#endif // AOC24_DRIVER
@@ -0,0 +1,125 @@
+// AoC 2024 - arena (bump) allocator
+// =================================
+
+// date:  2025-02-01
+// by:    Joseph21 (Joseph21-6147)
+
+#include <cstdint>
+#include <cstdlib>
+
+#include "flcArena.h"
+
+#if defined( __linux__ )
+#include <sys/mman.h>
+#define FLC_ARENA_MMAP
+#endif
+
+static const size_t HUGE_PAGE_SIZE = flcArena::HUGE_PAGE_SIZE;
+
+// gets a block of at least nSize bytes from the system - nSize is set to the actual size of the block
+static char *SystemAlloc( size_t &nSize, bool &bMapped ) {
+    bMapped = false;
+#ifdef FLC_ARENA_MMAP
+    if (nSize >= HUGE_PAGE_SIZE) {
+        // map one huge page extra, and unmap the parts in front of and after the aligned block
+        nSize = (nSize + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+        size_t nMapSize = nSize + HUGE_PAGE_SIZE;
+        void *pMap = mmap( nullptr, nMapSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+        if (pMap != MAP_FAILED) {
+            char *pStart = static_cast<char *>( pMap );
+            char *pData  = reinterpret_cast<char *>( (reinterpret_cast<uintptr_t>( pStart ) + HUGE_PAGE_SIZE - 1) & ~(uintptr_t)(HUGE_PAGE_SIZE - 1));
+            size_t nHead = pData - pStart;
+            if (nHead > 0) {
+                munmap( pStart, nHead );
+            }
+            if (nMapSize - nHead > nSize) {
+                munmap( pData + nSize, nMapSize - nHead - nSize );
+            }
+#ifdef MADV_HUGEPAGE
+            madvise( pData, nSize, MADV_HUGEPAGE );    // just advice - failing is fine
+#endif
+            bMapped = true;
+            return pData;
+        }
+    }
+#endif
+    char *pData = static_cast<char *>( malloc( nSize ));
+    if (pData == nullptr) {
+        throw std::bad_alloc();
+    }
+    return pData;
+}
+
+static void SystemFree( char *pData, size_t nSize, bool bMapped ) {
+#ifdef FLC_ARENA_MMAP
+    if (bMapped) {
+        munmap( pData, nSize );
+        return;
+    }
+#endif
+    (void)nSize;
+    (void)bMapped;
+    free( pData );
+}
+
+// ==============================/ Class flcArena /==============================
+
+void flcArena::NextBlock( size_t nMinBytes ) {
+    // reuse the next block if there is one after a Reset(), and it's large enough
+    while (m_nCurBlock + 1 < (int)m_vBlocks.size()) {
+        m_nCurBlock += 1;
+        m_nUsed = 0;
+        if (m_vBlocks[m_nCurBlock].nSize >= nMinBytes) {
+            return;
+        }
+    }
+    // allocations larger than the block size get a block of their own size
+    BlockType newBlock;
+    newBlock.nSize = (nMinBytes > m_nBlockSize) ? nMinBytes : m_nBlockSize;
+    newBlock.pData = SystemAlloc( newBlock.nSize, newBlock.bMapped );
+    m_vBlocks.push_back( newBlock );
+    m_nCurBlock = (int)m_vBlocks.size() - 1;
+    m_nUsed = 0;
+}
+
+void flcArena::AddDestructor( void (*fDestroy)( void * ), void *pObject ) {
+    DestructorType *pEntry = static_cast<DestructorType *>( Allocate( sizeof( DestructorType ), alignof( DestructorType )));
+    pEntry->fDestroy = fDestroy;
+    pEntry->pObject  = pObject;
+    pEntry->pNext    = m_pDestructors;
+    m_pDestructors = pEntry;
+}
+
+// the list runs from the newest to the oldest object, so objects are destroyed in reverse order of creation
+void flcArena::RunDestructors() {
+    for (DestructorType *pEntry = m_pDestructors; pEntry != nullptr; pEntry = pEntry->pNext) {
+        pEntry->fDestroy( pEntry->pObject );
+    }
+    m_pDestructors = nullptr;
+}
+
+void flcArena::Reset() {
+    RunDestructors();
+    m_nCurBlock  = m_vBlocks.empty() ? -1 : 0;
+    m_nUsed      = 0;
+    m_nBytesUsed = 0;
+}
+
+void flcArena::Release() {
+    RunDestructors();
+    for (BlockType &block : m_vBlocks) {
+        SystemFree( block.pData, block.nSize, block.bMapped );
+    }
+    m_vBlocks.clear();
+    m_nCurBlock  = -1;
+    m_nUsed      = 0;
+    m_nBytesUsed = 0;
+}
+
+size_t flcArena::BytesReserved() const {
+    size_t nTotal = 0;
+    for (const BlockType &block : m_vBlocks) {
+        nTotal += block.nSize;
+    }
+    return nTotal;
+}
@@ -0,0 +1,202 @@
+// AoC 2024 - arena (bump) allocator
+// =================================
+
+// date:  2025-02-01
+// by:    Joseph21 (Joseph21-6147)
+
+// An flcArena hands out memory from a few large blocks by just moving a pointer forward. There's no
+// per object free: all memory of the arena is given back in one step with Reset() (keeps the blocks
+// for reuse) or Release() (returns them to the system, also done by the destructor). That makes it a
+// good fit for data structures that are built once and then dropped as a whole, like the graphs and
+// node sets of a puzzle.
+//
+//   * Allocate( nBytes, nAlign )  - raw memory
+//   * New<T>( args... )           - constructs a T in the arena. If T has a non trivial destructor,
+//                                   that is called on Reset() / Release()
+//   * flcArenaAllocator<T>        - standard allocator, so std containers can live in an arena, e.g.
+//                                   std::vector<int, flcArenaAllocator<int>> v( flcArenaAllocator<int>( arena ));
+//                                   (day 23 keeps its graph map in an arena this way)
+//   * flcArenaLists<T>            - a fixed nr of growable lists (e.g. the neighbours or predecessors
+//                                   per node) with their entries in the arena
+//
+// Blocks of at least 2 MB (the default block size) are requested with mmap() where the platform has
+// that (Linux). Their size is rounded up to a multiple of 2 MB, the mapping is aligned to 2 MB, and it's
+// marked for transparent huge pages - which saves TLB misses on large graphs. madvise() can only back
+// whole, aligned huge pages, so a smaller or unaligned block wouldn't get any. Smaller blocks (an
+// arena constructed with a smaller block size) come from malloc().
+//
+// NOTE: an flcArena is not thread safe - use one arena per thread if needed.
+
+#ifndef FLCARENA_H
+#define FLCARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// ==============================/ Class flcArena /==============================
+
+class flcArena {
+public:
+    static const size_t HUGE_PAGE_SIZE     = 2 << 20;           // 2 MB - blocks of at least this size are mapped
+    static const size_t DEFAULT_BLOCK_SIZE = HUGE_PAGE_SIZE;
+
+    flcArena( size_t nBlockSize = DEFAULT_BLOCK_SIZE ) : m_nBlockSize( nBlockSize ) {}
+    ~flcArena() { Release(); }
+    flcArena( const flcArena & ) = delete;
+    flcArena &operator = ( const flcArena & ) = delete;
+
+    // returns nBytes of memory aligned to nAlign (a power of 2). Never returns nullptr - if the system
+    // is out of memory std::bad_alloc is thrown, like operator new does
+    void *Allocate( size_t nBytes, size_t nAlign = alignof( std::max_align_t )) {
+        size_t nOffset = m_nCurBlock < 0 ? 0 : AlignedOffset( nAlign );
+        if (m_nCurBlock < 0 || nOffset + nBytes > m_vBlocks[m_nCurBlock].nSize) {
+            NextBlock( nBytes + nAlign );
+            nOffset = AlignedOffset( nAlign );
+        }
+        m_nUsed = nOffset + nBytes;
+        m_nBytesUsed += nBytes;
+        return m_vBlocks[m_nCurBlock].pData + nOffset;
+    }
+
+    // constructs a T in the arena
+    template <typename T, typename... Args>
+    T *New( Args &&...args ) {
+        T *pObject = new (Allocate( sizeof( T ), alignof( T ))) T( std::forward<Args>( args )... );
+        if (!std::is_trivially_destructible<T>::value) {
+            AddDestructor( []( void *p ) { static_cast<T *>( p )->~T(); }, pObject );
+        }
+        return pObject;
+    }
+
+    // runs the pending destructors and makes all memory available again, keeping the blocks
+    void Reset();
+    // runs the pending destructors and returns all blocks to the system
+    void Release();
+
+    size_t BytesUsed()     const { return m_nBytesUsed; }    // sum of the allocation sizes since the last Reset()
+    size_t BytesReserved() const;                             // sum of the block sizes
+    int    BlockCount()    const { return (int)m_vBlocks.size(); }
+
+private:
+    typedef struct sBlockStruct {
+        char  *pData;
+        size_t nSize;
+        bool   bMapped;    // from mmap() instead of malloc()
+    } BlockType;
+
+    // destructors to run on Reset() / Release(), kept as a linked list in the arena itself
+    typedef struct sDestructorStruct {
+        void (*fDestroy)( void * );
+        void  *pObject;
+        sDestructorStruct *pNext;
+    } DestructorType;
+
+    // the first offset in the current block at or after m_nUsed whose address is aligned to nAlign. The
+    // address is aligned, not the offset - a block from malloc() is only aligned to max_align_t
+    size_t AlignedOffset( size_t nAlign ) const {
+        uintptr_t nAddress = reinterpret_cast<uintptr_t>( m_vBlocks[m_nCurBlock].pData ) + m_nUsed;
+        return m_nUsed + (((nAddress + nAlign - 1) & ~(uintptr_t)(nAlign - 1)) - nAddress);
+    }
+    // continues in the next block that can hold nMinBytes, allocating one if needed
+    void NextBlock( size_t nMinBytes );
+    void AddDestructor( void (*fDestroy)( void * ), void *pObject );
+    void RunDestructors();
+
+    size_t m_nBlockSize;
+    std::vector<BlockType> m_vBlocks;
+    int    m_nCurBlock  = -1;    // index of the block that's being filled
+    size_t m_nUsed      = 0;     // bytes used in that block
+    size_t m_nBytesUsed = 0;
+    DestructorType *m_pDestructors = nullptr;
+};
+
+// ==============================/ Class flcArenaAllocator /==============================
+
+// allocator for std containers. deallocate() does nothing, the memory comes back when the arena is
+// reset or released - so the container must not be used after that
+template <typename T>
+class flcArenaAllocator {
+public:
+    typedef T value_type;
+
+    flcArenaAllocator( flcArena &arena ) : m_pArena( &arena ) {}
+    template <typename U>
+    flcArenaAllocator( const flcArenaAllocator<U> &other ) : m_pArena( other.m_pArena ) {}
+
+    T *allocate( size_t n ) { return static_cast<T *>( m_pArena->Allocate( n * sizeof( T ), alignof( T ))); }
+    void deallocate( T *, size_t ) {}
+
+    template <typename U> bool operator == ( const flcArenaAllocator<U> &rhs ) const { return m_pArena == rhs.m_pArena; }
+    template <typename U> bool operator != ( const flcArenaAllocator<U> &rhs ) const { return m_pArena != rhs.m_pArena; }
+
+    flcArena *m_pArena;
+};
+
+// ==============================/ Class flcArenaLists /==============================
+
+// nLists lists of values of type T, e.g. the neighbours or predecessors per node. Only the list heads
+// are one array; the entries are linked and live in the arena. Adding puts an entry in front.
+template <typename T>
+class flcArenaLists {
+private:
+    typedef struct sEntryStruct {
+        T value;
+        sEntryStruct *pNext;
+    } EntryType;
+
+public:
+    class iterator {
+    public:
+        iterator( const EntryType *pEntry ) : m_pEntry( pEntry ) {}
+        const T &operator * () const { return m_pEntry->value; }
+        iterator &operator ++ () { m_pEntry = m_pEntry->pNext; return *this; }
+        bool operator != ( const iterator &rhs ) const { return m_pEntry != rhs.m_pEntry; }
+    private:
+        const EntryType *m_pEntry;
+    };
+
+    // view on one list, usable in range based for loops
+    class ListView {
+    public:
+        ListView( const EntryType *pFirst ) : m_pFirst( pFirst ) {}
+        iterator begin() const { return iterator( m_pFirst ); }
+        iterator end()   const { return iterator( nullptr ); }
+        bool empty() const { return m_pFirst == nullptr; }
+    private:
+        const EntryType *m_pFirst;
+    };
+
+    flcArenaLists() {}
+    flcArenaLists( flcArena &arena, int nLists ) { Init( arena, nLists ); }
+
+    // (re)initializes to nLists empty lists
+    void Init( flcArena &arena, int nLists ) {
+        static_assert( std::is_trivially_destructible<T>::value, "flcArenaLists: T must be trivially destructible" );
+        m_pArena = &arena;
+        m_vHeads.assign( nLists, nullptr );
+    }
+
+    int  ListCount() const { return (int)m_vHeads.size(); }
+    bool empty()     const { return m_vHeads.empty(); }
+
+    void Add( int nList, const T &value ) {
+        EntryType *pEntry = static_cast<EntryType *>( m_pArena->Allocate( sizeof( EntryType ), alignof( EntryType )));
+        pEntry->value = value;
+        pEntry->pNext = m_vHeads[nList];
+        m_vHeads[nList] = pEntry;
+    }
+    // empties one list - its entries stay in the arena until that is reset
+    void Clear( int nList ) { m_vHeads[nList] = nullptr; }
+
+    ListView operator [] ( int nList ) const { return ListView( m_vHeads[nList] ); }
+
+private:
+    flcArena *m_pArena = nullptr;
+    std::vector<EntryType *> m_vHeads;
+};
+
+#endif // FLCARENA_H
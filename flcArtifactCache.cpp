@@ -0,0 +1,147 @@
+// AoC 2024 - cache of intermediate results shared by the parts
+// ============================================================
+
+// date:  2025-02-07
+// by:    Joseph21 (Joseph21-6147)
+
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#include "flcArtifactCache.h"
+#include "flcInputCache.h"
+
+// layout of the header at the start of each artifact file
+typedef struct sArtifactHeaderStruct {
+    char     cMagic[8];      // "FLCARTIF"
+    uint32_t nVersion;       // FLC_ARTIFACT_VERSION
+    uint32_t nRecordSize;    // sizeof() of one record
+    uint64_t nInputHash;     // hash of the input the artifact was computed from
+    uint64_t nNameHash;      // hash of the artifact name
+    uint64_t nCount;         // nr of records following the header
+} ArtifactHeaderType;
+
+static const char *glbArtifactMagic = "FLCARTIF";
+
+// ==============================/ Class flcArtifactCache /==============================
+
+flcArtifactCache &flcArtifactCache::Instance() {
+    static flcArtifactCache instance;
+    return instance;
+}
+
+uint64_t flcArtifactCache::HashLines( const std::vector<std::string> &vLines ) {
+    uint64_t nHash = FLC_FNV_OFFSET_BASIS;
+    for (auto &sLine : vLines) {
+        nHash = flcInputCache::HashContent( sLine, nHash );
+        nHash = flcInputCache::HashContent( "\n", nHash );    // so that the line breaks count
+    }
+    return nHash;
+}
+
+void flcArtifactCache::Clear() {
+    std::lock_guard<std::mutex> lock( m_mutex );
+    m_mEntries.clear();
+}
+
+std::shared_ptr<const void> flcArtifactCache::FindEntry( uint64_t nInputHash, const std::string &sName, std::type_index type ) {
+    std::lock_guard<std::mutex> lock( m_mutex );
+    auto iter = m_mEntries.find( { sName, nInputHash } );
+    if (iter == m_mEntries.end()) {
+        return nullptr;
+    }
+    if (iter->second.type != type) {
+        std::cout << "ERROR: flcArtifactCache::FindEntry() --> artifact requested with another type than it was published with: " << sName << std::endl;
+        return nullptr;
+    }
+    return iter->second.pArtifact;
+}
+
+void flcArtifactCache::StoreEntry( uint64_t nInputHash, const std::string &sName, std::type_index type, std::shared_ptr<const void> pArtifact ) {
+    std::lock_guard<std::mutex> lock( m_mutex );
+    ArtifactEntryType &entry = m_mEntries[{ sName, nInputHash }];
+    entry.nStored   = ++m_nStored;
+    entry.type      = type;
+    entry.pArtifact = pArtifact;
+
+    // the entries of one name are adjacent in the map - if there are too many, drop the least recently stored one
+    auto iterFirst = m_mEntries.lower_bound( { sName, 0 } );
+    auto iterOldest = iterFirst;
+    int nEntries = 0;
+    for (auto iter = iterFirst; iter != m_mEntries.end() && iter->first.first == sName; iter++) {
+        nEntries += 1;
+        if (iter->second.nStored < iterOldest->second.nStored) {
+            iterOldest = iter;
+        }
+    }
+    if (nEntries > FLC_ARTIFACT_INPUTS_PER_NAME) {
+        m_mEntries.erase( iterOldest );
+    }
+}
+
+// ==========   PERSISTING
+
+// one file per artifact name and input, e.g. "<dir>/day20.path.0123456789abcdef.artifact"
+std::string flcArtifactCache::FileName( uint64_t nInputHash, const std::string &sName ) {
+    std::stringstream ss;
+    ss << m_sPersistDir << "/" << sName << "." << std::hex << std::setw( 16 ) << std::setfill( '0' ) << nInputHash << ".artifact";
+    return ss.str();
+}
+
+bool flcArtifactCache::ReadFile( uint64_t nInputHash, const std::string &sName, size_t nRecordSize, std::vector<char> &vBytes, size_t &nCount ) {
+    std::string sFileName = FileName( nInputHash, sName );
+    // a missing file is not an error, the artifact wasn't persisted yet
+    FILE *pFile = fopen( sFileName.c_str(), "rb" );
+    if (pFile == nullptr) {
+        return false;
+    }
+    ArtifactHeaderType header;
+    bool bValid = (
+        fread( &header, sizeof( header ), 1, pFile ) == 1 &&
+        memcmp( header.cMagic, glbArtifactMagic, sizeof( header.cMagic )) == 0 &&
+        header.nVersion    == FLC_ARTIFACT_VERSION &&
+        header.nRecordSize == nRecordSize &&
+        header.nInputHash  == nInputHash &&
+        header.nNameHash   == flcInputCache::HashContent( sName )
+    );
+    if (bValid) {
+        nCount = (size_t)header.nCount;
+        vBytes.resize( nCount * nRecordSize );
+        bValid = vBytes.empty() || fread( vBytes.data(), 1, vBytes.size(), pFile ) == vBytes.size();
+    }
+    fclose( pFile );
+    return bValid;
+}
+
+bool flcArtifactCache::WriteFile( uint64_t nInputHash, const std::string &sName, size_t nRecordSize, const void *pData, size_t nCount ) {
+    ArtifactHeaderType header;
+    memcpy( header.cMagic, glbArtifactMagic, sizeof( header.cMagic ));
+    header.nVersion    = FLC_ARTIFACT_VERSION;
+    header.nRecordSize = (uint32_t)nRecordSize;
+    header.nInputHash  = nInputHash;
+    header.nNameHash   = flcInputCache::HashContent( sName );
+    header.nCount      = nCount;
+
+    // write to a temporary file first, so that an interrupted run never leaves a half written artifact
+    std::string sFileName = FileName( nInputHash, sName );
+    std::string sTempFile = sFileName + ".tmp";
+    FILE *pFile = fopen( sTempFile.c_str(), "wb" );
+    if (pFile == nullptr) {
+        std::cout << "ERROR: flcArtifactCache::WriteFile() --> can't create file: " << sTempFile << std::endl;
+        return false;
+    }
+    bool bOK = (fwrite( &header, sizeof( header ), 1, pFile ) == 1);
+    if (bOK && nCount > 0) {
+        bOK = (fwrite( pData, nRecordSize, nCount, pFile ) == nCount);
+    }
+    bOK = (fclose( pFile ) == 0) && bOK;
+    if (bOK) {
+        bOK = (rename( sTempFile.c_str(), sFileName.c_str()) == 0);
+    }
+    if (!bOK) {
+        std::cout << "ERROR: flcArtifactCache::WriteFile() --> can't write file: " << sFileName << std::endl;
+        remove( sTempFile.c_str());
+    }
+    return bOK;
+}
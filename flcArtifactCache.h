@@ -0,0 +1,157 @@
+// AoC 2024 - cache of intermediate results shared by the parts
+// ============================================================
+
+// date:  2025-02-07
+// by:    Joseph21 (Joseph21-6147)
+
+// Part 2 of a day often needs an intermediate result that part 1 has computed already: the shortest paths
+// of day 16, the race track of day 20, the pattern trie of day 19. Passing those along in a global
+// variable only works if part 1 ran before part 2, on the same input. Instead, the parts share them as
+// artifacts: immutable objects keyed on a hash of the input they were computed from and a name.
+//
+//     // part 1 - always computes the artifact, and publishes it
+//     auto pPaths = flcArtifactCache::Instance().Produce<flcPathResult>( glbInputHash, "day16.paths",
+//                       [&]() { return AnalyseShortestPaths( inputData, glbSrcPos ); } );
+//     // part 2 - takes the artifact if it's there, otherwise computes and publishes it
+//     auto pPaths = flcArtifactCache::Instance().Consume<flcPathResult>( glbInputHash, "day16.paths", ... );
+//
+// Both return a std::shared_ptr<const T>. Produce() computes the artifact each time, so the timing of the
+// part that produces it doesn't change when it's repeated (--repeat). A part that consumes an artifact
+// skips that work, and still works when it runs on its own (--part 2).
+//
+// Artifacts of the type std::vector<T>, with T trivially copyable, can also be persisted to disk:
+// with --artifacts <dir> on the command line (see flcBenchmark) they are written to <dir>, and both
+// Produce() and Consume() load them from there when the input hash matches, so later runs skip the
+// computation altogether. The files have a header like those of flcInputCache, and are not portable
+// between machines with a different byte order.
+//
+// The artifacts are kept in memory per (name, input hash), so switching between a few inputs (like --verify
+// does) doesn't throw them away. Per name only the FLC_ARTIFACT_INPUTS_PER_NAME most recently stored inputs
+// are kept, so running many inputs (like --scaling does) doesn't pile them up. The cache may be used from
+// more than one thread.
+
+#ifndef FLCARTIFACTCACHE_H
+#define FLCARTIFACTCACHE_H
+
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <typeindex>
+#include <utility>
+#include <vector>
+
+// bump this if the layout of the artifact files changes
+#define FLC_ARTIFACT_VERSION 1
+
+// nr of inputs per artifact name that are kept in memory
+#define FLC_ARTIFACT_INPUTS_PER_NAME 4
+
+// only std::vectors of trivially copyable records can be persisted
+template <typename T>
+struct flcIsPersistable : std::false_type {};
+template <typename T>
+struct flcIsPersistable<std::vector<T>> : std::is_trivially_copyable<T> {};
+
+// ==============================/ Class flcArtifactCache /==============================
+
+class flcArtifactCache {
+public:
+    // there's one artifact cache per program run
+    static flcArtifactCache &Instance();
+
+    // persisting to disk is off by default - an empty sDir switches it off again
+    void SetPersistDir( const std::string &sDir ) { m_sPersistDir = sDir; }
+    std::string GetPersistDir() { return m_sPersistDir; }
+
+    // 64 bit FNV-1a hash over the lines of an input, to key the artifacts on
+    static uint64_t HashLines( const std::vector<std::string> &vLines );
+
+    // the artifact sName of the input with hash nInputHash, or nullptr if it's not in memory
+    template <typename T>
+    std::shared_ptr<const T> Find( uint64_t nInputHash, const std::string &sName ) {
+        return std::static_pointer_cast<const T>( FindEntry( nInputHash, sName, typeid( T )));
+    }
+
+    // stores artifact for the input with hash nInputHash under sName, replacing what was there
+    template <typename T>
+    std::shared_ptr<const T> Publish( uint64_t nInputHash, const std::string &sName, T artifact ) {
+        std::shared_ptr<const T> pArtifact = std::make_shared<const T>( std::move( artifact ));
+        StoreEntry( nInputHash, sName, typeid( T ), pArtifact );
+        if constexpr (flcIsPersistable<T>::value) {
+            if (!m_sPersistDir.empty()) {
+                WriteFile( nInputHash, sName, sizeof( typename T::value_type ), pArtifact->data(), pArtifact->size());
+            }
+        }
+        return pArtifact;
+    }
+
+    // computes the artifact with fnCompute() and publishes it - unless it can be loaded from disk
+    template <typename T, typename F>
+    std::shared_ptr<const T> Produce( uint64_t nInputHash, const std::string &sName, F fnCompute ) {
+        std::shared_ptr<const T> pArtifact = Load<T>( nInputHash, sName );
+        return pArtifact ? pArtifact : Publish<T>( nInputHash, sName, fnCompute());
+    }
+
+    // the artifact from memory or disk if it's there, otherwise it's computed with fnCompute() and published
+    template <typename T, typename F>
+    std::shared_ptr<const T> Consume( uint64_t nInputHash, const std::string &sName, F fnCompute ) {
+        std::shared_ptr<const T> pArtifact = Find<T>( nInputHash, sName );
+        if (!pArtifact) {
+            pArtifact = Load<T>( nInputHash, sName );
+        }
+        return pArtifact ? pArtifact : Publish<T>( nInputHash, sName, fnCompute());
+    }
+
+    // drops all artifacts from memory (the files on disk stay)
+    void Clear();
+
+private:
+    flcArtifactCache() {}
+
+    // an artifact as stored - the type is kept to catch a part that asks for the wrong one
+    typedef struct sArtifactEntryStruct {
+        uint64_t                    nStored = 0;    // when it was stored, to find the oldest one
+        std::type_index             type = typeid( void );
+        std::shared_ptr<const void> pArtifact;
+    } ArtifactEntryType;
+
+    std::shared_ptr<const void> FindEntry( uint64_t nInputHash, const std::string &sName, std::type_index type );
+    void StoreEntry( uint64_t nInputHash, const std::string &sName, std::type_index type, std::shared_ptr<const void> pArtifact );
+
+    // the artifact from disk (which is then also stored in memory), or nullptr if it's not persistable,
+    // persisting is off, or there's no valid file for this input
+    template <typename T>
+    std::shared_ptr<const T> Load( uint64_t nInputHash, const std::string &sName ) {
+        if constexpr (flcIsPersistable<T>::value) {
+            if (!m_sPersistDir.empty()) {
+                std::vector<char> vBytes;
+                size_t nCount;
+                if (ReadFile( nInputHash, sName, sizeof( typename T::value_type ), vBytes, nCount )) {
+                    T artifact( nCount );
+                    if (nCount > 0) {
+                        memcpy( (void *)artifact.data(), vBytes.data(), vBytes.size());
+                    }
+                    std::shared_ptr<const T> pArtifact = std::make_shared<const T>( std::move( artifact ));
+                    StoreEntry( nInputHash, sName, typeid( T ), pArtifact );
+                    return pArtifact;
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    std::string FileName( uint64_t nInputHash, const std::string &sName );
+    bool ReadFile( uint64_t nInputHash, const std::string &sName, size_t nRecordSize, std::vector<char> &vBytes, size_t &nCount );
+    bool WriteFile( uint64_t nInputHash, const std::string &sName, size_t nRecordSize, const void *pData, size_t nCount );
+
+    std::map<std::pair<std::string, uint64_t>, ArtifactEntryType> m_mEntries;    // keyed on (name, input hash)
+    uint64_t    m_nStored = 0;
+    std::mutex  m_mutex;
+    std::string m_sPersistDir;
+};
+
+#endif // FLCARTIFACTCACHE_H
@@ -0,0 +1,321 @@
+// AoC 2024 - benchmark utility
+// ============================
+
+// date:  2025-01-12
+// by:    Joseph21 (Joseph21-6147)
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+#include "flcBenchmark.h"
+#include "flcArtifactCache.h"
+#include "flcInputCache.h"
+#include "flcProfiler.h"
+#include "flcResults.h"
+#include "flcThreadPool.h"
+#include "flcTraceLog.h"
+
+// ==============================/ Class flcBenchmark /==============================
+
+flcBenchmark::flcBenchmark( int nWarmup, int nRepeat ) {
+    SetWarmup( nWarmup );
+    SetRepeat( nRepeat );
+}
+
+flcBenchmark::flcBenchmark( int argc, char *argv[] ) {
+    for (int i = 1; i < argc; i++) {
+        bool bWarmup = (strcmp( argv[i], "--warmup" ) == 0 || strcmp( argv[i], "-w" ) == 0);
+        bool bRepeat = (strcmp( argv[i], "--repeat" ) == 0 || strcmp( argv[i], "-r" ) == 0);
+        bool bJson   = (strcmp( argv[i], "--json"      ) == 0);
+        bool bCsv    = (strcmp( argv[i], "--csv"       ) == 0);
+        bool bCmp    = (strcmp( argv[i], "--compare"   ) == 0);
+        bool bThresh = (strcmp( argv[i], "--threshold" ) == 0);
+        bool bThreads = (strcmp( argv[i], "--threads"  ) == 0 || strcmp( argv[i], "-t" ) == 0);
+        bool bTrace  = (strcmp( argv[i], "--trace"     ) == 0);
+        bool bArtifacts = (strcmp( argv[i], "--artifacts" ) == 0);
+        if (strcmp( argv[i], "--profile" ) == 0 || strcmp( argv[i], "-p" ) == 0) {
+            flcProfiler::Instance().SetEnabled( true );
+        }
+        if (strcmp( argv[i], "--counters" ) == 0 || strcmp( argv[i], "-c" ) == 0) {
+            flcProfiler::Instance().SetCounters( true );
+        }
+        if (strcmp( argv[i], "--memory" ) == 0 || strcmp( argv[i], "-m" ) == 0) {
+            SetMemory( true );
+        }
+        if (strcmp( argv[i], "--cache" ) == 0) {
+            flcInputCache::SetEnabled( true );
+        }
+        if (bWarmup || bRepeat || bJson || bCsv || bCmp || bThresh || bThreads || bTrace || bArtifacts) {
+            if (i + 1 >= argc) {
+                std::cout << "ERROR: flcBenchmark() --> missing value for argument: " << argv[i] << std::endl;
+            } else {
+                i += 1;
+                if (bWarmup) SetWarmup( atoi( argv[i] ));
+                if (bRepeat) SetRepeat( atoi( argv[i] ));
+                if (bJson  ) m_sJsonFile     = argv[i];
+                if (bCsv   ) m_sCsvFile      = argv[i];
+                if (bCmp   ) m_sBaselineFile = argv[i];
+                if (bThresh) m_dThreshold    = atof( argv[i] );
+                if (bThreads) flcThreadPool::Instance().SetThreadCount( atoi( argv[i] ));
+                if (bArtifacts) flcArtifactCache::Instance().SetPersistDir( argv[i] );
+                if (bTrace) {
+                    int nLevel = flcTraceLog::ParseLevel( argv[i] );
+                    if (nLevel < 0) {
+                        std::cout << "ERROR: flcBenchmark() --> invalid trace level: " << argv[i] << std::endl;
+                    } else {
+                        flcTraceLog::SetLevel( nLevel );
+                    }
+                }
+            }
+        }
+    }
+}
+
+flcBenchmark::~flcBenchmark() {
+    if (!m_bResultsWritten) {
+        WriteResults();
+    }
+}
+
+void flcBenchmark::SetWarmup( int nWarmup ) {
+    if (nWarmup < 0) {
+        std::cout << "ERROR: flcBenchmark::SetWarmup() --> negative warmup count: " << nWarmup << std::endl;
+        nWarmup = 0;
+    }
+    m_nWarmup = nWarmup;
+}
+
+void flcBenchmark::SetRepeat( int nRepeat ) {
+    if (nRepeat < 1) {
+        std::cout << "ERROR: flcBenchmark::SetRepeat() --> repeat count must be at least 1: " << nRepeat << std::endl;
+        nRepeat = 1;
+    }
+    m_nRepeat = nRepeat;
+}
+
+void flcBenchmark::SetContext( const std::string &sDay, const std::string &sProgPhase ) {
+    m_sDay       = sDay;
+    m_sProgPhase = sProgPhase;
+}
+
+void flcBenchmark::SetAnswerString( const std::string &sAnswer ) {
+    if (m_vPhases.empty()) {
+        std::cout << "ERROR: flcBenchmark::SetAnswerString() --> no phase was run yet" << std::endl;
+        return;
+    }
+    m_vPhases.back().sAnswer = sAnswer;
+}
+
+void flcBenchmark::RunPhase( const std::string &sPhaseName, std::function<void()> fnPhase ) {
+    BenchPhaseType curPhase;
+    curPhase.sName      = sPhaseName;
+    curPhase.sDay       = m_sDay;
+    curPhase.sProgPhase = m_sProgPhase;
+    std::string sSectionName = FullName( curPhase );
+
+    // warmup runs are not profiled
+    flcProfiler &prof = flcProfiler::Instance();
+    prof.Pause();
+    for (int i = 0; i < m_nWarmup; i++) {
+        fnPhase();
+    }
+    prof.Resume();
+
+    MemStatsType memStart;
+    if (m_bMemory) {
+        flcMemStats::ResetPeakRSS();
+        flcMemStats::ResetPeak();
+        memStart = flcMemStats::Snapshot();
+    }
+    PerfSampleType countersStart;
+    if (prof.UsingCounters()) {
+        countersStart = flcPerfCounters::ThreadInstance().Read();
+    }
+    for (int i = 0; i < m_nRepeat; i++) {
+        // the phase is the top level section for any scoped timers within it
+        flcScopedTimer phaseSection( sSectionName.c_str());
+        m_timer.StartTiming();
+        fnPhase();
+        curPhase.vSamples.push_back( m_timer.TimeDuration());
+    }
+    curPhase.stats = CalcStats( curPhase.vSamples );
+    if (prof.UsingCounters()) {
+        curPhase.bCounters = true;
+        curPhase.counters  = flcPerfCounters::ThreadInstance().Read() - countersStart;
+        for (int i = 0; i < PERF_NR_COUNTERS; i++) {
+            curPhase.counters.nValue[i] /= m_nRepeat;
+        }
+    }
+    if (m_bMemory) {
+        curPhase.bMemory         = true;
+        MemStatsType memEnd = flcMemStats::Snapshot();
+        curPhase.mem.nAllocs     = (memEnd.nAllocs     - memStart.nAllocs    ) / m_nRepeat;
+        curPhase.mem.nFrees      = (memEnd.nFrees      - memStart.nFrees     ) / m_nRepeat;
+        curPhase.mem.nBytesAlloc = (memEnd.nBytesAlloc - memStart.nBytesAlloc) / m_nRepeat;
+        curPhase.mem.nBytesFreed = (memEnd.nBytesFreed - memStart.nBytesFreed) / m_nRepeat;
+        curPhase.mem.nBytesLive  =  memEnd.nBytesLive  - memStart.nBytesLive;
+        curPhase.mem.nPeakLive   =  memEnd.nPeakLive   - memStart.nBytesLive;
+        curPhase.nPeakRSS        = flcMemStats::PeakRSS();
+    }
+    m_vPhases.push_back( curPhase );
+}
+
+// nearest rank percentile on the sorted samples
+static double Percentile( const std::vector<double> &vSorted, double dPerc ) {
+    int nRank = (int)std::ceil( dPerc / 100.0 * (double)vSorted.size());
+    return vSorted[ std::max( 0, nRank - 1 ) ];
+}
+
+BenchStatsType flcBenchmark::CalcStats( const std::vector<double> &vSamples ) {
+    BenchStatsType result;
+    result.nSamples = (int)vSamples.size();
+    if (vSamples.empty()) {
+        return result;
+    }
+    std::vector<double> vSorted = vSamples;
+    std::sort( vSorted.begin(), vSorted.end() );
+
+    int n = result.nSamples;
+    result.dMin    = vSorted[0];
+    result.dMedian = (n % 2 == 1) ? vSorted[n / 2] : (vSorted[n / 2 - 1] + vSorted[n / 2]) / 2.0;
+    result.dP95    = Percentile( vSorted, 95.0 );
+
+    double dSum = 0.0;
+    for (auto d : vSorted) { dSum += d; }
+    result.dMean = dSum / n;
+
+    // sample standard deviation (0 for a single sample)
+    double dSqrSum = 0.0;
+    for (auto d : vSorted) { dSqrSum += (d - result.dMean) * (d - result.dMean); }
+    result.dStdDev = (n > 1) ? std::sqrt( dSqrSum / (n - 1)) : 0.0;
+
+    return result;
+}
+
+BenchPhaseType &flcBenchmark::GetPhase( int nIndex ) {
+    if (nIndex < 0 || nIndex >= (int)m_vPhases.size()) {
+        std::cout << "ERROR: flcBenchmark::GetPhase() --> index out of range: " << nIndex << std::endl;
+        // an empty phase, cleared on each call in case a caller wrote to it
+        static BenchPhaseType emptyPhase;
+        emptyPhase = BenchPhaseType();
+        return emptyPhase;
+    }
+    return m_vPhases[nIndex];
+}
+
+std::string flcBenchmark::FullName( const BenchPhaseType &phase ) {
+    return phase.sDay.empty() ? phase.sName : phase.sDay + " " + phase.sName;
+}
+
+// if a phase name was run more than once, the most recent one is returned
+BenchPhaseType *flcBenchmark::FindPhase( const std::string &sPhaseName ) {
+    for (int i = (int)m_vPhases.size() - 1; i >= 0; i--) {
+        if (m_vPhases[i].sName == sPhaseName) {
+            return &m_vPhases[i];
+        }
+    }
+    return nullptr;
+}
+
+void flcBenchmark::TimeReport( std::string sMsg1, std::string sMsg2, std::ostream &os ) {
+    if (m_vPhases.empty()) {
+        std::cout << "ERROR: flcBenchmark::TimeReport() --> no phase was run yet" << std::endl;
+        return;
+    }
+    BenchStatsType &s = m_vPhases.back().stats;
+    if (s.nSamples == 1) {
+        os << sMsg1 << s.dMin << sMsg2 << std::endl;
+    } else {
+        os << sMsg1 << "min "     << s.dMin
+                  << " / median " << s.dMedian
+                  << " / mean "   << s.dMean
+                  << " / p95 "    << s.dP95
+                  << " / stddev " << s.dStdDev << sMsg2
+                  << " (" << s.nSamples << " runs, " << m_nWarmup << " warmup)" << std::endl;
+    }
+    if (m_vPhases.back().bMemory) {
+        BenchPhaseType &p = m_vPhases.back();
+        os << "    Memory   - " << p.mem.nAllocs << " allocs, " << p.mem.nFrees << " frees, "
+           << flcMemStats::FormatBytes( p.mem.nBytesAlloc ) << " allocated, "
+           << flcMemStats::FormatBytes( p.mem.nBytesFreed ) << " freed"
+           << (m_nRepeat > 1 ? " (per run)" : "")
+           << " / live " << (p.mem.nBytesLive >= 0 ? "+" : "") << flcMemStats::FormatBytes( p.mem.nBytesLive )
+           << " / peak live " << flcMemStats::FormatBytes( p.mem.nPeakLive )
+           << " / peak RSS ";
+        if (p.nPeakRSS < 0) {
+            os << "n.a.";
+        } else {
+            os << flcMemStats::FormatBytes( p.nPeakRSS * 1024 );
+        }
+        os << std::endl;
+    }
+}
+
+void flcBenchmark::SummaryReport() {
+    auto aligned = []( const std::string &s, int nWidth ) {
+        std::stringstream ss;
+        ss << std::setw( nWidth ) << s;
+        return ss.str();
+    };
+    auto aligned_nr = []( double d, int nWidth ) {
+        std::stringstream ss;
+        ss << std::setw( nWidth ) << std::fixed << std::setprecision( 4 ) << d;
+        return ss.str();
+    };
+
+    int nNameWidth = 6;
+    for (auto &p : m_vPhases) {
+        nNameWidth = std::max( nNameWidth, (int)FullName( p ).length());
+    }
+    std::cout << "Benchmark summary - " << m_nWarmup << " warmup and " << m_nRepeat << " timed runs per phase, times in msec" << std::endl;
+    std::cout << "    " << std::left << std::setw( nNameWidth ) << "phase" << std::right
+              << aligned( "min", 13 ) << aligned( "median", 13 ) << aligned( "mean", 13 )
+              << aligned( "p95", 13 ) << aligned( "stddev", 13 ) << std::endl;
+    for (auto &p : m_vPhases) {
+        std::cout << "    " << std::left << std::setw( nNameWidth ) << FullName( p ) << std::right
+                  << aligned_nr( p.stats.dMin   , 13 ) << aligned_nr( p.stats.dMedian, 13 )
+                  << aligned_nr( p.stats.dMean  , 13 ) << aligned_nr( p.stats.dP95   , 13 )
+                  << aligned_nr( p.stats.dStdDev, 13 ) << std::endl;
+    }
+    std::cout << std::endl;
+
+    if (m_bMemory) {
+        std::cout << "Memory summary - allocation counts and bytes per run" << std::endl;
+        std::cout << "    " << std::left << std::setw( nNameWidth ) << "phase" << std::right
+                  << aligned( "allocs", 13 ) << aligned( "frees", 13 ) << aligned( "allocated", 13 )
+                  << aligned( "peak live", 13 ) << aligned( "peak RSS", 13 ) << std::endl;
+        for (auto &p : m_vPhases) {
+            std::cout << "    " << std::left << std::setw( nNameWidth ) << FullName( p ) << std::right
+                      << std::setw( 13 ) << p.mem.nAllocs << std::setw( 13 ) << p.mem.nFrees
+                      << aligned( flcMemStats::FormatBytes( p.mem.nBytesAlloc ), 13 )
+                      << aligned( flcMemStats::FormatBytes( p.mem.nPeakLive   ), 13 )
+                      << aligned( p.nPeakRSS < 0 ? "n.a." : flcMemStats::FormatBytes( p.nPeakRSS * 1024 ), 13 ) << std::endl;
+        }
+        std::cout << std::endl;
+    }
+}
+
+int flcBenchmark::WriteResults() {
+    m_bResultsWritten = true;
+    bool bOK = true;
+    if (!m_sJsonFile.empty()) {
+        bOK = flcResults::WriteJSON( m_sJsonFile, m_vPhases ) && bOK;
+    }
+    if (!m_sCsvFile.empty()) {
+        bOK = flcResults::WriteCSV( m_sCsvFile, m_vPhases ) && bOK;
+    }
+    int nRegressions = 0;
+    if (!m_sBaselineFile.empty()) {
+        std::vector<BenchPhaseType> vBaseline;
+        if (flcResults::ReadResults( m_sBaselineFile, vBaseline )) {
+            nRegressions = flcResults::CompareReport( vBaseline, m_vPhases, m_dThreshold );
+        } else {
+            bOK = false;
+        }
+    }
+    return bOK ? nRegressions : -1;
+}
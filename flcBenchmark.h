@@ -0,0 +1,145 @@
+// AoC 2024 - benchmark utility
+// ============================
+
+// date:  2025-01-12
+// by:    Joseph21 (Joseph21-6147)
+
+// Builds on flcTimer: each phase of a solution (input preparation, part 1, part 2) is run a number
+// of warmup times (untimed), and then a number of repeat times (timed). The timing samples are
+// condensed into min / median / mean / p95 / stddev statistics per phase.
+//
+// With the default settings (0 warmup runs, 1 repeat run) the output of TimeReport() is identical
+// to that of flcTimer::TimeReport(), so a single cold run looks just like it always did.
+//
+// Optionally (--memory on the command line) the heap allocations and the peak memory use of each
+// phase are reported as well, using flcMemStats.
+//
+// The results can also be written in machine readable form (--json <file> and / or --csv <file>), and
+// compared against a baseline file written earlier (--compare <file>, with --threshold <perc>), see
+// flcResults.
+
+#ifndef FLCBENCHMARK_H
+#define FLCBENCHMARK_H
+
+#include <iostream>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "flcTimer.h"
+#include "flcMemStats.h"
+#include "flcPerfCounters.h"
+
+// statistics over the timed samples of one phase - all times in milliseconds
+typedef struct sBenchStatsStruct {
+    int    nSamples = 0;
+    double dMin     = 0.0;
+    double dMedian  = 0.0;
+    double dMean    = 0.0;
+    double dP95     = 0.0;
+    double dStdDev  = 0.0;
+} BenchStatsType;
+
+// the timing results of one phase
+typedef struct sBenchPhaseStruct {
+    std::string         sName;
+    std::string         sDay;             // context of the phase, if set by SetContext()
+    std::string         sProgPhase;
+    std::string         sAnswer;          // if set by SetAnswer()
+    std::vector<double> vSamples;
+    BenchStatsType      stats;
+    // only if memory accounting is on: nAllocs, nFrees, nBytesAlloc and nBytesFreed are per timed run
+    // (averaged), nBytesLive is the growth of the live bytes over the phase, and nPeakLive is the peak
+    // of the live bytes on top of those that were live at the start of the phase
+    MemStatsType        mem;
+    long long           nPeakRSS = -1;    // in kB, -1 if not available
+    bool                bMemory = false;
+    // only if hardware counters are in use: counter values per timed run (averaged)
+    PerfSampleType      counters;
+    bool                bCounters = false;
+} BenchPhaseType;
+
+class flcBenchmark {
+public:
+    // warmup and repeat counts are passed explicitly...
+    flcBenchmark( int nWarmup = 0, int nRepeat = 1 );
+    // ... or taken from the command line: --warmup <n> (or -w <n>) and --repeat <n> (or -r <n>).
+    // Passing --profile (or -p) enables the flcProfiler section tree report, --counters (or -c) adds
+    // hardware performance counters to that report, and --memory (or -m) enables memory accounting.
+    // --cache enables the binary cache of parsed input data (see flcInputCache), --artifacts <dir> persists
+    // the artifacts that the parts share in <dir> (see flcArtifactCache), and --threads <n> (or
+    // -t <n>) sets the nr of threads of the parallel loops (see flcThreadPool). --trace <level> sets the
+    // run time level of the trace log (see flcTraceLog).
+    // For the results output see WriteResults()
+    flcBenchmark( int argc, char *argv[] );
+    // writes the results output if that's configured and WriteResults() wasn't called yet
+    ~flcBenchmark();
+
+    void SetWarmup( int nWarmup );
+    void SetRepeat( int nRepeat );
+    int  GetWarmup() { return m_nWarmup; }
+    int  GetRepeat() { return m_nRepeat; }
+    // turning it on also starts the counting of flcMemStats
+    void SetMemory( bool bMemory ) { m_bMemory = bMemory; if (bMemory) { flcMemStats::Enable(); } }
+    bool GetMemory() { return m_bMemory; }
+
+    // runs fnPhase m_nWarmup times without timing, and then m_nRepeat times timed. The samples
+    // are stored under sPhaseName, which is also the top level flcProfiler section for the run.
+    // NOTE: fnPhase must be repeatable, i.e. each call must start from the same state to give
+    // representative (and correct) results.
+    void RunPhase( const std::string &sPhaseName, std::function<void()> fnPhase );
+    // adds a phase that was run elsewhere, e.g. by another flcBenchmark object on another thread
+    void AddPhase( const BenchPhaseType &phase ) { m_vPhases.push_back( phase ); }
+
+    // the day and program phase (EXAMPLE, TEST, PUZZLE) are stored with all subsequently run phases
+    void SetContext( const std::string &sDay, const std::string &sProgPhase );
+    // stores the answer with the most recently run phase
+    template <typename T>
+    void SetAnswer( const T &answer ) {
+        std::stringstream ss;
+        ss << answer;
+        SetAnswerString( ss.str());
+    }
+    void SetAnswerString( const std::string &sAnswer );
+
+    // reports the statistics of the most recently run phase to os. If only one sample was taken,
+    // the output is like flcTimer::TimeReport(). If that phase was run with memory accounting on,
+    // a second line with the memory statistics follows
+    void TimeReport( std::string sMsg1, std::string sMsg2 = " msec", std::ostream &os = std::cout );
+
+    // prints an aligned table with the statistics of all phases run so far
+    void SummaryReport();
+
+    // writes the results of all phases to the files given with --json <file> and --csv <file>, and
+    // compares them against the file given with --compare <file>. A phase is flagged as regressed if
+    // its median time exceeds the baseline median by more than the --threshold percentage (default 10).
+    // Returns the nr of regressed phases, or -1 if a file could not be written or read
+    int WriteResults();
+
+    // access to the results
+    int             GetNrPhases() { return (int)m_vPhases.size(); }
+    BenchPhaseType &GetPhase( int nIndex );
+    BenchPhaseType *FindPhase( const std::string &sPhaseName );
+
+    // calculates the statistics over vSamples (which need not be sorted)
+    static BenchStatsType CalcStats( const std::vector<double> &vSamples );
+    // name of the phase, preceded by its day if that is set
+    static std::string FullName( const BenchPhaseType &phase );
+
+private:
+    int m_nWarmup = 0;    // nr of untimed runs per phase
+    int m_nRepeat = 1;    // nr of timed runs per phase
+    bool m_bMemory = false;
+
+    std::string m_sDay, m_sProgPhase;   // see SetContext()
+
+    std::string m_sJsonFile, m_sCsvFile, m_sBaselineFile;
+    double m_dThreshold = 10.0;         // in percent
+    bool m_bResultsWritten = false;
+
+    flcTimer m_timer;
+    std::vector<BenchPhaseType> m_vPhases;
+};
+
+#endif // FLCBENCHMARK_H
@@ -0,0 +1,286 @@
+// AoC 2024 - 2D bit grid (bitboard)
+// =================================
+
+// date:  2025-01-26
+// by:    Joseph21 (Joseph21-6147)
+
+#include <algorithm>
+#include <iostream>
+
+#include "flcBitGrid.h"
+#include "flcGrid.h"
+
+// nr of set bits resp. trailing zero bits (nWord must not be 0) of nWord
+static inline int PopCount( uint64_t nWord ) {
+#if defined( __GNUC__ ) || defined( __clang__ )
+    return __builtin_popcountll( nWord );
+#else
+    nWord = nWord - ((nWord >> 1) & 0x5555555555555555ULL);
+    nWord = (nWord & 0x3333333333333333ULL) + ((nWord >> 2) & 0x3333333333333333ULL);
+    nWord = (nWord + (nWord >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (int)((nWord * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+static inline int TrailingZeros( uint64_t nWord ) {
+#if defined( __GNUC__ ) || defined( __clang__ )
+    return __builtin_ctzll( nWord );
+#else
+    return PopCount( (nWord & (0 - nWord)) - 1 );
+#endif
+}
+
+// ==============================/ Class flcBitGrid /==============================
+
+void flcBitGrid::Init( int nWidth, int nHeight ) {
+    m_nWidth  = nWidth;
+    m_nHeight = nHeight;
+    m_nWordsPerRow  = (nWidth + 63) / 64;
+    m_nLastWordMask = (nWidth % 64 == 0) ? ~0ULL : ((1ULL << (nWidth % 64)) - 1);
+    m_vWords.assign( (size_t)m_nWordsPerRow * nHeight, 0 );
+}
+
+void flcBitGrid::ClearPadding() {
+    if (m_nLastWordMask != ~0ULL) {
+        for (int y = 0; y < m_nHeight; y++) {
+            m_vWords[ y * m_nWordsPerRow + m_nWordsPerRow - 1 ] &= m_nLastWordMask;
+        }
+    }
+}
+
+void flcBitGrid::SetAll() {
+    m_vWords.assign( m_vWords.size(), ~0ULL );
+    ClearPadding();
+}
+
+void flcBitGrid::ClearAll() {
+    m_vWords.assign( m_vWords.size(), 0 );
+}
+
+bool flcBitGrid::Any() const {
+    uint64_t nAny = 0;
+    for (uint64_t nWord : m_vWords) {
+        nAny |= nWord;
+    }
+    return nAny != 0;
+}
+
+int flcBitGrid::Count() const {
+    int nCount = 0;
+    for (uint64_t nWord : m_vWords) {
+        nCount += PopCount( nWord );
+    }
+    return nCount;
+}
+
+// the cell wise operations need grids of the same size
+static bool SameSize( const flcBitGrid &lhs, const flcBitGrid &rhs, const char *sFuncName ) {
+    if (lhs.Width() != rhs.Width() || lhs.Height() != rhs.Height()) {
+        std::cout << "ERROR: " << sFuncName << " --> grid sizes differ: " << lhs.Width() << "x" << lhs.Height()
+                  << " and " << rhs.Width() << "x" << rhs.Height() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+flcBitGrid &flcBitGrid::operator &= ( const flcBitGrid &rhs ) {
+    if (SameSize( *this, rhs, "flcBitGrid::operator &=()" )) {
+        for (size_t i = 0; i < m_vWords.size(); i++) {
+            m_vWords[i] &= rhs.m_vWords[i];
+        }
+    }
+    return *this;
+}
+
+flcBitGrid &flcBitGrid::operator |= ( const flcBitGrid &rhs ) {
+    if (SameSize( *this, rhs, "flcBitGrid::operator |=()" )) {
+        for (size_t i = 0; i < m_vWords.size(); i++) {
+            m_vWords[i] |= rhs.m_vWords[i];
+        }
+    }
+    return *this;
+}
+
+flcBitGrid &flcBitGrid::operator ^= ( const flcBitGrid &rhs ) {
+    if (SameSize( *this, rhs, "flcBitGrid::operator ^=()" )) {
+        for (size_t i = 0; i < m_vWords.size(); i++) {
+            m_vWords[i] ^= rhs.m_vWords[i];
+        }
+    }
+    return *this;
+}
+
+flcBitGrid &flcBitGrid::AndNot( const flcBitGrid &rhs ) {
+    if (SameSize( *this, rhs, "flcBitGrid::AndNot()" )) {
+        for (size_t i = 0; i < m_vWords.size(); i++) {
+            m_vWords[i] &= ~rhs.m_vWords[i];
+        }
+    }
+    return *this;
+}
+
+flcBitGrid flcBitGrid::operator ~ () const {
+    flcBitGrid result = *this;
+    for (uint64_t &nWord : result.m_vWords) {
+        nWord = ~nWord;
+    }
+    result.ClearPadding();
+    return result;
+}
+
+flcBitGrid operator & ( const flcBitGrid &lhs, const flcBitGrid &rhs ) { flcBitGrid result = lhs; result &= rhs; return result; }
+flcBitGrid operator | ( const flcBitGrid &lhs, const flcBitGrid &rhs ) { flcBitGrid result = lhs; result |= rhs; return result; }
+flcBitGrid operator ^ ( const flcBitGrid &lhs, const flcBitGrid &rhs ) { flcBitGrid result = lhs; result ^= rhs; return result; }
+
+// within a row, bit x of word i is cell 64 * i + x. Shifting towards higher x moves bits up within a
+// word, and carries the top bits into the next word of the same row
+void flcBitGrid::ShiftX( int dx ) {
+    if (dx == 0) {
+        return;
+    }
+    int nShift = (dx > 0) ? dx : -dx;
+    for (int y = 0; y < m_nHeight; y++) {
+        uint64_t *pRow = &m_vWords[ y * m_nWordsPerRow ];
+        if (dx > 0) {
+            for (int i = m_nWordsPerRow - 1; i >= 0; i--) {
+                uint64_t nCarry = (i > 0) ? (pRow[i - 1] >> (64 - nShift)) : 0;
+                pRow[i] = (pRow[i] << nShift) | nCarry;
+            }
+        } else {
+            for (int i = 0; i < m_nWordsPerRow; i++) {
+                uint64_t nCarry = (i < m_nWordsPerRow - 1) ? (pRow[i + 1] << (64 - nShift)) : 0;
+                pRow[i] = (pRow[i] >> nShift) | nCarry;
+            }
+        }
+    }
+    ClearPadding();
+}
+
+void flcBitGrid::ShiftY( int dy ) {
+    if (dy == 0) {
+        return;
+    }
+    int nRows  = (dy > 0) ? dy : -dy;
+    if (nRows >= m_nHeight) {
+        ClearAll();
+        return;
+    }
+    size_t nOffset = (size_t)nRows * m_nWordsPerRow;
+    size_t nSize   = m_vWords.size();
+    if (dy > 0) {
+        for (size_t i = nSize; i-- > nOffset; ) {
+            m_vWords[i] = m_vWords[i - nOffset];
+        }
+        for (size_t i = 0; i < nOffset; i++) {
+            m_vWords[i] = 0;
+        }
+    } else {
+        for (size_t i = 0; i + nOffset < nSize; i++) {
+            m_vWords[i] = m_vWords[i + nOffset];
+        }
+        for (size_t i = nSize - nOffset; i < nSize; i++) {
+            m_vWords[i] = 0;
+        }
+    }
+}
+
+flcBitGrid flcBitGrid::Shifted( int dx, int dy ) const {
+    if (dx <= -64 || dx >= 64) {
+        std::cout << "ERROR: flcBitGrid::Shifted() --> horizontal shift too large: " << dx << std::endl;
+        return flcBitGrid( m_nWidth, m_nHeight );
+    }
+    flcBitGrid result = *this;
+    result.ShiftX( dx );
+    result.ShiftY( dy );
+    return result;
+}
+
+flcBitGrid flcBitGrid::Shifted4( int nDir ) const { return Shifted( glbDirX4[nDir], glbDirY4[nDir] ); }
+flcBitGrid flcBitGrid::Shifted8( int nDir ) const { return Shifted( glbDirX8[nDir], glbDirY8[nDir] ); }
+
+flcBitGrid flcBitGrid::Dilated4() const {
+    // the horizontal neighbours first, then the vertical ones of the original cells
+    flcBitGrid result = *this;
+    result |= Shifted( +1, 0 );
+    result |= Shifted( -1, 0 );
+    result |= Shifted( 0, +1 );
+    result |= Shifted( 0, -1 );
+    return result;
+}
+
+flcBitGrid flcBitGrid::Dilated8() const {
+    // growing a row by one cell and then growing that vertically covers the diagonals as well
+    flcBitGrid result = *this;
+    result |= Shifted( +1, 0 );
+    result |= Shifted( -1, 0 );
+    flcBitGrid rowGrown = result;
+    result |= rowGrown.Shifted( 0, +1 );
+    result |= rowGrown.Shifted( 0, -1 );
+    return result;
+}
+
+// the dilation, masking and OR are done word by word in place, without temporary grids. The new value of
+// a word depends on the old values of its row and of the rows above and below it, so the old values of the
+// current and the previous row are kept in two row buffers
+bool flcBitGrid::FloodStep( const flcBitGrid &mask ) {
+    if (!SameSize( *this, mask, "flcBitGrid::FloodStep()" )) {
+        return false;
+    }
+    std::vector<uint64_t> vPrevRow( m_nWordsPerRow, 0 ), vCurRow( m_nWordsPerRow );
+    uint64_t nGrown = 0;
+    for (int y = 0; y < m_nHeight; y++) {
+        uint64_t *pRow = &m_vWords[ y * m_nWordsPerRow ];
+        const uint64_t *pNext = (y + 1 < m_nHeight) ? pRow + m_nWordsPerRow : nullptr;
+        const uint64_t *pMask = &mask.m_vWords[ y * m_nWordsPerRow ];
+        std::copy( pRow, pRow + m_nWordsPerRow, vCurRow.begin());
+        for (int i = 0; i < m_nWordsPerRow; i++) {
+            uint64_t nWord  = vCurRow[i];
+            uint64_t nLeft  = (i > 0)                  ? (vCurRow[i - 1] >> 63) : 0;    // carry from cell x - 1
+            uint64_t nRight = (i < m_nWordsPerRow - 1) ? (vCurRow[i + 1] << 63) : 0;    // carry from cell x + 1
+            uint64_t nDilated = nWord | (nWord << 1) | nLeft | (nWord >> 1) | nRight | vPrevRow[i] | (pNext ? pNext[i] : 0);
+            uint64_t nNew = (nDilated & pMask[i]) | nWord;
+            nGrown |= nNew ^ nWord;
+            pRow[i] = nNew;
+        }
+        vPrevRow.swap( vCurRow );
+    }
+    return nGrown != 0;
+}
+
+int flcBitGrid::FloodFill( const flcBitGrid &mask ) {
+    int nSteps = 0;
+    while (FloodStep( mask )) {
+        nSteps += 1;
+    }
+    return nSteps;
+}
+
+// ==============================/ Class flcBitGrid::iterator /==============================
+
+flcBitGrid::iterator::iterator( const flcBitGrid *pGrid, int nWord ) : m_pGrid( pGrid ), m_nWord( nWord ), m_nBits( 0 ) {
+    if (m_nWord < (int)m_pGrid->m_vWords.size()) {
+        m_nBits = m_pGrid->m_vWords[m_nWord];
+    }
+    SkipToSetBit();
+}
+
+CoordType flcBitGrid::iterator::operator * () const {
+    int nRow = m_nWord / m_pGrid->m_nWordsPerRow;
+    int nCol = m_nWord % m_pGrid->m_nWordsPerRow;
+    return { nCol * 64 + TrailingZeros( m_nBits ), nRow };
+}
+
+flcBitGrid::iterator &flcBitGrid::iterator::operator ++ () {
+    m_nBits &= m_nBits - 1;    // clear the lowest set bit
+    SkipToSetBit();
+    return *this;
+}
+
+// moves to the next word that has set bits, or to the end position
+void flcBitGrid::iterator::SkipToSetBit() {
+    int nEnd = (int)m_pGrid->m_vWords.size();
+    while (m_nBits == 0 && m_nWord < nEnd) {
+        m_nWord += 1;
+        m_nBits = (m_nWord < nEnd) ? m_pGrid->m_vWords[m_nWord] : 0;
+    }
+}
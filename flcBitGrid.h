@@ -0,0 +1,140 @@
+// AoC 2024 - 2D bit grid (bitboard)
+// =================================
+
+// date:  2025-01-26
+// by:    Joseph21 (Joseph21-6147)
+
+// flcBitGrid stores one bit per cell of a 2D map. Each row is stored in one or more 64 bit words, so
+// a 64 cell wide strip of the map is processed with a single word operation. Next to setting and
+// testing single cells it offers whole grid operations:
+//
+//   * AND / OR / XOR / AND NOT of two grids of the same size
+//   * shifting the content by (dx, dy), or one step in one of the 4 or 8 directions
+//   * counting the set cells (popcount)
+//   * flood fill steps: grow the set cells into their 4 neighbours, limited by a mask
+//   * iteration over the set cells (yields CoordType, see flcCoord.h)
+//
+// All whole grid operations are plain loops over the word arrays without branches, which the
+// compiler can unroll and vectorize.
+//
+// Typical use - all cells that can be reached from (0, 0) through open cells:
+//
+//     flcBitGrid open = BitGridFromLines( vMap, '.' );
+//     flcBitGrid reach( open.Width(), open.Height());
+//     reach.Set( 0, 0 );
+//     reach.FloodFill( open );
+
+#ifndef FLCBITGRID_H
+#define FLCBITGRID_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "flcCoord.h"
+
+// ==============================/ Class flcBitGrid /==============================
+
+class flcBitGrid {
+public:
+    class iterator {
+    public:
+        iterator( const flcBitGrid *pGrid, int nWord );
+        CoordType operator * () const;
+        iterator &operator ++ ();
+        bool operator != ( const iterator &rhs ) const { return m_nWord != rhs.m_nWord || m_nBits != rhs.m_nBits; }
+    private:
+        void SkipToSetBit();
+
+        const flcBitGrid *m_pGrid;
+        int      m_nWord;    // word that's being iterated
+        uint64_t m_nBits;    // the bits of that word that were not visited yet
+    };
+
+    flcBitGrid() {}
+    flcBitGrid( int nWidth, int nHeight ) { Init( nWidth, nHeight ); }
+
+    // (re)sizes the grid - all cells are cleared
+    void Init( int nWidth, int nHeight );
+
+    int Width()       const { return m_nWidth;  }
+    int Height()      const { return m_nHeight; }
+    int WordsPerRow() const { return m_nWordsPerRow; }
+    bool InBounds( int x, int y ) const { return x >= 0 && x < m_nWidth && y >= 0 && y < m_nHeight; }
+
+    // single cell access - NOTE: no bounds checking
+    void Set(   int x, int y ) { m_vWords[ WordIndex( x, y ) ] |=  (1ULL << (x & 63)); }
+    void Reset( int x, int y ) { m_vWords[ WordIndex( x, y ) ] &= ~(1ULL << (x & 63)); }
+    bool Test(  int x, int y ) const { return (m_vWords[ WordIndex( x, y ) ] >> (x & 63)) & 1ULL; }
+
+    // all cells at once
+    void SetAll();
+    void ClearAll();
+    bool Any() const;
+    int  Count() const;
+
+    // cell wise operations with a grid of the same size
+    flcBitGrid &operator &= ( const flcBitGrid &rhs );
+    flcBitGrid &operator |= ( const flcBitGrid &rhs );
+    flcBitGrid &operator ^= ( const flcBitGrid &rhs );
+    flcBitGrid &AndNot( const flcBitGrid &rhs );     // clears the cells that are set in rhs
+    flcBitGrid  operator ~  () const;
+    bool operator == ( const flcBitGrid &rhs ) const { return m_vWords == rhs.m_vWords; }
+    bool operator != ( const flcBitGrid &rhs ) const { return m_vWords != rhs.m_vWords; }
+
+    // returns a copy with the content moved by (dx, dy): cell (x, y) of the result is cell (x - dx,
+    // y - dy) of this grid. Cells shifted in from outside the grid are cleared. Requires |dx| < 64
+    flcBitGrid Shifted( int dx, int dy ) const;
+    // content moved one step in direction nDir - see the direction tables in flcGrid.h
+    flcBitGrid Shifted4( int nDir ) const;
+    flcBitGrid Shifted8( int nDir ) const;
+    // the cells that have a set cell as 4 resp. 8 neighbour, or are set themselves
+    flcBitGrid Dilated4() const;
+    flcBitGrid Dilated8() const;
+
+    // one flood fill step: the set cells grow into their 4 neighbours, but only into cells that are
+    // set in mask. Returns true if any cell was added
+    bool FloodStep( const flcBitGrid &mask );
+    // repeats FloodStep() until the set cells don't grow anymore. Returns the nr of steps that added cells
+    int  FloodFill( const flcBitGrid &mask );
+
+    iterator begin() const { return iterator( this, 0 ); }
+    iterator end()   const { return iterator( this, (int)m_vWords.size()); }
+
+private:
+    int WordIndex( int x, int y ) const { return y * m_nWordsPerRow + (x >> 6); }
+    // clears the bits beyond m_nWidth in the last word of each row
+    void ClearPadding();
+    // in place shifts of the content towards higher x resp. higher y (negative values shift back)
+    void ShiftX( int dx );
+    void ShiftY( int dy );
+
+    int m_nWidth  = 0;
+    int m_nHeight = 0;
+    int m_nWordsPerRow = 0;
+    uint64_t m_nLastWordMask = 0;    // the valid bits of the last word of each row
+    std::vector<uint64_t> m_vWords;
+};
+
+flcBitGrid operator & ( const flcBitGrid &lhs, const flcBitGrid &rhs );
+flcBitGrid operator | ( const flcBitGrid &lhs, const flcBitGrid &rhs );
+flcBitGrid operator ^ ( const flcBitGrid &lhs, const flcBitGrid &rhs );
+
+// creates a bit grid from a set of equally long text lines (e.g. a DataStream of std::string), where
+// the cells with character c are set
+template <typename LineContainer>
+flcBitGrid BitGridFromLines( const LineContainer &vLines, char c ) {
+    int nHeight = (int)vLines.size();
+    int nWidth  = (nHeight == 0) ? 0 : (int)vLines[0].length();
+    flcBitGrid grid( nWidth, nHeight );
+    for (int y = 0; y < nHeight; y++) {
+        for (int x = 0; x < nWidth && x < (int)vLines[y].length(); x++) {
+            if (vLines[y][x] == c) {
+                grid.Set( x, y );
+            }
+        }
+    }
+    return grid;
+}
+
+#endif // FLCBITGRID_H
@@ -0,0 +1,94 @@
+// AoC 2024 - packed coordinates, coordinate set and coordinate map
+// ================================================================
+
+// date:  2025-01-24
+// by:    Joseph21 (Joseph21-6147)
+
+#include <iostream>
+
+#include "flcCoord.h"
+
+// nr of trailing zero bits of nWord, which must not be 0
+static inline int TrailingZeros( uint64_t nWord ) {
+#if defined( __GNUC__ ) || defined( __clang__ )
+    return __builtin_ctzll( nWord );
+#else
+    int nResult = 0;
+    while ((nWord & 1ULL) == 0) {
+        nWord >>= 1;
+        nResult += 1;
+    }
+    return nResult;
+#endif
+}
+
+// ==============================/ Class flcCoordSet /==============================
+
+void flcCoordSet::Init( int nWidth, int nHeight, int nMinX, int nMinY ) {
+    m_nMinX   = nMinX;
+    m_nMinY   = nMinY;
+    m_nWidth  = nWidth;
+    m_nHeight = nHeight;
+    m_vWords.assign( ((size_t)nWidth * nHeight + 63) / 64, 0 );
+    m_nCount  = 0;
+}
+
+bool flcCoordSet::Insert( int x, int y ) {
+    if (!InRange( x, y )) {
+        std::cout << "ERROR: flcCoordSet::Insert() --> coordinate out of range: (" << x << ", " << y << ")" << std::endl;
+        return false;
+    }
+    int nBit = BitIndex( x, y );
+    uint64_t nMask = 1ULL << (nBit & 63);
+    if (m_vWords[nBit >> 6] & nMask) {
+        return false;
+    }
+    m_vWords[nBit >> 6] |= nMask;
+    m_nCount += 1;
+    return true;
+}
+
+bool flcCoordSet::Erase( int x, int y ) {
+    if (!Contains( x, y )) {
+        return false;
+    }
+    int nBit = BitIndex( x, y );
+    m_vWords[nBit >> 6] &= ~(1ULL << (nBit & 63));
+    m_nCount -= 1;
+    return true;
+}
+
+void flcCoordSet::clear() {
+    m_vWords.assign( m_vWords.size(), 0 );
+    m_nCount = 0;
+}
+
+// ==============================/ Class flcCoordSet::iterator /==============================
+
+flcCoordSet::iterator::iterator( const flcCoordSet *pSet, int nBit ) : m_pSet( pSet ), m_nBit( nBit ) {
+    SkipToSetBit();
+}
+
+CoordType flcCoordSet::iterator::operator * () const {
+    return { m_pSet->m_nMinX + m_nBit % m_pSet->m_nWidth, m_pSet->m_nMinY + m_nBit / m_pSet->m_nWidth };
+}
+
+flcCoordSet::iterator &flcCoordSet::iterator::operator ++ () {
+    m_nBit += 1;
+    SkipToSetBit();
+    return *this;
+}
+
+// moves m_nBit forward to the next set bit, or to the end position - whole empty words are skipped at once
+void flcCoordSet::iterator::SkipToSetBit() {
+    int nEnd = m_pSet->m_nWidth * m_pSet->m_nHeight;
+    while (m_nBit < nEnd) {
+        uint64_t nWord = m_pSet->m_vWords[m_nBit >> 6] >> (m_nBit & 63);
+        if (nWord != 0) {
+            m_nBit += TrailingZeros( nWord );
+            return;
+        }
+        m_nBit = (m_nBit | 63) + 1;
+    }
+    m_nBit = nEnd;
+}
@@ -0,0 +1,249 @@
+// AoC 2024 - packed coordinates, coordinate set and coordinate map
+// ================================================================
+
+// date:  2025-01-24
+// by:    Joseph21 (Joseph21-6147)
+
+// Most days keep sets of locations in a std::set<LocType>, which costs a tree node allocation and a
+// handful of cache misses per insert. This lib offers two alternatives:
+//
+//   * flcCoordSet    - dense set for coordinates within a known rectangle (e.g. the map), one bit per
+//                      coordinate. Insert, erase and lookup are a bit operation, size() is kept up to date
+//                      and iteration visits the set coordinates in row major order.
+//   * flcCoordMap<V> - hash map from coordinates to values of type V, for coordinates that are not
+//                      bounded in advance. Open addressing with linear probing in one flat table.
+//
+// Both work with (x, y) int pairs. Internally a coordinate is packed into one 64 bit key (see
+// PackCoord()), which is also usable on its own, e.g. as key in other containers.
+
+#ifndef FLCCOORD_H
+#define FLCCOORD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// ==========   PACKED COORDINATES
+
+typedef uint64_t CoordKeyType;
+
+// the y coordinate goes in the high 32 bits, the x coordinate in the low 32 bits - so the keys sort in
+// row major order (for non negative coordinates)
+inline CoordKeyType PackCoord( int x, int y ) { return ((CoordKeyType)(uint32_t)y << 32) | (uint32_t)x; }
+inline int CoordX( CoordKeyType nKey ) { return (int)(uint32_t)( nKey        & 0xFFFFFFFFULL); }
+inline int CoordY( CoordKeyType nKey ) { return (int)(uint32_t)((nKey >> 32) & 0xFFFFFFFFULL); }
+
+// what the containers yield when iterating
+typedef struct sCoordStruct {
+    int x, y;
+} CoordType;
+
+// ==============================/ Class flcCoordSet /==============================
+
+class flcCoordSet {
+public:
+    class iterator {
+    public:
+        iterator( const flcCoordSet *pSet, int nBit );
+        CoordType operator * () const;
+        iterator &operator ++ ();
+        bool operator != ( const iterator &rhs ) const { return m_nBit != rhs.m_nBit; }
+    private:
+        void SkipToSetBit();
+
+        const flcCoordSet *m_pSet;
+        int m_nBit;
+    };
+
+    flcCoordSet() {}
+    // the set can hold coordinates with nMinX <= x < nMinX + nWidth and nMinY <= y < nMinY + nHeight
+    flcCoordSet( int nWidth, int nHeight, int nMinX = 0, int nMinY = 0 ) { Init( nWidth, nHeight, nMinX, nMinY ); }
+
+    // (re)sizes the set and empties it
+    void Init( int nWidth, int nHeight, int nMinX = 0, int nMinY = 0 );
+
+    bool InRange( int x, int y ) const {
+        return x >= m_nMinX && x < m_nMinX + m_nWidth && y >= m_nMinY && y < m_nMinY + m_nHeight;
+    }
+    // returns true if (x, y) was not in the set yet. Coordinates out of range give an error message
+    bool Insert( int x, int y );
+    // returns true if (x, y) was in the set
+    bool Erase( int x, int y );
+    bool Contains( int x, int y ) const {
+        if (!InRange( x, y )) {
+            return false;
+        }
+        int nBit = BitIndex( x, y );
+        return (m_vWords[nBit >> 6] >> (nBit & 63)) & 1ULL;
+    }
+
+    int  size()  const { return m_nCount; }
+    bool empty() const { return m_nCount == 0; }
+    void clear();
+
+    iterator begin() const { return iterator( this, 0 ); }
+    iterator end()   const { return iterator( this, m_nWidth * m_nHeight ); }
+
+private:
+    int BitIndex( int x, int y ) const { return (y - m_nMinY) * m_nWidth + (x - m_nMinX); }
+
+    int m_nMinX = 0, m_nMinY = 0;
+    int m_nWidth = 0, m_nHeight = 0;
+    int m_nCount = 0;
+    std::vector<uint64_t> m_vWords;
+};
+
+// ==============================/ Class flcCoordMap /==============================
+
+// hash of a packed coordinate, spread over the high bits (Fibonacci hashing)
+inline uint64_t HashCoord( CoordKeyType nKey ) { return nKey * 0x9E3779B97F4A7C15ULL; }
+
+template <typename V>
+class flcCoordMap {
+public:
+    // what the iterator yields - value refers into the map
+    typedef struct sEntryStruct {
+        int x, y;
+        V  &value;
+    } EntryType;
+
+    class iterator {
+    public:
+        iterator( flcCoordMap *pMap, size_t nSlot ) : m_pMap( pMap ), m_nSlot( nSlot ) { SkipToUsedSlot(); }
+        EntryType operator * () const {
+            CoordKeyType nKey = m_pMap->m_vKeys[m_nSlot];
+            return { CoordX( nKey ), CoordY( nKey ), m_pMap->m_vValues[m_nSlot] };
+        }
+        iterator &operator ++ () { m_nSlot += 1; SkipToUsedSlot(); return *this; }
+        bool operator != ( const iterator &rhs ) const { return m_nSlot != rhs.m_nSlot; }
+    private:
+        void SkipToUsedSlot() {
+            while (m_nSlot < m_pMap->m_vUsed.size() && !m_pMap->m_vUsed[m_nSlot]) {
+                m_nSlot += 1;
+            }
+        }
+        flcCoordMap *m_pMap;
+        size_t m_nSlot;
+    };
+
+    flcCoordMap( size_t nExpected = 16 ) { Reserve( nExpected ); }
+
+    // makes room for nExpected elements without rehashing
+    void Reserve( size_t nExpected ) {
+        size_t nCapacity = 16;
+        while (nCapacity < 2 * nExpected) {
+            nCapacity *= 2;
+        }
+        if (nCapacity > m_vUsed.size()) {
+            Rehash( nCapacity );
+        }
+    }
+
+    // returns the value for (x, y), inserting a default constructed one if (x, y) is not in the map
+    V &operator () ( int x, int y ) {
+        CoordKeyType nKey = PackCoord( x, y );
+        size_t nSlot = FindSlot( nKey );
+        if (!m_vUsed[nSlot]) {
+            if (2 * (m_nCount + 1) > m_vUsed.size()) {
+                Rehash( 2 * m_vUsed.size());
+                nSlot = FindSlot( nKey );
+            }
+            m_vUsed[nSlot]   = 1;
+            m_vKeys[nSlot]   = nKey;
+            m_vValues[nSlot] = V();
+            m_nCount += 1;
+        }
+        return m_vValues[nSlot];
+    }
+    // returns true if (x, y) was not in the map yet - an existing value is overwritten
+    bool Insert( int x, int y, const V &value ) {
+        size_t nBefore = m_nCount;
+        (*this)( x, y ) = value;
+        return m_nCount > nBefore;
+    }
+    // returns a pointer to the value for (x, y), or nullptr if (x, y) is not in the map
+    V *Find( int x, int y ) {
+        size_t nSlot = FindSlot( PackCoord( x, y ));
+        return m_vUsed[nSlot] ? &m_vValues[nSlot] : nullptr;
+    }
+    bool Contains( int x, int y ) { return Find( x, y ) != nullptr; }
+
+    // returns true if (x, y) was in the map. The entries after it in the probe sequence are moved up,
+    // so no tombstones are needed
+    bool Erase( int x, int y ) {
+        size_t nSlot = FindSlot( PackCoord( x, y ));
+        if (!m_vUsed[nSlot]) {
+            return false;
+        }
+        size_t nMask = m_vUsed.size() - 1;
+        size_t nHole = nSlot;
+        for (size_t nNext = (nHole + 1) & nMask; m_vUsed[nNext]; nNext = (nNext + 1) & nMask) {
+            size_t nHome = HomeSlot( m_vKeys[nNext] );
+            // move the entry into the hole if its home slot doesn't lie cyclically in (nHole, nNext]
+            if (((nNext - nHome) & nMask) >= ((nNext - nHole) & nMask)) {
+                m_vKeys[nHole]   = m_vKeys[nNext];
+                m_vValues[nHole] = m_vValues[nNext];
+                nHole = nNext;
+            }
+        }
+        m_vUsed[nHole]   = 0;
+        m_vValues[nHole] = V();
+        m_nCount -= 1;
+        return true;
+    }
+
+    size_t size()  const { return m_nCount; }
+    bool   empty() const { return m_nCount == 0; }
+    void clear() {
+        m_vUsed.assign( m_vUsed.size(), 0 );
+        m_vValues.assign( m_vValues.size(), V());
+        m_nCount = 0;
+    }
+
+    iterator begin() { return iterator( this, 0 ); }
+    iterator end()   { return iterator( this, m_vUsed.size()); }
+
+private:
+    size_t HomeSlot( CoordKeyType nKey ) const { return (size_t)(HashCoord( nKey ) >> m_nShift); }
+
+    // slot that holds nKey, or the empty slot where it should go
+    size_t FindSlot( CoordKeyType nKey ) const {
+        size_t nMask = m_vUsed.size() - 1;
+        size_t nSlot = HomeSlot( nKey );
+        while (m_vUsed[nSlot] && m_vKeys[nSlot] != nKey) {
+            nSlot = (nSlot + 1) & nMask;
+        }
+        return nSlot;
+    }
+
+    // nCapacity must be a power of 2
+    void Rehash( size_t nCapacity ) {
+        std::vector<CoordKeyType>  vOldKeys   = std::move( m_vKeys   );
+        std::vector<V>             vOldValues = std::move( m_vValues );
+        std::vector<unsigned char> vOldUsed   = std::move( m_vUsed   );
+        m_vKeys.assign(   nCapacity, 0   );
+        m_vValues.assign( nCapacity, V() );
+        m_vUsed.assign(   nCapacity, 0   );
+        m_nShift = 64;
+        for (size_t n = nCapacity; n > 1; n >>= 1) {
+            m_nShift -= 1;
+        }
+        for (size_t i = 0; i < vOldUsed.size(); i++) {
+            if (vOldUsed[i]) {
+                size_t nSlot = FindSlot( vOldKeys[i] );
+                m_vUsed[nSlot]   = 1;
+                m_vKeys[nSlot]   = vOldKeys[i];
+                m_vValues[nSlot] = std::move( vOldValues[i] );
+            }
+        }
+    }
+
+    std::vector<CoordKeyType>  m_vKeys;
+    std::vector<V>             m_vValues;
+    std::vector<unsigned char> m_vUsed;
+    size_t m_nCount = 0;
+    int    m_nShift = 64;    // 64 - log2( capacity )
+};
+
+#endif // FLCCOORD_H
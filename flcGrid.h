@@ -0,0 +1,179 @@
+// AoC 2024 - 2D grid container
+// ============================
+
+// date:  2025-01-22
+// by:    Joseph21 (Joseph21-6147)
+
+// flcGrid<T> stores a 2D map in one contiguous, row major block of memory, instead of a
+// std::vector<std::string> or a vector of vectors. Optionally the map is surrounded by a border of
+// nBorder cells that hold a sentinel value. With a border that is wide enough, stepping from any cell
+// of the map to a neighbour never leaves the memory block, so the bounds checks in the inner loops can
+// be replaced by a check on the sentinel value.
+//
+// Cells are addressed either with (x, y) coordinates, where 0 <= x < Width() and 0 <= y < Height()
+// are the map itself and the border cells have coordinates down to -nBorder resp. up to Width() +
+// nBorder - 1, or with a flat index (see Index()). Stepping in a direction is adding an offset to the
+// flat index (see Offset4() and Offset8()).
+//
+// Typical use:
+//
+//     flcGrid<char> grid = GridFromLines( vLines, 1, '#' );   // map with a 1 cell border of '#'
+//     int nCur = grid.Index( x, y );
+//     int nNxt = nCur + grid.Offset4( nDir );
+//     if (grid[nNxt] != '#') { ... }
+//
+// NOTE: use char instead of bool for grids of flags - std::vector<bool> is packed, and its cells can't
+// be referenced.
+
+#ifndef FLCGRID_H
+#define FLCGRID_H
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "my_utility.h"
+
+// ==========   DIRECTION TABLES
+
+// 4 directions, clockwise starting with up: up, right, down, left
+constexpr int glbDirX4[4] = {  0, +1,  0, -1 };
+constexpr int glbDirY4[4] = { -1,  0, +1,  0 };
+// 8 directions, clockwise starting with up: up, up right, right, down right, down, down left, left, up left
+constexpr int glbDirX8[8] = {  0, +1, +1, +1,  0, -1, -1, -1 };
+constexpr int glbDirY8[8] = { -1, -1,  0, +1, +1, +1,  0, -1 };
+
+// ==============================/ Class flcGrid /==============================
+
+template <typename T>
+class flcGrid {
+public:
+    // strided view on a line of cells (a row, column or diagonal), usable in range based for loops
+    class View {
+    public:
+        class iterator {
+        public:
+            iterator( T *pCell, int nStep ) : m_pCell( pCell ), m_nStep( nStep ) {}
+            T &operator * () const { return *m_pCell; }
+            iterator &operator ++ () { m_pCell += m_nStep; return *this; }
+            bool operator != ( const iterator &rhs ) const { return m_pCell != rhs.m_pCell; }
+        private:
+            T  *m_pCell;
+            int m_nStep;
+        };
+
+        View( T *pFirst, int nStep, int nCount ) : m_pFirst( pFirst ), m_nStep( nStep ), m_nCount( nCount ) {}
+        iterator begin() const { return iterator( m_pFirst, m_nStep ); }
+        iterator end()   const { return iterator( m_pFirst + m_nStep * m_nCount, m_nStep ); }
+        int size() const { return m_nCount; }
+        T &operator [] ( int i ) const { return m_pFirst[ m_nStep * i ]; }
+    private:
+        T  *m_pFirst;
+        int m_nStep;
+        int m_nCount;
+    };
+
+    flcGrid() {}
+    flcGrid( int nWidth, int nHeight, const T &fill = T(), int nBorder = 0 ) { Init( nWidth, nHeight, fill, nBorder ); }
+
+    // (re)sizes the grid - all cells, including the border cells, are set to fill
+    void Init( int nWidth, int nHeight, const T &fill = T(), int nBorder = 0 ) {
+        m_nWidth  = nWidth;
+        m_nHeight = nHeight;
+        m_nBorder = nBorder;
+        m_nStride = nWidth + 2 * nBorder;
+        m_vCells.assign( (size_t)m_nStride * (nHeight + 2 * nBorder), fill );
+    }
+    // sets all cells to fill, or only the border cells to sentinel
+    void Fill( const T &fill ) { m_vCells.assign( m_vCells.size(), fill ); }
+    void SetBorder( const T &sentinel ) {
+        for (int y = -m_nBorder; y < m_nHeight + m_nBorder; y++) {
+            for (int x = -m_nBorder; x < m_nWidth + m_nBorder; x++) {
+                if (!InBounds( x, y )) {
+                    (*this)( x, y ) = sentinel;
+                }
+            }
+        }
+    }
+
+    // dimensions of the map, excluding the border
+    int Width()  const { return m_nWidth;  }
+    int Height() const { return m_nHeight; }
+    int Border() const { return m_nBorder; }
+    // nr of cells per row in memory, including the border cells
+    int Stride() const { return m_nStride; }
+    // nr of cells in memory, including the border cells
+    int Size()   const { return (int)m_vCells.size(); }
+
+    // true if (x, y) is a map cell (i.e. not in the border and not outside the grid)
+    bool InBounds( int x, int y ) const { return x >= 0 && x < m_nWidth && y >= 0 && y < m_nHeight; }
+
+    // conversion between (x, y) and the flat index
+    int Index( int x, int y ) const { return (y + m_nBorder) * m_nStride + (x + m_nBorder); }
+    int IndexX( int nIndex )  const { return nIndex % m_nStride - m_nBorder; }
+    int IndexY( int nIndex )  const { return nIndex / m_nStride - m_nBorder; }
+
+    // flat index offset of one step in direction nDir - see the direction tables
+    int Offset4( int nDir ) const { return glbDirY4[nDir] * m_nStride + glbDirX4[nDir]; }
+    int Offset8( int nDir ) const { return glbDirY8[nDir] * m_nStride + glbDirX8[nDir]; }
+
+    // cell access - NOTE: bounds are only checked in a checked build (MY_CHECKS, see my_utility.h). The
+    // file and line default to the place of the call, so that a failed check points at the caller. An
+    // operator [] can't have extra parameters, so its check reports no location
+    T       &operator () ( int x, int y, const char *sFile = __builtin_FILE(), int nLine = __builtin_LINE() ) {
+        CheckCell( x, y, sFile, nLine ); return m_vCells[ Index( x, y ) ];
+    }
+    const T &operator () ( int x, int y, const char *sFile = __builtin_FILE(), int nLine = __builtin_LINE() ) const {
+        CheckCell( x, y, sFile, nLine ); return m_vCells[ Index( x, y ) ];
+    }
+    T       &operator [] ( int nIndex )       { CheckIndex( "flcGrid::operator []", nIndex, 0, Size()); return m_vCells[ nIndex ]; }
+    const T &operator [] ( int nIndex ) const { CheckIndex( "flcGrid::operator []", nIndex, 0, Size()); return m_vCells[ nIndex ]; }
+    T       *Data()                           { return m_vCells.data(); }
+
+    // views on the map cells (the border is not part of them). Diag() runs down and to the right
+    // from (x, y), AntiDiag() runs down and to the left, both until they leave the map
+    View Row( int y, const char *sFile = __builtin_FILE(), int nLine = __builtin_LINE() ) {
+        return View( &(*this)( 0, y, sFile, nLine ), 1, m_nWidth );
+    }
+    View Col( int x, const char *sFile = __builtin_FILE(), int nLine = __builtin_LINE() ) {
+        return View( &(*this)( x, 0, sFile, nLine ), m_nStride, m_nHeight );
+    }
+    View Diag( int x, int y, const char *sFile = __builtin_FILE(), int nLine = __builtin_LINE() ) {
+        return View( &(*this)( x, y, sFile, nLine ), m_nStride + 1, std::min( m_nWidth - x, m_nHeight - y ));
+    }
+    View AntiDiag( int x, int y, const char *sFile = __builtin_FILE(), int nLine = __builtin_LINE() ) {
+        return View( &(*this)( x, y, sFile, nLine ), m_nStride - 1, std::min( x + 1, m_nHeight - y ));
+    }
+
+private:
+    // (x, y) must be a map or border cell - sFile and nLine are those of the caller
+    void CheckCell( int x, int y, const char *sFile, int nLine ) const {
+        if constexpr (MY_CHECKS) {
+            CheckIndex( "flcGrid::operator ()", x, -m_nBorder, m_nWidth  + m_nBorder, sFile, nLine );
+            CheckIndex( "flcGrid::operator ()", y, -m_nBorder, m_nHeight + m_nBorder, sFile, nLine );
+        }
+    }
+
+    int m_nWidth  = 0;
+    int m_nHeight = 0;
+    int m_nBorder = 0;
+    int m_nStride = 0;
+    std::vector<T> m_vCells;
+};
+
+// creates a character grid from a set of equally long text lines (e.g. a DataStream of std::string),
+// surrounded by a border of nBorder cells that are set to cSentinel
+template <typename LineContainer>
+flcGrid<char> GridFromLines( const LineContainer &vLines, int nBorder = 0, char cSentinel = ' ' ) {
+    int nHeight = (int)vLines.size();
+    int nWidth  = (nHeight == 0) ? 0 : (int)vLines[0].length();
+    flcGrid<char> grid( nWidth, nHeight, cSentinel, nBorder );
+    for (int y = 0; y < nHeight; y++) {
+        for (int x = 0; x < nWidth && x < (int)vLines[y].length(); x++) {
+            grid( x, y ) = vLines[y][x];
+        }
+    }
+    return grid;
+}
+
+#endif // FLCGRID_H
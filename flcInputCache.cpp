@@ -0,0 +1,161 @@
+// AoC 2024 - binary cache of parsed input data
+// ============================================
+
+// date:  2025-01-20
+// by:    Joseph21 (Joseph21-6147)
+
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <mutex>
+
+#include "flcInputCache.h"
+
+// layout of the header at the start of each cache file
+typedef struct sCacheHeaderStruct {
+    char     cMagic[8];      // "FLCCACHE"
+    uint32_t nVersion;       // FLC_INPUT_CACHE_VERSION
+    uint32_t nRecordSize;    // sizeof() of one record
+    uint64_t nInputSize;     // size of the input file in bytes
+    int64_t  nInputMTime;    // modification time of the input file (file clock ticks)
+    uint64_t nInputHash;     // hash of the input file content
+    uint64_t nTagHash;       // hash of the tag passed by the day
+    uint64_t nCount;         // nr of records following the header
+} CacheHeaderType;
+
+static const char *glbCacheMagic = "FLCCACHE";
+
+bool flcInputCache::m_bEnabled = false;
+
+uint64_t flcInputCache::HashContent( std::string_view sContent, uint64_t nHash ) {
+    for (unsigned char c : sContent) {
+        nHash ^= c;
+        nHash *= 1099511628211ULL;
+    }
+    return nHash;
+}
+
+// the modification time of sFileName, or 0 if it can't be determined
+static int64_t FileMTime( const std::string &sFileName ) {
+    std::error_code ec;
+    std::filesystem::file_time_type mtime = std::filesystem::last_write_time( sFileName, ec );
+    return ec ? 0 : (int64_t)mtime.time_since_epoch().count();
+}
+
+// the content hash of the most recently hashed input file, so that Save() after a failed Load() on
+// the same, unchanged file doesn't hash it again
+static std::mutex  glbHashMutex;
+static std::string glbHashedFile;
+static uint64_t    glbHashedSize  = 0;
+static int64_t     glbHashedMTime = 0;
+static uint64_t    glbHashedValue = 0;
+
+static uint64_t InputHash( flcInputFile &inputFile, uint64_t nSize, int64_t nMTime ) {
+    std::lock_guard<std::mutex> lock( glbHashMutex );
+    if (glbHashedFile != inputFile.GetFileName() || glbHashedSize != nSize || glbHashedMTime != nMTime) {
+        glbHashedFile  = inputFile.GetFileName();
+        glbHashedSize  = nSize;
+        glbHashedMTime = nMTime;
+        glbHashedValue = flcInputCache::HashContent( inputFile.GetContent());
+    }
+    return glbHashedValue;
+}
+
+// fills in the header that the cache file of inputFile should have for this tag and record size -
+// except for the content hash, which is only computed when it's needed
+static CacheHeaderType ExpectedHeader( flcInputFile &inputFile, const std::string &sTag, size_t nRecordSize ) {
+    CacheHeaderType header;
+    memcpy( header.cMagic, glbCacheMagic, sizeof( header.cMagic ));
+    header.nVersion    = FLC_INPUT_CACHE_VERSION;
+    header.nRecordSize = (uint32_t)nRecordSize;
+    header.nInputSize  = (uint64_t)inputFile.GetContent().length();
+    header.nInputMTime = FileMTime( inputFile.GetFileName());
+    header.nInputHash  = 0;
+    header.nTagHash    = flcInputCache::HashContent( sTag );
+    header.nCount      = 0;
+    return header;
+}
+
+bool flcInputCache::OpenBlock( flcInputFile &inputFile, const std::string &sTag, size_t nRecordSize,
+                               flcInputFile &cacheFile, std::string_view &sPayload, size_t &nCount ) {
+    if (!m_bEnabled || !inputFile.IsOpen()) {
+        return false;
+    }
+    std::string sCacheFile = CacheFileName( inputFile.GetFileName());
+    // a missing cache file is not an error, so check before flcInputFile::Open() reports it
+    FILE *pFile = fopen( sCacheFile.c_str(), "rb" );
+    if (pFile == nullptr) {
+        return false;
+    }
+    fclose( pFile );
+    if (!cacheFile.Open( sCacheFile )) {
+        return false;
+    }
+
+    std::string_view sContent = cacheFile.GetContent();
+    if (sContent.length() < sizeof( CacheHeaderType )) {
+        return false;
+    }
+    CacheHeaderType header, expected = ExpectedHeader( inputFile, sTag, nRecordSize );
+    memcpy( &header, sContent.data(), sizeof( CacheHeaderType ));
+    bool bValid = (
+        memcmp( header.cMagic, expected.cMagic, sizeof( header.cMagic )) == 0 &&
+        header.nVersion    == expected.nVersion    &&
+        header.nRecordSize == expected.nRecordSize &&
+        header.nInputSize  == expected.nInputSize  &&
+        header.nTagHash    == expected.nTagHash    &&
+        sContent.length() - sizeof( CacheHeaderType ) == header.nCount * nRecordSize
+    );
+    // same size but a different modification time: the file may have been touched only, let the content decide
+    if (bValid && header.nInputMTime != expected.nInputMTime) {
+        bValid = (header.nInputHash == InputHash( inputFile, expected.nInputSize, expected.nInputMTime ));
+        if (bValid) {
+            // store the new time, so the next Load() doesn't need the hash again
+            pFile = fopen( sCacheFile.c_str(), "r+b" );
+            if (pFile != nullptr) {
+                if (fseek( pFile, (long)offsetof( CacheHeaderType, nInputMTime ), SEEK_SET ) == 0) {
+                    fwrite( &expected.nInputMTime, sizeof( expected.nInputMTime ), 1, pFile );
+                }
+                fclose( pFile );
+            }
+        }
+    }
+    if (bValid) {
+        sPayload = sContent.substr( sizeof( CacheHeaderType ));
+        nCount   = (size_t)header.nCount;
+    }
+    return bValid;
+}
+
+bool flcInputCache::WriteBlock( flcInputFile &inputFile, const std::string &sTag, size_t nRecordSize,
+                                const void *pData, size_t nCount ) {
+    if (!m_bEnabled || !inputFile.IsOpen()) {
+        return false;
+    }
+    CacheHeaderType header = ExpectedHeader( inputFile, sTag, nRecordSize );
+    header.nInputHash = InputHash( inputFile, header.nInputSize, header.nInputMTime );
+    header.nCount     = nCount;
+
+    // write to a temporary file first, so that an interrupted run never leaves a half written cache
+    std::string sCacheFile = CacheFileName( inputFile.GetFileName());
+    std::string sTempFile  = sCacheFile + ".tmp";
+    FILE *pFile = fopen( sTempFile.c_str(), "wb" );
+    if (pFile == nullptr) {
+        std::cout << "ERROR: flcInputCache::WriteBlock() --> can't create file: " << sTempFile << std::endl;
+        return false;
+    }
+    bool bOK = (fwrite( &header, sizeof( header ), 1, pFile ) == 1);
+    if (bOK && nCount > 0) {
+        bOK = (fwrite( pData, nRecordSize, nCount, pFile ) == nCount);
+    }
+    bOK = (fclose( pFile ) == 0) && bOK;
+    if (bOK) {
+        bOK = (rename( sTempFile.c_str(), sCacheFile.c_str()) == 0);
+    }
+    if (!bOK) {
+        std::cout << "ERROR: flcInputCache::WriteBlock() --> can't write file: " << sCacheFile << std::endl;
+        remove( sTempFile.c_str());
+    }
+    return bOK;
+}
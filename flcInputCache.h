@@ -0,0 +1,104 @@
+// AoC 2024 - binary cache of parsed input data
+// ============================================
+
+// date:  2025-01-20
+// by:    Joseph21 (Joseph21-6147)
+
+// The puzzle input files never change, but every run tokenizes them again. With the cache enabled
+// (--cache on the command line, see flcBenchmark) the first run stores the parsed data stream in a
+// binary file next to the input file (<input file>.cache), and later runs copy it back from that file
+// in one go, without any tokenizing.
+//
+// The cache file starts with a header that holds a format version, a tag identifying the record
+// layout, the record size, and the size, modification time and a hash of the content of the input
+// file. The cache is only used if all of these match, otherwise the input is parsed as usual and the
+// cache file is rewritten. So changing the input file invalidates the cache automatically - change
+// the tag if the meaning of the record fields changes but their size doesn't.
+//
+// To keep Load() cheap the input file is only hashed if its size matches but its modification time
+// doesn't (e.g. after a fresh checkout) - then the content hash decides. The hash is computed at most
+// once per input file state, Save() after a failed Load() reuses it.
+//
+// Only data streams of trivially copyable records (no std::string, no pointers) can be cached, and
+// the cache files are not portable between machines with a different byte order.
+//
+// Typical use in ReadInputData():
+//
+//     flcInputFile dataFile( sFileName );
+//     vData.clear();
+//     if (flcInputCache::Load( dataFile, DAY_STRING ".v1", vData )) {
+//         return;
+//     }
+//     ... parse the input into vData ...
+//     flcInputCache::Save( dataFile, DAY_STRING ".v1", vData );
+
+#ifndef FLCINPUTCACHE_H
+#define FLCINPUTCACHE_H
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "flcInputFile.h"
+
+// bump this if the layout of the cache file itself changes
+#define FLC_INPUT_CACHE_VERSION 2
+
+// starting value of the FNV-1a hash
+#define FLC_FNV_OFFSET_BASIS 14695981039346656037ULL
+
+class flcInputCache {
+public:
+    // the cache is disabled by default, Load() and Save() do nothing then
+    static void SetEnabled( bool bEnabled ) { m_bEnabled = bEnabled; }
+    static bool IsEnabled() { return m_bEnabled; }
+
+    // name of the cache file that belongs to sInputFile
+    static std::string CacheFileName( const std::string &sInputFile ) { return sInputFile + ".cache"; }
+
+    // 64 bit FNV-1a hash of sContent. Pass the hash of the preceding data as nHash to hash data that
+    // comes in pieces. This is the one content hash of the flc code, the artifact cache uses it as well
+    static uint64_t HashContent( std::string_view sContent, uint64_t nHash = FLC_FNV_OFFSET_BASIS );
+
+    // if the cache is enabled and holds valid data for the content of inputFile, the records are
+    // copied into vData (replacing its content) and true is returned. Otherwise vData is left as is
+    // and false is returned
+    template <typename T>
+    static bool Load( flcInputFile &inputFile, const std::string &sTag, std::vector<T> &vData ) {
+        static_assert( std::is_trivially_copyable<T>::value, "flcInputCache: records must be trivially copyable" );
+        flcInputFile cacheFile;
+        std::string_view sPayload;
+        size_t nCount;
+        if (!OpenBlock( inputFile, sTag, sizeof( T ), cacheFile, sPayload, nCount )) {
+            return false;
+        }
+        vData.resize( nCount );
+        if (nCount > 0) {
+            memcpy( (void *)vData.data(), sPayload.data(), nCount * sizeof( T ));
+        }
+        return true;
+    }
+
+    // if the cache is enabled, writes the records of vData to the cache file of inputFile. Returns
+    // false if the cache file could not be written
+    template <typename T>
+    static bool Save( flcInputFile &inputFile, const std::string &sTag, const std::vector<T> &vData ) {
+        static_assert( std::is_trivially_copyable<T>::value, "flcInputCache: records must be trivially copyable" );
+        return WriteBlock( inputFile, sTag, sizeof( T ), (const void *)vData.data(), vData.size());
+    }
+
+private:
+    // opens and validates the cache file of inputFile. On success sPayload points to the records in
+    // cacheFile, which must be kept open while sPayload is used
+    static bool OpenBlock( flcInputFile &inputFile, const std::string &sTag, size_t nRecordSize,
+                           flcInputFile &cacheFile, std::string_view &sPayload, size_t &nCount );
+    static bool WriteBlock( flcInputFile &inputFile, const std::string &sTag, size_t nRecordSize,
+                            const void *pData, size_t nCount );
+
+    static bool m_bEnabled;
+};
+
+#endif // FLCINPUTCACHE_H
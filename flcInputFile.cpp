@@ -0,0 +1,171 @@
+// AoC 2024 - zero copy input file loader
+// ======================================
+
+// date:  2025-01-18
+// by:    Joseph21 (Joseph21-6147)
+
+#include <cstdio>
+#include <iostream>
+
+#include "flcInputFile.h"
+
+#if defined( __unix__ ) || defined( __APPLE__ )
+#define FLC_USE_MMAP
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+// ==========   LINE SPLITTING
+
+std::string_view SplitLineAt( std::string_view sContent, size_t nPos, size_t &nNext ) {
+    size_t nEnd = sContent.find( '\n', nPos );
+    if (nEnd == std::string_view::npos) {
+        nEnd  = sContent.length();
+        nNext = nEnd;
+    } else {
+        nNext = nEnd + 1;
+    }
+    if (nEnd > nPos && sContent[nEnd - 1] == '\r') {
+        nEnd -= 1;
+    }
+    return sContent.substr( nPos, nEnd - nPos );
+}
+
+// ==============================/ Class flcInputFile /==============================
+
+flcInputFile::flcInputFile( const std::string &sFileName ) {
+    Open( sFileName );
+}
+
+flcInputFile::~flcInputFile() {
+    Close();
+}
+
+bool flcInputFile::Open( const std::string &sFileName ) {
+    Close();
+    m_sFileName = sFileName;
+
+#ifdef FLC_USE_MMAP
+    int nFd = open( sFileName.c_str(), O_RDONLY );
+    if (nFd != -1) {
+        bool bDone = false;
+        struct stat fileStat;
+        if (fstat( nFd, &fileStat ) == 0 && S_ISREG( fileStat.st_mode )) {
+            if (fileStat.st_size == 0) {
+                bDone = true;    // nothing to map
+            } else {
+                void *pMapped = mmap( nullptr, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, nFd, 0 );
+                if (pMapped != MAP_FAILED) {
+                    // the file is read front to back
+                    madvise( pMapped, (size_t)fileStat.st_size, MADV_SEQUENTIAL );
+                    m_pMapped     = pMapped;
+                    m_nMappedSize = (size_t)fileStat.st_size;
+                    m_sContent    = std::string_view( (const char *)m_pMapped, m_nMappedSize );
+                    bDone = true;
+                }
+            }
+        }
+        close( nFd );
+        if (bDone) {
+            m_bOpen = true;
+            return true;
+        }
+    }
+#endif
+    // fall back to reading the whole file into the buffer
+    FILE *pFile = fopen( sFileName.c_str(), "rb" );
+    if (pFile == nullptr) {
+        std::cout << "ERROR: flcInputFile::Open() --> can't open file: " << sFileName << std::endl;
+        return false;
+    }
+    char cChunk[65536];
+    size_t nRead;
+    while ((nRead = fread( cChunk, 1, sizeof( cChunk ), pFile )) > 0) {
+        m_vBuffer.insert( m_vBuffer.end(), cChunk, cChunk + nRead );
+    }
+    fclose( pFile );
+    m_sContent = std::string_view( m_vBuffer.data(), m_vBuffer.size());
+    m_bOpen = true;
+    return true;
+}
+
+void flcInputFile::Close() {
+#ifdef FLC_USE_MMAP
+    if (m_pMapped != nullptr) {
+        munmap( m_pMapped, m_nMappedSize );
+    }
+#endif
+    m_pMapped     = nullptr;
+    m_nMappedSize = 0;
+    m_vBuffer.clear();
+    m_sContent    = std::string_view();
+    m_nCursor     = 0;
+    m_bOpen       = false;
+    m_sFileName.clear();
+}
+
+bool flcInputFile::NextLine( std::string_view &sLine ) {
+    if (m_nCursor >= m_sContent.length()) {
+        return false;
+    }
+    sLine = SplitLineAt( m_sContent, m_nCursor, m_nCursor );
+    return true;
+}
+
+bool flcInputFile::NextRecord( std::vector<std::string_view> &vLines ) {
+    vLines.clear();
+    std::string_view sLine;
+    // skip empty lines before the record
+    bool bFound = false;
+    while (!bFound && NextLine( sLine )) {
+        bFound = !sLine.empty();
+    }
+    if (!bFound) {
+        return false;
+    }
+    vLines.push_back( sLine );
+    while (NextLine( sLine ) && !sLine.empty()) {
+        vLines.push_back( sLine );
+    }
+    return true;
+}
+
+std::vector<std::string_view> flcInputFile::GetLines() {
+    std::vector<std::string_view> vResult;
+    for (auto sLine : Lines()) {
+        vResult.push_back( sLine );
+    }
+    return vResult;
+}
+
+std::vector<std::vector<std::string_view>> flcInputFile::GetRecords() {
+    std::vector<std::vector<std::string_view>> vResult;
+    size_t nKeep = m_nCursor;
+    m_nCursor = 0;
+    std::vector<std::string_view> vRecord;
+    while (NextRecord( vRecord )) {
+        vResult.push_back( vRecord );
+    }
+    m_nCursor = nKeep;
+    return vResult;
+}
+
+// ==============================/ Class flcInputFile::LineRange::iterator /==============================
+
+flcInputFile::LineRange::iterator::iterator( std::string_view sContent, size_t nPos ) : m_sContent( sContent ), m_nPos( nPos ), m_nNext( nPos ) {
+    SplitLine();
+}
+
+void flcInputFile::LineRange::iterator::SplitLine() {
+    if (m_nPos < m_sContent.length()) {
+        m_sLine = SplitLineAt( m_sContent, m_nPos, m_nNext );
+    }
+}
+
+flcInputFile::LineRange::iterator &flcInputFile::LineRange::iterator::operator ++ () {
+    m_nPos = m_nNext;
+    SplitLine();
+    return *this;
+}
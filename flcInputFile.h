@@ -0,0 +1,107 @@
+// AoC 2024 - zero copy input file loader
+// ======================================
+
+// date:  2025-01-18
+// by:    Joseph21 (Joseph21-6147)
+
+// Gives read only access to the content of an input file, without copying it into std::string's. The file
+// is memory mapped where possible (POSIX systems), otherwise it is read into one buffer in a single go.
+// The content is available as one std::string_view, as a range of lines and as a range of records (a
+// record is a block of consecutive non empty lines, records are separated by empty lines).
+//
+// Lines are split like getline() does: a trailing '\r' is removed, and a newline at the end of the file
+// does not give an extra empty line.
+//
+// NOTE: all string_views point into the mapping / buffer, so they are valid only as long as the
+// flcInputFile object exists.
+//
+// Typical use:
+//
+//     flcInputFile dataFile( sFileName );
+//     for (std::string_view sLine : dataFile.Lines()) {
+//         ...
+//     }
+
+#ifndef FLCINPUTFILE_H
+#define FLCINPUTFILE_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+class flcInputFile {
+public:
+    flcInputFile() {}
+    // opens sFileName - check with IsOpen() if that succeeded
+    flcInputFile( const std::string &sFileName );
+    ~flcInputFile();
+
+    // not copyable, the object owns the mapping
+    flcInputFile( const flcInputFile & ) = delete;
+    flcInputFile &operator = ( const flcInputFile & ) = delete;
+
+    // closes the current file if any, and opens sFileName. Returns false and prints an error if the file
+    // can't be opened
+    bool Open( const std::string &sFileName );
+    void Close();
+
+    bool IsOpen()   { return m_bOpen; }
+    std::string GetFileName() { return m_sFileName; }
+    // true if the content is memory mapped, false if it was read into a buffer
+    bool IsMapped() { return m_pMapped != nullptr; }
+
+    // the complete file content
+    std::string_view GetContent() { return m_sContent; }
+
+    // cursor interface, comparable to getline(): returns the next line in sLine and moves the cursor
+    // past it, or returns false at the end of the content
+    bool NextLine( std::string_view &sLine );
+    // returns the lines of the next record in vLines and moves the cursor past the record and the
+    // empty line after it, or returns false if there are no more records
+    bool NextRecord( std::vector<std::string_view> &vLines );
+    // puts the cursor back at the start of the content
+    void Rewind() { m_nCursor = 0; }
+
+    // range over the lines of the content, for use in range based for loops - independent of the cursor
+    class LineRange {
+    public:
+        class iterator {
+        public:
+            iterator( std::string_view sContent, size_t nPos );
+            std::string_view operator * () const { return m_sLine; }
+            iterator &operator ++ ();
+            bool operator != ( const iterator &rhs ) const { return m_nPos != rhs.m_nPos; }
+        private:
+            void SplitLine();
+
+            std::string_view m_sContent, m_sLine;
+            size_t m_nPos, m_nNext;
+        };
+
+        LineRange( std::string_view sContent ) : m_sContent( sContent ) {}
+        iterator begin() const { return iterator( m_sContent, 0 ); }
+        iterator end()   const { return iterator( m_sContent, m_sContent.length()); }
+    private:
+        std::string_view m_sContent;
+    };
+    LineRange Lines() { return LineRange( m_sContent ); }
+
+    // all lines and all records at once
+    std::vector<std::string_view> GetLines();
+    std::vector<std::vector<std::string_view>> GetRecords();
+
+private:
+    bool m_bOpen = false;
+    std::string m_sFileName;
+    void  *m_pMapped = nullptr;    // start of the mapping if the file is mapped
+    size_t m_nMappedSize = 0;
+    std::vector<char> m_vBuffer;   // holds the content if the file is not mapped
+    std::string_view m_sContent;
+    size_t m_nCursor = 0;
+};
+
+// splits off the line that starts at nPos in sContent - the returned line excludes the newline and a
+// trailing '\r'. nNext is set to the start of the next line
+std::string_view SplitLineAt( std::string_view sContent, size_t nPos, size_t &nNext );
+
+#endif // FLCINPUTFILE_H
@@ -0,0 +1,636 @@
+// AoC 2024 - synthetic input generators
+// =====================================
+
+// date:  2025-02-03
+// by:    Joseph21 (Joseph21-6147)
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#include "flcInputGen.h"
+#include "flcRandom.h"
+#include "flcGrid.h"
+
+// ==========   OUTPUT
+
+// buffered output of the generated text
+class GenOutput {
+public:
+    GenOutput( const std::string &sFileName ) : m_file( sFileName, std::ios::binary ) {
+        if (!m_file.is_open()) {
+            std::cout << "ERROR: GenOutput() --> can't open output file: " << sFileName << std::endl;
+        }
+        m_sBuffer.reserve( BUFFER_SIZE + 1024 );
+    }
+    ~GenOutput() { if (m_file.is_open()) Flush(); }
+
+    bool IsOpen() const { return m_file.is_open(); }
+    long long BytesWritten() const { return m_nWritten + (long long)m_sBuffer.size(); }
+
+    GenOutput &operator << ( char c ) { m_sBuffer.push_back( c ); Check(); return *this; }
+    GenOutput &operator << ( const char *s ) { m_sBuffer.append( s ); Check(); return *this; }
+    GenOutput &operator << ( const std::string &s ) { m_sBuffer.append( s ); Check(); return *this; }
+    GenOutput &operator << ( long long n ) {
+        char sNum[24];
+        char *pEnd = std::to_chars( sNum, sNum + sizeof( sNum ), n ).ptr;
+        m_sBuffer.append( sNum, pEnd - sNum );
+        Check();
+        return *this;
+    }
+    GenOutput &operator << ( int n ) { return *this << (long long)n; }
+
+    void Flush() {
+        m_file.write( m_sBuffer.data(), m_sBuffer.size());
+        m_nWritten += (long long)m_sBuffer.size();
+        m_sBuffer.clear();
+    }
+    // flushes and closes the file - false if any write failed (e.g. disk full)
+    bool Close() {
+        Flush();
+        m_file.close();
+        return !m_file.fail();
+    }
+
+private:
+    static const size_t BUFFER_SIZE = 1 << 20;
+    void Check() { if (m_sBuffer.size() >= BUFFER_SIZE) Flush(); }
+
+    std::ofstream m_file;
+    std::string m_sBuffer;
+    long long m_nWritten = 0;
+};
+
+// ==========   GENERATORS PER DAY
+
+// count at the given scale, at least 1
+static long long Scaled( long long nBase, const flcGenParams &params ) {
+    return std::max( 1LL, (long long)std::llround( nBase * params.dScale ));
+}
+// side of a square grid with nBase x nBase cells at scale 1
+static int ScaledSide( int nBase, const flcGenParams &params ) {
+    return std::max( 4, (int)std::lround( nBase * std::sqrt( params.dScale )));
+}
+
+static void WriteGrid( GenOutput &out, flcGrid<char> &grid ) {
+    for (int y = 0; y < grid.Height(); y++) {
+        for (int x = 0; x < grid.Width(); x++) {
+            out << grid( x, y );
+        }
+        out << '\n';
+    }
+}
+
+// two columns of location ids. The values are drawn from a range of 10 values per line, and a fraction
+// params.dDup of the right values is taken from the left list (these give the similarity score)
+static void GenDay01( GenOutput &out, flcRandom &rng, const flcGenParams &params ) {
+    long long nLines = Scaled( 1000, params );
+    long long nRange = std::max( 90000LL, 10 * nLines );
+    std::vector<long long> vLeft;
+    for (long long i = 0; i < nLines; i++) {
+        vLeft.push_back( 10000 + rng.Below( nRange ));
+    }
+    for (long long i = 0; i < nLines; i++) {
+        long long nRight = rng.Chance( params.dDup ) ? vLeft[rng.Below( nLines )] : 10000 + (long long)rng.Below( nRange );
+        out << vLeft[i] << "   " << nRight << '\n';
+    }
+}
+
+// reports of 5 to 8 levels, increasing or decreasing by 1 to 3 - about half of them has one bad step
+static void GenDay02( GenOutput &out, flcRandom &rng, const flcGenParams &params ) {
+    long long nLines = Scaled( 1000, params );
+    for (long long i = 0; i < nLines; i++) {
+        int nLevels = (int)rng.IntBetween( 5, 8 );
+        int nDir    = rng.Chance( 0.5 ) ? 1 : -1;
+        int nBad    = rng.Chance( 0.5 ) ? (int)rng.IntBetween( 1, nLevels - 1 ) : -1;
+        int nLevel  = (int)rng.IntBetween( 40, 59 );
+        for (int j = 0; j < nLevels; j++) {
+            if (j > 0) {
+                int nStep = (int)rng.IntBetween( 1, 3 );
+                if (j == nBad) {
+                    // a flat step, a step that's too large, or a step in the wrong direction
+                    switch (rng.Below( 3 )) {
+                        case 0: nStep = 0;                            break;
+                        case 1: nStep = (int)rng.IntBetween( 4, 5 ); break;
+                        case 2: nStep = -nStep;                       break;
+                    }
+                }
+                nLevel += nDir * nStep;
+                out << ' ';
+            }
+            out << nLevel;
+        }
+        out << '\n';
+    }
+}
+
+// corrupted memory: lines of noise with valid and corrupted mul( a, b ) instructions, do() and don't()
+static void GenDay03( GenOutput &out, flcRandom &rng, const flcGenParams &params ) {
+    static const char *vNoise  = "!@#$%^&*()[]{}<>?',+-/~ :;whyeretlscmu";
+    static const char *vTokens[] = { "do()", "don't()", "mul(", "mul[", "mul ( ", "select()", "when()", "from()", "what()" };
+    int nNoise = (int)strlen( vNoise );
+    long long nLines = Scaled( 6, params );
+    for (long long i = 0; i < nLines; i++) {
+        int nLen = 0;
+        while (nLen < 3000) {
+            double dPick = rng.Real();
+            std::string sToken;
+            if (dPick < 0.04) {
+                sToken = "mul(" + std::to_string( rng.IntBetween( 1, 999 )) + "," + std::to_string( rng.IntBetween( 1, 999 )) + ")";
+            } else if (dPick < 0.06) {
+                sToken = vTokens[rng.Below( 9 )];
+            } else {
+                sToken = std::string( 1, vNoise[rng.Below( nNoise )] );
+            }
+            out << sToken;
+            nLen += (int)sToken.length();
+        }
+        out << '\n';
+    }
+}
+
+// letter grid of X, M, A and S
+static void GenDay04( GenOutput &out, flcRandom &rng, const flcGenParams &params ) {
+    int nSide = ScaledSide( 140, params );
+    flcGrid<char> grid( nSide, nSide );
+    for (int i = 0; i < grid.Size(); i++) {
+        grid[i] = "XMAS"[rng.Below( 4 )];
+    }
+    WriteGrid( out, grid );
+}
+
+// page ordering rules that form a total order over all pages, and updates of an odd nr of distinct
+// pages, about half of them in the right order
+static void GenDay05( GenOutput &out, flcRandom &rng, const flcGenParams &params ) {
+    int nPages = std::max( 5, (int)std::lround( 49 * std::sqrt( params.dScale )));
+    // distinct page numbers, in the order of the rules
+    std::vector<int> vAll;
+    for (int p = 10; p < 10 + std::max( 90, 4 * nPages ); p++) {
+        vAll.push_back( p );
+    }
+    rng.Shuffle( vAll );
+    std::vector<int> vOrder( vAll.begin(), vAll.begin() + nPages );
+    std::vector<std::pair<int, int>> vRules;
+    for (int i = 0; i < nPages; i++) {
+        for (int j = i + 1; j < nPages; j++) {
+            vRules.push_back( { i, j } );
+        }
+    }
+    rng.Shuffle( vRules );
+    for (auto &rule : vRules) {
+        out << vOrder[rule.first] << '|' << vOrder[rule.second] << '\n';
+    }
+    out << '\n';
+
+    long long nUpdates = Scaled( 200, params );
+    std::vector<int> vIndices( nPages );
+    for (int i = 0; i < nPages; i++) vIndices[i] = i;
+    for (long long u = 0; u < nUpdates; u++) {
+        int nLen = std::min( nPages - (nPages % 2 == 0 ? 1 : 0), 5 + 2 * (int)rng.Below( 10 ));
+        // the first nLen indices after a partial shuffle are a random subset
+        for (int i = 0; i < nLen; i++) {
+            std::swap( vIndices[i], vIndices[i + rng.Below( nPages - i )] );
+        }
+        std::vector<int> vUpdate( vIndices.begin(), vIndices.begin() + nLen );
+        if (rng.Chance( 0.5 )) {
+            std::sort( vUpdate.begin(), vUpdate.end());
+        }
+        for (int i = 0; i < nLen; i++) {
+            out << (i > 0 ? "," : "") << vOrder[vUpdate[i]];
+        }
+        out << '\n';
+    }
+}
+
+// true if the guard at (x, y) facing up walks off the map
+static bool GuardLeaves( flcGrid<char> &grid, int x, int y ) {
+    std::vector<char> vSeen( (size_t)grid.Size() * 4, 0 );
+    int nDir = 0;
+    while (true) {
+        char &cSeen = vSeen[(size_t)grid.Index( x, y ) * 4 + nDir];
+        if (cSeen) return false;
+        cSeen = 1;
+        int nx = x + glbDirX4[nDir], ny = y + glbDirY4[nDir];
+        if (!grid.InBounds( nx, ny )) return true;
+        if (grid( nx, ny ) == '#') {
+            nDir = (nDir + 1) % 4;
+        } else {
+            x = nx; y = ny;
+        }
+    }
+}
+
+// lab map with obstacles and a guard '^' that walks off the map (so part 1 terminates)
+static void GenDay06( GenOutput &out, flcRandom &rng, const flcGenParams &params ) {
+    int nSide = ScaledSide( 130, params );
+    flcGrid<char> grid( nSide, nSide );
+    for (int nTry = 0; nTry < 1000; nTry++) {
+        for (int i = 0; i < grid.Size(); i++) {
+            grid[i] = rng.Chance( 0.05 ) ? '#' : '.';
+        }
+        int x = (int)rng.Below( nSide ), y = (int)rng.Below( nSide );
+        grid( x, y ) = '.';
+        if (GuardLeaves( grid, x, y )) {
+            grid( x, y ) = '^';
+            WriteGrid( out, grid );
+            return;
+        }
+    }
+    // no luck - clear the column above the guard, so it walks straight off the map
+    int x = (int)rng.Below( nSide ), y = (int)rng.Below( nSide );
+    for (int i = 0; i < y; i++) {
+        grid( x, i ) = '.';
+    }
+    grid( x, y ) = '^';
+    WriteGrid( out, grid );
+}
+
+// equations: a test value that the numbers give with + * and ||, or (about 40 %) a value that's one off
+static void GenDay07( GenOutput &out, flcRandom &rng, const flcGenParams &params ) {
+    long long nLines = Scaled( 850, params );
+    for (long long i = 0; i < nLines; i++) {
+        std::vector<long long> vNums;
+        long long nValue;
+        bool bValid = false;
+        while (!bValid) {
+            int nCount = (int)rng.IntBetween( 3, 12 );
+            vNums.assign( 1, rng.IntBetween( 1, 999 ));
+            nValue = vNums[0];
+            bValid = true;
+            for (int j = 1; j < nCount && bValid; j++) {
+                long long nNum = rng.IntBetween( 1, (j % 3 == 0) ? 999 : 9 );
+                vNums.push_back( nNum );
+                switch (rng.Below( 3 )) {
+                    case 0: nValue += nNum; break;
+                    case 1: nValue *= nNum; break;
+                    case 2: nValue = std::stoll( std::to_string( nValue ) + std::to_string( nNum )); break;
+                }
+                bValid = (nValue < 100000000000000LL);
+            }
+        }
+        if (rng.Chance( 0.4 )) {
+            nValue += 1;
+        }
+        out << nValue << ':';
+        for (long long nNum : vNums) {
+            out << ' ' << nNum;
+        }
+        out << '\n';
+    }
+}
+
+// map with antennas of 62 frequencies (digits and letters)
+static void GenDay08( GenOutput &out, flcRandom &rng, const flcGenParams &params ) {
+    static const char *vFreqs = "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    int nSide = ScaledSide( 50, params );
+    flcGrid<char> grid( nSide, nSide, '.' );
+    long long nAntennas = std::min( (long long)grid.Size() / 4, Scaled( 190, params ));
+    for (long long i = 0; i < nAntennas; i++) {
+        grid[(int)rng.Below( grid.Size())] = vFreqs[rng.Below( 62 )];
+    }
+    WriteGrid( out, grid );
+}
+
+// disk map: alternating file lengths (1 - 9) and free space lengths (0 - 9), ending with a file
+static void GenDay09( GenOutput &out, flcRandom &rng, const flcGenParams &params ) {
+    long long nDigits = Scaled( 20000, params ) | 1;
+    for (long long i = 0; i < nDigits; i++) {
+        out << (char)('0' + ((i % 2 == 0) ? rng.IntBetween( 1, 9 ) : rng.IntBetween( 0, 9 )));
+    }
+    out << '\n';
+}
+
+// topographic map: random heights with a nr of hiking trails 0 - 9 painted over them
+static void GenDay10( GenOutput &out, flcRandom &rng, const flcGenParams &params ) {
+    int nSide = ScaledSide( 42, params );
+    flcGrid<char> grid( nSide, nSide );
+    for (int i = 0; i < grid.Size(); i++) {
+        grid[i] = (char)('0' + rng.Below( 10 ));
+    }
+    long long nTrails = std::max( 1LL, (long long)grid.Size() / 30 );
+    for (long long t = 0; t < nTrails; t++) {
+        int x = (int)rng.Below( nSide ), y = (int)rng.Below( nSide );
+        for (int h = 0; h <= 9; h++) {
+            grid( x, y ) = (char)('0' + h);
+            int nDir = (int)rng.Below( 4 );
+            int nx = x + glbDirX4[nDir], ny = y + glbDirY4[nDir];
+            if (!grid.InBounds( nx, ny )) break;
+            x = nx; y = ny;
+        }
+    }
+    WriteGrid( out, grid );
+}
+
+// a line of stones
+static void GenDay11( GenOutput &out, flcRandom &rng, const flcGenParams &params ) {
+    long long nStones = Scaled( 8, params );
+    for (long long i = 0; i < nStones; i++) {
+        out << (i > 0 ? " " : "") << rng.IntBetween( 0, 9999999 );
+    }
+    out << '\n';
+}
+
+// garden of irregular regions, grown from random seeds in random order
+static void GenDay12( GenOutput &out, flcRandom &rng, const flcGenParams &params ) {
+    int nSide = ScaledSide( 140, params );
+    flcGrid<char> grid( nSide, nSide, '.' );
+    std::vector<int> vFrontier;
+    int nSeeds = std::max( 1, grid.Size() / 60 );
+    for (int i = 0; i < nSeeds; i++) {
+        int nCell = (int)rng.Below( grid.Size());
+        if (grid[nCell] == '.') {
+            grid[nCell] = (char)('A' + rng.Below( 26 ));
+            vFrontier.push_back( nCell );
+        }
+    }
+    while (!vFrontier.empty()) {
+        int nPick = (int)rng.Below( vFrontier.size());
+        int nCell = vFrontier[nPick];
+        int x = grid.IndexX( nCell ), y = grid.IndexY( nCell );
+        bool bGrown = false;
+        for (int d = 0; d < 4 && !bGrown; d++) {
+            int nDir = (d + (int)rng.Below( 4 )) % 4;
+            int nx = x + glbDirX4[nDir], ny = y + glbDirY4[nDir];
+            if (grid.InBounds( nx, ny ) && grid( nx, ny ) == '.') {
+                grid( nx, ny ) = grid[nCell];
+                vFrontier.push_back( grid.Index( nx, ny ));
+                bGrown = true;
+            }
+        }
+        if (!bGrown) {
+            // all neighbours are taken - this cell can't grow anymore
+            vFrontier[nPick] = vFrontier.back();
+            vFrontier.pop_back();
+        }
+    }
+    WriteGrid( out, grid );
+}
+
+// the prize offset that part 2 of day 13 adds to both coordinates
+#define DAY13_PART2_OFFSET 10000000000000LL
+
+// claw machines - about a third of the prizes can be won in part 1, and about a third in part 2 only
+static void GenDay13( GenOutput &out, flcRandom &rng, const flcGenParams &params ) {
+    long long nMachines = Scaled( 320, params );
+    for (long long i = 0; i < nMachines; i++) {
+        long long ax = rng.IntBetween( 10, 99 ), ay = rng.IntBetween( 10, 99 );
+        long long bx, by, px, py;
+        int nKind = (int)rng.Below( 3 );
+        bool bDone = false;
+        while (!bDone) {
+            do {
+                // the button movements must not be parallel, the solutions divide by ax * by - ay * bx
+                bx = rng.IntBetween( 10, 99 );
+                by = rng.IntBetween( 10, 99 );
+            } while (ax * by == ay * bx);
+            if (nKind == 0) {
+                long long a = rng.IntBetween( 1, 100 ), b = rng.IntBetween( 1, 100 );
+                px = a * ax + b * bx;
+                py = a * ay + b * by;
+                bDone = true;
+            } else if (nKind == 1) {
+                // a chosen (a, b) press pair for the far away prize of part 2: solve the presses for
+                // a prize near (tx, ty), round them down and derive the prize from the rounded ones
+                long long tx = DAY13_PART2_OFFSET + rng.IntBetween( 1000, 20000 );
+                long long ty = DAY13_PART2_OFFSET + rng.IntBetween( 1000, 20000 );
+                // (the coordinates are below 2^45 and the movements below 100, so the products fit)
+                long long nDet = ax * by - ay * bx;
+                long long a = (tx * by - ty * bx) / nDet;
+                long long b = (ax * ty - ay * tx) / nDet;
+                px = a * ax + b * bx - DAY13_PART2_OFFSET;
+                py = a * ay + b * by - DAY13_PART2_OFFSET;
+                // check with Cramer's rule that the prize gives exactly these presses
+                long long nPX = px + DAY13_PART2_OFFSET, nPY = py + DAY13_PART2_OFFSET;
+                long long nNumA = nPX * by - nPY * bx, nNumB = ax * nPY - ay * nPX;
+                bool bExact = (nNumA % nDet == 0 && nNumB % nDet == 0 && nNumA / nDet == a && nNumB / nDet == b);
+                // the presses can't be negative, and the prize must be in the first quadrant
+                bDone = (bExact && a > 0 && b > 0 && px > 0 && py > 0);
+            } else {
+                px = rng.IntBetween( 1000, 20000 );
+                py = rng.IntBetween( 1000, 20000 );
+                bDone = true;
+            }
+        }
+        if (i > 0) out << '\n';
+        out << "Button A: X+" << ax << ", Y+" << ay << '\n';
+        out << "Button B: X+" << bx << ", Y+" << by << '\n';
+        out << "Prize: X=" << px << ", Y=" << py << '\n';
+    }
+}
+
+// robots in the 101 x 103 room of the puzzle. Like in the puzzle, at some second 75 % of the robots
+// form a picture (a filled block), so part 2 finds an answer
+static void GenDay14( GenOutput &out, flcRandom &rng, const flcGenParams &params ) {
+    const int ROOM_X = 101, ROOM_Y = 103;
+    long long nRobots  = Scaled( 500, params );
+    long long nPicture = std::min( nRobots * 3 / 4, (long long)ROOM_X * ROOM_Y );
+    int nSide = std::max( 1, (int)std::ceil( std::sqrt( (double)nPicture )));
+    int nLeft = (int)rng.Below( ROOM_X - std::min( nSide, ROOM_X ) + 1 );
+    int nTop  = (int)rng.Below( ROOM_Y - std::min( nSide, ROOM_Y ) + 1 );
+    long long nTime = rng.IntBetween( 1, ROOM_X * ROOM_Y - 1 );
+    for (long long i = 0; i < nRobots; i++) {
+        long long vx = rng.IntBetween( -100, 100 ), vy = rng.IntBetween( -100, 100 );
+        long long px, py;
+        if (i < nPicture) {
+            // in the block at nTime - wind back the position to time 0
+            long long nCol = i % nSide, nRow = i / nSide;
+            if (nSide > ROOM_X) { nCol = i % ROOM_X; nRow = i / ROOM_X; }
+            px = ((nLeft + nCol - vx * nTime) % ROOM_X + ROOM_X) % ROOM_X;
+            py = ((nTop  + nRow - vy * nTime) % ROOM_Y + ROOM_Y) % ROOM_Y;
+        } else {
+            px = rng.IntBetween( 0, ROOM_X - 1 );
+            py = rng.IntBetween( 0, ROOM_Y - 1 );
+        }
+        out << "p=" << px << ',' << py << " v=" << vx << ',' << vy << '\n';
+    }
+}
+
+// perfect maze (exactly one path between any two cells) of side nSide (odd): the cells at odd
+// coordinates are open, and a depth first search with random order knocks out the walls between them
+static void CarveMaze( flcGrid<char> &grid, flcRandom &rng ) {
+    static const int vDX[] = { 0, 2, 0, -2 };
+    static const int vDY[] = { -2, 0, 2, 0 };
+    grid.Fill( '#' );
+    std::vector<int> vStack = { grid.Index( 1, grid.Height() - 2 ) };
+    grid[vStack[0]] = '.';
+    while (!vStack.empty()) {
+        int x = grid.IndexX( vStack.back()), y = grid.IndexY( vStack.back());
+        int vOptions[4], nOptions = 0;
+        for (int d = 0; d < 4; d++) {
+            int nx = x + vDX[d], ny = y + vDY[d];
+            if (nx > 0 && nx < grid.Width() - 1 && ny > 0 && ny < grid.Height() - 1 && grid( nx, ny ) == '#') {
+                vOptions[nOptions++] = d;
+            }
+        }
+        if (nOptions == 0) {
+            vStack.pop_back();
+        } else {
+            int d = vOptions[rng.Below( nOptions )];
+            grid( x + vDX[d] / 2, y + vDY[d] / 2 ) = '.';
+            grid( x + vDX[d], y + vDY[d] ) = '.';
+            vStack.push_back( grid.Index( x + vDX[d], y + vDY[d] ));
+        }
+    }
+}
+
+// reindeer maze: a perfect maze with about 10 % of the inner walls between two cells knocked out, so
+// there are several (best) paths from S (bottom left) to E (top right)
+static void GenDay16( GenOutput &out, flcRandom &rng, const flcGenParams &params ) {
+    int nSide = ScaledSide( 141, params ) | 1;
+    flcGrid<char> grid( nSide, nSide );
+    CarveMaze( grid, rng );
+    for (int y = 1; y < nSide - 1; y++) {
+        for (int x = 1; x < nSide - 1; x++) {
+            bool bBetweenH = (x % 2 == 0 && y % 2 == 1), bBetweenV = (x % 2 == 1 && y % 2 == 0);
+            if (grid( x, y ) == '#' && (bBetweenH || bBetweenV) && rng.Chance( 0.1 )) {
+                grid( x, y ) = '.';
+            }
+        }
+    }
+    grid( 1, nSide - 2 ) = 'S';
+    grid( nSide - 2, 1 ) = 'E';
+    WriteGrid( out, grid );
+}
+
+// race track: a single path without branches, like in the puzzle. It snakes over the grid in horizontal
+// runs 4 rows apart, and each run has random detours into the row below it, so that the track length is
+// proportional to the grid size
+static void GenDay20( GenOutput &out, flcRandom &rng, const flcGenParams &params ) {
+    int nSide = std::max( ScaledSide( 141, params ), 15 );
+    flcGrid<char> grid( nSide, nSide, '#' );
+    int nLastRun = 1 + ((nSide - 4) / 4) * 4;    // the detours of the last run use row nLastRun + 1, inside the border
+    int nStart = grid.Index( 1, 1 ), nEnd = 0;
+    for (int y = 1; y <= nLastRun; y += 4) {
+        bool bLeftToRight = ((y / 4) % 2 == 0);
+        for (int x = 1; x < nSide - 1; x++) {
+            grid( x, y ) = '.';
+        }
+        // detours down one row: (x, y) -> (x, y + 1) -> (x + 2, y + 1) -> (x + 2, y), with (x + 1, y) a wall
+        for (int x = 3; x + 2 < nSide - 4; x++) {
+            if (rng.Chance( 0.3 )) {
+                grid( x, y + 1 ) = grid( x + 1, y + 1 ) = grid( x + 2, y + 1 ) = '.';
+                grid( x + 1, y ) = '#';
+                x += 3;
+            }
+        }
+        // connect to the next run at the end of this one
+        int xEnd = bLeftToRight ? nSide - 2 : 1;
+        if (y + 4 <= nLastRun) {
+            for (int dy = 1; dy < 4; dy++) {
+                grid( xEnd, y + dy ) = '.';
+            }
+        } else {
+            nEnd = grid.Index( xEnd, y );
+        }
+    }
+    grid[nStart] = 'S';
+    grid[nEnd]   = 'E';
+    WriteGrid( out, grid );
+}
+
+// towel patterns and designs. The designs are made of patterns, but about 30 % get a random letter
+// changed. There's no single letter pattern "g", so not every design is possible
+static void GenDay19( GenOutput &out, flcRandom &rng, const flcGenParams &params ) {
+    static const char *vColours = "wubrg";
+    std::vector<std::string> vPatterns;
+    std::vector<std::string> vSingles = { "w", "u", "b", "r" };
+    vPatterns = vSingles;
+    while (vPatterns.size() < 447) {
+        std::string sPattern;
+        int nLen = (int)rng.IntBetween( 2, 8 );
+        for (int i = 0; i < nLen; i++) sPattern.push_back( vColours[rng.Below( 5 )] );
+        if (std::find( vPatterns.begin(), vPatterns.end(), sPattern ) == vPatterns.end()) {
+            vPatterns.push_back( sPattern );
+        }
+    }
+    rng.Shuffle( vPatterns );
+    for (int i = 0; i < (int)vPatterns.size(); i++) {
+        out << (i > 0 ? ", " : "") << vPatterns[i];
+    }
+    out << "\n\n";
+    long long nDesigns = Scaled( 400, params );
+    for (long long d = 0; d < nDesigns; d++) {
+        std::string sDesign;
+        int nLen = (int)rng.IntBetween( 20, 60 );
+        while ((int)sDesign.length() < nLen) {
+            sDesign += vPatterns[rng.Below( vPatterns.size())];
+        }
+        if (rng.Chance( 0.3 )) {
+            sDesign[rng.Below( sDesign.length())] = vColours[rng.Below( 5 )];
+        }
+        out << sDesign << '\n';
+    }
+}
+
+typedef struct sGeneratorStruct {
+    int nDay;
+    const char *sDescription;
+    void (*fGenerate)( GenOutput &, flcRandom &, const flcGenParams & );
+} GeneratorType;
+
+static const GeneratorType glbGenerators[] = {
+    {  1, "location id pairs (--dup <f>: fraction of right values taken from the left list)", GenDay01 },
+    {  2, "reports of levels"                 , GenDay02 },
+    {  3, "corrupted memory"                  , GenDay03 },
+    {  4, "XMAS letter grid"                  , GenDay04 },
+    {  5, "page ordering rules and updates"   , GenDay05 },
+    {  6, "lab map with guard"                , GenDay06 },
+    {  7, "calibration equations"             , GenDay07 },
+    {  8, "antenna map"                       , GenDay08 },
+    {  9, "disk map"                          , GenDay09 },
+    { 10, "topographic map"                   , GenDay10 },
+    { 11, "stones"                            , GenDay11 },
+    { 12, "garden plots"                      , GenDay12 },
+    { 13, "claw machines"                     , GenDay13 },
+    { 14, "robots"                            , GenDay14 },
+    { 16, "reindeer maze"                     , GenDay16 },
+    { 19, "towel patterns and designs"        , GenDay19 },
+    { 20, "race track"                        , GenDay20 },
+};
+
+// ==========   INTERFACE
+
+std::vector<std::pair<int, std::string>> InputGeneratorList() {
+    std::vector<std::pair<int, std::string>> vResult;
+    for (auto &gen : glbGenerators) {
+        vResult.push_back( { gen.nDay, gen.sDescription } );
+    }
+    return vResult;
+}
+
+bool HasInputGenerator( int nDay ) {
+    for (auto &gen : glbGenerators) {
+        if (gen.nDay == nDay) return true;
+    }
+    return false;
+}
+
+long long GenerateInput( int nDay, const std::string &sFileName, uint64_t nSeed, const flcGenParams &params ) {
+    const GeneratorType *pGen = nullptr;
+    for (auto &gen : glbGenerators) {
+        if (gen.nDay == nDay) pGen = &gen;
+    }
+    if (pGen == nullptr) {
+        std::cout << "ERROR: GenerateInput() --> no generator for day: " << nDay << std::endl;
+        return -1;
+    }
+    if (params.dScale <= 0.0) {
+        std::cout << "ERROR: GenerateInput() --> scale must be positive: " << params.dScale << std::endl;
+        return -1;
+    }
+    GenOutput out( sFileName );
+    if (!out.IsOpen()) {
+        return -1;
+    }
+    // a stream per day, so that the days don't get the same random numbers for the same seed
+    flcRandom rng( nSeed, nDay );
+    pGen->fGenerate( out, rng, params );
+    if (!out.Close()) {
+        std::cout << "ERROR: GenerateInput() --> writing failed: " << sFileName << std::endl;
+        return -1;
+    }
+    return out.BytesWritten();
+}
@@ -0,0 +1,35 @@
+// AoC 2024 - synthetic input generators
+// =====================================
+
+// date:  2025-02-03
+// by:    Joseph21 (Joseph21-6147)
+
+// Generates input files in the format of the puzzle input of a day, but of any size, to see how the
+// solutions scale. Scale 1 gives about the size of the puzzle input, scale 100 about 100 times as
+// much data (for grids: 100 times as many cells). The content is random, but structurally valid: e.g.
+// the page ordering rules of day 05 are consistent, the guard of day 06 leaves the map and the race
+// track of day 20 is a single path. The same seed and scale always give the same file.
+//
+// Used by the aoc24_gen program, and by the --scaling mode of the aoc24 driver.
+
+#ifndef FLCINPUTGEN_H
+#define FLCINPUTGEN_H
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+typedef struct sGenParamsStruct {
+    double dScale = 1.0;
+    double dDup   = 0.2;    // day 01: fraction of the right list values that is taken from the left list
+} flcGenParams;
+
+// the days that have a generator, with a short description of the generated input
+std::vector<std::pair<int, std::string>> InputGeneratorList();
+bool HasInputGenerator( int nDay );
+
+// writes a generated input for day nDay to sFileName. Returns the nr of bytes written, or -1 on error
+long long GenerateInput( int nDay, const std::string &sFileName, uint64_t nSeed, const flcGenParams &params );
+
+#endif // FLCINPUTGEN_H
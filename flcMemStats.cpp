@@ -0,0 +1,197 @@
+// AoC 2024 - heap allocation and peak memory accounting
+// =====================================================
+
+// date:  2025-01-15
+// by:    Joseph21 (Joseph21-6147)
+
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <new>
+#include <sstream>
+
+#include "flcMemStats.h"
+
+// ==========   COUNTERS
+
+// NOTE: these are zero initialized before any dynamic initialization takes place, so they are valid
+// for allocations done by constructors of other static objects as well
+static std::atomic<long long> glbAllocs    { 0 };
+static std::atomic<long long> glbFrees     { 0 };
+static std::atomic<long long> glbBytesAlloc{ 0 };
+static std::atomic<long long> glbBytesFreed{ 0 };
+static std::atomic<long long> glbBytesLive { 0 };
+static std::atomic<long long> glbPeakLive  { 0 };
+
+static std::atomic<bool> glbEnabled{ false };
+
+// the requested size is stored in a header in front of each block, so that delete knows how many
+// bytes are released. The header size keeps the default new alignment intact. The top bit of the size
+// tells whether the block was counted, so that blocks from before Enable() aren't subtracted
+static const size_t HEADER_SIZE = alignof( std::max_align_t );
+static const size_t COUNTED_BIT = (size_t)1 << (sizeof( size_t ) * 8 - 1);
+
+// for over-aligned types (operator new with std::align_val_t) the header takes a whole alignment unit,
+// so that the user pointer stays aligned. The aligned delete gets the same alignment, so it finds the
+// start of the block again
+static size_t HeaderSize( size_t nAlign ) {
+    return (nAlign > HEADER_SIZE) ? nAlign : HEADER_SIZE;
+}
+
+static void *CountedAlloc( size_t nSize, size_t nAlign = HEADER_SIZE ) {
+    size_t nHeader = HeaderSize( nAlign );
+    void *pBlock;
+    if (nAlign <= HEADER_SIZE) {
+        pBlock = malloc( nSize + nHeader );
+    } else {
+        // aligned_alloc() wants a multiple of the alignment
+        pBlock = aligned_alloc( nAlign, (nSize + nHeader + nAlign - 1) / nAlign * nAlign );
+    }
+    if (pBlock == nullptr) {
+        return nullptr;
+    }
+    if (!glbEnabled.load( std::memory_order_relaxed )) {
+        *(size_t *)pBlock = nSize;
+        return (char *)pBlock + nHeader;
+    }
+    *(size_t *)pBlock = nSize | COUNTED_BIT;
+
+    glbAllocs.fetch_add( 1, std::memory_order_relaxed );
+    glbBytesAlloc.fetch_add( (long long)nSize, std::memory_order_relaxed );
+    long long nLive = glbBytesLive.fetch_add( (long long)nSize, std::memory_order_relaxed ) + (long long)nSize;
+    long long nPeak = glbPeakLive.load( std::memory_order_relaxed );
+    while (nLive > nPeak && !glbPeakLive.compare_exchange_weak( nPeak, nLive, std::memory_order_relaxed )) {
+        // nPeak is updated by a failing compare_exchange_weak()
+    }
+    return (char *)pBlock + nHeader;
+}
+
+static void CountedFree( void *pUser, size_t nAlign = HEADER_SIZE ) {
+    if (pUser == nullptr) {
+        return;
+    }
+    void *pBlock = (char *)pUser - HeaderSize( nAlign );
+    size_t nSize = *(size_t *)pBlock;
+    if ((nSize & COUNTED_BIT) == 0) {
+        free( pBlock );
+        return;
+    }
+    nSize &= ~COUNTED_BIT;
+
+    glbFrees.fetch_add( 1, std::memory_order_relaxed );
+    glbBytesFreed.fetch_add( (long long)nSize, std::memory_order_relaxed );
+    glbBytesLive.fetch_sub( (long long)nSize, std::memory_order_relaxed );
+    free( pBlock );
+}
+
+// the throwing versions call the new handler until the allocation succeeds, or throw if there is none
+static void *CountedNew( size_t nSize, size_t nAlign = HEADER_SIZE ) {
+    if (nSize == 0) {
+        nSize = 1;
+    }
+    void *pResult = CountedAlloc( nSize, nAlign );
+    while (pResult == nullptr) {
+        std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr) {
+            throw std::bad_alloc();
+        }
+        handler();
+        pResult = CountedAlloc( nSize, nAlign );
+    }
+    return pResult;
+}
+
+// ==========   GLOBAL OPERATOR NEW / DELETE REPLACEMENTS
+
+void *operator new  ( size_t nSize ) { return CountedNew( nSize ); }
+void *operator new[]( size_t nSize ) { return CountedNew( nSize ); }
+void *operator new  ( size_t nSize, const std::nothrow_t & ) noexcept { return CountedAlloc( nSize == 0 ? 1 : nSize ); }
+void *operator new[]( size_t nSize, const std::nothrow_t & ) noexcept { return CountedAlloc( nSize == 0 ? 1 : nSize ); }
+
+void operator delete  ( void *p ) noexcept { CountedFree( p ); }
+void operator delete[]( void *p ) noexcept { CountedFree( p ); }
+void operator delete  ( void *p, size_t ) noexcept { CountedFree( p ); }
+void operator delete[]( void *p, size_t ) noexcept { CountedFree( p ); }
+void operator delete  ( void *p, const std::nothrow_t & ) noexcept { CountedFree( p ); }
+void operator delete[]( void *p, const std::nothrow_t & ) noexcept { CountedFree( p ); }
+
+// the versions for over-aligned types
+void *operator new  ( size_t nSize, std::align_val_t nAlign ) { return CountedNew( nSize, (size_t)nAlign ); }
+void *operator new[]( size_t nSize, std::align_val_t nAlign ) { return CountedNew( nSize, (size_t)nAlign ); }
+void *operator new  ( size_t nSize, std::align_val_t nAlign, const std::nothrow_t & ) noexcept { return CountedAlloc( nSize == 0 ? 1 : nSize, (size_t)nAlign ); }
+void *operator new[]( size_t nSize, std::align_val_t nAlign, const std::nothrow_t & ) noexcept { return CountedAlloc( nSize == 0 ? 1 : nSize, (size_t)nAlign ); }
+
+void operator delete  ( void *p, std::align_val_t nAlign ) noexcept { CountedFree( p, (size_t)nAlign ); }
+void operator delete[]( void *p, std::align_val_t nAlign ) noexcept { CountedFree( p, (size_t)nAlign ); }
+void operator delete  ( void *p, size_t, std::align_val_t nAlign ) noexcept { CountedFree( p, (size_t)nAlign ); }
+void operator delete[]( void *p, size_t, std::align_val_t nAlign ) noexcept { CountedFree( p, (size_t)nAlign ); }
+void operator delete  ( void *p, std::align_val_t nAlign, const std::nothrow_t & ) noexcept { CountedFree( p, (size_t)nAlign ); }
+void operator delete[]( void *p, std::align_val_t nAlign, const std::nothrow_t & ) noexcept { CountedFree( p, (size_t)nAlign ); }
+
+// ==============================/ Class flcMemStats /==============================
+
+void flcMemStats::Enable() {
+    glbEnabled.store( true, std::memory_order_relaxed );
+}
+
+MemStatsType flcMemStats::Snapshot() {
+    MemStatsType result;
+    result.nAllocs     = glbAllocs    .load( std::memory_order_relaxed );
+    result.nFrees      = glbFrees     .load( std::memory_order_relaxed );
+    result.nBytesAlloc = glbBytesAlloc.load( std::memory_order_relaxed );
+    result.nBytesFreed = glbBytesFreed.load( std::memory_order_relaxed );
+    result.nBytesLive  = glbBytesLive .load( std::memory_order_relaxed );
+    result.nPeakLive   = glbPeakLive  .load( std::memory_order_relaxed );
+    return result;
+}
+
+void flcMemStats::ResetPeak() {
+    glbPeakLive.store( glbBytesLive.load( std::memory_order_relaxed ), std::memory_order_relaxed );
+}
+
+// returns the value (in kB) of the line starting with sKey in /proc/self/status, or -1
+static long long ReadProcStatus( const std::string &sKey ) {
+    std::ifstream statusFile( "/proc/self/status" );
+    std::string sLine;
+    while (std::getline( statusFile, sLine )) {
+        if (sLine.compare( 0, sKey.length(), sKey ) == 0) {
+            return atoll( sLine.c_str() + sKey.length());
+        }
+    }
+    return -1;
+}
+
+long long flcMemStats::PeakRSS()    { return ReadProcStatus( "VmHWM:" ); }
+long long flcMemStats::CurrentRSS() { return ReadProcStatus( "VmRSS:" ); }
+
+// writing 5 to /proc/self/clear_refs resets VmHWM (Linux 4.0 and up)
+bool flcMemStats::ResetPeakRSS() {
+    FILE *pFile = fopen( "/proc/self/clear_refs", "w" );
+    if (pFile == nullptr) {
+        return false;
+    }
+    bool bResult = (fputs( "5", pFile ) >= 0);
+    bResult = (fclose( pFile ) == 0) && bResult;
+    return bResult;
+}
+
+std::string flcMemStats::FormatBytes( long long nBytes ) {
+    const char *sUnits[] = { "B", "kB", "MB", "GB" };
+    double dValue = (double)nBytes;
+    int nUnit = 0;
+    while (nUnit < 3 && (dValue >= 1024.0 || dValue <= -1024.0)) {
+        dValue /= 1024.0;
+        nUnit += 1;
+    }
+    std::stringstream ss;
+    if (nUnit == 0) {
+        ss << nBytes << " " << sUnits[0];
+    } else {
+        ss.precision( 1 );
+        ss << std::fixed << dValue << " " << sUnits[nUnit];
+    }
+    return ss.str();
+}
@@ -0,0 +1,60 @@
+// AoC 2024 - heap allocation and peak memory accounting
+// =====================================================
+
+// date:  2025-01-15
+// by:    Joseph21 (Joseph21-6147)
+
+// Linking in flcMemStats.cpp replaces the global operator new / delete (all plain, array and nothrow
+// variants, also those for over-aligned types) by versions that count the nr of allocations and frees,
+// the bytes allocated and freed, the live bytes and the peak of the live bytes. The counters are process
+// wide and thread safe.
+//
+// Counting only starts with Enable() (flcBenchmark calls it for --memory). Before that, each new and
+// delete costs one relaxed load of the enabled flag, next to the malloc() / free() it calls anyway, and
+// each block carries a header of alignof( std::max_align_t ) bytes with its size - or of the alignment
+// itself for over-aligned blocks. Once enabled, each new does three atomic additions and a compare and
+// swap loop for the peak, and each delete three atomic additions - on shared cache lines, so they get
+// more expensive as more threads allocate at the same time. Blocks that were allocated before Enable()
+// aren't counted when they are freed.
+//
+// Next to the heap counters the peak resident set size (VmHWM) and current resident set size (VmRSS)
+// are read from /proc/self/status. On Linux the peak RSS can be reset, so that it can be measured per
+// phase. Where /proc/self/status is not available, the RSS values read as -1.
+//
+// flcBenchmark uses this to report per phase memory statistics (--memory on the command line).
+
+#ifndef FLCMEMSTATS_H
+#define FLCMEMSTATS_H
+
+#include <string>
+
+// a snapshot (or the difference of two snapshots) of the heap counters
+typedef struct sMemStatsStruct {
+    long long nAllocs     = 0;    // nr of calls to operator new
+    long long nFrees      = 0;    // nr of calls to operator delete (with a non null pointer)
+    long long nBytesAlloc = 0;    // total bytes requested
+    long long nBytesFreed = 0;    // total bytes released
+    long long nBytesLive  = 0;    // bytes allocated but not yet released
+    long long nPeakLive   = 0;    // highest value of nBytesLive since the last ResetPeak()
+} MemStatsType;
+
+class flcMemStats {
+public:
+    // starts counting the allocations and frees - there is no way back
+    static void Enable();
+    // returns the current values of the heap counters
+    static MemStatsType Snapshot();
+    // sets the peak of live bytes to the current nr of live bytes
+    static void ResetPeak();
+
+    // peak and current resident set size in kB, or -1 if they can't be read
+    static long long PeakRSS();
+    static long long CurrentRSS();
+    // resets the peak RSS to the current RSS. Returns false if that's not supported
+    static bool ResetPeakRSS();
+
+    // formats a byte count with a B / kB / MB / GB unit
+    static std::string FormatBytes( long long nBytes );
+};
+
+#endif // FLCMEMSTATS_H
@@ -0,0 +1,319 @@
+// AoC 2024 - shortest path algorithms
+// ===================================
+
+// date:  2025-01-28
+// by:    Joseph21 (Joseph21-6147)
+
+// Shortest path searches over implicit state spaces. A state is an int in the range [0, nStates) - for
+// a grid that's typically y * width + x, optionally combined with a direction. There's no graph data
+// structure: the edges are produced on the fly by a neighbour callback, that is called as
+//
+//     fNeighbours( nState, visit )
+//
+// and calls visit( nNextState, nWeight ) once for each edge leaving nState. For instance for a grid
+// with 4 way unit steps:
+//
+//     auto fNeighbours = [&]( int nCur, auto &&visit ) {
+//         int x = nCur % nWidth, y = nCur / nWidth;
+//         for (int dir = 0; dir < 4; dir++) {
+//             int nx = x + glbDirX4[dir], ny = y + glbDirY4[dir];
+//             if (InBounds( nx, ny ) && vMap[ny][nx] != '#') { visit( ny * nWidth + nx, 1 ); }
+//         }
+//     };
+//     flcPathResult result = PathBFS( nWidth * nHeight, { nStart }, fNeighbours );
+//
+// The available algorithms, all returning an flcPathResult:
+//
+//   * PathBFS()      - breadth first search, all weights are taken as 1
+//   * Path01BFS()    - weights 0 or 1, double ended queue
+//   * PathDial()     - small non negative integer weights up to a given maximum, ring of buckets
+//   * PathDijkstra() - any non negative weights, binary heap
+//   * PathAStar()    - like PathDijkstra(), directed by a heuristic. The heuristic must be consistent
+//                      (never over estimate, and obey the triangle inequality), e.g. a manhattan distance
+//
+// All searches take a set of source states (distance 0), and stop early when options.nTarget is settled.
+// With options.bAllPreds set, the result keeps all predecessors of each state that lie on a shortest
+// path, instead of only one. Those are needed to enumerate all shortest paths (see OnShortestPaths()).
+// NOTE: with an early stop on a target, the predecessor sets are only complete for the target itself
+// if there are no 0 weight edges.
+
+#ifndef FLCPATHFIND_H
+#define FLCPATHFIND_H
+
+#include <algorithm>
+#include <climits>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "flcArena.h"
+
+// distance of states that were not reached - leaves room for adding a weight without overflow
+constexpr int PATH_INFINITY = INT_MAX / 2;
+
+typedef struct sPathOptionsStruct {
+    int  nTarget   = -1;       // stop when this state is settled, -1 to search the whole reachable space
+    bool bAllPreds = false;    // keep all shortest path predecessors, not only one
+} flcPathOptions;
+
+// ==============================/ Class flcPathResult /==============================
+
+class flcPathResult {
+public:
+    std::vector<int> vDist;                   // distance per state, PATH_INFINITY if not reached
+    std::vector<int> vPred;                   // a predecessor on a shortest path per state, -1 for sources and unreached states
+    flcArenaLists<int> vAllPreds;             // all predecessors on shortest paths - only filled with options.bAllPreds
+    std::shared_ptr<flcArena> pPredArena;     // holds the entries of vAllPreds, shared by copies of the result
+
+    void Init( int nStates, bool bAllPreds ) {
+        vDist.assign( nStates, PATH_INFINITY );
+        vPred.assign( nStates, -1 );
+        vAllPreds = flcArenaLists<int>();
+        pPredArena.reset();
+        if (bAllPreds) {
+            pPredArena = std::make_shared<flcArena>();
+            vAllPreds.Init( *pPredArena, nStates );
+        }
+    }
+
+    int  Dist(    int nState ) const { return vDist[nState]; }
+    bool Reached( int nState ) const { return vDist[nState] < PATH_INFINITY; }
+
+    // the states of a shortest path from a source to nTarget, including both. Empty if nTarget was not reached
+    std::vector<int> PathTo( int nTarget ) const {
+        std::vector<int> vPath;
+        if (Reached( nTarget )) {
+            for (int nCur = nTarget; nCur != -1; nCur = vPred[nCur]) {
+                vPath.push_back( nCur );
+            }
+            std::reverse( vPath.begin(), vPath.end());
+        }
+        return vPath;
+    }
+
+    // flags (1 / 0) per state whether it lies on any shortest path from a source to one of the targets.
+    // Needs a search with options.bAllPreds. Pass only the targets that have the shortest distance if
+    // the paths to the nearest one of them are wanted
+    std::vector<char> OnShortestPaths( const std::vector<int> &vTargets ) const {
+        std::vector<char> vOnPath( vDist.size(), 0 );
+        if (vAllPreds.empty()) {
+            std::cout << "ERROR: flcPathResult::OnShortestPaths() --> search was run without options.bAllPreds" << std::endl;
+            return vOnPath;
+        }
+        std::vector<int> vStack;
+        for (int nTarget : vTargets) {
+            if (Reached( nTarget ) && !vOnPath[nTarget]) {
+                vOnPath[nTarget] = 1;
+                vStack.push_back( nTarget );
+            }
+        }
+        while (!vStack.empty()) {
+            int nCur = vStack.back();
+            vStack.pop_back();
+            for (int nPred : vAllPreds[nCur]) {
+                if (!vOnPath[nPred]) {
+                    vOnPath[nPred] = 1;
+                    vStack.push_back( nPred );
+                }
+            }
+        }
+        return vOnPath;
+    }
+
+    // used by the searches: edge nFrom -> nTo gives nTo distance nNewDist. Returns true if that's an
+    // improvement, an equally short alternative is only added to the predecessor sets
+    bool Relax( int nFrom, int nTo, int nNewDist ) {
+        if (nNewDist < vDist[nTo]) {
+            vDist[nTo] = nNewDist;
+            vPred[nTo] = nFrom;
+            if (!vAllPreds.empty()) {
+                vAllPreds.Clear( nTo );
+                vAllPreds.Add( nTo, nFrom );
+            }
+            return true;
+        }
+        if (nNewDist == vDist[nTo] && !vAllPreds.empty()) {
+            vAllPreds.Add( nTo, nFrom );
+        }
+        return false;
+    }
+
+    // sets up the sources with distance 0
+    void InitSources( const std::vector<int> &vSources ) {
+        for (int nSource : vSources) {
+            vDist[nSource] = 0;
+        }
+    }
+};
+
+// ==========   BREADTH FIRST SEARCH
+
+template <typename NeighbourFunc>
+flcPathResult PathBFS( int nStates, const std::vector<int> &vSources, NeighbourFunc fNeighbours, const flcPathOptions &options = flcPathOptions()) {
+    flcPathResult result;
+    result.Init( nStates, options.bAllPreds );
+    result.InitSources( vSources );
+    // each state enters the queue once, so a vector with a read index does the job
+    std::vector<int> vQueue;
+    vQueue.reserve( nStates );
+    for (int nSource : vSources) {
+        vQueue.push_back( nSource );
+    }
+    for (size_t nHead = 0; nHead < vQueue.size(); nHead++) {
+        int nCur = vQueue[nHead];
+        if (nCur == options.nTarget) {
+            break;
+        }
+        int nNewDist = result.vDist[nCur] + 1;
+        fNeighbours( nCur, [&]( int nNext, int /* nWeight */ ) {
+            if (result.Relax( nCur, nNext, nNewDist )) {
+                vQueue.push_back( nNext );
+            }
+        });
+    }
+    return result;
+}
+
+// ==========   0-1 BREADTH FIRST SEARCH
+
+template <typename NeighbourFunc>
+flcPathResult Path01BFS( int nStates, const std::vector<int> &vSources, NeighbourFunc fNeighbours, const flcPathOptions &options = flcPathOptions()) {
+    flcPathResult result;
+    result.Init( nStates, options.bAllPreds );
+    result.InitSources( vSources );
+    std::vector<char> vSettled( nStates, 0 );
+    // 0 weight edges go to the front of the queue, 1 weight edges to the back
+    std::deque<int> dQueue( vSources.begin(), vSources.end());
+    while (!dQueue.empty()) {
+        int nCur = dQueue.front();
+        dQueue.pop_front();
+        if (vSettled[nCur]) {
+            continue;
+        }
+        vSettled[nCur] = 1;
+        if (nCur == options.nTarget) {
+            break;
+        }
+        fNeighbours( nCur, [&]( int nNext, int nWeight ) {
+            if (nWeight != 0 && nWeight != 1) {
+                std::cout << "ERROR: Path01BFS() --> weight must be 0 or 1: " << nWeight << std::endl;
+                return;
+            }
+            if (result.Relax( nCur, nNext, result.vDist[nCur] + nWeight )) {
+                if (nWeight == 0) {
+                    dQueue.push_front( nNext );
+                } else {
+                    dQueue.push_back( nNext );
+                }
+            }
+        });
+    }
+    return result;
+}
+
+// ==========   DIAL'S ALGORITHM
+
+// Dijkstra with a ring of nMaxWeight + 1 buckets instead of a heap: bucket d % (nMaxWeight + 1) holds the
+// states with tentative distance d. Since no edge is longer than nMaxWeight, the ring never wraps onto
+// distances that are still pending
+template <typename NeighbourFunc>
+flcPathResult PathDial( int nStates, const std::vector<int> &vSources, NeighbourFunc fNeighbours, int nMaxWeight, const flcPathOptions &options = flcPathOptions()) {
+    flcPathResult result;
+    result.Init( nStates, options.bAllPreds );
+    result.InitSources( vSources );
+    std::vector<char> vSettled( nStates, 0 );
+    int nBuckets = nMaxWeight + 1;
+    std::vector<std::vector<int>> vBuckets( nBuckets );
+    vBuckets[0].assign( vSources.begin(), vSources.end());
+    int nPending = (int)vSources.size();
+
+    bool bTargetSettled = false;
+    for (int nDist = 0; nPending > 0 && !bTargetSettled; nDist++) {
+        std::vector<int> &vBucket = vBuckets[nDist % nBuckets];
+        // 0 weight edges add to the bucket that is processed, so index it and don't hold references
+        for (size_t i = 0; i < vBucket.size() && !bTargetSettled; i++) {
+            int nCur = vBucket[i];
+            nPending -= 1;
+            // skip entries that were superseded by a shorter distance
+            if (vSettled[nCur] || result.vDist[nCur] != nDist) {
+                continue;
+            }
+            vSettled[nCur] = 1;
+            if (nCur == options.nTarget) {
+                bTargetSettled = true;
+                break;
+            }
+            fNeighbours( nCur, [&]( int nNext, int nWeight ) {
+                if (nWeight < 0 || nWeight > nMaxWeight) {
+                    std::cout << "ERROR: PathDial() --> weight out of range [0, " << nMaxWeight << "]: " << nWeight << std::endl;
+                    return;
+                }
+                if (result.Relax( nCur, nNext, nDist + nWeight )) {
+                    vBuckets[(nDist + nWeight) % nBuckets].push_back( nNext );
+                    nPending += 1;
+                }
+            });
+        }
+        vBuckets[nDist % nBuckets].clear();
+    }
+    return result;
+}
+
+// ==========   DIJKSTRA AND A*
+
+// the heap search shared by Dijkstra and A*: the heap is ordered on distance + heuristic
+template <typename NeighbourFunc, typename HeuristicFunc>
+flcPathResult PathHeapSearch( int nStates, const std::vector<int> &vSources, NeighbourFunc fNeighbours, HeuristicFunc fHeuristic, const flcPathOptions &options ) {
+    flcPathResult result;
+    result.Init( nStates, options.bAllPreds );
+    result.InitSources( vSources );
+    std::vector<char> vSettled( nStates, 0 );
+
+    typedef std::pair<int, int> HeapEntry;    // (distance + heuristic, state)
+    std::priority_queue<HeapEntry, std::vector<HeapEntry>, std::greater<HeapEntry>> heap;
+    for (int nSource : vSources) {
+        heap.push( { fHeuristic( nSource ), nSource } );
+    }
+    while (!heap.empty()) {
+        int nCur = heap.top().second;
+        heap.pop();
+        // a state can be in the heap more than once - only the first time it comes out counts
+        if (vSettled[nCur]) {
+            continue;
+        }
+        vSettled[nCur] = 1;
+        if (nCur == options.nTarget) {
+            break;
+        }
+        int nCurDist = result.vDist[nCur];
+        fNeighbours( nCur, [&]( int nNext, int nWeight ) {
+            if (nWeight < 0) {
+                std::cout << "ERROR: PathHeapSearch() --> negative weight: " << nWeight << std::endl;
+                return;
+            }
+            if (!vSettled[nNext] || options.bAllPreds) {
+                int nNewDist = nCurDist + nWeight;
+                if (result.Relax( nCur, nNext, nNewDist )) {
+                    heap.push( { nNewDist + fHeuristic( nNext ), nNext } );
+                }
+            }
+        });
+    }
+    return result;
+}
+
+template <typename NeighbourFunc>
+flcPathResult PathDijkstra( int nStates, const std::vector<int> &vSources, NeighbourFunc fNeighbours, const flcPathOptions &options = flcPathOptions()) {
+    return PathHeapSearch( nStates, vSources, fNeighbours, []( int ) { return 0; }, options );
+}
+
+template <typename NeighbourFunc, typename HeuristicFunc>
+flcPathResult PathAStar( int nStates, const std::vector<int> &vSources, NeighbourFunc fNeighbours, HeuristicFunc fHeuristic, const flcPathOptions &options = flcPathOptions()) {
+    return PathHeapSearch( nStates, vSources, fNeighbours, fHeuristic, options );
+}
+
+#endif // FLCPATHFIND_H
@@ -0,0 +1,133 @@
+// AoC 2024 - hardware performance counters
+// ========================================
+
+// date:  2025-01-14
+// by:    Joseph21 (Joseph21-6147)
+
+#include "flcPerfCounters.h"
+
+#ifdef __linux__
+#include <cstring>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+// ==============================/ Class flcPerfCounters /==============================
+
+#ifdef __linux__
+
+// glibc doesn't provide a wrapper for this system call
+static int PerfEventOpen( struct perf_event_attr *pAttr, int nGroupFd ) {
+    return (int)syscall( __NR_perf_event_open, pAttr, 0 /* this thread */, -1 /* any cpu */, nGroupFd, 0 );
+}
+
+// opens one counter - the cycles counter is the group leader, the others are members of its group
+// so that all counters can be read with one read() call
+static int OpenCounter( int nCounter, int nGroupFd ) {
+    struct perf_event_attr attr;
+    memset( &attr, 0, sizeof( attr ));
+    attr.size           = sizeof( attr );
+    attr.disabled       = (nGroupFd == -1) ? 1 : 0;   // only the leader is enabled explicitly
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+    attr.read_format    = PERF_FORMAT_GROUP;
+
+    switch (nCounter) {
+        case PERF_CYCLES:
+            attr.type   = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_CPU_CYCLES;
+            break;
+        case PERF_INSTRUCTIONS:
+            attr.type   = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+            break;
+        case PERF_L1D_MISSES:
+            attr.type   = PERF_TYPE_HW_CACHE;
+            attr.config = PERF_COUNT_HW_CACHE_L1D |
+                         (PERF_COUNT_HW_CACHE_OP_READ       <<  8) |
+                         (PERF_COUNT_HW_CACHE_RESULT_MISS   << 16);
+            break;
+        case PERF_LLC_MISSES:
+            attr.type   = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_CACHE_MISSES;
+            break;
+        case PERF_BRANCH_MISS:
+            attr.type   = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+            break;
+    }
+    return PerfEventOpen( &attr, nGroupFd );
+}
+
+flcPerfCounters::flcPerfCounters() {
+    for (int i = 0; i < PERF_NR_COUNTERS; i++) {
+        m_nFd[i] = -1;
+    }
+    m_nFd[PERF_CYCLES] = OpenCounter( PERF_CYCLES, -1 );
+    m_bAvailable = (m_nFd[PERF_CYCLES] != -1);
+    if (m_bAvailable) {
+        for (int i = PERF_CYCLES + 1; i < PERF_NR_COUNTERS; i++) {
+            m_nFd[i] = OpenCounter( i, m_nFd[PERF_CYCLES] );
+        }
+        ioctl( m_nFd[PERF_CYCLES], PERF_EVENT_IOC_RESET , PERF_IOC_FLAG_GROUP );
+        ioctl( m_nFd[PERF_CYCLES], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP );
+    }
+}
+
+flcPerfCounters::~flcPerfCounters() {
+    for (int i = PERF_NR_COUNTERS - 1; i >= 0; i--) {
+        if (m_nFd[i] != -1) {
+            close( m_nFd[i] );
+        }
+    }
+}
+
+PerfSampleType flcPerfCounters::Read() {
+    PerfSampleType result;
+    if (m_bAvailable) {
+        // with PERF_FORMAT_GROUP the layout is: nr of values, followed by the values in the order
+        // the counters were added to the group
+        long long buffer[PERF_NR_COUNTERS + 1];
+        if (read( m_nFd[PERF_CYCLES], buffer, sizeof( buffer )) > 0) {
+            int nIndex = 1;
+            for (int i = 0; i < PERF_NR_COUNTERS && nIndex <= buffer[0]; i++) {
+                if (m_nFd[i] != -1) {
+                    result.nValue[i] = buffer[nIndex++];
+                }
+            }
+        }
+    }
+    return result;
+}
+
+#else   // no perf_event_open() - counters are never available
+
+flcPerfCounters::flcPerfCounters() {
+    for (int i = 0; i < PERF_NR_COUNTERS; i++) {
+        m_nFd[i] = -1;
+    }
+}
+
+flcPerfCounters::~flcPerfCounters() {}
+
+PerfSampleType flcPerfCounters::Read() { return PerfSampleType(); }
+
+#endif // __linux__
+
+flcPerfCounters &flcPerfCounters::ThreadInstance() {
+    static thread_local flcPerfCounters instance;
+    return instance;
+}
+
+std::string flcPerfCounters::CounterName( int nCounter ) {
+    switch (nCounter) {
+        case PERF_CYCLES      : return "cycles";
+        case PERF_INSTRUCTIONS: return "instr";
+        case PERF_L1D_MISSES  : return "L1D miss";
+        case PERF_LLC_MISSES  : return "LLC miss";
+        case PERF_BRANCH_MISS : return "br miss";
+    }
+    return "unknown";
+}
@@ -0,0 +1,71 @@
+// AoC 2024 - hardware performance counters
+// ========================================
+
+// date:  2025-01-14
+// by:    Joseph21 (Joseph21-6147)
+
+// Optional instrumentation backend for flcProfiler: reads the Linux perf_event_open() counters for
+// cycles, instructions, L1 data cache misses, last level cache misses and branch misses.
+// The counters count user space events of the calling thread only.
+//
+// If the counters can't be opened (not on Linux, no PMU in a virtual machine, or restricted by
+// /proc/sys/kernel/perf_event_paranoid) IsAvailable() returns false, and the profiler falls back
+// to wall clock timing only.
+
+#ifndef FLCPERFCOUNTERS_H
+#define FLCPERFCOUNTERS_H
+
+#include <string>
+
+// counter indices
+#define PERF_CYCLES       0
+#define PERF_INSTRUCTIONS 1
+#define PERF_L1D_MISSES   2
+#define PERF_LLC_MISSES   3
+#define PERF_BRANCH_MISS  4
+#define PERF_NR_COUNTERS  5
+
+// a snapshot (or a difference of two snapshots) of all counters
+typedef struct sPerfSampleStruct {
+    long long nValue[PERF_NR_COUNTERS] = { 0 };
+
+    sPerfSampleStruct operator - (const sPerfSampleStruct &rhs ) const {
+        sPerfSampleStruct result;
+        for (int i = 0; i < PERF_NR_COUNTERS; i++) {
+            result.nValue[i] = this->nValue[i] - rhs.nValue[i];
+        }
+        return result;
+    }
+    sPerfSampleStruct &operator += (const sPerfSampleStruct &rhs ) {
+        for (int i = 0; i < PERF_NR_COUNTERS; i++) {
+            this->nValue[i] += rhs.nValue[i];
+        }
+        return *this;
+    }
+} PerfSampleType;
+
+class flcPerfCounters {
+public:
+    // the counters are per thread, so each thread has its own instance
+    static flcPerfCounters &ThreadInstance();
+    ~flcPerfCounters();
+
+    // true if at least the cycles counter could be opened
+    bool IsAvailable() { return m_bAvailable; }
+    // true if counter nCounter could be opened (some PMU's don't support all events)
+    bool IsCounting( int nCounter ) { return m_nFd[nCounter] != -1; }
+
+    // reads the current value of all counters. Counters that are not available read as 0
+    PerfSampleType Read();
+
+    // short mnemonic for counter nCounter, for use in reports
+    static std::string CounterName( int nCounter );
+
+private:
+    flcPerfCounters();
+
+    bool m_bAvailable = false;
+    int  m_nFd[PERF_NR_COUNTERS];
+};
+
+#endif // FLCPERFCOUNTERS_H
@@ -0,0 +1,251 @@
+// AoC 2024 - streaming parse / solve pipeline
+// ===========================================
+
+// date:  2025-02-08
+// by:    Joseph21 (Joseph21-6147)
+
+// For days whose input is a list of independent records (reports, updates, equations, machines, designs)
+// the solving doesn't have to wait until all of the input is parsed. pipeline_reduce() parses and solves
+// at the same time:
+//
+//     flcInputFile dataFile( sFileName );
+//     int nSafe = pipeline_reduce<DatumType>(
+//         [&]( auto &&emit ) {                                    // producer: parses the records
+//             for (std::string_view sLine : dataFile.Lines()) {
+//                 emit( ParseReport( sLine ));
+//             }
+//         },
+//         0,                                                      // initial value of the reduction
+//         []( const DatumType &d ) { return IsSafe1( d ) ? 1 : 0; },  // map: the value of one record
+//         []( int a, int b ) { return a + b; }                    // reduce: combine two values
+//     );
+//
+// The producer and the consumers run as tasks of flcThreadPool: one producer, and one consumer per other
+// thread of the pool (at least 1). The producer puts the records in batches of PIPELINE_BATCH into an
+// flcBoundedQueue. The consumers take the batches from the queue, map the records and reduce the values,
+// each into a partial result of its own. The partial results are reduced in task order at the end.
+//
+// Notes:
+//   * which consumer gets which record depends on the scheduling, so fnReduce must be associative and
+//     commutative (like a sum or a count) to give the same result on each run
+//   * the queue holds at most PIPELINE_QUEUE_SIZE batches: a producer that gets ahead of the consumers
+//     doesn't parse on until there's room, so the memory use is bounded, however large the input is.
+//     Together with the memory mapping of flcInputFile, the input doesn't have to fit in memory as
+//     parsed records
+//   * the consumers wait by yielding their time slice - the queue has no locks. A producer that finds
+//     the queue full processes a batch itself, so the pipeline also works when the pool runs the tasks
+//     one after the other (with --threads 1, or from within a parallel loop)
+//
+// flcBoundedQueue is the bounded multi producer / multi consumer queue of Dmitry Vyukov: a ring of cells
+// that each carry a sequence number, which tells a producer whether the cell is free and a consumer
+// whether it's filled. Claiming a cell is one compare and swap on the head or tail position.
+
+#ifndef FLCPIPELINE_H
+#define FLCPIPELINE_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "flcThreadPool.h"
+
+#define PIPELINE_BATCH        256    // nr of records per batch in the queue
+#define PIPELINE_QUEUE_SIZE    64    // nr of batches the queue holds
+
+// ==============================/ Class flcBoundedQueue /==============================
+
+template <typename T>
+class flcBoundedQueue {
+public:
+    // the capacity is rounded up to a power of 2
+    flcBoundedQueue( size_t nCapacity ) {
+        size_t nSize = 2;
+        while (nSize < nCapacity) {
+            nSize <<= 1;
+        }
+        m_nMask  = nSize - 1;
+        m_pCells = std::make_unique<CellType[]>( nSize );
+        for (size_t i = 0; i < nSize; i++) {
+            m_pCells[i].nSeq.store( i, std::memory_order_relaxed );
+        }
+    }
+
+    // moves item into the queue and returns true, or returns false (leaving item as is) if the queue is full
+    bool TryPush( T &item ) {
+        size_t nPos = m_nTail.load( std::memory_order_relaxed );
+        for (;;) {
+            CellType &cell = m_pCells[nPos & m_nMask];
+            intptr_t nDiff = (intptr_t)cell.nSeq.load( std::memory_order_acquire ) - (intptr_t)nPos;
+            if (nDiff == 0) {
+                // the cell is free - claim it
+                if (m_nTail.compare_exchange_weak( nPos, nPos + 1, std::memory_order_relaxed )) {
+                    cell.data = std::move( item );
+                    cell.nSeq.store( nPos + 1, std::memory_order_release );
+                    return true;
+                }
+            } else if (nDiff < 0) {
+                return false;    // the cell still holds the item of one round ago
+            } else {
+                nPos = m_nTail.load( std::memory_order_relaxed );    // another producer was first
+            }
+        }
+    }
+
+    // moves the front item into item and returns true, or returns false if the queue is empty
+    bool TryPop( T &item ) {
+        size_t nPos = m_nHead.load( std::memory_order_relaxed );
+        for (;;) {
+            CellType &cell = m_pCells[nPos & m_nMask];
+            intptr_t nDiff = (intptr_t)cell.nSeq.load( std::memory_order_acquire ) - (intptr_t)(nPos + 1);
+            if (nDiff == 0) {
+                // the cell is filled - claim it
+                if (m_nHead.compare_exchange_weak( nPos, nPos + 1, std::memory_order_relaxed )) {
+                    item = std::move( cell.data );
+                    cell.nSeq.store( nPos + m_nMask + 1, std::memory_order_release );
+                    return true;
+                }
+            } else if (nDiff < 0) {
+                return false;    // the cell wasn't filled yet
+            } else {
+                nPos = m_nHead.load( std::memory_order_relaxed );    // another consumer was first
+            }
+        }
+    }
+
+private:
+    typedef struct sCellStruct {
+        std::atomic<size_t> nSeq;
+        T data;
+    } CellType;
+
+    std::unique_ptr<CellType[]> m_pCells;
+    size_t m_nMask;
+    alignas( 64 ) std::atomic<size_t> m_nTail{ 0 };    // the producers and the consumers each on their own cache line
+    alignas( 64 ) std::atomic<size_t> m_nHead{ 0 };
+};
+
+// ==========   PIPELINE
+
+// what happened in a pipeline_reduce() call - the waits tell which side was the bottleneck
+typedef struct sPipelineStatsStruct {
+    int       nConsumers     = 0;
+    long long nProduced      = 0;    // nr of records the producer emitted
+    long long nRecords       = 0;    // nr of records that were mapped - equal to nProduced, unless records got lost
+    long long nBatches       = 0;
+    long long nProducerWaits = 0;    // nr of times the queue was full
+    long long nConsumerWaits = 0;    // nr of times the queue was empty while the producer was busy
+} PipelineStatsType;
+
+// fnProduce( emit ) is called by the producer task (normally on the calling thread), and must call
+// emit( record ) for each record (of type R). The records are mapped with fnMap and reduced with fnReduce
+// by the consumer tasks. init is only combined once with the reduced records, so it need not be the
+// identity of fnReduce. If pStats is not nullptr, the statistics of the run are stored in it
+template <typename R, typename V, typename P, typename M, typename C>
+V pipeline_reduce( P fnProduce, V init, M fnMap, C fnReduce, PipelineStatsType *pStats = nullptr ) {
+    // task 0 produces, the others consume. If the pool runs the tasks one after the other (with one thread,
+    // or when it's busy), the consumers only start when the producer is done - so the producer processes a
+    // batch itself whenever the queue is full, rather than waiting for a consumer
+    int nTasks = std::max( 2, flcThreadPool::Instance().GetThreadCount());
+    flcBoundedQueue<std::vector<R>> queue( PIPELINE_QUEUE_SIZE );
+    std::atomic<bool> bDone( false );
+    std::vector<std::optional<V>> vPartial( nTasks );    // empty if the task didn't map any records
+    std::vector<long long> vMapped( nTasks, 0 ), vWaits( nTasks, 0 );
+    PipelineStatsType stats;
+
+    auto process = [&]( std::vector<R> &batch, std::optional<V> &partial, long long &nMapped ) {
+        for (auto &record : batch) {
+            if (partial) {
+                partial = fnReduce( *partial, fnMap( record ));
+            } else {
+                partial = fnMap( record );
+            }
+        }
+        nMapped += batch.size();
+    };
+
+    auto produce = [&]() {
+        std::optional<V> partial;
+        long long nMapped = 0;
+        std::vector<R> batch, other;
+        batch.reserve( PIPELINE_BATCH );
+        auto flush = [&]() {
+            stats.nProduced += batch.size();
+            stats.nBatches  += 1;
+            while (!queue.TryPush( batch )) {
+                stats.nProducerWaits += 1;
+                if (queue.TryPop( other )) {
+                    process( other, partial, nMapped );
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+            batch = std::vector<R>();    // the batch was moved into the queue
+            batch.reserve( PIPELINE_BATCH );
+        };
+        auto emit = [&]( R &&record ) {
+            batch.push_back( std::move( record ));
+            if (batch.size() == PIPELINE_BATCH) {
+                flush();
+            }
+        };
+        fnProduce( emit );
+        if (!batch.empty()) {
+            flush();
+        }
+        bDone.store( true, std::memory_order_release );
+        vPartial[0] = partial;
+        vMapped[0]  = nMapped;
+    };
+
+    auto consume = [&]( int t ) {
+        std::optional<V> partial;
+        long long nMapped = 0, nWaits = 0;
+        std::vector<R> batch;
+        for (;;) {
+            // read the flag before trying to pop: if the queue is empty after the producer was done,
+            // it stays empty
+            bool bProducerDone = bDone.load( std::memory_order_acquire );
+            if (queue.TryPop( batch )) {
+                process( batch, partial, nMapped );
+            } else if (bProducerDone) {
+                break;
+            } else {
+                nWaits += 1;
+                std::this_thread::yield();
+            }
+        }
+        vPartial[t] = partial;
+        vMapped[t]  = nMapped;
+        vWaits[t]   = nWaits;
+    };
+
+    flcThreadPool::Instance().Run( nTasks, [&]( int t ) {
+        if (t == 0) {
+            produce();
+        } else {
+            consume( t );
+        }
+    });
+
+    V result = init;
+    for (int t = 0; t < nTasks; t++) {
+        if (vPartial[t]) {
+            result = fnReduce( result, *vPartial[t] );
+        }
+        stats.nRecords       += vMapped[t];
+        stats.nConsumerWaits += vWaits[t];
+    }
+    stats.nConsumers = nTasks - 1;
+    if (pStats != nullptr) {
+        *pStats = stats;
+    }
+    return result;
+}
+
+#endif // FLCPIPELINE_H
@@ -0,0 +1,180 @@
+// AoC 2024 - hierarchical scoped timers
+// =====================================
+
+// date:  2025-01-13
+// by:    Joseph21 (Joseph21-6147)
+
+#include <cstring>
+#include <iomanip>
+
+#include "flcProfiler.h"
+
+// each thread has its own current section and pause count, all threads share the same tree
+static thread_local int tlsCurrentNode = 0;
+static thread_local int tlsPaused = 0;
+
+// ==============================/ Class flcProfiler /==============================
+
+flcProfiler::flcProfiler() {
+    Reset();
+}
+
+flcProfiler::~flcProfiler() {
+    if (m_bEnabled && !m_bReported && m_vNodes.size() > 1) {
+        Report();
+    }
+}
+
+flcProfiler &flcProfiler::Instance() {
+    static flcProfiler instance;
+    return instance;
+}
+
+void flcProfiler::Reset() {
+    std::lock_guard<std::mutex> lock( m_mutex );
+    m_vNodes.clear();
+    ProfileNodeType root;
+    root.sName = "<root>";
+    m_vNodes.push_back( root );
+    tlsCurrentNode = 0;
+    m_bReported = false;
+}
+
+bool flcProfiler::SetCounters( bool bCounters ) {
+    m_bCounters = false;
+    if (bCounters) {
+        m_bEnabled = true;
+        if (flcPerfCounters::ThreadInstance().IsAvailable()) {
+            m_bCounters = true;
+        } else {
+            std::cout << "WARNING: flcProfiler::SetCounters() --> hardware counters not available, using wall clock only" << std::endl;
+        }
+    }
+    return m_bCounters;
+}
+
+void flcProfiler::Pause() {
+    tlsPaused += 1;
+}
+
+void flcProfiler::Resume() {
+    tlsPaused -= 1;
+}
+
+bool flcProfiler::IsRecording() {
+    return m_bEnabled && tlsPaused == 0;
+}
+
+int flcProfiler::EnterSection( const char *sName ) {
+    std::lock_guard<std::mutex> lock( m_mutex );
+    int nParent = tlsCurrentNode;
+    // look for an existing child section with this name
+    int nFound = -1;
+    for (int i = 0; i < (int)m_vNodes[nParent].vChildren.size() && nFound == -1; i++) {
+        int nChild = m_vNodes[nParent].vChildren[i];
+        if (strcmp( m_vNodes[nChild].sName.c_str(), sName ) == 0) {
+            nFound = nChild;
+        }
+    }
+    // create it if it's not there yet
+    if (nFound == -1) {
+        ProfileNodeType newNode;
+        newNode.sName   = sName;
+        newNode.nParent = nParent;
+        nFound = (int)m_vNodes.size();
+        m_vNodes.push_back( newNode );
+        m_vNodes[nParent].vChildren.push_back( nFound );
+    }
+    tlsCurrentNode = nFound;
+    return nFound;
+}
+
+void flcProfiler::LeaveSection( int nNode, double dElapsed, const PerfSampleType &counters ) {
+    std::lock_guard<std::mutex> lock( m_mutex );
+    if (nNode <= 0 || nNode >= (int)m_vNodes.size()) {
+        std::cout << "ERROR: flcProfiler::LeaveSection() --> invalid node index: " << nNode << std::endl;
+        return;
+    }
+    m_vNodes[nNode].nCalls     += 1;
+    m_vNodes[nNode].dInclusive += dElapsed;
+    m_vNodes[nNode].counters   += counters;
+    tlsCurrentNode = m_vNodes[nNode].nParent;
+}
+
+double flcProfiler::GetExclusive( int nNode ) {
+    double dResult = m_vNodes[nNode].dInclusive;
+    for (auto nChild : m_vNodes[nNode].vChildren) {
+        dResult -= m_vNodes[nChild].dInclusive;
+    }
+    return dResult;
+}
+
+void flcProfiler::Report( std::ostream &os ) {
+    std::ios_base::fmtflags oldFlags = os.flags();
+    std::streamsize nOldPrecision = os.precision();
+    os << "Profile report - times in msec" << std::endl;
+    os << "    " << std::left << std::setw( 44 ) << "section" << std::right
+       << std::setw( 10 ) << "calls" << std::setw( 15 ) << "inclusive" << std::setw( 15 ) << "exclusive";
+    if (m_bCounters) {
+        for (int i = 0; i < PERF_NR_COUNTERS; i++) {
+            os << std::setw( 15 ) << flcPerfCounters::CounterName( i );
+        }
+        os << std::setw( 8 ) << "IPC";
+    }
+    os << std::endl;
+    for (auto nChild : m_vNodes[0].vChildren) {
+        ReportNode( os, nChild, 0 );
+    }
+    os << std::endl;
+    os.flags( oldFlags );
+    os.precision( nOldPrecision );
+    m_bReported = true;
+}
+
+void flcProfiler::ReportNode( std::ostream &os, int nNode, int nDepth ) {
+    ProfileNodeType &node = m_vNodes[nNode];
+    std::string sIndented = std::string( 2 * nDepth, ' ' ) + node.sName;
+    os << "    " << std::left << std::setw( 44 ) << sIndented << std::right
+       << std::setw( 10 ) << node.nCalls
+       << std::setw( 15 ) << std::fixed << std::setprecision( 4 ) << node.dInclusive
+       << std::setw( 15 ) << GetExclusive( nNode );
+    if (m_bCounters) {
+        for (int i = 0; i < PERF_NR_COUNTERS; i++) {
+            os << std::setw( 15 ) << node.counters.nValue[i];
+        }
+        long long nCycles = node.counters.nValue[PERF_CYCLES];
+        double dIPC = (nCycles > 0) ? (double)node.counters.nValue[PERF_INSTRUCTIONS] / (double)nCycles : 0.0;
+        os << std::setw( 8 ) << std::setprecision( 2 ) << dIPC;
+    }
+    os << std::endl;
+    for (auto nChild : node.vChildren) {
+        ReportNode( os, nChild, nDepth + 1 );
+    }
+}
+
+// ==============================/ Class flcScopedTimer /==============================
+
+// the clock is only read if the profiler is enabled - otherwise a scoped timer costs just a check on a bool
+flcScopedTimer::flcScopedTimer( const char *sName ) {
+    flcProfiler &prof = flcProfiler::Instance();
+    if (prof.IsRecording()) {
+        m_nNode = prof.EnterSection( sName );
+        if (prof.UsingCounters()) {
+            m_startCounters = flcPerfCounters::ThreadInstance().Read();
+        }
+        m_tStart = std::chrono::steady_clock::now();
+    }
+}
+
+flcScopedTimer::~flcScopedTimer() {
+    if (m_nNode != -1) {
+        double dElapsed = std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now() - m_tStart ).count();
+        flcProfiler &prof = flcProfiler::Instance();
+        if (prof.UsingCounters()) {
+            PerfSampleType deltaCounters = flcPerfCounters::ThreadInstance().Read() - m_startCounters;
+            prof.LeaveSection( m_nNode, dElapsed, deltaCounters );
+        } else {
+            prof.LeaveSection( m_nNode, dElapsed );
+        }
+    }
+}
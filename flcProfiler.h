@@ -0,0 +1,108 @@
+// AoC 2024 - hierarchical scoped timers
+// =====================================
+
+// date:  2025-01-13
+// by:    Joseph21 (Joseph21-6147)
+
+// Put an flcScopedTimer object (or the FLC_PROFILE_SCOPE() macro) at the start of a block, and the time
+// spent in that block is added to a named section. Sections that are entered while another section is
+// active become children of it, so a tree of sections results. For each section the call count, the
+// inclusive time (including the child sections) and the exclusive time (without them) are kept.
+//
+// The profiler is disabled by default - then a scoped timer costs just a check on a bool, the clock is
+// not read. If enabled (for instance by passing --profile on the command line to flcBenchmark), an
+// indented report of the section tree is printed at the end of the run.
+//
+// Optionally hardware performance counters (see flcPerfCounters) are collected per section as well. If
+// the counters are not available on this machine, the report contains wall clock times only.
+
+#ifndef FLCPROFILER_H
+#define FLCPROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "flcPerfCounters.h"
+
+// one section in the tree - node 0 is the (unnamed) root of the tree
+typedef struct sProfileNodeStruct {
+    std::string sName;
+    int nParent = -1;
+    std::vector<int> vChildren;
+    long long nCalls = 0;
+    double dInclusive = 0.0;    // in milliseconds
+    PerfSampleType counters;    // inclusive counter values - only if counters are in use
+} ProfileNodeType;
+
+class flcProfiler {
+public:
+    // there's one profiler per program run
+    static flcProfiler &Instance();
+    // prints the report if the profiler is enabled and anything was recorded
+    ~flcProfiler();
+
+    void SetEnabled( bool bEnabled ) { m_bEnabled = bEnabled; }
+    bool IsEnabled() { return m_bEnabled; }
+    // no sections are recorded on this thread between Pause() and Resume(), e.g. during warmup runs. The
+    // calls may be nested. Other threads - like a part that runs concurrently - keep recording, and so do
+    // the worker threads of flcThreadPool
+    void Pause();
+    void Resume();
+    bool IsRecording();
+
+    // enables collecting hardware counters per section (this also enables the profiler). Returns
+    // false - and the profiler falls back to wall clock only - if the counters are not available
+    bool SetCounters( bool bCounters );
+    bool UsingCounters() { return m_bCounters; }
+
+    // makes the section sName a child of the current section (creating it if needed), and makes it the
+    // current section. Returns the node index to be passed to LeaveSection()
+    int  EnterSection( const char *sName );
+    // adds dElapsed (msec) and the counter differences to section nNode, and makes its parent the
+    // current section again
+    void LeaveSection( int nNode, double dElapsed, const PerfSampleType &counters = PerfSampleType());
+
+    // clears all recorded sections
+    void Reset();
+
+    // exclusive time of section nNode: its inclusive time minus that of its child sections
+    double GetExclusive( int nNode );
+    int GetNrNodes() { return (int)m_vNodes.size(); }
+    ProfileNodeType &GetNode( int nNode ) { return m_vNodes[nNode]; }
+
+    // prints the indented section tree to os
+    void Report( std::ostream &os = std::cout );
+
+private:
+    flcProfiler();
+
+    void ReportNode( std::ostream &os, int nNode, int nDepth );
+
+    std::vector<ProfileNodeType> m_vNodes;
+    std::atomic<bool> m_bEnabled{ false };
+    bool m_bCounters = false;
+    bool m_bReported = false;
+    std::mutex m_mutex;          // sections may be entered from more than one thread
+};
+
+class flcScopedTimer {
+public:
+    flcScopedTimer( const char *sName );
+    ~flcScopedTimer();
+
+private:
+    int m_nNode = -1;            // stays -1 if the profiler was disabled at construction
+    std::chrono::steady_clock::time_point m_tStart;    // only read if the profiler was enabled
+    PerfSampleType m_startCounters;
+};
+
+// convenience macro to put a uniquely named scoped timer in the current block
+#define FLC_PROFILE_CONCAT2( a, b ) a##b
+#define FLC_PROFILE_CONCAT( a, b )  FLC_PROFILE_CONCAT2( a, b )
+#define FLC_PROFILE_SCOPE( name )   flcScopedTimer FLC_PROFILE_CONCAT( flcScope_, __LINE__ )( name )
+
+#endif // FLCPROFILER_H
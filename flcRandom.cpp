@@ -0,0 +1,73 @@
+// AoC 2024 - seeded pseudo random generator
+// =========================================
+
+// date:  2025-02-03
+// by:    Joseph21 (Joseph21-6147)
+
+#include <atomic>
+
+#include "flcRandom.h"
+
+// ==============================/ Class flcRandom /==============================
+
+// the state is filled from the seed with splitmix64, as recommended by the xoshiro authors - that
+// never gives the all zero state
+void flcRandom::Seed( uint64_t nSeed, int nStream ) {
+    uint64_t x = nSeed;
+    for (int i = 0; i < 4; i++) {
+        x += 0x9E3779B97F4A7C15ULL;
+        uint64_t z = x;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        m_nState[i] = z ^ (z >> 31);
+    }
+    for (int i = 0; i < nStream; i++) {
+        Jump();
+    }
+}
+
+void flcRandom::Jump() {
+    static const uint64_t JUMP[] = { 0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL, 0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL };
+    uint64_t s[4] = { 0, 0, 0, 0 };
+    for (int i = 0; i < 4; i++) {
+        for (int b = 0; b < 64; b++) {
+            if (JUMP[i] & (1ULL << b)) {
+                for (int j = 0; j < 4; j++) {
+                    s[j] ^= m_nState[j];
+                }
+            }
+            Next();
+        }
+    }
+    for (int j = 0; j < 4; j++) {
+        m_nState[j] = s[j];
+    }
+}
+
+// ==========   THREAD LOCAL GENERATORS
+
+static std::atomic<uint64_t> glbRandomSeed{ 0 };
+static std::atomic<int>      glbNextStream{ 0 };
+
+void SetRandomSeed( uint64_t nSeed ) {
+    glbRandomSeed.store( nSeed );
+}
+
+uint64_t GetRandomSeed() {
+    return glbRandomSeed.load();
+}
+
+flcRandom &ThreadRandom() {
+    static thread_local int      tlsStream = -1;
+    static thread_local uint64_t tlsSeed   = 0;
+    static thread_local flcRandom tlsRandom;
+    uint64_t nSeed = glbRandomSeed.load( std::memory_order_relaxed );
+    if (tlsStream < 0 || tlsSeed != nSeed) {
+        if (tlsStream < 0) {
+            tlsStream = glbNextStream.fetch_add( 1 );
+        }
+        tlsSeed = nSeed;
+        tlsRandom.Seed( nSeed, tlsStream );
+    }
+    return tlsRandom;
+}
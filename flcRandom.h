@@ -0,0 +1,117 @@
+// AoC 2024 - seeded pseudo random generator
+// =========================================
+
+// date:  2025-02-03
+// by:    Joseph21 (Joseph21-6147)
+
+// flcRandom is a xoshiro256** generator: fast (a few shifts, rotates and adds per number), with 256 bits
+// of state and good statistical quality. Unlike rand() the sequence only depends on the seed, not on the
+// platform, so a seed reproduces the same numbers everywhere.
+//
+// An flcRandom object must not be shared between threads without locking. Each thread can use its own
+// generator though:
+//   * flcRandom( nSeed, nStream ) gives independent streams for the same seed (e.g. one per thread or
+//     per chunk of work), by jumping 2^128 numbers ahead per stream nr
+//   * ThreadRandom() returns a generator local to the calling thread, seeded from SetRandomSeed() and an
+//     own stream nr per thread
+//
+// IntBetween() is unbiased (Lemire's multiply and reject method), unlike rand() % n.
+
+#ifndef FLCRANDOM_H
+#define FLCRANDOM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// ==============================/ Class flcRandom /==============================
+
+class flcRandom {
+public:
+    flcRandom( uint64_t nSeed = 0, int nStream = 0 ) { Seed( nSeed, nStream ); }
+
+    // restarts the sequence for nSeed, stream nStream
+    void Seed( uint64_t nSeed, int nStream = 0 );
+
+    // next 64 random bits
+    uint64_t Next() {
+        uint64_t nResult = Rotl( m_nState[1] * 5, 7 ) * 9;
+        uint64_t t = m_nState[1] << 17;
+        m_nState[2] ^= m_nState[0];
+        m_nState[3] ^= m_nState[1];
+        m_nState[1] ^= m_nState[2];
+        m_nState[0] ^= m_nState[3];
+        m_nState[2] ^= t;
+        m_nState[3] = Rotl( m_nState[3], 45 );
+        return nResult;
+    }
+
+    // uniform in [0, nRange >, nRange > 0
+    uint64_t Below( uint64_t nRange ) {
+        uint64_t nLow;
+        uint64_t nHigh = MulHigh( Next(), nRange, nLow );
+        if (nLow < nRange) {
+            uint64_t nThreshold = -nRange % nRange;
+            while (nLow < nThreshold) {
+                nHigh = MulHigh( Next(), nRange, nLow );
+            }
+        }
+        return nHigh;
+    }
+    // uniform in [nMin, nMax]
+    long long IntBetween( long long nMin, long long nMax ) {
+        return nMin + (long long)Below( (uint64_t)(nMax - nMin) + 1 );
+    }
+    // uniform in [0.0, 1.0 >
+    double Real() { return (Next() >> 11) * (1.0 / 9007199254740992.0); }
+    // true with probability dProb
+    bool Chance( double dProb ) { return Real() < dProb; }
+
+    // random permutation of v (Fisher-Yates)
+    template <typename T>
+    void Shuffle( std::vector<T> &v ) {
+        for (size_t i = v.size(); i > 1; i--) {
+            std::swap( v[i - 1], v[Below( i )] );
+        }
+    }
+
+private:
+    // advances the state 2^128 numbers - Seed() uses it to split one seed in non overlapping streams
+    void Jump();
+
+    static uint64_t Rotl( uint64_t x, int k ) { return (x << k) | (x >> (64 - k)); }
+
+    // high 64 bits of the 128 bit product a * b - nLow is set to the low 64 bits
+    static uint64_t MulHigh( uint64_t a, uint64_t b, uint64_t &nLow ) {
+#if defined( __SIZEOF_INT128__ )
+        unsigned __int128 m = (unsigned __int128)a * b;
+        nLow = (uint64_t)m;
+        return (uint64_t)(m >> 64);
+#else
+        // schoolbook multiply on 32 bit halves
+        uint64_t aLo = a & 0xFFFFFFFFULL, aHi = a >> 32;
+        uint64_t bLo = b & 0xFFFFFFFFULL, bHi = b >> 32;
+        uint64_t nLoLo = aLo * bLo, nHiLo = aHi * bLo;
+        uint64_t nLoHi = aLo * bHi, nHiHi = aHi * bHi;
+        uint64_t nMid  = (nLoLo >> 32) + (nHiLo & 0xFFFFFFFFULL) + nLoHi;
+        nLow = (nMid << 32) | (nLoLo & 0xFFFFFFFFULL);
+        return nHiHi + (nHiLo >> 32) + (nMid >> 32);
+#endif
+    }
+
+    uint64_t m_nState[4];
+};
+
+// ==========   THREAD LOCAL GENERATORS
+
+// sets the seed for the generators of ThreadRandom(). Threads that already have a generator restart
+// their stream with the new seed when they next call ThreadRandom()
+void SetRandomSeed( uint64_t nSeed );
+uint64_t GetRandomSeed();
+
+// the generator of the calling thread. The streams of the threads don't overlap, and the first thread
+// that calls this gets stream 0, the next one stream 1 etc.
+flcRandom &ThreadRandom();
+
+#endif // FLCRANDOM_H
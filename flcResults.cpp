@@ -0,0 +1,331 @@
+// AoC 2024 - machine readable benchmark results
+// =============================================
+
+// date:  2025-01-17
+// by:    Joseph21 (Joseph21-6147)
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+
+#include "flcResults.h"
+
+// ==========   RECORD FIELDS
+
+// a record as read from or written to file: field name -> field value (as text)
+typedef std::map<std::string, std::string> RecordType;
+
+// the order of the fields in the output
+static const char *sFieldNames[] = {
+    "day", "phase", "part", "answer",
+    "samples", "min", "median", "mean", "p95", "stddev",
+    "cycles", "instructions", "l1d_misses", "llc_misses", "branch_misses",
+    "allocs", "frees", "bytes_alloc", "bytes_freed", "peak_live", "peak_rss_kb"
+};
+static const int nNrFields = sizeof( sFieldNames ) / sizeof( sFieldNames[0] );
+static const int nNrTextFields = 4;    // the first fields are strings, the others numbers
+
+static std::string Number2string( double dValue ) {
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision( 6 ) << dValue;
+    return ss.str();
+}
+
+// fields that were not collected are not put in the record
+static RecordType Phase2record( const BenchPhaseType &phase ) {
+    RecordType rec;
+    rec["day"    ] = phase.sDay;
+    rec["phase"  ] = phase.sProgPhase;
+    rec["part"   ] = phase.sName;
+    rec["answer" ] = phase.sAnswer;
+    rec["samples"] = std::to_string( phase.stats.nSamples );
+    rec["min"    ] = Number2string( phase.stats.dMin    );
+    rec["median" ] = Number2string( phase.stats.dMedian );
+    rec["mean"   ] = Number2string( phase.stats.dMean   );
+    rec["p95"    ] = Number2string( phase.stats.dP95    );
+    rec["stddev" ] = Number2string( phase.stats.dStdDev );
+    if (phase.bCounters) {
+        rec["cycles"       ] = std::to_string( phase.counters.nValue[PERF_CYCLES      ] );
+        rec["instructions" ] = std::to_string( phase.counters.nValue[PERF_INSTRUCTIONS] );
+        rec["l1d_misses"   ] = std::to_string( phase.counters.nValue[PERF_L1D_MISSES  ] );
+        rec["llc_misses"   ] = std::to_string( phase.counters.nValue[PERF_LLC_MISSES  ] );
+        rec["branch_misses"] = std::to_string( phase.counters.nValue[PERF_BRANCH_MISS ] );
+    }
+    if (phase.bMemory) {
+        rec["allocs"     ] = std::to_string( phase.mem.nAllocs     );
+        rec["frees"      ] = std::to_string( phase.mem.nFrees      );
+        rec["bytes_alloc"] = std::to_string( phase.mem.nBytesAlloc );
+        rec["bytes_freed"] = std::to_string( phase.mem.nBytesFreed );
+        rec["peak_live"  ] = std::to_string( phase.mem.nPeakLive   );
+        rec["peak_rss_kb"] = std::to_string( phase.nPeakRSS        );
+    }
+    return rec;
+}
+
+// only the identification, answer and the timing statistics are needed for a baseline
+static BenchPhaseType Record2phase( RecordType &rec ) {
+    BenchPhaseType phase;
+    phase.sDay          = rec["day"   ];
+    phase.sProgPhase    = rec["phase" ];
+    phase.sName         = rec["part"  ];
+    phase.sAnswer       = rec["answer"];
+    phase.stats.nSamples = atoi( rec["samples"].c_str());
+    phase.stats.dMin     = atof( rec["min"    ].c_str());
+    phase.stats.dMedian  = atof( rec["median" ].c_str());
+    phase.stats.dMean    = atof( rec["mean"   ].c_str());
+    phase.stats.dP95     = atof( rec["p95"    ].c_str());
+    phase.stats.dStdDev  = atof( rec["stddev" ].c_str());
+    return phase;
+}
+
+// ==========   JSON
+
+static std::string JSONescape( const std::string &s ) {
+    std::string sResult;
+    for (auto c : s) {
+        switch (c) {
+            case '"' : sResult += "\\\""; break;
+            case '\\': sResult += "\\\\"; break;
+            case '\n': sResult += "\\n" ; break;
+            case '\t': sResult += "\\t" ; break;
+            default  : sResult += c;
+        }
+    }
+    return sResult;
+}
+
+// parses one flat JSON object with string and number values - as written by WriteJSON()
+static bool ParseJSONobject( const std::string &sLine, RecordType &rec ) {
+    size_t nPos = sLine.find( '{' );
+    if (nPos == std::string::npos) {
+        return false;
+    }
+    // reads a quoted string starting at nPos, and moves nPos past it
+    auto read_string = [&]( std::string &sValue ) {
+        sValue.clear();
+        for (nPos += 1; nPos < sLine.length() && sLine[nPos] != '"'; nPos++) {
+            if (sLine[nPos] == '\\' && nPos + 1 < sLine.length()) {
+                nPos += 1;
+                switch (sLine[nPos]) {
+                    case 'n': sValue += '\n'; break;
+                    case 't': sValue += '\t'; break;
+                    default : sValue += sLine[nPos];
+                }
+            } else {
+                sValue += sLine[nPos];
+            }
+        }
+        nPos += 1;
+    };
+    nPos += 1;
+    while (nPos < sLine.length() && sLine[nPos] != '}') {
+        if (sLine[nPos] == '"') {
+            std::string sKey, sValue;
+            read_string( sKey );
+            nPos = sLine.find_first_not_of( " :", nPos );
+            if (nPos == std::string::npos) {
+                return false;
+            }
+            if (sLine[nPos] == '"') {
+                read_string( sValue );
+            } else {
+                size_t nEnd = sLine.find_first_of( ",}", nPos );
+                if (nEnd == std::string::npos) {
+                    return false;
+                }
+                sValue = sLine.substr( nPos, nEnd - nPos );
+                sValue.erase( sValue.find_last_not_of( ' ' ) + 1 );
+                nPos = nEnd;
+            }
+            rec[sKey] = sValue;
+        } else {
+            nPos += 1;
+        }
+    }
+    return true;
+}
+
+bool flcResults::WriteJSON( const std::string &sFileName, const std::vector<BenchPhaseType> &vPhases ) {
+    std::ofstream outFile( sFileName );
+    if (!outFile.is_open()) {
+        std::cout << "ERROR: flcResults::WriteJSON() --> can't open file: " << sFileName << std::endl;
+        return false;
+    }
+    // one record per line, so that the files can be diffed and grepped easily
+    outFile << "[" << std::endl;
+    for (int i = 0; i < (int)vPhases.size(); i++) {
+        RecordType rec = Phase2record( vPhases[i] );
+        outFile << "  {";
+        bool bFirst = true;
+        for (int j = 0; j < nNrFields; j++) {
+            auto iter = rec.find( sFieldNames[j] );
+            if (iter != rec.end()) {
+                outFile << (bFirst ? "" : ", ") << "\"" << sFieldNames[j] << "\": ";
+                if (j < nNrTextFields) {
+                    outFile << "\"" << JSONescape( iter->second ) << "\"";
+                } else {
+                    outFile << iter->second;
+                }
+                bFirst = false;
+            }
+        }
+        outFile << "}" << (i + 1 < (int)vPhases.size() ? "," : "") << std::endl;
+    }
+    outFile << "]" << std::endl;
+    return true;
+}
+
+// ==========   CSV
+
+static std::string CSVquote( const std::string &s ) {
+    std::string sResult = "\"";
+    for (auto c : s) {
+        if (c == '"') sResult += '"';
+        sResult += c;
+    }
+    return sResult + "\"";
+}
+
+static std::vector<std::string> CSVsplit( const std::string &sLine ) {
+    std::vector<std::string> vResult;
+    std::string sField;
+    bool bQuoted = false;
+    for (size_t i = 0; i < sLine.length(); i++) {
+        char c = sLine[i];
+        if (bQuoted) {
+            if (c == '"' && i + 1 < sLine.length() && sLine[i + 1] == '"') {
+                sField += '"';
+                i += 1;
+            } else if (c == '"') {
+                bQuoted = false;
+            } else {
+                sField += c;
+            }
+        } else if (c == '"') {
+            bQuoted = true;
+        } else if (c == ',') {
+            vResult.push_back( sField );
+            sField.clear();
+        } else if (c != '\r') {
+            sField += c;
+        }
+    }
+    vResult.push_back( sField );
+    return vResult;
+}
+
+bool flcResults::WriteCSV( const std::string &sFileName, const std::vector<BenchPhaseType> &vPhases ) {
+    std::ofstream outFile( sFileName );
+    if (!outFile.is_open()) {
+        std::cout << "ERROR: flcResults::WriteCSV() --> can't open file: " << sFileName << std::endl;
+        return false;
+    }
+    for (int j = 0; j < nNrFields; j++) {
+        outFile << (j == 0 ? "" : ",") << sFieldNames[j];
+    }
+    outFile << std::endl;
+    for (auto &p : vPhases) {
+        RecordType rec = Phase2record( p );
+        for (int j = 0; j < nNrFields; j++) {
+            auto iter = rec.find( sFieldNames[j] );
+            std::string sValue = (iter == rec.end()) ? "" : iter->second;
+            outFile << (j == 0 ? "" : ",") << (j < nNrTextFields ? CSVquote( sValue ) : sValue);
+        }
+        outFile << std::endl;
+    }
+    return true;
+}
+
+// ==========   READING AND COMPARING
+
+bool flcResults::ReadResults( const std::string &sFileName, std::vector<BenchPhaseType> &vPhases ) {
+    std::ifstream inFile( sFileName );
+    if (!inFile.is_open()) {
+        std::cout << "ERROR: flcResults::ReadResults() --> can't open file: " << sFileName << std::endl;
+        return false;
+    }
+    vPhases.clear();
+    std::string sLine;
+    std::vector<std::string> vHeader;
+    bool bJSON = false, bFirstLine = true;
+    while (getline( inFile, sLine )) {
+        if (bFirstLine) {
+            // JSON files start with '[', CSV files with the header line
+            bJSON = (sLine.find_first_not_of( " \t" ) != std::string::npos && sLine[sLine.find_first_not_of( " \t" )] == '[');
+            if (!bJSON) {
+                vHeader = CSVsplit( sLine );
+            }
+            bFirstLine = false;
+            if (!bJSON) continue;
+        }
+        RecordType rec;
+        if (bJSON) {
+            if (!ParseJSONobject( sLine, rec )) continue;
+        } else {
+            std::vector<std::string> vFields = CSVsplit( sLine );
+            for (int i = 0; i < (int)vFields.size() && i < (int)vHeader.size(); i++) {
+                rec[vHeader[i]] = vFields[i];
+            }
+        }
+        if (!rec.empty()) {
+            vPhases.push_back( Record2phase( rec ));
+        }
+    }
+    return true;
+}
+
+int flcResults::CompareReport( const std::vector<BenchPhaseType> &vBaseline, const std::vector<BenchPhaseType> &vCurrent, double dThreshold ) {
+    int nNameWidth = 6;
+    for (auto &p : vCurrent) {
+        nNameWidth = std::max( nNameWidth, (int)flcBenchmark::FullName( p ).length());
+    }
+    // the format of std::cout is restored at the end of each row, so that it doesn't leak into later output
+    std::ios_base::fmtflags oldFlags = std::cout.flags();
+    std::streamsize nOldPrecision = std::cout.precision();
+    std::cout << "Comparison against baseline - median times in msec, threshold " << dThreshold << " %" << std::endl;
+    std::cout << "    " << std::left << std::setw( nNameWidth ) << "phase" << std::right
+              << std::setw( 13 ) << "baseline" << std::setw( 13 ) << "current" << std::setw( 11 ) << "change" << std::endl;
+
+    int nFlagged = 0;
+    for (auto &cur : vCurrent) {
+        // look for the matching baseline record
+        const BenchPhaseType *pBase = nullptr;
+        for (auto &b : vBaseline) {
+            if (b.sDay == cur.sDay && b.sProgPhase == cur.sProgPhase && b.sName == cur.sName) {
+                pBase = &b;
+            }
+        }
+        std::cout << "    " << std::left << std::setw( nNameWidth ) << flcBenchmark::FullName( cur ) << std::right << std::fixed << std::setprecision( 4 );
+        if (pBase == nullptr) {
+            std::cout << std::setw( 13 ) << "-" << std::setw( 13 ) << cur.stats.dMedian << std::setw( 11 ) << "-" << "   (not in baseline)";
+        } else {
+            double dBase = pBase->stats.dMedian;
+            double dChange = (dBase > 0.0) ? (cur.stats.dMedian - dBase) / dBase * 100.0 : 0.0;
+            std::stringstream ssChange;
+            ssChange << std::showpos << std::fixed << std::setprecision( 1 ) << dChange << " %";
+            std::cout << std::setw( 13 ) << dBase << std::setw( 13 ) << cur.stats.dMedian << std::setw( 11 ) << ssChange.str();
+            bool bFlagged = false;
+            if (dChange > dThreshold) {
+                std::cout << "   REGRESSION";
+                bFlagged = true;
+            }
+            // a changed answer is flagged as well - it's probably caused by a change in a shared lib
+            if (!pBase->sAnswer.empty() && !cur.sAnswer.empty() && pBase->sAnswer != cur.sAnswer) {
+                std::cout << "   ANSWER CHANGED (was " << pBase->sAnswer << ")";
+                bFlagged = true;
+            }
+            if (bFlagged) {
+                nFlagged += 1;
+            }
+        }
+        std::cout.flags( oldFlags );
+        std::cout.precision( nOldPrecision );
+        std::cout << std::endl;
+    }
+    std::cout << nFlagged << " phase(s) flagged" << std::endl << std::endl;
+    return nFlagged;
+}
@@ -0,0 +1,39 @@
+// AoC 2024 - machine readable benchmark results
+// =============================================
+
+// date:  2025-01-17
+// by:    Joseph21 (Joseph21-6147)
+
+// Writes the phase results of flcBenchmark as JSON or CSV - one record per phase with the day, program
+// phase, part (the phase name), answer, timing statistics, and the hardware counters and memory
+// statistics if these were collected. Fields that were not collected are left empty (CSV) or omitted
+// (JSON). All times are in milliseconds.
+//
+// A results file written earlier can be read back as a baseline, and compared against the current
+// results. Records are matched on day, program phase and part.
+
+#ifndef FLCRESULTS_H
+#define FLCRESULTS_H
+
+#include <string>
+#include <vector>
+
+#include "flcBenchmark.h"
+
+class flcResults {
+public:
+    // these return false if the file couldn't be written
+    static bool WriteJSON( const std::string &sFileName, const std::vector<BenchPhaseType> &vPhases );
+    static bool WriteCSV(  const std::string &sFileName, const std::vector<BenchPhaseType> &vPhases );
+
+    // reads a results file as written by WriteJSON() or WriteCSV() - the format is recognized from the
+    // content. Only the stats of the phases are filled, not the samples. Returns false if the file
+    // couldn't be read
+    static bool ReadResults( const std::string &sFileName, std::vector<BenchPhaseType> &vPhases );
+
+    // prints a table that compares the median times of vCurrent with those in vBaseline. Phases that
+    // got slower by more than dThreshold percent are flagged. Returns the nr of flagged phases
+    static int CompareReport( const std::vector<BenchPhaseType> &vBaseline, const std::vector<BenchPhaseType> &vCurrent, double dThreshold );
+};
+
+#endif // FLCRESULTS_H
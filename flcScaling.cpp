@@ -0,0 +1,165 @@
+// AoC 2024 - empirical complexity analysis
+// ========================================
+
+// date:  2025-02-04
+// by:    Joseph21 (Joseph21-6147)
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#include "flcScaling.h"
+
+// ==============================/ Class flcScaling /==============================
+
+double flcScaling::CriticalT( int nDF ) {
+    static const double vTable[] = { 12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228 };
+    if (nDF < 1) {
+        return INFINITY;
+    }
+    if (nDF <= 10) {
+        return vTable[nDF - 1];
+    }
+    // close enough to the table values for more degrees of freedom, and 1.96 in the limit
+    return 1.96 + 2.4 / nDF;
+}
+
+// Akaike information criterion of a least squares fit with nParams parameters and sum of squared
+// residuals dSSE. The residuals are floored, so that an exact fit doesn't give -inf
+static double AIC( int nPoints, int nParams, double dSSE ) {
+    return nPoints * log( std::max( dSSE / nPoints, 1e-12 )) + 2.0 * nParams;
+}
+
+// sum of squared residuals of ln t = ln c + ln f(n), with ln c fitted (i.e. the mean of the differences)
+static double OneParamSSE( const std::vector<double> &vX, const std::vector<double> &vY ) {
+    double dMean = 0.0;
+    for (size_t i = 0; i < vX.size(); i++) {
+        dMean += vY[i] - vX[i];
+    }
+    dMean /= vX.size();
+    double dSSE = 0.0;
+    for (size_t i = 0; i < vX.size(); i++) {
+        double r = vY[i] - vX[i] - dMean;
+        dSSE += r * r;
+    }
+    return dSSE;
+}
+
+ScalingFitType flcScaling::Fit( const std::vector<double> &vSize, const std::vector<double> &vTime ) {
+    ScalingFitType fit;
+    std::vector<double> vX, vY, vXLog;    // ln n, ln t and ln( n ln n )
+    double dMaxTime = 0.0;
+    for (size_t i = 0; i < vSize.size() && i < vTime.size(); i++) {
+        if (vSize[i] > 0.0 && vTime[i] > 0.0) {
+            vX.push_back( log( vSize[i] ));
+            vY.push_back( log( vTime[i] ));
+            vXLog.push_back( log( vSize[i] * std::max( log( vSize[i] ), 1.0 )));
+            dMaxTime = std::max( dMaxTime, vTime[i] );
+        }
+    }
+    int m = (int)vX.size();
+    fit.nPoints = m;
+    double dMeanX = 0.0, dMeanY = 0.0;
+    for (int i = 0; i < m; i++) {
+        dMeanX += vX[i];
+        dMeanY += vY[i];
+    }
+    double dSxx = 0.0, dSxy = 0.0, dSyy = 0.0;
+    if (m > 0) {
+        dMeanX /= m;
+        dMeanY /= m;
+        for (int i = 0; i < m; i++) {
+            dSxx += (vX[i] - dMeanX) * (vX[i] - dMeanX);
+            dSxy += (vX[i] - dMeanX) * (vY[i] - dMeanY);
+            dSyy += (vY[i] - dMeanY) * (vY[i] - dMeanY);
+        }
+    }
+    if (m < 2 || dSxx <= 0.0) {
+        fit.sModel = "-";
+        fit.sVerdict = "unknown";
+        return fit;
+    }
+    fit.dExponent = dSxy / dSxx;
+    fit.dCoeff    = exp( dMeanY - fit.dExponent * dMeanX );
+    double dSSE = std::max( dSyy - fit.dExponent * dSxy, 0.0 );
+    fit.dR2 = (dSyy > 0.0) ? 1.0 - dSSE / dSyy : 1.0;
+    fit.dLow = fit.dHigh = fit.dExponent;
+    if (m > 2) {
+        double dStdErr = sqrt( dSSE / (m - 2) / dSxx );
+        double dMargin = CriticalT( m - 2 ) * dStdErr;
+        fit.dLow  = fit.dExponent - dMargin;
+        fit.dHigh = fit.dExponent + dMargin;
+        fit.bInterval = true;
+    }
+
+    // which model describes the timings best
+    double dAicLin   = AIC( m, 1, OneParamSSE( vX   , vY ));
+    double dAicNLogN = AIC( m, 1, OneParamSSE( vXLog, vY ));
+    double dAicPower = AIC( m, 2, dSSE );
+    if (m <= 2) {
+        dAicPower = INFINITY;    // two points are always fitted exactly, that doesn't count as evidence
+    }
+    if (dAicPower < std::min( dAicLin, dAicNLogN )) {
+        std::stringstream ss;
+        ss << "n^" << std::fixed << std::setprecision( 2 ) << fit.dExponent;
+        fit.sModel = ss.str();
+    } else {
+        fit.sModel = (dAicNLogN < dAicLin) ? "n log n" : "n";
+    }
+
+    if (dMaxTime < SCALING_MIN_TIME) {
+        fit.sVerdict = "noise";
+    } else if (!fit.bInterval) {
+        fit.sVerdict = "unknown";
+    } else if (fit.dLow > SCALING_SUPERLINEAR) {
+        fit.sVerdict = "super-linear";
+    } else if (fit.dExponent > SCALING_POSSIBLY) {
+        fit.sVerdict = "possibly super-linear";
+    } else if (fit.dHigh < 2.0 - SCALING_SUPERLINEAR) {
+        fit.sVerdict = "sub-linear";
+    } else {
+        fit.sVerdict = "linear";
+    }
+    return fit;
+}
+
+int flcScaling::Report( const std::vector<ScalingSeriesType> &vSeries ) {
+    int nFlagged = 0, nPossibly = 0;
+    // the format of std::cout is restored after each line with fixed notation, so that it doesn't leak into
+    // the scale column or into later output
+    std::ios_base::fmtflags oldFlags = std::cout.flags();
+    std::streamsize nOldPrecision = std::cout.precision();
+    std::cout << "Scaling report - median times in msec, exponent k of t = c * n^k with 95% confidence interval" << std::endl;
+    for (auto &series : vSeries) {
+        ScalingFitType fit = Fit( series.vSize, series.vTime );
+        std::cout << "    " << series.sName << std::endl;
+        std::cout << "        " << std::setw( 10 ) << "scale" << std::setw( 14 ) << "size" << std::setw( 14 ) << "time" << std::endl;
+        for (size_t i = 0; i < series.vTime.size(); i++) {
+            std::cout << "        " << std::setw( 10 ) << (i < series.vScale.size() ? series.vScale[i] : 0.0)
+                      << std::setw( 14 ) << (long long)series.vSize[i]
+                      << std::setw( 14 ) << std::fixed << std::setprecision( 4 ) << series.vTime[i] << std::endl;
+            std::cout.flags( oldFlags );
+            std::cout.precision( nOldPrecision );
+        }
+        std::cout << "        k = " << std::fixed << std::setprecision( 2 ) << fit.dExponent;
+        if (fit.bInterval) {
+            std::cout << "  [" << fit.dLow << ", " << fit.dHigh << "]";
+        }
+        std::cout << "  R^2 = " << std::setprecision( 3 ) << fit.dR2;
+        std::cout.flags( oldFlags );
+        std::cout.precision( nOldPrecision );
+        std::cout << "  best model: " << fit.sModel << "  -> " << fit.sVerdict;
+        if (fit.sVerdict == "super-linear") {
+            std::cout << "   FLAGGED";
+            nFlagged += 1;
+        } else if (fit.sVerdict == "possibly super-linear") {
+            std::cout << "   CHECK";
+            nPossibly += 1;
+        }
+        std::cout << std::endl;
+    }
+    std::cout << nFlagged << " phase(s) super-linear, " << nPossibly << " possibly" << std::endl << std::endl;
+    return nFlagged;
+}
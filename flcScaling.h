@@ -0,0 +1,74 @@
+// AoC 2024 - empirical complexity analysis
+// ========================================
+
+// date:  2025-02-04
+// by:    Joseph21 (Joseph21-6147)
+
+// Estimates how the running time of a phase grows with the size of its input, from timings at a number
+// of input sizes (see the --scaling mode of the aoc24 driver, which generates the inputs with
+// flcInputGen). The timings are fitted to a power law
+//
+//     t = c * n^k
+//
+// by least squares on ln t = ln c + k * ln n. The exponent k is reported with its 95% confidence interval
+// (Student t, so it gets wide with few sizes or noisy timings), together with R^2 of the fit.
+//
+// The power law is also compared against the one parameter models t = c * n and t = c * n log n. Since
+// those can't bend towards the data like the power law can, the comparison uses the AIC (nr of points
+// times the log of the mean squared residual, plus 2 per parameter), so the power law only wins if it
+// fits clearly better.
+//
+// A phase is flagged as super-linear if the whole confidence interval of k lies above 1.15 - a bit of
+// margin, because n log n over a range of sizes looks like k slightly above 1. If k itself is above 1.2
+// but the interval still reaches down to 1.15, the phase is reported as possibly super-linear: not
+// flagged, but worth a run over a wider range of sizes. Very short timings (below 0.05 msec) are mostly
+// noise, those fits are marked as such.
+//
+// The wider the range of sizes, the narrower the interval: SCALING_DEFAULT_SCALES spans a factor 64.
+
+#ifndef FLCSCALING_H
+#define FLCSCALING_H
+
+#include <string>
+#include <vector>
+
+#define SCALING_SUPERLINEAR   1.15    // lower bound of the CI of k above which a phase is flagged
+#define SCALING_POSSIBLY      1.2     // k above which a phase that isn't flagged is possibly super-linear
+#define SCALING_DEFAULT_SCALES { 0.25, 0.5, 1.0, 2.0, 4.0, 8.0, 16.0 }
+#define SCALING_MIN_TIME      0.05    // msec - fits of phases that are never slower than this are noise
+
+// the result of fitting one series of timings
+typedef struct sScalingFitStruct {
+    int    nPoints    = 0;
+    double dExponent  = 0.0;    // k of t = c * n^k
+    double dCoeff     = 0.0;    // c of t = c * n^k
+    double dLow       = 0.0;    // 95% confidence interval of k - equal to k if there are only 2 points
+    double dHigh      = 0.0;
+    bool   bInterval  = false;  // false if there were too few points for a confidence interval
+    double dR2        = 0.0;
+    std::string sModel;         // the model that fits best: "n", "n log n" or "n^k"
+    std::string sVerdict;       // "super-linear", "possibly super-linear", "linear", "sub-linear", "noise" or "unknown"
+} ScalingFitType;
+
+// the timings of one phase at a number of input sizes
+typedef struct sScalingSeriesStruct {
+    std::string         sName;      // e.g. "day09 solving puzzle part 2"
+    std::vector<double> vScale;     // the scale factor of each input (for the report only)
+    std::vector<double> vSize;      // size of each input (n), e.g. in bytes
+    std::vector<double> vTime;      // time at each input size, in msec
+} ScalingSeriesType;
+
+class flcScaling {
+public:
+    // fits the series to the models above. Points with a size or time <= 0 are left out
+    static ScalingFitType Fit( const std::vector<double> &vSize, const std::vector<double> &vTime );
+
+    // prints a table with the timings and fit of each series. Returns the nr of super-linear series (the
+    // possibly super-linear ones are not counted)
+    static int Report( const std::vector<ScalingSeriesType> &vSeries );
+
+    // two sided 95% critical value of the Student t distribution for nDF degrees of freedom
+    static double CriticalT( int nDF );
+};
+
+#endif // FLCSCALING_H
@@ -0,0 +1,115 @@
+// AoC 2024 - immutable shared input snapshots
+// ===========================================
+
+// date:  2025-02-05
+// by:    Joseph21 (Joseph21-6147)
+
+// The parsed input of a day is held in an flcSnapshot: an immutable, reference counted object. The parts
+// view it read only, instead of each working on its own deep copy of the input:
+//
+//     flcSnapshot<DataStream> glbInputData;
+//
+//     void PrepareInput() {
+//         DataStream inputData;
+//         GetInput( inputData, glbProgPhase != PUZZLE );
+//         glbInputData = MakeSnapshot( std::move( inputData ));
+//     }
+//
+//     int SolvePart1() {
+//         const DataStream &inputData = *glbInputData;
+//         ...
+//
+// A part that does change its input gets a copy-on-write overlay on the snapshot:
+//   * flcCowView<T> copies the whole object on the first write - for data that is changed all over
+//   * flcCowVector<T> (on a snapshot of a std::vector<T>) copies only the elements that are written to,
+//     e.g. the updates of day 05 that need reordering, or the rows of a map that a part changes
+// Until then all reads go to the snapshot. The snapshot itself never changes, so it can be shared by
+// the parts and by threads without locking, and the memory use stays at one copy of the input plus
+// whatever the parts change.
+
+#ifndef FLCSNAPSHOT_H
+#define FLCSNAPSHOT_H
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+// ==============================/ Class flcSnapshot /==============================
+
+template <typename T>
+class flcSnapshot {
+public:
+    // an empty object, so that a snapshot can always be read
+    flcSnapshot() : m_pData( std::make_shared<const T>()) {}
+    explicit flcSnapshot( T &&data ) : m_pData( std::make_shared<const T>( std::move( data ))) {}
+
+    const T &operator * () const { return *m_pData; }
+    const T *operator -> () const { return m_pData.get(); }
+    const T &Get() const { return *m_pData; }
+
+    // nr of snapshot objects (and overlays) that share the data
+    long UseCount() const { return m_pData.use_count(); }
+
+private:
+    std::shared_ptr<const T> m_pData;
+};
+
+// takes over the data - pass it with std::move() to prevent a copy
+template <typename T>
+flcSnapshot<T> MakeSnapshot( T data ) {
+    return flcSnapshot<T>( std::move( data ));
+}
+
+// ==============================/ Class flcCowView /==============================
+
+template <typename T>
+class flcCowView {
+public:
+    flcCowView( const flcSnapshot<T> &snapshot ) : m_snapshot( snapshot ) {}
+
+    // the current state: the snapshot, or the own copy once it's written to
+    const T &Read() const { return m_pCopy ? *m_pCopy : *m_snapshot; }
+    // makes the own copy if that's not done yet
+    T &Write() {
+        if (!m_pCopy) {
+            m_pCopy = std::make_unique<T>( *m_snapshot );
+        }
+        return *m_pCopy;
+    }
+    bool IsCopied() const { return m_pCopy != nullptr; }
+
+private:
+    flcSnapshot<T>     m_snapshot;
+    std::unique_ptr<T> m_pCopy;
+};
+
+// ==============================/ Class flcCowVector /==============================
+
+template <typename T>
+class flcCowVector {
+public:
+    flcCowVector( const flcSnapshot<std::vector<T>> &snapshot ) : m_snapshot( snapshot ), m_vSlot( snapshot->size(), -1 ) {}
+
+    size_t size()  const { return m_vSlot.size(); }
+    bool   empty() const { return m_vSlot.empty(); }
+
+    // element i as it is now: from the snapshot, or the own copy once it's written to
+    const T &operator [] ( size_t i ) const { return m_vSlot[i] < 0 ? (*m_snapshot)[i] : m_vCopies[m_vSlot[i]]; }
+    // copies element i if that's not done yet. The reference stays valid when other elements are copied
+    T &Write( size_t i ) {
+        if (m_vSlot[i] < 0) {
+            m_vSlot[i] = (int)m_vCopies.size();
+            m_vCopies.push_back( (*m_snapshot)[i] );
+        }
+        return m_vCopies[m_vSlot[i]];
+    }
+    // nr of elements that were copied
+    int CopiedCount() const { return (int)m_vCopies.size(); }
+
+private:
+    flcSnapshot<std::vector<T>> m_snapshot;
+    std::vector<int> m_vSlot;      // per element the index in m_vCopies, or -1 if it's not copied
+    std::deque<T>    m_vCopies;    // a deque, so that references to copies stay valid
+};
+
+#endif // FLCSNAPSHOT_H
@@ -0,0 +1,176 @@
+// AoC 2024 - work stealing thread pool
+// ====================================
+
+// date:  2025-01-30
+// by:    Joseph21 (Joseph21-6147)
+
+#include <iostream>
+
+#include "flcThreadPool.h"
+
+// the index of the current thread in the pool, and whether it's running chunks of a job (which is
+// always true for the workers)
+static thread_local int  tlsWorkerIndex = 0;
+static thread_local bool tlsInJob       = false;
+
+// ==============================/ Class flcThreadPool /==============================
+
+flcThreadPool &flcThreadPool::Instance() {
+    static flcThreadPool instance;
+    return instance;
+}
+
+flcThreadPool::flcThreadPool() {
+    SetThreadCount( 0 );
+}
+
+flcThreadPool::~flcThreadPool() {
+    StopWorkers();
+}
+
+int flcThreadPool::WorkerIndex() {
+    return tlsWorkerIndex;
+}
+
+void flcThreadPool::SetThreadCount( int nThreads ) {
+    if (tlsInJob) {
+        std::cout << "ERROR: flcThreadPool::SetThreadCount() --> can't be called from within a parallel loop" << std::endl;
+        return;
+    }
+    if (nThreads < 0) {
+        std::cout << "ERROR: flcThreadPool::SetThreadCount() --> negative thread count: " << nThreads << std::endl;
+        nThreads = 0;
+    }
+    if (nThreads == 0) {
+        nThreads = std::max( 1, (int)std::thread::hardware_concurrency());
+    }
+    std::lock_guard<std::mutex> jobLock( m_jobMutex );
+    StopWorkers();
+    m_nThreads = nThreads;
+}
+
+void flcThreadPool::StartWorkers() {
+    m_bStop = false;
+    m_vQueues.clear();
+    for (int i = 0; i < m_nThreads; i++) {
+        m_vQueues.push_back( std::make_unique<WorkQueue>());
+    }
+    for (int i = 1; i < m_nThreads; i++) {
+        m_vWorkers.emplace_back( &flcThreadPool::WorkerLoop, this, i );
+    }
+}
+
+void flcThreadPool::StopWorkers() {
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        m_bStop = true;
+    }
+    m_cvWork.notify_all();
+    for (std::thread &worker : m_vWorkers) {
+        worker.join();
+    }
+    m_vWorkers.clear();
+}
+
+void flcThreadPool::WorkerLoop( int nWorker ) {
+    tlsWorkerIndex = nWorker;
+    tlsInJob       = true;    // a parallel loop started by a worker runs serially
+    long long nLastJob = 0;
+    std::unique_lock<std::mutex> lock( m_mutex );
+    while (true) {
+        m_cvWork.wait( lock, [&]() { return m_bStop || m_nJobNr != nLastJob; } );
+        if (m_bStop) {
+            return;
+        }
+        nLastJob = m_nJobNr;
+        const std::function<void( int )> *pJob = m_pJob;
+        m_nActive += 1;
+        lock.unlock();
+
+        ExecuteChunks( nWorker, pJob );
+
+        lock.lock();
+        m_nActive -= 1;
+        if (m_nActive == 0) {
+            m_cvDone.notify_all();
+        }
+    }
+}
+
+bool flcThreadPool::TakeChunk( int nWorker, int &nChunk ) {
+    // own queue first, from the front
+    {
+        WorkQueue &own = *m_vQueues[nWorker];
+        std::lock_guard<std::mutex> lock( own.mutex );
+        if (!own.dChunks.empty()) {
+            nChunk = own.dChunks.front();
+            own.dChunks.pop_front();
+            return true;
+        }
+    }
+    // then steal from the back of the other queues, starting with the next thread
+    for (int i = 1; i < m_nThreads; i++) {
+        WorkQueue &other = *m_vQueues[(nWorker + i) % m_nThreads];
+        std::lock_guard<std::mutex> lock( other.mutex );
+        if (!other.dChunks.empty()) {
+            nChunk = other.dChunks.back();
+            other.dChunks.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
+
+void flcThreadPool::ExecuteChunks( int nWorker, const std::function<void( int )> *pJob ) {
+    int nChunk;
+    while (pJob != nullptr && TakeChunk( nWorker, nChunk )) {
+        (*pJob)( nChunk );
+    }
+}
+
+void flcThreadPool::Run( int nChunks, const std::function<void( int )> &fChunk ) {
+    if (nChunks <= 0) {
+        return;
+    }
+    // run serially with a single thread, from within a parallel loop, or if another thread is running a job
+    std::unique_lock<std::mutex> jobLock( m_jobMutex, std::defer_lock );
+    if (m_nThreads <= 1 || nChunks == 1 || tlsInJob || !jobLock.try_lock()) {
+        bool bInJob = tlsInJob;
+        tlsInJob = true;
+        for (int i = 0; i < nChunks; i++) {
+            fChunk( i );
+        }
+        tlsInJob = bInJob;
+        return;
+    }
+    if (m_vWorkers.empty()) {
+        StartWorkers();
+    }
+    {
+        // a worker may still be leaving the previous job - let it go before handing out new chunks
+        std::unique_lock<std::mutex> lock( m_mutex );
+        m_cvDone.wait( lock, [&]() { return m_nActive == 0; } );
+        // each thread gets a contiguous share of the chunks
+        for (int t = 0; t < m_nThreads; t++) {
+            WorkQueue &queue = *m_vQueues[t];
+            std::lock_guard<std::mutex> queueLock( queue.mutex );
+            queue.dChunks.clear();
+            for (int c = (int)((long long)nChunks * t / m_nThreads); c < (int)((long long)nChunks * (t + 1) / m_nThreads); c++) {
+                queue.dChunks.push_back( c );
+            }
+        }
+        m_pJob    = &fChunk;
+        m_nJobNr += 1;
+    }
+    m_cvWork.notify_all();
+
+    // the calling thread works along as thread 0
+    tlsInJob = true;
+    ExecuteChunks( 0, &fChunk );
+    tlsInJob = false;
+
+    // all chunks are taken, wait for the workers that are still running one
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_cvDone.wait( lock, [&]() { return m_nActive == 0; } );
+    m_pJob = nullptr;
+}
@@ -0,0 +1,156 @@
+// AoC 2024 - work stealing thread pool
+// ====================================
+
+// date:  2025-01-30
+// by:    Joseph21 (Joseph21-6147)
+
+// A shared pool of worker threads for loops whose iterations are independent of each other, e.g. one
+// iteration per report, per equation or per candidate location. Use it via the two loop primitives:
+//
+//     parallel_for( 0, nItems, [&]( int i ) { vResult[i] = Analyse( vData[i] ); } );
+//
+//     long long nSum = parallel_reduce( 0, nItems, 0LL,
+//         [&]( int i ) { return Analyse( vData[i] ); },          // map: the value of one item
+//         []( long long a, long long b ) { return a + b; } );    // reduce: combine two values
+//
+// The range is cut into chunks of nGrain items (by default about 8 chunks per thread). Each thread
+// starts on its own contiguous share of the chunks, and a thread that runs out of work steals chunks
+// from the back of the other threads' shares. So iterations with very uneven costs still spread over
+// all threads, and neighbouring iterations mostly stay on the same thread.
+//
+// The calling thread takes part in the work, and the call returns when all iterations are done. The
+// reduction combines the partial results in chunk order, so the result doesn't depend on the
+// scheduling (also not for floating point values, or for ties when searching a maximum).
+//
+// Notes:
+//   * the iterations must not write shared data, except disjoint elements (like vResult[i] above)
+//   * scratch data per thread can be indexed with flcThreadPool::WorkerIndex(), provided it is local to
+//     the call - see e.g. day 06
+//   * a parallel loop inside a parallel loop, or a parallel loop started while the pool is busy with
+//     another one, runs serially on the calling thread
+//   * the nr of threads is the hardware concurrency by default, and is set with --threads <n> on the
+//     command line (see flcBenchmark) or SetThreadCount(). With 1 thread everything runs serially
+
+#ifndef FLCTHREADPOOL_H
+#define FLCTHREADPOOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ==============================/ Class flcThreadPool /==============================
+
+class flcThreadPool {
+public:
+    // the pool that is shared by the whole program
+    static flcThreadPool &Instance();
+    ~flcThreadPool();
+
+    // nr of threads that work on a parallel loop, including the calling thread. 0 means the hardware
+    // concurrency. Must not be called from within a parallel loop
+    void SetThreadCount( int nThreads );
+    int  GetThreadCount() const { return m_nThreads; }
+
+    // index of the current thread within the pool: 1 .. GetThreadCount() - 1 for the worker threads,
+    // 0 for any other thread
+    static int WorkerIndex();
+
+    // calls fChunk( c ) for all chunk indices 0 <= c < nChunks, spread over the threads. Returns when
+    // all chunks are done. Normally used via parallel_for() and parallel_reduce()
+    void Run( int nChunks, const std::function<void( int )> &fChunk );
+
+private:
+    flcThreadPool();
+    flcThreadPool( const flcThreadPool & ) = delete;
+    flcThreadPool &operator = ( const flcThreadPool & ) = delete;
+
+    void StartWorkers();
+    void StopWorkers();
+    void WorkerLoop( int nWorker );
+    // runs chunks of the current job until there are none left to take
+    void ExecuteChunks( int nWorker, const std::function<void( int )> *pJob );
+    // takes a chunk from the front of the own queue, or else steals one from the back of another queue
+    bool TakeChunk( int nWorker, int &nChunk );
+
+    typedef struct sWorkQueueStruct {
+        std::mutex      mutex;
+        std::deque<int> dChunks;
+    } WorkQueue;
+
+    int m_nThreads = 1;
+    std::vector<std::thread> m_vWorkers;                  // m_nThreads - 1 threads, started on first use
+    std::vector<std::unique_ptr<WorkQueue>> m_vQueues;    // one per thread, index 0 is the calling thread
+
+    std::mutex m_jobMutex;                  // held while a job runs - one job at a time
+    std::mutex m_mutex;                     // guards the members below
+    std::condition_variable m_cvWork;       // workers wait here for a new job
+    std::condition_variable m_cvDone;       // the calling thread waits here for the workers to finish
+    const std::function<void( int )> *m_pJob = nullptr;
+    long long m_nJobNr   = 0;               // incremented for each job
+    int       m_nActive  = 0;               // nr of workers that are working on the current job
+    bool      m_bStop    = false;
+};
+
+// ==========   LOOP PRIMITIVES
+
+// the chunk size if none is given: about 8 chunks per thread leaves room for balancing uneven work
+inline int ParallelGrain( int nCount, int nGrain ) {
+    if (nGrain > 0) {
+        return nGrain;
+    }
+    return std::max( 1, nCount / (flcThreadPool::Instance().GetThreadCount() * 8));
+}
+
+// calls fBody( i ) for all nBegin <= i < nEnd
+template <typename BodyFunc>
+void parallel_for( int nBegin, int nEnd, BodyFunc fBody, int nGrain = 0 ) {
+    int nCount = nEnd - nBegin;
+    if (nCount <= 0) {
+        return;
+    }
+    nGrain = ParallelGrain( nCount, nGrain );
+    int nChunks = (nCount + nGrain - 1) / nGrain;
+    flcThreadPool::Instance().Run( nChunks, [&]( int nChunk ) {
+        int nFirst = nBegin + nChunk * nGrain;
+        int nLast  = std::min( nEnd, nFirst + nGrain );
+        for (int i = nFirst; i < nLast; i++) {
+            fBody( i );
+        }
+    });
+}
+
+// returns identity reduced with fMap( i ) for all nBegin <= i < nEnd, in the order of i. fReduce( a, b )
+// combines two values, and identity must not change a value it's combined with
+template <typename T, typename MapFunc, typename ReduceFunc>
+T parallel_reduce( int nBegin, int nEnd, T identity, MapFunc fMap, ReduceFunc fReduce, int nGrain = 0 ) {
+    int nCount = nEnd - nBegin;
+    if (nCount <= 0) {
+        return identity;
+    }
+    nGrain = ParallelGrain( nCount, nGrain );
+    int nChunks = (nCount + nGrain - 1) / nGrain;
+    // one partial result per chunk
+    std::vector<T> vPartials( nChunks, identity );
+    flcThreadPool::Instance().Run( nChunks, [&]( int nChunk ) {
+        int nFirst = nBegin + nChunk * nGrain;
+        int nLast  = std::min( nEnd, nFirst + nGrain );
+        T partial = identity;
+        for (int i = nFirst; i < nLast; i++) {
+            partial = fReduce( partial, fMap( i ));
+        }
+        vPartials[nChunk] = partial;
+    });
+    T result = identity;
+    for (const T &partial : vPartials) {
+        result = fReduce( result, partial );
+    }
+    return result;
+}
+
+#endif // FLCTHREADPOOL_H
@@ -0,0 +1,213 @@
+// AoC 2024 - asynchronous trace log
+// =================================
+
+// date:  2025-02-02
+// by:    Joseph21 (Joseph21-6147)
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+#include "flcTraceLog.h"
+
+std::atomic<int> flcTraceLog::s_nLevel{ FLC_LOG_VERBOSE };
+
+// small thread ids for the trace lines, in order of the first message of each thread
+static std::atomic<int> glbNextThreadId{ 0 };
+static thread_local int tlsThreadId = -1;
+
+static const char *LevelName( int nLevel ) {
+    switch (nLevel) {
+        case FLC_LOG_PANIC  : return "PANIC  ";
+        case FLC_LOG_ERROR  : return "ERROR  ";
+        case FLC_LOG_TRACE  : return "TRACE  ";
+        case FLC_LOG_DEBUG  : return "DEBUG  ";
+        case FLC_LOG_VERBOSE: return "VERBOSE";
+    }
+    return "?      ";
+}
+
+// ==============================/ Class flcTraceLog /==============================
+
+flcTraceLog &flcTraceLog::Instance() {
+    static flcTraceLog instance;
+    return instance;
+}
+
+flcTraceLog::flcTraceLog() : m_vRing( RING_SIZE ) {
+    for (int i = 0; i < RING_SIZE; i++) {
+        m_vRing[i].nSequence.store( i, std::memory_order_relaxed );
+    }
+    m_tStart = std::chrono::steady_clock::now();
+}
+
+flcTraceLog::~flcTraceLog() {
+    Close();
+}
+
+void flcTraceLog::SetLevel( int nLevel ) {
+    if (nLevel < FLC_LOG_OFF || nLevel > FLC_LOG_VERBOSE) {
+        std::cout << "ERROR: flcTraceLog::SetLevel() --> invalid level: " << nLevel << std::endl;
+        return;
+    }
+    s_nLevel.store( nLevel, std::memory_order_relaxed );
+}
+
+int flcTraceLog::ParseLevel( const std::string &sLevel ) {
+    const char *vNames[] = { "off", "panic", "error", "trace", "debug", "verbose" };
+    for (int i = FLC_LOG_OFF; i <= FLC_LOG_VERBOSE; i++) {
+        if (sLevel == vNames[i] || sLevel == std::to_string( i )) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void flcTraceLog::Open( const std::string &sFileName ) {
+    Close();
+    std::lock_guard<std::mutex> lock( m_mutex );
+    m_file.open( sFileName );
+    m_bOpened = true;
+    if (!m_file.is_open()) {
+        std::cout << "ERROR: flcTraceLog::Open() --> can't open trace file: " << sFileName << std::endl;
+    }
+}
+
+void flcTraceLog::Start() {
+    std::lock_guard<std::mutex> lock( m_mutex );
+    if (m_bStarted.load( std::memory_order_relaxed )) {
+        return;
+    }
+    if (!m_file.is_open()) {
+        m_file.open( FLC_LOG_FILE, m_bOpened ? std::ios::app : std::ios::trunc );
+        m_bOpened = true;
+    }
+    m_bStop = false;
+    m_writer = std::thread( &flcTraceLog::WriterLoop, this );
+    m_bStarted.store( true, std::memory_order_release );
+}
+
+void flcTraceLog::Close() {
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        m_bStop = true;
+    }
+    m_cvWake.notify_all();
+    if (m_writer.joinable()) {
+        m_writer.join();
+    }
+    std::lock_guard<std::mutex> lock( m_mutex );
+    m_bStarted.store( false, std::memory_order_release );
+    m_file.close();
+}
+
+void flcTraceLog::Write( int nLevel, std::string_view sFunc, std::string_view sMsg ) {
+    if (!m_bStarted.load( std::memory_order_acquire )) {
+        Start();
+    }
+    if (tlsThreadId < 0) {
+        tlsThreadId = glbNextThreadId.fetch_add( 1, std::memory_order_relaxed );
+    }
+    // claim a ticket whose slot is free
+    uint64_t nPos = m_nWritePos.load( std::memory_order_relaxed );
+    SlotType *pSlot;
+    while (true) {
+        pSlot = &m_vRing[nPos & (RING_SIZE - 1)];
+        int64_t nDiff = (int64_t)pSlot->nSequence.load( std::memory_order_acquire ) - (int64_t)nPos;
+        if (nDiff == 0) {
+            if (m_nWritePos.compare_exchange_weak( nPos, nPos + 1, std::memory_order_relaxed )) {
+                break;
+            }
+        } else if (nDiff < 0) {
+            // the ring is full - drop the message, unless it's the last words before an exit
+            if (nLevel != FLC_LOG_PANIC) {
+                m_nDropped.fetch_add( 1, std::memory_order_relaxed );
+                return;
+            }
+            m_cvWake.notify_one();
+            std::this_thread::yield();
+            nPos = m_nWritePos.load( std::memory_order_relaxed );
+        } else {
+            nPos = m_nWritePos.load( std::memory_order_relaxed );
+        }
+    }
+    pSlot->dTime   = std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now() - m_tStart ).count();
+    pSlot->nLevel  = nLevel;
+    pSlot->nThread = tlsThreadId;
+    pSlot->nFuncLen = (uint8_t)std::min( sFunc.size(), (size_t)FUNC_LEN );
+    pSlot->nMsgLen  = (uint8_t)std::min( sMsg.size() , (size_t)MSG_LEN  );
+    memcpy( pSlot->sFunc, sFunc.data(), pSlot->nFuncLen );
+    memcpy( pSlot->sMsg , sMsg.data() , pSlot->nMsgLen  );
+    pSlot->nSequence.store( nPos + 1, std::memory_order_release );
+}
+
+void flcTraceLog::Flush() {
+    if (!m_bStarted.load( std::memory_order_acquire )) {
+        return;
+    }
+    uint64_t nTarget = m_nWritePos.load( std::memory_order_acquire );
+    while (m_nReadPos.load( std::memory_order_acquire ) < nTarget) {
+        m_cvWake.notify_one();
+        std::this_thread::sleep_for( std::chrono::microseconds( 50 ));
+    }
+}
+
+void flcTraceLog::Format( const SlotType &slot ) {
+    char sPrefix[64];
+    snprintf( sPrefix, sizeof( sPrefix ), "%12.3f ms  t%-3d %s  ", slot.dTime, slot.nThread, LevelName( slot.nLevel ));
+    m_sBuffer.append( sPrefix );
+    m_sBuffer.append( "function: " );
+    m_sBuffer.append( slot.sFunc, slot.nFuncLen );
+    m_sBuffer.append( " --> " );
+    m_sBuffer.append( slot.sMsg, slot.nMsgLen );
+    if (slot.nMsgLen == MSG_LEN) {
+        m_sBuffer.append( "..." );
+    }
+    m_sBuffer.push_back( '\n' );
+}
+
+int flcTraceLog::Drain() {
+    // only the writer thread moves the read position
+    uint64_t nPos = m_nReadPos.load( std::memory_order_relaxed );
+    int nCount = 0;
+    while (true) {
+        SlotType &slot = m_vRing[nPos & (RING_SIZE - 1)];
+        if (slot.nSequence.load( std::memory_order_acquire ) != nPos + 1) {
+            break;
+        }
+        Format( slot );
+        slot.nSequence.store( nPos + RING_SIZE, std::memory_order_release );
+        nPos += 1;
+        nCount += 1;
+    }
+    long long nDropped = m_nDropped.load( std::memory_order_relaxed );
+    if (nDropped != m_nDroppedReported) {
+        m_sBuffer.append( "WARNING: " + std::to_string( nDropped - m_nDroppedReported ) + " trace messages dropped, ring buffer was full\n" );
+        m_nDroppedReported = nDropped;
+    }
+    if (!m_sBuffer.empty()) {
+        m_file.write( m_sBuffer.data(), m_sBuffer.size());
+        m_file.flush();
+        m_sBuffer.clear();
+    }
+    m_nReadPos.store( nPos, std::memory_order_release );
+    return nCount;
+}
+
+void flcTraceLog::WriterLoop() {
+    std::unique_lock<std::mutex> lock( m_mutex );
+    while (true) {
+        bool bStop = m_bStop;
+        lock.unlock();
+        int nCount = Drain();
+        lock.lock();
+        if (bStop && nCount == 0) {
+            return;
+        }
+        // producers don't signal (that would cost a lock), so the writer also looks every few msec
+        if (nCount == 0 && !m_bStop) {
+            m_cvWake.wait_for( lock, std::chrono::milliseconds( 2 ));
+        }
+    }
+}
@@ -0,0 +1,148 @@
+// AoC 2024 - asynchronous trace log
+// =================================
+
+// date:  2025-02-02
+// by:    Joseph21 (Joseph21-6147)
+
+// Trace messages (myTrace(), myPanic(), FLC_LOG()) are not written to the trace file by the thread that
+// produces them. Instead they are copied into a slot of a lock free ring buffer, and a background thread
+// writes them to the file in batches. A message therefore costs a copy of at most a few hundred bytes,
+// instead of a formatted stream write plus a flush.
+//
+// Messages have a level:
+//
+//     FLC_LOG_PANIC     1    critical errors, written by myPanic() just before the program exits
+//     FLC_LOG_ERROR     2
+//     FLC_LOG_TRACE     3    written by myTrace()
+//     FLC_LOG_DEBUG     4    also gates the DEBUG( x ) macro of my_utility.h
+//     FLC_LOG_VERBOSE   5    also gates the VERBOSE( x ) macro of my_utility.h
+//
+// Two levels select which messages are kept:
+//   * compile time: FLC_LOG_MAX_LEVEL (default FLC_LOG_VERBOSE). Messages above it are removed by the
+//     compiler, including the evaluation of their arguments. Compile with -DFLC_LOG_MAX_LEVEL=0 to
+//     remove all tracing
+//   * run time: SetLevel(), or --trace <level> on the command line (see flcBenchmark). The level is a
+//     number or a name: off, panic, error, trace, debug, verbose. Messages above it cost one relaxed
+//     atomic load. Default is to keep everything that's compiled in
+//
+// Use the FLC_LOG() macro for messages that are put together at run time, e.g.
+//
+//     FLC_LOG( FLC_LOG_DEBUG, "SolvePart1()", "nr of stones: " + std::to_string( vStones.size()));
+//
+// since it doesn't evaluate the message if the level is off.
+//
+// If the ring buffer is full, messages are dropped rather than making the producing thread wait (panic
+// messages do wait). The nr of dropped messages is written to the trace file.
+
+#ifndef FLCTRACELOG_H
+#define FLCTRACELOG_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#define FLC_LOG_OFF       0
+#define FLC_LOG_PANIC     1
+#define FLC_LOG_ERROR     2
+#define FLC_LOG_TRACE     3
+#define FLC_LOG_DEBUG     4
+#define FLC_LOG_VERBOSE   5
+
+#ifndef FLC_LOG_MAX_LEVEL
+#define FLC_LOG_MAX_LEVEL   FLC_LOG_VERBOSE
+#endif
+
+#define FLC_LOG_FILE   "debug_output.txt"    // default trace file
+
+// logs sMsg at nLevel, with sFunc as the name of the function that logs it. Neither argument is evaluated
+// if nLevel is disabled at compile time or at run time
+#define FLC_LOG( nLevel, sFunc, sMsg )                                   \
+    do {                                                                 \
+        if constexpr ((nLevel) <= FLC_LOG_MAX_LEVEL) {                   \
+            if (flcTraceLog::Enabled( nLevel )) {                        \
+                flcTraceLog::Instance().Write( (nLevel), (sFunc), (sMsg) ); \
+            }                                                            \
+        }                                                                \
+    } while (false)
+
+// ==============================/ Class flcTraceLog /==============================
+
+class flcTraceLog {
+public:
+    // the log that is shared by the whole program
+    static flcTraceLog &Instance();
+    ~flcTraceLog();
+
+    // whether messages of nLevel are kept at run time
+    static bool Enabled( int nLevel ) { return nLevel <= s_nLevel.load( std::memory_order_relaxed ); }
+    static void SetLevel( int nLevel );
+    static int  GetLevel() { return s_nLevel.load( std::memory_order_relaxed ); }
+    // parses a level as a number or a name (see above). Returns -1 if it's not valid
+    static int  ParseLevel( const std::string &sLevel );
+
+    // (re)opens the trace file. If this isn't called, FLC_LOG_FILE is opened with the first message
+    void Open( const std::string &sFileName = FLC_LOG_FILE );
+    // writes all pending messages and closes the file
+    void Close();
+
+    // puts a message in the ring buffer. Texts that don't fit in a slot are cut off
+    void Write( int nLevel, std::string_view sFunc, std::string_view sMsg );
+    // waits until all messages that were written before the call are in the file
+    void Flush();
+
+    long long DroppedCount() const { return m_nDropped.load( std::memory_order_relaxed ); }
+
+private:
+    flcTraceLog();
+    flcTraceLog( const flcTraceLog & ) = delete;
+    flcTraceLog &operator = ( const flcTraceLog & ) = delete;
+
+    static const int RING_SIZE = 4096;    // nr of slots, must be a power of 2
+    static const int FUNC_LEN  = 48;
+    static const int MSG_LEN   = 176;
+
+    // a slot is free for the producer of ticket t if nSequence == t, and holds a message for the writer
+    // if nSequence == t + 1
+    typedef struct sSlotStruct {
+        std::atomic<uint64_t> nSequence;
+        double  dTime;        // msec since the log was created
+        int     nLevel;
+        int     nThread;
+        uint8_t nFuncLen, nMsgLen;
+        char    sFunc[FUNC_LEN];
+        char    sMsg[MSG_LEN];
+    } SlotType;
+
+    void Start();
+    void WriterLoop();
+    // writes the slots that are ready to the file, returns the nr of them
+    int  Drain();
+    void Format( const SlotType &slot );
+
+    static std::atomic<int> s_nLevel;
+
+    std::vector<SlotType> m_vRing;
+    alignas( 64 ) std::atomic<uint64_t> m_nWritePos{ 0 };    // next ticket for producers
+    alignas( 64 ) std::atomic<uint64_t> m_nReadPos { 0 };    // next slot for the writer thread
+    std::atomic<long long> m_nDropped{ 0 };
+    long long m_nDroppedReported = 0;
+
+    std::atomic<bool> m_bStarted{ false };
+    std::mutex  m_mutex;    // guards starting / stopping, the file and the wake up of the writer
+    std::condition_variable m_cvWake;
+    std::thread m_writer;
+    bool        m_bStop = false;
+    std::ofstream m_file;
+    bool        m_bOpened = false;    // the first open of the file in a run truncates it, later ones append
+    std::string m_sBuffer;    // formatted lines waiting to be written
+    std::chrono::steady_clock::time_point m_tStart;
+};
+
+#endif // FLCTRACELOG_H
@@ -1,4 +1,5 @@
 #include "my_utility.h"
+#include "flcRandom.h"
 
 #include <deque>
 #include <string>
@@ -7,7 +8,7 @@
 // --------------------------+ GLOBAL VARIABLES +--------------------------- //
 //                           +------------------+                            //
 
-std::ofstream debug_output, test_output;     // file pointers for debugging and testing
+std::ofstream test_output;                   // file pointer for testing
 
 //                              +------------+                               //
 // -----------------------------+ FUNCTIONS  +------------------------------ //
@@ -15,68 +16,56 @@ std::ofstream debug_output, test_output;     // file pointers for debugging and
 
 void InitializeTracing() {
     if (MY_TRACE)
-        debug_output.open( FILE_NAME_DEBUG );
+        flcTraceLog::Instance().Open( FILE_NAME_DEBUG );
 }
 
 void FinalizeTracing() {
     if (MY_TRACE)
-        debug_output.close();
+        flcTraceLog::Instance().Close();
 }
 
-void myPanic( std::string functionName, std::string errorMsg, int exitVal ) {
+// the panic message must be in the file before the program exits, so the trace log is flushed first
+void myPanic( std::string_view functionName, std::string_view errorMsg, int exitVal ) {
     if (MY_TRACE) {
-        debug_output << "CRITICAL ERROR in function " << functionName << " --> " << errorMsg << std::endl;
-        debug_output << "                           " <<                 "     " << "exiting with status: " << exitVal << std::endl;
+        FLC_LOG( FLC_LOG_PANIC, functionName, std::string( "CRITICAL ERROR: " ).append( errorMsg ) + ", exiting with status: " + std::to_string( exitVal ));
+        flcTraceLog::Instance().Flush();
     }
     exit( exitVal );
 }
 
-void myTrace( std::string functionName, std::string msg ) {
-    if (MY_TRACE) debug_output << "function: " << functionName << " --> " << msg << std::endl;
-}
+// Index, range and pointer checking functions (guards) - error reporting, the checks are inline in the header
 
-// Index, range and pointer checking functions (guards)
+// returns " (at file:line)" or an empty string if the location is unknown
+static std::string CheckLocation( const char *sFile, int nLine ) {
+    if (sFile == nullptr)
+        return "";
+    return std::string( " (at " ) + sFile + ":" + std::to_string( nLine ) + ")";
+}
 
 // index must be in interval [ minVal, maxVal >
 // Note that maxval is excluded (!) as valid value for index.
-void CheckIndex( std::string fName, int index, int minVal, int maxVal ) {
-    if (index < minVal)
-        std::cout << "ERROR: " << fName << " --> index out of range: "    << std::to_string( index  )
-                                        << ", should be between (min.): " << std::to_string( minVal )
-                                        << " and (max.): "                << std::to_string( maxVal ) << std::endl;
-    if (index >= maxVal)
-        std::cout << "ERROR: " << fName << " --> index out of range: "    << std::to_string( index  )
-                                        << ", should be between (min.): " << std::to_string( minVal )
-                                        << " and (max.): "                << std::to_string( maxVal ) << std::endl;
+void CheckIndexFailed( std::string_view fName, const char *sFile, int nLine, int index, int minVal, int maxVal ) {
+    std::cout << "ERROR: " << fName << " --> index out of range: "    << std::to_string( index  )
+                                    << ", should be between (min.): " << std::to_string( minVal )
+                                    << " and (max.): "                << std::to_string( maxVal ) << CheckLocation( sFile, nLine ) << std::endl;
 }
 
 // val must be in interval [ minVal, maxVal ]
 // Note that maxval is included as valid value for val.
-void CheckRange( std::string fName, int val, int minVal, int maxVal ) {
-    if (val < minVal)
-        std::cout << "ERROR: " << fName << " --> value out of range: "    << std::to_string( val    )
-                                        << ", should be between (min.): " << std::to_string( minVal )
-                                        << " and (max.): "                << std::to_string( maxVal ) << std::endl;
-    if (val > maxVal)
-        std::cout << "ERROR: " << fName << " --> value out of range: "    << std::to_string( val    )
-                                        << ", should be between (min.): " << std::to_string( minVal )
-                                        << " and (max.): "                << std::to_string( maxVal ) << std::endl;
+void CheckRangeFailed( std::string_view fName, const char *sFile, int nLine, int val, int minVal, int maxVal ) {
+    std::cout << "ERROR: " << fName << " --> value out of range: "    << std::to_string( val    )
+                                    << ", should be between (min.): " << std::to_string( minVal )
+                                    << " and (max.): "                << std::to_string( maxVal ) << CheckLocation( sFile, nLine ) << std::endl;
 }
 
-void CheckRange( std::string fName, float val, float minVal, float maxVal ) {
-    if (val < minVal)
-        std::cout << "ERROR: " << fName << " --> value out of range: "    << std::to_string( val    )
-                                        << ", should be between (min.): " << std::to_string( minVal )
-                                        << " and (max.): "                << std::to_string( maxVal ) << std::endl;
-    if (val > maxVal)
-        std::cout << "ERROR: " << fName << " --> value out of range: "    << std::to_string( val    )
-                                        << ", should be between (min.): " << std::to_string( minVal )
-                                        << " and (max.): "                << std::to_string( maxVal ) << std::endl;
+void CheckRangeFailed( std::string_view fName, const char *sFile, int nLine, float val, float minVal, float maxVal ) {
+    std::cout << "ERROR: " << fName << " --> value out of range: "    << std::to_string( val    )
+                                    << ", should be between (min.): " << std::to_string( minVal )
+                                    << " and (max.): "                << std::to_string( maxVal ) << CheckLocation( sFile, nLine ) << std::endl;
 }
 
-void CheckPointer( std::string fName, void *ptr ) {
-    if (ptr == nullptr)
-        std::cout << "ERROR: " << fName << " --> nullptr passed as input argument" << std::endl;
+void CheckPointerFailed( std::string_view fName, const char *sFile, int nLine ) {
+    std::cout << "ERROR: " << fName << " --> nullptr passed as input argument" << CheckLocation( sFile, nLine ) << std::endl;
 }
 
 // String alignment functions
@@ -171,18 +160,18 @@ std::string      BoolToString( bool var ) { return (var ? "TRUE " : "FALSE"); }
 
 // returns an integer random number in the range [ minValue, maxValue ]
 int RandomNumberBetween( int minValue, int maxValue ) {
-    return (rand() % (maxValue + 1 - minValue)) + minValue;
+    return (int)ThreadRandom().IntBetween( minValue, maxValue );
 }
 
 // returns a floating point random number in the range [ minValue, maxValue ]
 float RandomNumberBetween( float minValue, float maxValue ) {
-    return ((float)rand() / (float)RAND_MAX) * (maxValue - minValue) + minValue;
+    return RandChance() * (maxValue - minValue) + minValue;
 }
 
 // returns true if a change of x to y occurs. Example: Chance_x2y( 1, 10 ) returns
 // a chance distribution corresponding to 0.1f.
 bool Chance_x2y( int x, int y ) {
-    return (rand() % y) < x;
+    return (int)ThreadRandom().Below( y ) < x;
 }
 
 // utility function to translate a radian angle into degrees
@@ -237,12 +226,12 @@ std::string to_hex( uint32_t val ) {
 
 // returns random number in [0.0f, 1.0f]
 float RandChance() {
-    return float( rand() ) / float( RAND_MAX );
+    return float( ThreadRandom().Next() >> 40 ) / float( (1 << 24) - 1 );
 }
 
 // returns true if chance of n out of m occurs. Note that n <= m!!
 bool ChanceInt( int n, int m ) {
-    return (rand() % m) < n;
+    return (int)ThreadRandom().Below( m ) < n;
 }
 
 // returns true if chance of fNormdPerc occurs. The argument must be in [0.0f, 1.0f]
@@ -252,7 +241,7 @@ bool ChanceFloat( float fNormdPerc ) {
 
 // return a random integer value in the range [a, b]
 int RandIntBetween( int a, int b ) {
-    return (rand() % (b - a + 1)) + a;
+    return (int)ThreadRandom().IntBetween( a, b );
 }
 
 // return a random float value in the range [a, b]
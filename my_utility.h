@@ -3,6 +3,9 @@
 
 #include <iostream>
 #include  <fstream>
+#include <string_view>
+
+#include "flcTraceLog.h"
 
 //                          +--------------------+                           //
 // -------------------------+ MODULE DESCRIPTION +-------------------------- //
@@ -25,11 +28,18 @@
 // levels of debug output. DEBUG_FLAG true = minimal debug output, VERBOSE_FLAG true = additional detailed debug output
 #define DEBUG_FLAG    true
 #define VERBOSE_FLAG  true
-#define DEBUG( x )    if (  DEBUG_FLAG) std::cout << x
-#define VERBOSE( x )  if (VERBOSE_FLAG) std::cout << x
+// the flags are checked at compile time, the trace log level (see flcTraceLog) at run time
+#define DEBUG( x )    do { if constexpr (  DEBUG_FLAG && FLC_LOG_DEBUG   <= FLC_LOG_MAX_LEVEL) { if (flcTraceLog::Enabled( FLC_LOG_DEBUG   )) std::cout << x; } } while (false)
+#define VERBOSE( x )  do { if constexpr (VERBOSE_FLAG && FLC_LOG_VERBOSE <= FLC_LOG_MAX_LEVEL) { if (flcTraceLog::Enabled( FLC_LOG_VERBOSE )) std::cout << x; } } while (false)
 
 #define MY_TRACE      true  // set to false before creating a new release
 
+// argument guards (CheckIndex(), CheckRange(), CheckPointer() and the CHECK_...() macros) are compiled in
+// if MY_CHECKS is true, and removed completely otherwise. Compile with -DMY_CHECKS=true for a checked build
+#ifndef MY_CHECKS
+#define MY_CHECKS     false
+#endif
+
 //                              +------------+                               //
 // -----------------------------+ PROTOTYPES +------------------------------ //
 //                              +------------+                               //
@@ -38,29 +48,67 @@
 void InitializeTracing();
 void FinalizeTracing();
 
-// prints an error message to debug_output
+// prints an error message to the trace file (FILE_NAME_DEBUG), via the asynchronous trace log
+// NOTE: the message is only displayed if MY_TRACE == true and the trace level is FLC_LOG_TRACE or higher!
+// It's inline, so that a disabled trace costs nothing
+inline void myTrace( std::string_view functionName, std::string_view msg ) {
+    if constexpr (MY_TRACE) {
+        FLC_LOG( FLC_LOG_TRACE, functionName, msg );
+    }
+}
+// prints an error message to the trace file and exits with status exitVal
 // NOTE: the message is only displayed if MY_TRACE == true!
-void myTrace( std::string functionName, std::string msg );
-// prints an error message to debug_output and exits with status exitVal
-// NOTE: the message is only displayed if MY_TRACE == true!
-void myPanic( std::string functionName, std::string errorMsg, int exitVal );
+void myPanic( std::string_view functionName, std::string_view errorMsg, int exitVal );
 
 // ========== Argument checking ==========
 
+// The guards only cost a comparison if the check passes - the error is reported out of line. If MY_CHECKS
+// is false they are empty. The CHECK_...() macros add the source location to the error message, and don't
+// evaluate their arguments at all if MY_CHECKS is false, e.g.
+//
+//     CHECK_INDEX( x, 0, nWidth );
+
+// error reporting of the guards, only called if a check fails. sFile == nullptr means: location unknown
+void CheckIndexFailed(   std::string_view sFuncName, const char *sFile, int nLine, int   index, int   minVal, int   maxVal );
+void CheckRangeFailed(   std::string_view sFuncName, const char *sFile, int nLine, int   val  , int   minVal, int   maxVal );
+void CheckRangeFailed(   std::string_view sFuncName, const char *sFile, int nLine, float val  , float minVal, float maxVal );
+void CheckPointerFailed( std::string_view sFuncName, const char *sFile, int nLine );
+
 // index must be in interval [ minVal, maxVal >
 // Note that maxval is excluded (!) as valid value for index.
 // sFuncName is the name of the function where the guard is built into.
-void   CheckIndex( std::string sFuncName, int index, int minVal, int maxVal );
+inline void CheckIndex( std::string_view sFuncName, int index, int minVal, int maxVal, const char *sFile = nullptr, int nLine = 0 ) {
+    if constexpr (MY_CHECKS) {
+        if (index < minVal || index >= maxVal) CheckIndexFailed( sFuncName, sFile, nLine, index, minVal, maxVal );
+    }
+}
 
 // val must be in interval [ minVal, maxVal ]
 // Note that maxval is included as valid value for val.
 // sFuncName is the name of the function where the guard is built into.
-void   CheckRange( std::string sFuncName, int   val, int   minVal, int   maxVal );
-void   CheckRange( std::string sFuncName, float val, float minVal, float maxVal );
+inline void CheckRange( std::string_view sFuncName, int val, int minVal, int maxVal, const char *sFile = nullptr, int nLine = 0 ) {
+    if constexpr (MY_CHECKS) {
+        if (val < minVal || val > maxVal) CheckRangeFailed( sFuncName, sFile, nLine, val, minVal, maxVal );
+    }
+}
+inline void CheckRange( std::string_view sFuncName, float val, float minVal, float maxVal, const char *sFile = nullptr, int nLine = 0 ) {
+    if constexpr (MY_CHECKS) {
+        if (val < minVal || val > maxVal) CheckRangeFailed( sFuncName, sFile, nLine, val, minVal, maxVal );
+    }
+}
 
 // Checks on the pointer not to be nullptr
 // sFuncName is the name of the function where the guard is built into.
-void CheckPointer( std::string sFuncName, void *ptr );
+inline void CheckPointer( std::string_view sFuncName, const void *ptr, const char *sFile = nullptr, int nLine = 0 ) {
+    if constexpr (MY_CHECKS) {
+        if (ptr == nullptr) CheckPointerFailed( sFuncName, sFile, nLine );
+    }
+}
+
+// the guards with the name of the enclosing function and the source location filled in
+#define CHECK_INDEX( index, minVal, maxVal ) do { if constexpr (MY_CHECKS) CheckIndex( __func__, (index), (minVal), (maxVal), __FILE__, __LINE__ ); } while (false)
+#define CHECK_RANGE( val  , minVal, maxVal ) do { if constexpr (MY_CHECKS) CheckRange( __func__, (val  ), (minVal), (maxVal), __FILE__, __LINE__ ); } while (false)
+#define CHECK_POINTER( ptr )                 do { if constexpr (MY_CHECKS) CheckPointer( __func__, (ptr), __FILE__, __LINE__ ); } while (false)
 
 // ========== Aligned printing ==========
 
@@ -98,6 +146,9 @@ std::string BoolToString( bool var );
 
 // ==============================/   utility functions /========================================
 
+// NOTE: the random functions below use the thread local generator of flcRandom (see ThreadRandom()), so
+// they are thread safe, and seeded with SetRandomSeed() instead of srand()
+
 // returns an integer random number in the range [ minValue, maxValue ]
 int RandomNumberBetween( int minValue, int maxValue );
 // returns a floating point random number in the range [ minValue, maxValue ]
@@ -153,7 +204,7 @@ float Clamp( float a, float a_start, float a_end );
 // --------------------------+ GLOBAL VARIABLES +--------------------------- //
 //                           +------------------+                            //
 
-extern std::ofstream debug_output, test_output;   // file pointers for testing, debugging
+extern std::ofstream test_output;                 // file pointer for testing
 
 //                                                                           //
 // ------------------------------------------------------------------------- //
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <vector>
 
 #include "parse_functions.h"
@@ -6,28 +7,100 @@
 
 // this is the beginning of my parsing library :)
 
+// ==========/ string_view versions /==========
+
+string_view get_token_dlmtd( string_view delim, string_view &input_to_be_adapted ) {
+    size_t splitIndex = input_to_be_adapted.find( delim );
+    string_view token = input_to_be_adapted.substr( 0, splitIndex );
+    input_to_be_adapted = (splitIndex == string_view::npos) ? string_view() : input_to_be_adapted.substr( splitIndex + delim.length());
+    return token;
+}
+
+void split_token_dlmtd( string_view delim, string_view input, string_view &out1, string_view &out2 ) {
+    out1 = get_token_dlmtd( delim, input );
+    out2 = input;
+}
+
+string_view get_token_sized( size_t nSize, string_view &input_to_be_adapted ) {
+    nSize = min( nSize, input_to_be_adapted.length());
+    string_view token = input_to_be_adapted.substr( 0, nSize );
+    input_to_be_adapted.remove_prefix( nSize );
+    return token;
+}
+
+void split_token_sized( size_t nSize, string_view input, string_view &out1, string_view &out2 ) {
+    out1 = get_token_sized( nSize, input );
+    out2 = input;
+}
+
+void split_token_generic( const ParseList &parseInfo, string_view &input, vector<string_view> &output ) {
+    output.clear();
+    for (int i = 0; i < (int)parseInfo.size(); i++) {
+        const sParseInfo &curPI = parseInfo[i];
+        if (curPI.bFixed) {
+            if (curPI.nTokenSize <= 0) {
+                cout << "ERROR: split_token_generic() --> invalid token size = " << curPI.nTokenSize << " at index " << i << endl;
+            } else {
+                output.push_back( get_token_sized( curPI.nTokenSize, input ));
+            }
+        } else {
+            if (curPI.sDelim == "") {
+                cout << "ERROR: split_token_generic() --> invalid delimiter = " << curPI.sDelim << " at index " << i << endl;
+            } else {
+                output.push_back( get_token_dlmtd( curPI.sDelim, input ));
+            }
+        }
+    }
+}
+
+// ==========/ std::string versions /==========
+
+// the remainder of the input view is always the tail of the string, so the offset of the remainder is the
+// nr of characters that were cut off
+static size_t remainder_offset( const string &input, string_view remainder ) {
+    return input.length() - remainder.length();
+}
+
+// the tokens are cut off a view on the remainder of the input - the input itself isn't changed
+string get_token_dlmtd( const string &delim, const string &input, size_t &nOffset ) {
+    string_view inputView( input );
+    inputView.remove_prefix( min( nOffset, inputView.length()));
+    string token( get_token_dlmtd( string_view( delim ), inputView ));
+    nOffset = remainder_offset( input, inputView );
+    return token;
+}
+
+string get_token_sized( const int nSize, const string &input, size_t &nOffset ) {
+    string_view inputView( input );
+    inputView.remove_prefix( min( nOffset, inputView.length()));
+    string token( get_token_sized( (nSize < 0) ? string_view::npos : (size_t)nSize, inputView ));
+    nOffset = remainder_offset( input, inputView );
+    return token;
+}
+
 // Cuts of and returns the front token from "input_to_be_adapted", using "delim" as delimiter.
 // If delimiter is not found, the complete input string is passed as a token.
 // The input string becomes shorter as a result, and may even become empty
 string get_token_dlmtd( const string &delim, string &input_to_be_adapted ) {
-    size_t splitIndex = input_to_be_adapted.find( delim );
-    string token = input_to_be_adapted.substr( 0, splitIndex );
-    input_to_be_adapted = (splitIndex == string::npos) ? "" : input_to_be_adapted.substr( splitIndex + delim.length());
-
+    size_t nOffset = 0;
+    string token = get_token_dlmtd( delim, input_to_be_adapted, nOffset );
+    input_to_be_adapted.erase( 0, nOffset );
     return token;
 }
 
 // Cuts of and returns a token of size nSize from the front of input_to_be_adapted.
 // This input string becomes shorter as a result of this cut off, and may even become empty.
 string get_token_sized( const int nSize, string &input_to_be_adapted ) {
-    string token;
-    token = input_to_be_adapted.substr( 0, nSize );
-    input_to_be_adapted = (nSize == (int)string::npos) ? "" : input_to_be_adapted.substr( nSize );
+    size_t nOffset = 0;
+    string token = get_token_sized( nSize, input_to_be_adapted, nOffset );
+    input_to_be_adapted.erase( 0, nOffset );
     return token;
 }
 
 // Like get_token_dlmtd(), but interprets the remainder as the second token.
 // So it splits up the token "input" using the delimiter "delim", and returns the resulting parts via "out1" and "out2"
+// NOTE: unlike the string_view version, only the first character of the delimiter is skipped - the rest of a
+// multi character delimiter stays at the front of out2, so a number in it still parses with stoi()
 void split_token_dlmtd( const string &delim, const string &input, string &out1, string &out2 ) {
     size_t splitIndex = input.find( delim );
     out1 = input.substr( 0, splitIndex );
@@ -37,32 +110,20 @@ void split_token_dlmtd( const string &delim, const string &input, string &out1,
 // Like get_token_sized(), but interprets the remainder as the second token
 // so it splits up the input using the size nSize and returns two tokens via out1 and out2
 void split_token_sized( const int nSize, const string &input, string &out1, string &out2 ) {
-    out1 = input.substr( 0, nSize );
-    out2 = (nSize == (int)string::npos) ? "" : input.substr( nSize );
+    string_view view1, view2;
+    split_token_sized( (nSize < 0) ? string_view::npos : (size_t)nSize, string_view( input ), view1, view2 );
+    out1 = view1;
+    out2 = view2;
 }
 
 // takes the parse list parseInfo as instruction to cut of the tokens from input, and shorten the
 // input string as a result. The resulting tokens are passed back via output as separate strings
 void split_token_generic( const ParseList &parseInfo, string &input, vector<string> &output ) {
-    output.clear();
-    for (int i = 0; i < (int)parseInfo.size(); i++) {
-        sParseInfo curPI = parseInfo[i];
-        if (curPI.bFixed) {
-            if (curPI.nTokenSize <= 0) {
-                    cout << "ERROR: split_token_generic() --> invalid token size = " << curPI.nTokenSize << " at index " << i << endl;
-            } else {
-                string tmp = get_token_sized( curPI.nTokenSize, input );
-                output.push_back( tmp );
-            }
-        } else {
-            if (curPI.sDelim == "") {
-                    cout << "ERROR: split_token_generic() --> invalid delimiter = " << curPI.sDelim << " at index " << i << endl;
-            } else {
-                string tmp = get_token_dlmtd( curPI.sDelim, input );
-                output.push_back( tmp );
-            }
-        }
-    }
+    string_view inputView( input );
+    vector<string_view> viewOutput;
+    split_token_generic( parseInfo, inputView, viewOutput );
+    output.assign( viewOutput.begin(), viewOutput.end());
+    input.erase( 0, remainder_offset( input, inputView ));    // one move for all tokens
 }
 
 // this is an example how split_token_generic() could be used to build arbitrary splitting up parsing functions.
@@ -71,12 +132,12 @@ void split_token_generic( const ParseList &parseInfo, string &input, vector<stri
 // Like get_sized_token(), but interprets the remainder as the second token
 // so it splits up the input using the size nSize and returns two tokens via out1 and out2
 void split_token_2( const int nSize, const string &input, string &out1, string &out2 ) {
-    // prepare the call to split_token_generic()
-    string inputCopy( input );
+    // prepare the call to split_token_generic() - a view on the input, so it isn't copied or shortened
+    string_view inputView( input );
     ParseList parseInstructions = { { true, nSize, "" }, { false, -1, " " } };
-    vector<string> results;
+    vector<string_view> results;
     // do the parsing
-    split_token_generic( parseInstructions, inputCopy, results );
+    split_token_generic( parseInstructions, inputView, results );
     // pass the resulting tokens
     out1 = results[0];
     out2 = results[1];
@@ -85,12 +146,12 @@ void split_token_2( const int nSize, const string &input, string &out1, string &
 // Like get_sized_token(), but interprets the remainder as the second token
 // so it splits up the input using the size nSize and returns two tokens via out1 and out2
 void split_token_3( const int nSize1, const int nSize2, const string &input, string &out1, string &out2, string &out3 ) {
-    // prepare the call to split_token_generic()
-    string inputCopy( input );
+    // prepare the call to split_token_generic() - a view on the input, so it isn't copied or shortened
+    string_view inputView( input );
     ParseList parseInstructions = { { true, nSize1, "" }, { true, nSize2, "" }, { false, -1, " " } };
-    vector<string> results;
+    vector<string_view> results;
     // do the parsing
-    split_token_generic( parseInstructions, inputCopy, results );
+    split_token_generic( parseInstructions, inputView, results );
     // pass the resulting tokens
     out1 = results[0];
     out2 = results[1];
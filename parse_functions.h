@@ -2,6 +2,9 @@
 #define PARSE_FUNCTIONS_H
 
 #include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
 
 using namespace std;
 
@@ -12,8 +15,36 @@ struct sParseInfo {
 };
 typedef vector<sParseInfo> ParseList;
 
+// ==========/ token parsing - string_view versions /==========
+
+// These work like the std::string versions below, but the input is a string_view that acts as a cursor: each
+// token that is cut off the front just moves the start of the view. The tokens are string_views into the same
+// underlying data, so nothing is copied or allocated (O(1) per token, apart from the delimiter search).
+// NOTE: the tokens are only valid as long as the underlying string (or mapped file) exists.
+
+string_view get_token_dlmtd( string_view delim, string_view &input_to_be_adapted );
+void split_token_dlmtd( string_view delim, string_view input, string_view &out1, string_view &out2 );
+
+// if nSize is larger than the input, the complete input is returned as token
+string_view get_token_sized( size_t nSize, string_view &input_to_be_adapted );
+void split_token_sized( size_t nSize, string_view input, string_view &out1, string_view &out2 );
+
+// the tokens are appended to output after clearing it - reuse the same output vector over calls so that
+// its capacity is reused as well
+void split_token_generic( const ParseList &parseInfo, string_view &input, vector<string_view> &output );
+
 // ==========/ token parsing /==========
 
+// The std::string versions are thin wrappers around the string_view versions above. Cutting a token off
+// the front of a std::string means moving the rest of it forward, so a loop over the tokens of a long
+// string should use the nOffset versions instead: those leave the input as is, and move nOffset past the
+// token (and delimiter) instead.
+
+// Like get_token_dlmtd() / get_token_sized() below, on the part of input from nOffset onward. nOffset is
+// moved past the token, and equals input.length() when the input is used up.
+string get_token_dlmtd( const string &delim, const string &input, size_t &nOffset );
+string get_token_sized( const int nSize, const string &input, size_t &nOffset );
+
 // Cuts of and returns the front token from "input_to_be_adapted", using "delim" as delimiter.
 // If delimiter is not found, the complete input string is passed as a token.
 // The input string becomes shorter as a result, and may even become empty
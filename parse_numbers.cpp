@@ -0,0 +1,185 @@
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <string>
+
+#include "parse_numbers.h"
+
+// ==============================/   NUMBER PARSING LIB   /========================================
+
+// ==========/ kernels /==========
+
+// the SWAR kernels assume the first character ends up in the lowest byte when loading 8 characters
+#if defined( __BYTE_ORDER__ ) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__ || defined( _M_X64 ) || defined( _M_IX86 ) || defined( _M_ARM64 )
+#define PARSE_NUMBERS_SWAR
+#endif
+
+bool is_8_digits( const char *pChars ) {
+#ifdef PARSE_NUMBERS_SWAR
+    uint64_t nChunk;
+    memcpy( &nChunk, pChars, 8 );
+    // all high nibbles must be 3, and adding 6 to each byte must not carry into the high nibble (so > '9' fails)
+    return (((nChunk & 0xF0F0F0F0F0F0F0F0ULL) | (((nChunk + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) == 0x3333333333333333ULL);
+#else
+    for (int i = 0; i < 8; i++) {
+        if (pChars[i] < '0' || pChars[i] > '9') return false;
+    }
+    return true;
+#endif
+}
+
+unsigned int convert_8_digits( const char *pChars ) {
+#ifdef PARSE_NUMBERS_SWAR
+    uint64_t nChunk;
+    memcpy( &nChunk, pChars, 8 );
+    nChunk -= 0x3030303030303030ULL;                                          // ASCII to digit values
+    nChunk = (nChunk * 10   ) + (nChunk >>  8); nChunk &= 0x00FF00FF00FF00FFULL;   // 4 values of 2 digits
+    nChunk = (nChunk * 100  ) + (nChunk >> 16); nChunk &= 0x0000FFFF0000FFFFULL;   // 2 values of 4 digits
+    nChunk = (nChunk * 10000) + (nChunk >> 32);                                     // 1 value  of 8 digits
+    return (unsigned int)(nChunk & 0xFFFFFFFFULL);
+#else
+    unsigned int nResult = 0;
+    for (int i = 0; i < 8; i++) {
+        nResult = nResult * 10 + (unsigned int)(pChars[i] - '0');
+    }
+    return nResult;
+#endif
+}
+
+// ==========/ scalar parsing /==========
+
+static inline bool is_digit( char c ) { return c >= '0' && c <= '9'; }
+
+// parses the sign and digits at the front of input into a sign flag and magnitude. Returns the nr of chars
+// used, or 0 if there are no digits. bOverflow is set if the magnitude doesn't fit in 19 digits
+static size_t parse_magnitude( string_view input, bool &bNegative, unsigned long long &nMagnitude, bool &bOverflow ) {
+    const char *pCur = input.data();
+    const char *pEnd = pCur + input.length();
+    bNegative  = false;
+    bOverflow  = false;
+    nMagnitude = 0;
+    if (pCur < pEnd && (*pCur == '-' || *pCur == '+')) {
+        bNegative = (*pCur == '-');
+        pCur += 1;
+    }
+    const char *pDigits = pCur;
+    // leading zeros don't count for the overflow check
+    while (pCur < pEnd && *pCur == '0') {
+        pCur += 1;
+    }
+    const char *pSignificant = pCur;
+    // bulk of the digits 8 at a time...
+    while (pEnd - pCur >= 8 && is_8_digits( pCur )) {
+        nMagnitude = nMagnitude * 100000000ULL + convert_8_digits( pCur );
+        pCur += 8;
+    }
+    // ... and the rest one by one
+    while (pCur < pEnd && is_digit( *pCur )) {
+        nMagnitude = nMagnitude * 10 + (unsigned long long)(*pCur - '0');
+        pCur += 1;
+    }
+    if (pCur == pDigits) {
+        return 0;
+    }
+    bOverflow = (pCur - pSignificant > 19);
+    return (size_t)(pCur - input.data());
+}
+
+bool parse_ll( string_view &input_to_be_adapted, long long &nValue ) {
+    bool bNegative, bOverflow;
+    unsigned long long nMagnitude;
+    size_t nUsed = parse_magnitude( input_to_be_adapted, bNegative, nMagnitude, bOverflow );
+    unsigned long long nLimit = (unsigned long long)numeric_limits<long long>::max() + (bNegative ? 1 : 0);
+    if (nUsed == 0 || bOverflow || nMagnitude > nLimit) {
+        return false;
+    }
+    nValue = bNegative ? (long long)(0ULL - nMagnitude) : (long long)nMagnitude;
+    input_to_be_adapted.remove_prefix( nUsed );
+    return true;
+}
+
+bool parse_int( string_view &input_to_be_adapted, int &nValue ) {
+    string_view input = input_to_be_adapted;
+    long long nResult;
+    if (!parse_ll( input, nResult ) || nResult < numeric_limits<int>::min() || nResult > numeric_limits<int>::max()) {
+        return false;
+    }
+    nValue = (int)nResult;
+    input_to_be_adapted = input;
+    return true;
+}
+
+static string_view skip_white_space( string_view token ) {
+    while (!token.empty() && (token[0] == ' ' || token[0] == '\t')) {
+        token.remove_prefix( 1 );
+    }
+    return token;
+}
+
+long long to_ll( string_view token ) {
+    string_view input = skip_white_space( token );
+    long long nResult = 0;
+    if (!parse_ll( input, nResult )) {
+        cout << "ERROR: to_ll() --> not a valid number: " << token << endl;
+    }
+    return nResult;
+}
+
+int to_int( string_view token ) {
+    string_view input = skip_white_space( token );
+    int nResult = 0;
+    if (!parse_int( input, nResult )) {
+        cout << "ERROR: to_int() --> not a valid number: " << token << endl;
+    }
+    return nResult;
+}
+
+// ==========/ lists of numbers /==========
+
+// overloads so that the list parser can be written once for both types
+static inline bool parse_value( string_view &input, int       &nValue ) { return parse_int( input, nValue ); }
+static inline bool parse_value( string_view &input, long long &nValue ) { return parse_ll(  input, nValue ); }
+
+// calls fnStore( value ) for each number in the list, until it returns false
+template <typename T, typename StoreFunc>
+static size_t parse_list_generic( string_view input, char delim, StoreFunc fnStore ) {
+    size_t nCount = 0;
+    bool bDone = false;
+    while (!bDone) {
+        while (!input.empty() && input[0] == delim) {
+            input.remove_prefix( 1 );
+        }
+        T nValue;
+        if (input.empty() || !parse_value( input, nValue )) {
+            bDone = true;
+        } else {
+            nCount += 1;
+            bDone = !fnStore( nValue );
+        }
+    }
+    return nCount;
+}
+
+size_t parse_list( string_view input, char delim, vector<int> &output ) {
+    return parse_list_generic<int>( input, delim, [&]( int n ) { output.push_back( n ); return true; } );
+}
+
+size_t parse_list( string_view input, char delim, vector<long long> &output ) {
+    return parse_list_generic<long long>( input, delim, [&]( long long n ) { output.push_back( n ); return true; } );
+}
+
+size_t parse_list( string_view input, char delim, int *pBuffer, size_t nCapacity ) {
+    if (nCapacity == 0) return 0;
+    size_t nIndex = 0;
+    return parse_list_generic<int>( input, delim, [&]( int n ) { pBuffer[nIndex++] = n; return nIndex < nCapacity; } );
+}
+
+size_t parse_list( string_view input, char delim, long long *pBuffer, size_t nCapacity ) {
+    if (nCapacity == 0) return 0;
+    size_t nIndex = 0;
+    return parse_list_generic<long long>( input, delim, [&]( long long n ) { pBuffer[nIndex++] = n; return nIndex < nCapacity; } );
+}
+
+
+// ==============================/   End NUMBER PARSING LIB   /========================================
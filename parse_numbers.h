@@ -0,0 +1,52 @@
+#ifndef PARSE_NUMBERS_H
+#define PARSE_NUMBERS_H
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+
+// ==============================/   NUMBER PARSING LIB   /========================================
+
+// Companion of parse_functions: converts (string_view) tokens to integers without allocating and without
+// locale handling, comparable to std::from_chars(). Runs of 8 or more digits are converted 8 digits at a
+// time with a SWAR kernel (the 8 ASCII digits are loaded as one 64 bit word and combined in three
+// multiply / shift / mask steps), so a 16 digit number takes two kernel calls.
+
+// ==========/ scalar parsing /==========
+
+// Parses an optionally signed ('+' or '-') integer at the front of input_to_be_adapted, and moves the
+// input past it. Returns false (and leaves the input unchanged) if there are no digits, or if the value
+// doesn't fit the result type.
+bool parse_int( string_view &input_to_be_adapted, int &nValue );
+bool parse_ll(  string_view &input_to_be_adapted, long long &nValue );
+
+// Drop in replacements for stoi() and stoll() on a token: leading white space is skipped and anything after
+// the number is ignored. If there's no valid number, an error is printed and 0 is returned.
+int       to_int( string_view token );
+long long to_ll(  string_view token );
+
+// ==========/ lists of numbers /==========
+
+// Parses all numbers in input, separated by delim (runs of delimiters are treated as one), and appends them
+// to output. Parsing stops at the first token that's not a number. Returns the nr of numbers parsed.
+size_t parse_list( string_view input, char delim, vector<int>       &output );
+size_t parse_list( string_view input, char delim, vector<long long> &output );
+
+// Same, but writes into a caller provided buffer of nCapacity elements. Parsing stops when the buffer is full.
+size_t parse_list( string_view input, char delim, int       *pBuffer, size_t nCapacity );
+size_t parse_list( string_view input, char delim, long long *pBuffer, size_t nCapacity );
+
+// ==========/ kernels /==========
+
+// true if the 8 bytes at pChars are all ASCII digits
+bool is_8_digits( const char *pChars );
+// converts the 8 ASCII digits at pChars to their value (0 .. 99999999)
+unsigned int convert_8_digits( const char *pChars );
+
+
+// ==============================/   End NUMBER PARSING LIB   /========================================
+
+
+#endif // PARSE_NUMBERS_H